@@ -11,13 +11,16 @@ import 'package:axichat/src/calendar/storage/calendar_hive_adapters.dart';
 import 'package:axichat/src/calendar/storage/calendar_storage_manager.dart';
 import 'package:axichat/src/calendar/storage/calendar_storage_registry.dart';
 import 'package:axichat/src/common/capability.dart';
+import 'package:axichat/src/common/memory_budget.dart';
 import 'package:axichat/src/common/network_availability.dart';
 import 'package:axichat/src/common/policy.dart';
 import 'package:axichat/src/common/safe_logging.dart';
 import 'package:axichat/src/common/startup/auth_bootstrap.dart';
 import 'package:axichat/src/common/startup/first_frame_gate.dart';
+import 'package:axichat/src/common/startup/startup_trace.dart';
 import 'package:axichat/src/common/ui/ui.dart' show compactDeviceBreakpoint;
 import 'package:axichat/src/notifications/notification_service.dart';
+import 'package:axichat/src/share/desktop_launch_channel.dart';
 import 'package:axichat/src/storage/app_storage.dart';
 import 'package:axichat/src/storage/credential_store.dart';
 import 'package:flutter/foundation.dart';
@@ -36,11 +39,14 @@ final ValueNotifier<bool> foregroundServiceActive = ValueNotifier(false);
 
 Future<void> main(List<String> args) async {
   final WidgetsBinding binding = WidgetsFlutterBinding.ensureInitialized();
+  startupTrace.start(binding);
   _configureLogging();
   _installProfileErrorLogging();
   firstFrameGate.defer(binding);
   await _applyPhoneOrientationPolicy(binding.platformDispatcher.views);
   _installKeyboardGuard();
+  _installDesktopBackgroundTrim();
+  _installMemoryBudget(binding);
   await NetworkAvailabilityService.instance.start();
 
   const capability = Capability();
@@ -86,8 +92,10 @@ Future<void> main(List<String> args) async {
   await hiveInitFuture;
   registerCalendarHiveAdapters();
   await storageManager.ensureGuestStorage();
+  startupTrace.mark(StartupPhase.storageReady);
 
   await notificationInitFuture;
+  startupTrace.mark(StartupPhase.notificationsReady);
 
   final bool hasStoredLoginCredentials = await storedCredentialsFuture;
   final AuthBootstrap authBootstrap = AuthBootstrap(
@@ -111,7 +119,18 @@ Future<void> main(List<String> args) async {
           ),
   );
 
-  runApp(RepositoryProvider.value(value: authBootstrap, child: app));
+  startupTrace.mark(StartupPhase.runApp);
+  final Widget root = RepositoryProvider.value(
+    value: authBootstrap,
+    child: app,
+  );
+  if (DesktopLaunchChannel.isSupportedPlatform) {
+    // Windows attach to and detach from a running engine; see
+    // DesktopViewHost.
+    runWidget(root);
+  } else {
+    runApp(root);
+  }
   firstFrameGate.allow();
 }
 
@@ -192,6 +211,76 @@ bool _isPhoneDisplay(ui.Display display) {
   return logicalSize.shortestSide < compactDeviceBreakpoint;
 }
 
+const int _detachedImageCacheBytes = 4 << 20;
+int? _attachedImageCacheBytes;
+
+/// In Linux background mode the engine runs without a window; decoded images
+/// serve no purpose there, so the image cache is emptied and capped until a
+/// window is attached again.
+void _installDesktopBackgroundTrim() {
+  if (!DesktopLaunchChannel.isSupportedPlatform) return;
+  final log = Logger('DesktopBackground');
+  final ValueListenable<bool> windowAttached =
+      desktopLaunchChannel.windowAttached;
+  void apply() {
+    final ImageCache imageCache = PaintingBinding.instance.imageCache;
+    if (windowAttached.value) {
+      final int? restored = _attachedImageCacheBytes;
+      if (restored != null) {
+        imageCache.maximumSizeBytes = restored;
+      }
+    } else {
+      _attachedImageCacheBytes ??= imageCache.maximumSizeBytes;
+      imageCache
+        ..clear()
+        ..clearLiveImages()
+        ..maximumSizeBytes = _detachedImageCacheBytes;
+    }
+    log.info(
+      'Window ${windowAttached.value ? 'attached' : 'detached'}; '
+      'rss=${(ProcessInfo.currentRss / (1 << 20)).toStringAsFixed(1)} MiB',
+    );
+  }
+
+  windowAttached.addListener(apply);
+  unawaited(desktopLaunchChannel.start());
+}
+
+/// Puts the decoded image cache under the process-wide memory budget and
+/// feeds desktop low-memory warnings into it. Trimming lowers the image
+/// cache ceiling just long enough to evict down to the target.
+void _installMemoryBudget(WidgetsBinding binding) {
+  final MemoryBudget budget = MemoryBudget.instance;
+  budget.register(
+    'Decoded images',
+    sizeBytes: () => PaintingBinding.instance.imageCache.currentSizeBytes,
+    trim: (targetBytes) {
+      final ImageCache imageCache = PaintingBinding.instance.imageCache;
+      if (targetBytes == 0) {
+        imageCache
+          ..clear()
+          ..clearLiveImages();
+        return;
+      }
+      final int ceiling = imageCache.maximumSizeBytes;
+      imageCache
+        ..maximumSizeBytes = targetBytes
+        ..maximumSizeBytes = ceiling;
+    },
+  );
+  if (DesktopLaunchChannel.isSupportedPlatform) {
+    desktopLaunchChannel.lowMemoryWarnings.listen((level) {
+      budget.relieve(
+        level >= DesktopLaunchChannel.criticalMemoryWarningLevel
+            ? MemoryPressure.critical
+            : MemoryPressure.moderate,
+        reason: 'low-memory-warning $level',
+      );
+    });
+  }
+  budget.start(binding);
+}
+
 var _loggerConfigured = false;
 var _profileErrorLoggingInstalled = false;
 
@@ -15,6 +15,7 @@ import 'package:axichat/src/calendar/storage/calendar_storage_manager.dart';
 import 'package:axichat/src/calendar/view/shell/calendar_task_off_grid_drag_controller.dart';
 import 'package:axichat/src/chats/bloc/chats_cubit.dart';
 import 'package:axichat/src/common/capability.dart';
+import 'package:axichat/src/common/desktop_view_host.dart';
 import 'package:axichat/src/common/env.dart';
 import 'package:axichat/src/common/fire_and_forget.dart';
 import 'package:axichat/src/common/foreground_runtime_controller.dart';
@@ -543,6 +544,7 @@ class _MaterialAxichatState extends State<MaterialAxichat> {
     onResume: _handleLifecycleResume,
     onShow: _handleLifecycleResume,
     onRestart: _handleLifecycleResume,
+    onPause: _handleLifecyclePause,
     onExitRequested: _handleExitRequested,
   );
 
@@ -1079,11 +1081,19 @@ class _MaterialAxichatState extends State<MaterialAxichat> {
           },
         );
 
-        return ScaffoldMessenger(child: app);
+        return DesktopViewHost(child: ScaffoldMessenger(child: app));
       },
     );
   }
 
+  // A paused process can be killed without further notice.
+  void _handleLifecyclePause() {
+    fireAndForget(
+      () => context.read<XmppService>().flushOmemoRatchets(),
+      operationName: 'XmppService.flushOmemoRatchets',
+    );
+  }
+
   void _handleLifecycleResume() {
     context.read<UpdateCubit>().refresh();
     fireAndForget(
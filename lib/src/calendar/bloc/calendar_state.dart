@@ -6,6 +6,7 @@ import 'package:freezed_annotation/freezed_annotation.dart';
 
 import 'package:axichat/src/demo/demo_mode.dart';
 import 'package:axichat/src/calendar/models/calendar_model.dart';
+import 'package:axichat/src/calendar/models/calendar_occurrence_index.dart';
 import 'package:axichat/src/calendar/models/calendar_critical_path.dart';
 import 'package:axichat/src/calendar/models/calendar_task.dart';
 import 'package:axichat/src/calendar/models/day_event.dart';
@@ -203,98 +204,9 @@ extension CalendarStateExtensions on CalendarState {
       rangeEnd.microsecond,
     );
 
-    final results = <CalendarTask>[];
-    final emittedIds = <String>{};
-
-    for (final task in model.tasks.values) {
-      final baseInstance = task.baseOccurrenceInstance();
-      if (baseInstance != null && baseInstance.scheduledTime != null) {
-        final baseStart = baseInstance.scheduledTime!;
-        final baseEnd = baseInstance.effectiveEndDate ?? baseStart;
-        if (_overlapsRange(
-          baseStart,
-          baseEnd,
-          normalizedStart,
-          normalizedEnd,
-        )) {
-          results.add(baseInstance);
-          emittedIds.add(baseInstance.id);
-        }
-      }
-
-      if (!task.hasRecurrenceData) {
-        continue;
-      }
-
-      final generated = task.occurrencesWithin(normalizedStart, normalizedEnd);
-      for (final occurrence in generated) {
-        if (emittedIds.contains(occurrence.id)) {
-          continue;
-        }
-        final occurrenceStart = occurrence.scheduledTime;
-        if (occurrenceStart == null) continue;
-        final occurrenceEnd = occurrence.effectiveEndDate ?? occurrenceStart;
-        if (_overlapsRange(
-          occurrenceStart,
-          occurrenceEnd,
-          normalizedStart,
-          normalizedEnd,
-        )) {
-          results.add(occurrence);
-          emittedIds.add(occurrence.id);
-        }
-      }
-
-      if (task.occurrenceOverrides.isNotEmpty) {
-        for (final MapEntry<String, TaskOccurrenceOverride> entry
-            in task.occurrenceOverrides.entries) {
-          final override = entry.value;
-          if (override.isCancelled == true) {
-            continue;
-          }
-          final DateTime? originalStart = task.originalStartForOccurrenceKey(
-            entry.key,
-          );
-          if (originalStart == null) {
-            continue;
-          }
-          final CalendarTask instance = task.createOccurrenceInstance(
-            originalStart: originalStart,
-            occurrenceKey: entry.key,
-            override: override,
-          );
-          if (emittedIds.contains(instance.id)) {
-            continue;
-          }
-          final DateTime? overrideStart = instance.scheduledTime;
-          if (overrideStart == null) {
-            continue;
-          }
-          final DateTime overrideEnd =
-              instance.effectiveEndDate ?? overrideStart;
-          if (_overlapsRange(
-            overrideStart,
-            overrideEnd,
-            normalizedStart,
-            normalizedEnd,
-          )) {
-            results.add(instance);
-            emittedIds.add(instance.id);
-          }
-        }
-      }
-    }
-
-    results.sort((a, b) {
-      final aTime = a.scheduledTime;
-      final bTime = b.scheduledTime;
-      if (aTime == null && bTime == null) return 0;
-      if (aTime == null) return 1;
-      if (bTime == null) return -1;
-      return aTime.compareTo(bTime);
-    });
-
-    return results;
+    return CalendarOccurrenceIndex.of(
+      model,
+    ).tasksInRange(normalizedStart, normalizedEnd);
   }
 
   List<DayEvent> dayEventsForDate(DateTime date) {
@@ -353,15 +265,6 @@ extension CalendarStateExtensions on CalendarState {
         .where((path) => path.taskIds.any((id) => baseTaskIdFrom(id) == baseId))
         .toList();
   }
-
-  bool _overlapsRange(
-    DateTime eventStart,
-    DateTime eventEnd,
-    DateTime rangeStart,
-    DateTime rangeEnd,
-  ) {
-    return !eventEnd.isBefore(rangeStart) && !eventStart.isAfter(rangeEnd);
-  }
 }
 
 extension CalendarAlertBadgeModelExtensions on CalendarModel {
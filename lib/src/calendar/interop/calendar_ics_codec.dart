@@ -23,7 +23,6 @@ import 'package:axichat/src/calendar/reminders/alarm_reminder_bridge.dart';
 
 const String _icsLineBreak = '\r\n';
 const int _icsFoldLimit = 75;
-const String _icsComponentRoot = 'ROOT';
 const String _icsComponentVcalendar = 'VCALENDAR';
 const String _icsComponentVevent = 'VEVENT';
 const String _icsComponentVtodo = 'VTODO';
@@ -204,8 +203,33 @@ class CalendarIcsCodec {
   const CalendarIcsCodec();
 
   String encode(CalendarModel model) {
-    final writer = _IcsWriter(StringBuffer());
+    final StringBuffer buffer = StringBuffer();
+    encodeTo(model, buffer);
+    return buffer.toString();
+  }
+
+  /// Writes [model] to [sink] one component at a time, so a file sink only
+  /// buffers what it has not flushed yet. [onProgress] is called after each
+  /// item with the number of items written and the total.
+  void encodeTo(
+    CalendarModel model,
+    StringSink sink, {
+    void Function(int written, int total)? onProgress,
+  }) {
+    final writer = _IcsWriter(sink);
     final CalendarCollection? collection = model.collection;
+    final int total =
+        model.tasks.length +
+        model.dayEvents.length +
+        model.journals.length +
+        model.availability.length +
+        model.availabilityOverlays.length;
+    var written = 0;
+    void advance() {
+      written += 1;
+      onProgress?.call(written, total);
+    }
+
     writer.beginComponent(_icsComponentVcalendar);
     writer.writeProperty(
       _icsPropertyProdId,
@@ -296,20 +320,25 @@ class CalendarIcsCodec {
         criticalPathLinks: criticalPathLinks,
         taskUids: taskUids,
       );
+      advance();
     }
     for (final DayEvent event in model.dayEvents.values) {
       _writeDayEventComponent(writer, event);
+      advance();
     }
     for (final CalendarJournal journal in model.journals.values) {
       _writeJournalComponent(writer, journal);
+      advance();
     }
     for (final MapEntry<String, CalendarAvailability> entry
         in model.availability.entries) {
       _writeAvailabilityComponent(writer, entry.value, entry.key);
+      advance();
     }
     for (final MapEntry<String, CalendarAvailabilityOverlay> entry
         in model.availabilityOverlays.entries) {
       _writeFreeBusyComponent(writer, entry.value, entry.key);
+      advance();
     }
     if (collection != null) {
       for (final component in collection.rawComponents) {
@@ -319,19 +348,52 @@ class CalendarIcsCodec {
       }
     }
     writer.endComponent(_icsComponentVcalendar);
-    return writer.toString();
   }
 
   CalendarModel decode(String data) {
-    final CalendarRawComponent root = _IcsParser().parse(data);
-    final CalendarRawComponent? calendar = _findComponent(
-      root,
-      _icsComponentVcalendar,
-    );
-    if (calendar == null) {
+    final _IcsStreamDecoder decoder = _IcsStreamDecoder();
+    decoder.add(data);
+    return decoder.close();
+  }
+
+  /// Decodes UTF-8 [bytes] as they arrive. Lines are unfolded in a single
+  /// pass and each component is handed to the model parser when its END line
+  /// is read, so the file is never held in memory as a whole. [onBytesRead]
+  /// reports the running byte count.
+  Future<CalendarModel> decodeStream(
+    Stream<List<int>> bytes, {
+    void Function(int bytesRead)? onBytesRead,
+  }) async {
+    final _IcsStreamDecoder decoder = _IcsStreamDecoder();
+    var bytesRead = 0;
+    final Stream<String> chunks = bytes
+        .map((chunk) {
+          bytesRead += chunk.length;
+          return chunk;
+        })
+        .transform(utf8.decoder);
+    await for (final String chunk in chunks) {
+      decoder.add(chunk);
+      onBytesRead?.call(bytesRead);
+    }
+    return decoder.close();
+  }
+}
+
+class _IcsStreamDecoder {
+  final _CalendarModelParser _modelParser = _CalendarModelParser();
+  late final _IcsParser _parser = _IcsParser(_modelParser);
+  late final _IcsLineUnfolder _unfolder = _IcsLineUnfolder(_parser.addLine);
+
+  void add(String chunk) => _unfolder.add(chunk);
+
+  CalendarModel close() {
+    _unfolder.close();
+    _parser.close();
+    if (!_parser.sawCalendar) {
       throw const FormatException('Missing VCALENDAR component');
     }
-    final _CalendarParseResult result = _CalendarModelParser().parse(calendar);
+    final _CalendarParseResult result = _modelParser.finish();
     final DateTime now = DateTime.now();
     final CalendarModel model = CalendarModel(
       tasks: result.tasks,
@@ -380,59 +442,82 @@ class _CalendarParseResult {
   final CalendarCollection? collection;
 }
 
+/// Collects the calendar's properties and top-level components as they are
+/// read. Components sharing a UID are grouped until [finish], since a
+/// recurrence override may appear anywhere after its master.
 class _CalendarModelParser {
-  _CalendarParseResult parse(CalendarRawComponent calendar) {
-    final collection = _parseCollection(calendar);
-    final Map<String, List<CalendarRawComponent>> todoGroups = {};
-    final Map<String, List<CalendarRawComponent>> eventGroups = {};
-    final Map<String, List<CalendarRawComponent>> journalGroups = {};
-    final Map<String, CalendarAvailability> availability = {};
-    final Map<String, CalendarAvailabilityOverlay> overlays = {};
-    final List<CalendarRawComponent> otherComponents = <CalendarRawComponent>[];
-    for (final CalendarRawComponent component in calendar.components) {
-      final String name = component.name.toUpperCase();
-      if (name == _icsComponentVtodo) {
-        final String uid = _componentUid(component);
-        todoGroups
-            .putIfAbsent(uid, () => <CalendarRawComponent>[])
-            .add(component);
-        continue;
-      }
-      if (name == _icsComponentVevent) {
-        final String uid = _componentUid(component);
-        eventGroups
-            .putIfAbsent(uid, () => <CalendarRawComponent>[])
-            .add(component);
-        continue;
-      }
-      if (name == _icsComponentVjournal) {
-        final String uid = _componentUid(component);
-        journalGroups
-            .putIfAbsent(uid, () => <CalendarRawComponent>[])
-            .add(component);
-        continue;
-      }
-      if (name == _icsComponentVfreebusy) {
-        final _FreeBusyParseResult parsed = _parseFreeBusyComponent(component);
-        if (parsed.overlay != null && parsed.uid != null) {
-          overlays[parsed.uid!] = parsed.overlay!;
-        }
-        continue;
-      }
-      if (name == _icsComponentVavailability) {
-        final CalendarAvailability? parsed = _parseAvailabilityComponent(
-          component,
-        );
-        if (parsed != null) {
-          availability[parsed.id] = parsed;
-        }
-        continue;
+  final List<CalendarRawProperty> _calendarProperties = <CalendarRawProperty>[];
+  final List<CalendarRawComponent> _timeZones = <CalendarRawComponent>[];
+  final Map<String, List<CalendarRawComponent>> _todoGroups = {};
+  final Map<String, List<CalendarRawComponent>> _eventGroups = {};
+  final Map<String, List<CalendarRawComponent>> _journalGroups = {};
+  final Map<String, CalendarAvailability> _availability = {};
+  final Map<String, CalendarAvailabilityOverlay> _overlays = {};
+  final List<CalendarRawComponent> _otherComponents = <CalendarRawComponent>[];
+
+  void addCalendarProperty(CalendarRawProperty property) {
+    _calendarProperties.add(property);
+  }
+
+  void addComponent(CalendarRawComponent component) {
+    final String name = component.name.toUpperCase();
+    if (name == _icsComponentVtodo) {
+      final String uid = _componentUid(component);
+      _todoGroups
+          .putIfAbsent(uid, () => <CalendarRawComponent>[])
+          .add(component);
+      return;
+    }
+    if (name == _icsComponentVevent) {
+      final String uid = _componentUid(component);
+      _eventGroups
+          .putIfAbsent(uid, () => <CalendarRawComponent>[])
+          .add(component);
+      return;
+    }
+    if (name == _icsComponentVjournal) {
+      final String uid = _componentUid(component);
+      _journalGroups
+          .putIfAbsent(uid, () => <CalendarRawComponent>[])
+          .add(component);
+      return;
+    }
+    if (name == _icsComponentVfreebusy) {
+      final _FreeBusyParseResult parsed = _parseFreeBusyComponent(component);
+      if (parsed.overlay != null && parsed.uid != null) {
+        _overlays[parsed.uid!] = parsed.overlay!;
       }
-      if (name == _icsComponentVtimezone) {
-        continue;
+      return;
+    }
+    if (name == _icsComponentVavailability) {
+      final CalendarAvailability? parsed = _parseAvailabilityComponent(
+        component,
+      );
+      if (parsed != null) {
+        _availability[parsed.id] = parsed;
       }
-      otherComponents.add(component);
+      return;
+    }
+    if (name == _icsComponentVtimezone) {
+      _timeZones.add(component);
+      return;
     }
+    _otherComponents.add(component);
+  }
+
+  _CalendarParseResult finish() {
+    final collection = _parseCollection(
+      CalendarRawComponent(
+        name: _icsComponentVcalendar,
+        properties: List<CalendarRawProperty>.unmodifiable(
+          _calendarProperties,
+        ),
+        components: List<CalendarRawComponent>.unmodifiable(_timeZones),
+      ),
+    );
+    final Map<String, CalendarAvailability> availability = _availability;
+    final Map<String, CalendarAvailabilityOverlay> overlays = _overlays;
+    final List<CalendarRawComponent> otherComponents = _otherComponents;
 
     final Map<String, CalendarTask> tasks = <String, CalendarTask>{};
     final Map<String, DayEvent> dayEvents = <String, DayEvent>{};
@@ -448,7 +533,7 @@ class _CalendarModelParser {
     final bool isCalendarCancel = method == CalendarMethod.cancel;
 
     for (final MapEntry<String, List<CalendarRawComponent>> entry
-        in todoGroups.entries) {
+        in _todoGroups.entries) {
       final _TaskGroupResult? parsed = _parseTaskGroup(
         entry.value,
         isEvent: false,
@@ -466,7 +551,7 @@ class _CalendarModelParser {
     }
 
     for (final MapEntry<String, List<CalendarRawComponent>> entry
-        in eventGroups.entries) {
+        in _eventGroups.entries) {
       final _EventGroupResult? parsed = _parseEventGroup(
         entry.value,
         isCalendarCancel: isCalendarCancel,
@@ -496,7 +581,7 @@ class _CalendarModelParser {
     }
 
     for (final MapEntry<String, List<CalendarRawComponent>> entry
-        in journalGroups.entries) {
+        in _journalGroups.entries) {
       final _JournalGroupResult? parsed = _parseJournalGroup(
         entry.value,
         isCalendarCancel: isCalendarCancel,
@@ -607,9 +692,9 @@ class _CriticalPathEntry {
 }
 
 class _IcsWriter {
-  _IcsWriter(this._buffer);
+  _IcsWriter(this._sink);
 
-  final StringBuffer _buffer;
+  final StringSink _sink;
 
   void beginComponent(String name) {
     _writeLine('$_icsPropertyBegin$_icsValueColon$name');
@@ -648,57 +733,153 @@ class _IcsWriter {
     endComponent(component.name);
   }
 
-  @override
-  String toString() => _buffer.toString();
-
   void _writeLine(String line) {
     final List<String> folded = _foldLine(line);
     for (final String segment in folded) {
-      _buffer
+      _sink
         ..write(segment)
         ..write(_icsLineBreak);
     }
   }
 }
 
+/// Builds components from unfolded lines. Only the first VCALENDAR is read,
+/// and each of its direct children is handed to [_CalendarModelParser] as
+/// soon as it ends, so just the component being read is kept in memory.
 class _IcsParser {
-  CalendarRawComponent parse(String data) {
-    final List<String> lines = _unfoldLines(data);
-    final _IcsComponentBuilder rootBuilder = _IcsComponentBuilder(
-      _icsComponentRoot,
-    );
-    final List<_IcsComponentBuilder> stack = <_IcsComponentBuilder>[
-      rootBuilder,
-    ];
+  _IcsParser(this._modelParser);
 
-    for (final String rawLine in lines) {
-      final String line = rawLine.trim();
-      if (line.isEmpty) {
-        continue;
+  final _CalendarModelParser _modelParser;
+  final List<_IcsComponentBuilder> _stack = <_IcsComponentBuilder>[];
+  int _depth = 0;
+  bool _inCalendar = false;
+  bool sawCalendar = false;
+
+  void addLine(String rawLine) {
+    final String line = rawLine.trim();
+    if (line.isEmpty) {
+      return;
+    }
+    if (line.startsWith('$_icsPropertyBegin$_icsValueColon')) {
+      final String name = _normalizeName(
+        line.substring(_icsPropertyBegin.length + _icsValueColon.length),
+      );
+      _depth += 1;
+      if (_depth == 1) {
+        _inCalendar = !sawCalendar && name == _icsComponentVcalendar;
+        sawCalendar = sawCalendar || _inCalendar;
+        return;
       }
-      if (line.startsWith('$_icsPropertyBegin$_icsValueColon')) {
-        final String name = line.substring(
-          _icsPropertyBegin.length + _icsValueColon.length,
-        );
-        final _IcsComponentBuilder child = _IcsComponentBuilder(
-          _normalizeName(name),
-        );
-        stack.last.children.add(child);
-        stack.add(child);
-        continue;
+      if (!_inCalendar) {
+        return;
+      }
+      final _IcsComponentBuilder child = _IcsComponentBuilder(name);
+      if (_stack.isNotEmpty) {
+        _stack.last.children.add(child);
       }
-      if (line.startsWith('$_icsPropertyEnd$_icsValueColon')) {
-        if (stack.length > 1) {
-          stack.removeLast();
+      _stack.add(child);
+      return;
+    }
+    if (line.startsWith('$_icsPropertyEnd$_icsValueColon')) {
+      if (_depth == 0) {
+        return;
+      }
+      _depth -= 1;
+      if (_depth == 0) {
+        _inCalendar = false;
+      } else if (_inCalendar && _stack.isNotEmpty) {
+        final _IcsComponentBuilder finished = _stack.removeLast();
+        if (_stack.isEmpty) {
+          _modelParser.addComponent(finished.build());
         }
-        continue;
       }
-      final CalendarRawProperty? property = _parsePropertyLine(line);
-      if (property != null) {
-        stack.last.properties.add(property);
+      return;
+    }
+    if (!_inCalendar) {
+      return;
+    }
+    final CalendarRawProperty? property = _parsePropertyLine(line);
+    if (property == null) {
+      return;
+    }
+    if (_stack.isEmpty) {
+      _modelParser.addCalendarProperty(property);
+    } else {
+      _stack.last.properties.add(property);
+    }
+  }
+
+  /// Keeps a component left open at the end of the input, as a tree parser
+  /// would.
+  void close() {
+    if (_inCalendar && _stack.isNotEmpty) {
+      _modelParser.addComponent(_stack.first.build());
+    }
+    _stack.clear();
+    _inCalendar = false;
+  }
+}
+
+/// Splits text chunks into unfolded content lines in a single pass. A
+/// physical line starting with a space or tab continues the previous one.
+class _IcsLineUnfolder {
+  _IcsLineUnfolder(this._onLine);
+
+  final void Function(String line) _onLine;
+  final StringBuffer _line = StringBuffer();
+  final StringBuffer _partial = StringBuffer();
+
+  void add(String chunk) {
+    var start = 0;
+    while (true) {
+      final int newline = chunk.indexOf('\n', start);
+      if (newline == -1) {
+        break;
+      }
+      if (_partial.isEmpty) {
+        _addPhysicalLine(chunk.substring(start, newline));
+      } else {
+        _partial.write(chunk.substring(start, newline));
+        _addPhysicalLine(_partial.toString());
+        _partial.clear();
       }
+      start = newline + 1;
+    }
+    if (start < chunk.length) {
+      _partial.write(chunk.substring(start));
+    }
+  }
+
+  void close() {
+    if (_partial.isNotEmpty) {
+      _addPhysicalLine(_partial.toString());
+      _partial.clear();
     }
-    return rootBuilder.build();
+    _flush();
+  }
+
+  void _addPhysicalLine(String physical) {
+    final String line = physical.endsWith('\r')
+        ? physical.substring(0, physical.length - 1)
+        : physical;
+    if (line.isEmpty) {
+      return;
+    }
+    if ((line.startsWith(_icsValueSpace) || line.startsWith('\t')) &&
+        _line.isNotEmpty) {
+      _line.write(line.substring(_icsValueSpace.length));
+      return;
+    }
+    _flush();
+    _line.write(line);
+  }
+
+  void _flush() {
+    if (_line.isEmpty) {
+      return;
+    }
+    _onLine(_line.toString());
+    _line.clear();
   }
 }
 
@@ -718,15 +899,6 @@ class _IcsComponentBuilder {
   );
 }
 
-CalendarRawComponent? _findComponent(CalendarRawComponent root, String name) {
-  for (final CalendarRawComponent component in root.components) {
-    if (component.name == name) {
-      return component;
-    }
-  }
-  return null;
-}
-
 CalendarRawProperty? _parsePropertyLine(String line) {
   final int separatorIndex = line.indexOf(_icsValueColon);
   if (separatorIndex <= 0) {
@@ -770,24 +942,6 @@ CalendarPropertyParameter? _parseParameter(String raw) {
   return CalendarPropertyParameter(name: name, values: values);
 }
 
-List<String> _unfoldLines(String data) {
-  final List<String> rawLines = data.split(RegExp(r'\r?\n'));
-  final List<String> lines = <String>[];
-  for (final String line in rawLines) {
-    if (line.isEmpty) {
-      continue;
-    }
-    if ((line.startsWith(_icsValueSpace) || line.startsWith('\t')) &&
-        lines.isNotEmpty) {
-      lines[lines.length - 1] =
-          '${lines.last}${line.substring(_icsValueSpace.length)}';
-    } else {
-      lines.add(line);
-    }
-  }
-  return lines;
-}
-
 List<String> _splitUnquoted(String input, String separator) {
   final List<String> parts = <String>[];
   final StringBuffer buffer = StringBuffer();
@@ -4,6 +4,7 @@
 import 'dart:convert';
 import 'dart:async';
 import 'dart:io';
+import 'dart:isolate';
 
 import 'package:path/path.dart' as p;
 import 'package:path_provider/path_provider.dart';
@@ -18,6 +19,12 @@ const int kCalendarJsonExportVersion = 2;
 const String _taskIcsExportPrefix = 'axichat_task';
 const String _dayEventIcsExportPrefix = 'axichat_event';
 const int _calendarImportMaxBytes = 20 * 1024 * 1024;
+
+/// ICS imports are streamed, so they may be larger than JSON imports, which
+/// are decoded from one string.
+const int _calendarIcsImportMaxBytes = 100 * 1024 * 1024;
+const int _calendarIcsExportFlushChars = 64 * 1024;
+const int _calendarIcsExportProgressStep = 256;
 const String _calendarImportTooLargeError = 'Calendar import file too large.';
 
 enum CalendarExportFormat { ics, json }
@@ -131,9 +138,13 @@ class CalendarTransferService {
   }
 
   /// Exports the full calendar model in iCalendar format.
+  ///
+  /// The file is written from a background isolate as it is encoded.
+  /// [onProgress] receives the number of items written and the total.
   Future<File> exportIcs({
     required CalendarModel model,
     String? fileNamePrefix,
+    void Function(int itemsWritten, int totalItems)? onProgress,
   }) async {
     final Directory directory = await _tempDirectoryProvider();
     final String prefix = fileNamePrefix ?? 'axichat_calendar';
@@ -143,10 +154,18 @@ class CalendarTransferService {
         .replaceAll(':', '')
         .replaceAll('-', '');
     final String path = p.join(directory.path, '$prefix-$timestamp.ics');
-    final String contents = _icsCodec.encode(model);
-    final file = File(path);
-    await file.writeAsString(contents, flush: true);
-    return file;
+    final progressPort = onProgress == null ? null : ReceivePort();
+    progressPort?.listen((message) {
+      if (message is List && message.length == 2) {
+        onProgress?.call(message[0] as int, message[1] as int);
+      }
+    });
+    try {
+      await _writeIcsInIsolate(path, model, progressPort?.sendPort);
+    } finally {
+      progressPort?.close();
+    }
+    return File(path);
   }
 
   CalendarModel _modelFromTasks(Iterable<CalendarTask> tasks) {
@@ -210,16 +229,35 @@ class CalendarTransferService {
   /// Returns a [CalendarImportResult] containing either:
   /// - A full [CalendarModel] (for v2+ JSON format)
   /// - A list of tasks (for v1 JSON format)
-  Future<CalendarImportResult> importFromFile(File file) async {
+  ///
+  /// iCalendar files are streamed through the decoder on a background
+  /// isolate; [onProgress] receives the bytes read and the file size.
+  Future<CalendarImportResult> importFromFile(
+    File file, {
+    void Function(int bytesRead, int totalBytes)? onProgress,
+  }) async {
     final String extension = p.extension(file.path).toLowerCase();
     final int sizeBytes = await file.length();
-    if (sizeBytes > _calendarImportMaxBytes) {
+    final int maxBytes = extension == '.ics'
+        ? _calendarIcsImportMaxBytes
+        : _calendarImportMaxBytes;
+    if (sizeBytes > maxBytes) {
       throw const FormatException(_calendarImportTooLargeError);
     }
-    final String data = await file.readAsString();
 
     if (extension == '.ics') {
-      final CalendarModel model = _icsCodec.decode(data);
+      final progressPort = onProgress == null ? null : ReceivePort();
+      progressPort?.listen((message) {
+        if (message is int) {
+          onProgress?.call(message, sizeBytes);
+        }
+      });
+      final CalendarModel model;
+      try {
+        model = await _readIcsInIsolate(file.path, progressPort?.sendPort);
+      } finally {
+        progressPort?.close();
+      }
       return CalendarImportResult(
         tasks: model.tasks.values.toList(),
         dayEvents: model.dayEvents.values.toList(),
@@ -230,7 +268,7 @@ class CalendarTransferService {
     }
 
     if (extension == '.json') {
-      return _decodeJson(data);
+      return _decodeJson(await file.readAsString());
     }
 
     throw const FormatException('Unsupported calendar format');
@@ -293,6 +331,47 @@ class CalendarTransferService {
     throw const FormatException('Invalid calendar JSON');
   }
 
+  /// Kept apart from the callers so the isolate closure captures only the
+  /// path, the model, and the port.
+  static Future<void> _writeIcsInIsolate(
+    String path,
+    CalendarModel model,
+    SendPort? progress,
+  ) => Isolate.run(() => _writeIcs(path, model, progress));
+
+  static Future<CalendarModel> _readIcsInIsolate(
+    String path,
+    SendPort? progress,
+  ) => Isolate.run(
+    () => _icsCodec.decodeStream(
+      File(path).openRead(),
+      onBytesRead: progress?.send,
+    ),
+  );
+
+  static void _writeIcs(String path, CalendarModel model, SendPort? progress) {
+    final RandomAccessFile file = File(path).openSync(mode: FileMode.write);
+    try {
+      final sink = _IcsFileSink(file);
+      _icsCodec.encodeTo(
+        model,
+        sink,
+        onProgress: progress == null
+            ? null
+            : (written, total) {
+                if (written == total ||
+                    written % _calendarIcsExportProgressStep == 0) {
+                  progress.send(<int>[written, total]);
+                }
+              },
+      );
+      sink.flush();
+      file.flushSync();
+    } finally {
+      file.closeSync();
+    }
+  }
+
   static Future<void> _cleanupExportFile(File file) async {
     await Future<void>.delayed(_exportCleanupDelay);
     try {
@@ -304,3 +383,50 @@ class CalendarTransferService {
     }
   }
 }
+
+/// Writes encoded ICS text to [_file] in blocks, so an export holds at most
+/// one block in memory.
+final class _IcsFileSink implements StringSink {
+  _IcsFileSink(this._file);
+
+  final RandomAccessFile _file;
+  final StringBuffer _buffer = StringBuffer();
+
+  @override
+  void write(Object? object) {
+    _buffer.write(object);
+    _maybeFlush();
+  }
+
+  @override
+  void writeAll(Iterable<dynamic> objects, [String separator = '']) {
+    _buffer.writeAll(objects, separator);
+    _maybeFlush();
+  }
+
+  @override
+  void writeCharCode(int charCode) {
+    _buffer.writeCharCode(charCode);
+    _maybeFlush();
+  }
+
+  @override
+  void writeln([Object? object = '']) {
+    _buffer.writeln(object);
+    _maybeFlush();
+  }
+
+  void flush() {
+    if (_buffer.isEmpty) {
+      return;
+    }
+    _file.writeStringSync(_buffer.toString());
+    _buffer.clear();
+  }
+
+  void _maybeFlush() {
+    if (_buffer.length >= _calendarIcsExportFlushChars) {
+      flush();
+    }
+  }
+}
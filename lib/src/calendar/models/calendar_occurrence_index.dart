@@ -0,0 +1,281 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+// Copyright (C) 2025-present Eliot Lew, Axichat Developers
+
+import 'dart:collection';
+import 'dart:math' as math;
+
+import 'package:axichat/src/calendar/models/calendar_model.dart';
+import 'package:axichat/src/calendar/models/calendar_task.dart';
+import 'package:axichat/src/calendar/models/recurrence_utils.dart';
+
+/// Months of buckets kept per model, enough for a month view plus the
+/// neighbours it scrolls into.
+const int _occurrenceIndexMaxMonths = 6;
+
+/// Months of recurrence expansion kept per task.
+const int _occurrenceCacheMaxMonths = 24;
+
+/// Instances covering more days of a month than this are not copied into
+/// every day bucket; they sit in one list per month that every query in it
+/// scans, so a multi-week task costs one entry instead of up to 31.
+const int _occurrenceIndexMaxBucketDays = 7;
+
+const int _monthsPerYear = 12;
+
+/// Answers `tasksInRange` for one [CalendarModel] from day buckets instead of
+/// expanding every recurring task per query.
+///
+/// Buckets are built a month at a time around the requested range. Recurrence
+/// expansion is cached per month on the task instance itself, so a new model
+/// that keeps a task unchanged reuses its expansion and only edited tasks
+/// are expanded again.
+final class CalendarOccurrenceIndex {
+  CalendarOccurrenceIndex._(this._model);
+
+  factory CalendarOccurrenceIndex.of(CalendarModel model) =>
+      _indexes[model] ??= CalendarOccurrenceIndex._(model);
+
+  static final Expando<CalendarOccurrenceIndex> _indexes =
+      Expando<CalendarOccurrenceIndex>('CalendarOccurrenceIndex');
+
+  final CalendarModel _model;
+  final LinkedHashMap<int, _OccurrenceMonth> _months =
+      LinkedHashMap<int, _OccurrenceMonth>();
+
+  /// Task instances scheduled in or overlapping [rangeStart, rangeEnd],
+  /// sorted by start. Matches the inclusion rules of a direct expansion:
+  /// base and overridden instances count when they overlap the range, other
+  /// generated occurrences when they start inside it.
+  List<CalendarTask> tasksInRange(DateTime rangeStart, DateTime rangeEnd) {
+    if (rangeEnd.isBefore(rangeStart)) {
+      return <CalendarTask>[];
+    }
+    final DateTime firstDay = _localDay(rangeStart);
+    final DateTime lastDay = _localDay(rangeEnd);
+    final Map<String, _IndexedOccurrence> selected =
+        <String, _IndexedOccurrence>{};
+    void consider(_IndexedOccurrence occurrence) {
+      if (!occurrence.matches(rangeStart, rangeEnd)) {
+        return;
+      }
+      final _IndexedOccurrence? existing = selected[occurrence.task.id];
+      if (existing == null || occurrence.source.index < existing.source.index) {
+        selected[occurrence.task.id] = occurrence;
+      }
+    }
+
+    final int firstMonth = _monthKey(firstDay);
+    final int lastMonth = _monthKey(lastDay);
+    for (var monthKey = firstMonth; monthKey <= lastMonth; monthKey += 1) {
+      final _OccurrenceMonth month = _month(monthKey);
+      month.longOccurrences.forEach(consider);
+      final int fromDay = monthKey == firstMonth ? firstDay.day : 1;
+      final int toDay = monthKey == lastMonth
+          ? lastDay.day
+          : month.days.length;
+      for (var day = fromDay; day <= toDay; day += 1) {
+        month.days[day - 1].forEach(consider);
+      }
+    }
+
+    final List<CalendarTask> results = selected.values
+        .map((occurrence) => occurrence.task)
+        .toList();
+    results.sort((a, b) => a.scheduledTime!.compareTo(b.scheduledTime!));
+    return results;
+  }
+
+  _OccurrenceMonth _month(int monthKey) {
+    final _OccurrenceMonth? cached = _months.remove(monthKey);
+    if (cached != null) {
+      _months[monthKey] = cached;
+      return cached;
+    }
+    final month = _OccurrenceMonth.build(_model, monthKey);
+    _months[monthKey] = month;
+    while (_months.length > _occurrenceIndexMaxMonths) {
+      _months.remove(_months.keys.first);
+    }
+    return month;
+  }
+}
+
+/// Which expansion produced an instance. Earlier sources win when two
+/// produce the same occurrence id.
+enum _OccurrenceSource { base, generated, override }
+
+final class _IndexedOccurrence {
+  _IndexedOccurrence(this.task, this.source)
+    : start = task.scheduledTime!,
+      end = task.effectiveEndDate ?? task.scheduledTime!;
+
+  final CalendarTask task;
+  final _OccurrenceSource source;
+  final DateTime start;
+  final DateTime end;
+
+  bool get startsOnly => source == _OccurrenceSource.generated;
+
+  bool overlaps(DateTime rangeStart, DateTime rangeEnd) =>
+      !end.isBefore(rangeStart) && !start.isAfter(rangeEnd);
+
+  bool matches(DateTime rangeStart, DateTime rangeEnd) {
+    if (!overlaps(rangeStart, rangeEnd)) {
+      return false;
+    }
+    return !startsOnly ||
+        (!start.isBefore(rangeStart) && !start.isAfter(rangeEnd));
+  }
+}
+
+final class _OccurrenceMonth {
+  _OccurrenceMonth(int daysInMonth)
+    : days = List<List<_IndexedOccurrence>>.generate(
+        daysInMonth,
+        (_) => <_IndexedOccurrence>[],
+      );
+
+  factory _OccurrenceMonth.build(CalendarModel model, int monthKey) {
+    final DateTime monthStart = _monthStart(monthKey);
+    final DateTime monthEnd = _monthStart(
+      monthKey + 1,
+    ).subtract(const Duration(microseconds: 1));
+    final month = _OccurrenceMonth(monthEnd.day);
+    for (final CalendarTask task in model.tasks.values) {
+      final _TaskOccurrences occurrences = _TaskOccurrences.of(task);
+      for (final occurrence in occurrences.fixed) {
+        if (occurrence.overlaps(monthStart, monthEnd)) {
+          month._add(occurrence, monthStart, monthEnd);
+        }
+      }
+      if (task.hasRecurrenceData) {
+        for (final occurrence in occurrences.generatedIn(monthKey)) {
+          month._add(occurrence, monthStart, monthEnd);
+        }
+      }
+    }
+    return month;
+  }
+
+  final List<List<_IndexedOccurrence>> days;
+  final List<_IndexedOccurrence> longOccurrences = <_IndexedOccurrence>[];
+
+  void _add(
+    _IndexedOccurrence occurrence,
+    DateTime monthStart,
+    DateTime monthEnd,
+  ) {
+    final DateTime first = occurrence.start.isBefore(monthStart)
+        ? monthStart
+        : _localDay(occurrence.start);
+    if (occurrence.startsOnly) {
+      days[first.day - 1].add(occurrence);
+      return;
+    }
+    final DateTime last = occurrence.end.isAfter(monthEnd)
+        ? _localDay(monthEnd)
+        : _localDay(occurrence.end);
+    final int lastDay = math.max(first.day, last.day);
+    if (lastDay - first.day + 1 > _occurrenceIndexMaxBucketDays) {
+      longOccurrences.add(occurrence);
+      return;
+    }
+    for (var day = first.day; day <= lastDay; day += 1) {
+      days[day - 1].add(occurrence);
+    }
+  }
+}
+
+/// Expansions of one task instance. Tasks are immutable, so anything cached
+/// here stays valid for as long as a model holds the same instance.
+final class _TaskOccurrences {
+  _TaskOccurrences._(this._task) : fixed = _fixedOccurrences(_task);
+
+  factory _TaskOccurrences.of(CalendarTask task) =>
+      _cache[task] ??= _TaskOccurrences._(task);
+
+  static final Expando<_TaskOccurrences> _cache = Expando<_TaskOccurrences>(
+    'CalendarTaskOccurrences',
+  );
+
+  final CalendarTask _task;
+
+  /// The base instance and overridden instances, which do not depend on the
+  /// requested range.
+  final List<_IndexedOccurrence> fixed;
+
+  final LinkedHashMap<int, List<_IndexedOccurrence>> _generated =
+      LinkedHashMap<int, List<_IndexedOccurrence>>();
+
+  List<_IndexedOccurrence> generatedIn(int monthKey) {
+    final List<_IndexedOccurrence>? cached = _generated.remove(monthKey);
+    if (cached != null) {
+      _generated[monthKey] = cached;
+      return cached;
+    }
+    final DateTime monthStart = _monthStart(monthKey);
+    final DateTime monthEnd = _monthStart(
+      monthKey + 1,
+    ).subtract(const Duration(microseconds: 1));
+    final List<_IndexedOccurrence> occurrences = <_IndexedOccurrence>[
+      for (final CalendarTask occurrence in _task.occurrencesWithin(
+        monthStart,
+        monthEnd,
+      ))
+        if (occurrence.scheduledTime != null)
+          _IndexedOccurrence(occurrence, _OccurrenceSource.generated),
+    ];
+    _generated[monthKey] = occurrences;
+    while (_generated.length > _occurrenceCacheMaxMonths) {
+      _generated.remove(_generated.keys.first);
+    }
+    return occurrences;
+  }
+
+  static List<_IndexedOccurrence> _fixedOccurrences(CalendarTask task) {
+    final List<_IndexedOccurrence> occurrences = <_IndexedOccurrence>[];
+    final CalendarTask? baseInstance = task.baseOccurrenceInstance();
+    if (baseInstance != null && baseInstance.scheduledTime != null) {
+      occurrences.add(
+        _IndexedOccurrence(baseInstance, _OccurrenceSource.base),
+      );
+    }
+    if (!task.hasRecurrenceData) {
+      return occurrences;
+    }
+    for (final MapEntry<String, TaskOccurrenceOverride> entry
+        in task.occurrenceOverrides.entries) {
+      if (entry.value.isCancelled == true) {
+        continue;
+      }
+      final DateTime? originalStart = task.originalStartForOccurrenceKey(
+        entry.key,
+      );
+      if (originalStart == null) {
+        continue;
+      }
+      final CalendarTask instance = task.createOccurrenceInstance(
+        originalStart: originalStart,
+        occurrenceKey: entry.key,
+        override: entry.value,
+      );
+      if (instance.scheduledTime == null) {
+        continue;
+      }
+      occurrences.add(
+        _IndexedOccurrence(instance, _OccurrenceSource.override),
+      );
+    }
+    return occurrences;
+  }
+}
+
+DateTime _localDay(DateTime value) {
+  final DateTime local = value.toLocal();
+  return DateTime(local.year, local.month, local.day);
+}
+
+int _monthKey(DateTime day) => day.year * _monthsPerYear + day.month - 1;
+
+DateTime _monthStart(int monthKey) =>
+    DateTime(monthKey ~/ _monthsPerYear, monthKey % _monthsPerYear + 1);
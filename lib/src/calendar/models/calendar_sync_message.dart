@@ -31,8 +31,9 @@ abstract final class CalendarSyncType {
   static const String full = 'calendar_full';
   static const String update = 'calendar_update';
   static const String snapshot = 'calendar_snapshot';
+  static const String delta = 'calendar_delta';
 
-  static const List<String> all = [request, full, update, snapshot];
+  static const List<String> all = [request, full, update, snapshot, delta];
 }
 
 class CalendarSyncAttachment {
@@ -78,6 +79,10 @@ abstract class CalendarSyncMessage with _$CalendarSyncMessage {
   static const String roomPrimaryViewEntity = 'room_primary_view';
   static const String roomPrimaryViewPayloadId = 'room_primary_view';
   static const String roomPrimaryViewDataKey = 'primary_view';
+  static const String deltaSourceDataKey = 'source';
+  static const String deltaSinceDataKey = 'since';
+  static const String deltaUntilDataKey = 'until';
+  static const String deltaModelDataKey = 'model';
 
   const factory CalendarSyncMessage({
     /// Message type: request, full, update, or snapshot.
@@ -105,8 +110,19 @@ abstract class CalendarSyncMessage with _$CalendarSyncMessage {
   factory CalendarSyncMessage.fromJson(Map<String, dynamic> json) =>
       _$CalendarSyncMessageFromJson(json);
 
-  factory CalendarSyncMessage.request() => CalendarSyncMessage(
+  /// Requests calendar data from peers. A peer whose source is in
+  /// [watermarks] replies with only the items it received after that
+  /// position; [checksum] is the requester's model checksum, which lets a
+  /// peer with nothing new confirm the two calendars match.
+  factory CalendarSyncMessage.request({
+    Map<String, int> watermarks = const <String, int>{},
+    String? checksum,
+  }) => CalendarSyncMessage(
     type: CalendarSyncType.request,
+    data: watermarks.isEmpty
+        ? null
+        : <String, dynamic>{deltaSinceDataKey: watermarks},
+    checksum: checksum,
     timestamp: _calendarSyncNowUtc(),
   );
 
@@ -143,6 +159,26 @@ abstract class CalendarSyncMessage with _$CalendarSyncMessage {
     entity: roomPrimaryViewEntity,
   );
 
+  /// Carries the items and tombstones [source] received in the receipt
+  /// positions (since, until] as a partial calendar model.
+  factory CalendarSyncMessage.delta({
+    required Map<String, dynamic> model,
+    required String checksum,
+    required String source,
+    required int since,
+    required int until,
+  }) => CalendarSyncMessage(
+    type: CalendarSyncType.delta,
+    data: <String, dynamic>{
+      deltaSourceDataKey: source,
+      deltaSinceDataKey: since,
+      deltaUntilDataKey: until,
+      deltaModelDataKey: model,
+    },
+    checksum: checksum,
+    timestamp: _calendarSyncNowUtc(),
+  );
+
   /// Creates a snapshot message referencing an attachment-based snapshot.
   factory CalendarSyncMessage.snapshot({
     required String snapshotChecksum,
@@ -173,6 +209,56 @@ abstract class CalendarSyncMessage with _$CalendarSyncMessage {
     return ChatPrimaryView.tryParse(rawValue);
   }
 
+  /// The requester's watermark per peer source.
+  Map<String, int> get deltaWatermarks {
+    final rawValue = type == CalendarSyncType.request
+        ? data?[deltaSinceDataKey]
+        : null;
+    if (rawValue is! Map) {
+      return const <String, int>{};
+    }
+    return <String, int>{
+      for (final MapEntry(:key, :value) in rawValue.entries)
+        if (key is String && value is int && value >= 0) key: value,
+    };
+  }
+
+  /// The peer whose receipt positions a delta counts in.
+  String? get deltaSource {
+    final rawValue = data?[deltaSourceDataKey];
+    return rawValue is String && rawValue.isNotEmpty ? rawValue : null;
+  }
+
+  /// The receipt position a delta starts after.
+  int? get deltaSince => _dataPosition(deltaSinceDataKey);
+
+  /// The newest receipt position a delta covers.
+  int? get deltaUntil => _dataPosition(deltaUntilDataKey);
+
+  Map<String, dynamic>? get deltaModel {
+    if (type != CalendarSyncType.delta) {
+      return null;
+    }
+    final model = data?[deltaModelDataKey];
+    return model is Map<String, dynamic> ? model : null;
+  }
+
+  CalendarSyncMessage withDeltaModel(
+    Map<String, dynamic> model, {
+    required String checksum,
+  }) => copyWith(
+    data: <String, dynamic>{...?data, deltaModelDataKey: model},
+    checksum: checksum,
+  );
+
+  int? _dataPosition(String key) {
+    if (type != CalendarSyncType.delta) {
+      return null;
+    }
+    final rawValue = data?[key];
+    return rawValue is int && rawValue >= 0 ? rawValue : null;
+  }
+
   XmlElement toXmppExtension() {
     final element = XmlElement(XmlName('calendar_sync'));
 
@@ -9,11 +9,14 @@ import 'package:logging/logging.dart';
 
 import 'package:axichat/src/storage/hive_extensions.dart';
 import 'calendar_hive_adapters.dart';
+import 'calendar_item_store.dart';
 
 /// Hive-backed [Storage] implementation that namespaces keys so multiple
-/// hydrated blocs can share the same box without collisions.
+/// hydrated blocs can share the same box without collisions. Calendar states
+/// are split into per-item records by [CalendarItemStore].
 class CalendarHydratedStorage implements Storage {
-  CalendarHydratedStorage._(this._box, this._prefix);
+  CalendarHydratedStorage._(this._box, this._prefix)
+    : _items = CalendarItemStore.forBox(_box);
 
   /// Opens (or reuses) the Hive box identified by [boxName] and returns a
   /// storage wrapper that scopes all keys using [prefix].
@@ -60,6 +63,7 @@ class CalendarHydratedStorage implements Storage {
 
   final Box<dynamic> _box;
   final String _prefix;
+  final CalendarItemStore _items;
 
   String _namespaced(String key) => '${_prefix}_$key';
 
@@ -79,7 +83,7 @@ class CalendarHydratedStorage implements Storage {
     if (!_box.isOpen) {
       return null;
     }
-    return _box.get(_namespaced(key));
+    return _items.read(_namespaced(key));
   }
 
   @override
@@ -87,7 +91,7 @@ class CalendarHydratedStorage implements Storage {
     if (!_box.isOpen) {
       return;
     }
-    await _box.put(_namespaced(key), value);
+    await _items.write(_namespaced(key), value);
   }
 
   @override
@@ -95,7 +99,7 @@ class CalendarHydratedStorage implements Storage {
     if (!_box.isOpen) {
       return;
     }
-    await _box.delete(_namespaced(key));
+    await _items.delete(_namespaced(key));
   }
 
   @override
@@ -103,6 +107,7 @@ class CalendarHydratedStorage implements Storage {
     if (!_box.isOpen) {
       return;
     }
+    _items.forget();
     await _box.deleteAll(_scopedKeys);
   }
 
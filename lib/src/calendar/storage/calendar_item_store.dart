@@ -0,0 +1,331 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+// Copyright (C) 2025-present Eliot Lew, Axichat Developers
+
+import 'dart:async';
+import 'dart:convert';
+
+import 'package:crypto/crypto.dart';
+import 'package:hive_ce/hive.dart';
+
+const String _calendarItemStoreMarkerKey = 'calendarItemStore';
+const int _calendarItemStoreVersion = 1;
+const String _calendarItemStoreStateKey = 'state';
+const String _calendarStateModelKey = 'model';
+const String _calendarItemKeySeparator = '#';
+const int _hiveMaxKeyLength = 255;
+
+/// Model fields that hold one entry per task, event, or tombstone, under the
+/// snake_case names json_serializable writes. Everything else in the model is
+/// small and stays in the manifest.
+const Set<String> _calendarItemFields = <String>{
+  'tasks',
+  'day_events',
+  'journals',
+  'critical_paths',
+  'availability',
+  'availability_overlays',
+  'deleted_task_ids',
+  'deleted_day_event_ids',
+  'deleted_journal_ids',
+  'deleted_critical_path_ids',
+};
+
+final RegExp _calendarItemKeySafeId = RegExp(r'^[\x20-\x7e]+$');
+
+/// Persists hydrated calendar state in a Hive box as one record per item
+/// instead of one record for the whole model.
+///
+/// The state's top-level fields and the model's scalar fields go into a small
+/// manifest under the storage key; every task, event, journal, and tombstone
+/// gets its own record keyed `<storage key>#<field>#<id>`. A write compares
+/// each item with the value last persisted and encodes and appends only the
+/// items that differ, so toggling one task rewrites one task. Hive's log then
+/// reclaims the superseded frames when it compacts.
+///
+/// Values that are not calendar states are stored unchanged, and a legacy
+/// whole-state record is migrated on its next write.
+final class CalendarItemStore {
+  CalendarItemStore._(this._box);
+
+  /// One store per box, so wrappers sharing a box share its item index.
+  factory CalendarItemStore.forBox(Box<dynamic> box) =>
+      _stores[box] ??= CalendarItemStore._(box);
+
+  static final Expando<CalendarItemStore> _stores = Expando<CalendarItemStore>(
+    'CalendarItemStore',
+  );
+
+  final Box<dynamic> _box;
+
+  /// What the box holds, per storage key. Only updated once a write lands.
+  final Map<String, Map<String, _CalendarStoredItem>> _items =
+      <String, Map<String, _CalendarStoredItem>>{};
+  final Map<String, String> _manifests = <String, String>{};
+  Future<void> _writeTail = Future<void>.value();
+
+  static bool isCalendarState(Object? value) =>
+      value is Map && value[_calendarStateModelKey] is Map;
+
+  Object? read(String key) {
+    final stored = _box.get(key);
+    final manifest = _manifests[key] ?? _manifestState(stored);
+    if (manifest == null) {
+      return stored;
+    }
+    final state = jsonDecode(manifest) as Map<String, dynamic>;
+    final model = Map<String, dynamic>.of(
+      state[_calendarStateModelKey] as Map<String, dynamic>,
+    );
+    for (final item in _itemsFor(key).values) {
+      final collection = model.putIfAbsent(
+        item.field,
+        () => <String, dynamic>{},
+      );
+      (collection as Map<String, dynamic>)[item.id] = item.value;
+    }
+    state[_calendarStateModelKey] = model;
+    return state;
+  }
+
+  /// Writes [value] under [key]. Writes are applied in call order, each one
+  /// diffed against what the writes before it actually persisted, so a failed
+  /// write is retried in full by the next one.
+  Future<void> write(String key, Object? value) {
+    if (!isCalendarState(value)) {
+      return _enqueue(() => _replaceWithRaw(key, value));
+    }
+    return _enqueue(() async {
+      final _CalendarItemBatch batch;
+      try {
+        batch = _diff(key, value as Map);
+      } on JsonUnsupportedObjectError {
+        return _replaceWithRaw(key, value);
+      }
+      if (batch.puts.isNotEmpty) {
+        await _box.putAll(batch.puts);
+      }
+      if (batch.removed.isNotEmpty) {
+        await _box.deleteAll(batch.removed);
+      }
+      _items[key] = batch.items;
+      _manifests[key] = batch.manifest;
+      if (batch.migrated) {
+        await _box.compact();
+      }
+    });
+  }
+
+  Future<void> delete(String key) {
+    return _enqueue(() async {
+      final itemKeys = _itemsFor(key).keys.toList(growable: false);
+      await _box.deleteAll(<String>[key, ...itemKeys]);
+      _items.remove(key);
+      _manifests.remove(key);
+    });
+  }
+
+  /// Drops cached item indexes, e.g. after the box was cleared externally.
+  void forget() {
+    _items.clear();
+    _manifests.clear();
+  }
+
+  _CalendarItemBatch _diff(String key, Map value) {
+    final state = Map<String, dynamic>.of(value.cast());
+    final model = Map<String, dynamic>.of(
+      (state[_calendarStateModelKey] as Map).cast(),
+    );
+    final previous = _itemsFor(key);
+    final next = <String, _CalendarStoredItem>{};
+    final puts = <String, Object?>{};
+    for (final field in _calendarItemFields) {
+      final collection = model.remove(field);
+      if (collection is! Map) {
+        continue;
+      }
+      for (final MapEntry(key: rawId, value: item) in collection.entries) {
+        final id = rawId.toString();
+        final itemKey = _itemKey(storageKey: key, field: field, id: id);
+        final existing = previous[itemKey];
+        if (existing != null && _jsonEquals(existing.value, item)) {
+          next[itemKey] = existing;
+          continue;
+        }
+        final stored = _CalendarStoredItem(
+          field: field,
+          id: id,
+          encoded: jsonEncode(item),
+          value: item,
+        );
+        next[itemKey] = stored;
+        puts[itemKey] = <Object?>[stored.id, stored.encoded];
+      }
+    }
+    state[_calendarStateModelKey] = model;
+    final manifest = jsonEncode(state);
+    final removed = <String>[
+      for (final itemKey in previous.keys)
+        if (!next.containsKey(itemKey)) itemKey,
+    ];
+    final migrated = !_manifests.containsKey(key) && _box.containsKey(key);
+    if (_manifests[key] != manifest || migrated) {
+      puts[key] = <String, Object?>{
+        _calendarItemStoreMarkerKey: _calendarItemStoreVersion,
+        _calendarItemStoreStateKey: manifest,
+      };
+    }
+    return _CalendarItemBatch(
+      items: next,
+      manifest: manifest,
+      puts: puts,
+      removed: removed,
+      migrated: migrated,
+    );
+  }
+
+  Future<void> _replaceWithRaw(String key, Object? value) async {
+    final itemKeys = _itemsFor(key).keys.toList(growable: false);
+    await _box.put(key, value);
+    if (itemKeys.isNotEmpty) {
+      await _box.deleteAll(itemKeys);
+    }
+    _items[key] = <String, _CalendarStoredItem>{};
+    _manifests.remove(key);
+  }
+
+  Future<void> _enqueue(Future<void> Function() operation) {
+    final next = _writeTail.then((_) => operation());
+    _writeTail = next.then<void>((_) {}, onError: (Object _) {});
+    return next;
+  }
+
+  /// Builds the item index for [key] from the box on first use. Later reads
+  /// and writes use the index, which tracks what has been persisted.
+  Map<String, _CalendarStoredItem> _itemsFor(String key) {
+    final cached = _items[key];
+    if (cached != null) {
+      return cached;
+    }
+    final items = <String, _CalendarStoredItem>{};
+    final prefix = '$key$_calendarItemKeySeparator';
+    for (final itemKey in _box.keys.whereType<String>()) {
+      if (!itemKey.startsWith(prefix)) continue;
+      final stored = _box.get(itemKey);
+      if (stored is! List || stored.length != 2) continue;
+      final [id, encoded] = stored;
+      final field = itemKey
+          .substring(prefix.length)
+          .split(_calendarItemKeySeparator)
+          .first;
+      if (id is! String || encoded is! String) continue;
+      if (!_calendarItemFields.contains(field)) continue;
+      items[itemKey] = _CalendarStoredItem(
+        field: field,
+        id: id,
+        encoded: encoded,
+      );
+    }
+    _items[key] = items;
+    final manifest = _manifestState(_box.get(key));
+    if (manifest != null) {
+      _manifests[key] = manifest;
+    }
+    return items;
+  }
+
+  static String? _manifestState(Object? stored) {
+    if (stored is! Map ||
+        stored[_calendarItemStoreMarkerKey] != _calendarItemStoreVersion) {
+      return null;
+    }
+    final state = stored[_calendarItemStoreStateKey];
+    return state is String ? state : null;
+  }
+
+  /// Hive keys must be printable ASCII of at most 255 characters; other ids
+  /// are hashed. The id itself is stored in the record.
+  static String _itemKey({
+    required String storageKey,
+    required String field,
+    required String id,
+  }) {
+    final prefix =
+        '$storageKey$_calendarItemKeySeparator$field'
+        '$_calendarItemKeySeparator';
+    final plain = '$prefix$id';
+    if (plain.length <= _hiveMaxKeyLength &&
+        _calendarItemKeySafeId.hasMatch(id)) {
+      return plain;
+    }
+    return '$prefix${sha256.convert(utf8.encode(id))}';
+  }
+}
+
+final class _CalendarStoredItem {
+  _CalendarStoredItem({
+    required this.field,
+    required this.id,
+    required this.encoded,
+    Object? value,
+  }) : _value = value;
+
+  final String field;
+  final String id;
+  final String encoded;
+  Object? _value;
+
+  /// The item as last written, or decoded from [encoded] when it was loaded
+  /// from the box.
+  Object? get value => _value ??= jsonDecode(encoded);
+}
+
+final class _CalendarItemBatch {
+  const _CalendarItemBatch({
+    required this.items,
+    required this.manifest,
+    required this.puts,
+    required this.removed,
+    required this.migrated,
+  });
+
+  /// The item index and manifest the box holds once the batch lands.
+  final Map<String, _CalendarStoredItem> items;
+  final String manifest;
+  final Map<String, Object?> puts;
+  final List<String> removed;
+
+  /// The write replaces a legacy whole-state record, so most of the box is
+  /// now garbage and worth compacting right away.
+  final bool migrated;
+}
+
+/// Compares two JSON values without encoding them. Numbers compare by value,
+/// so an `int` read back from the box equals the `double` it was written as.
+bool _jsonEquals(Object? a, Object? b) {
+  if (identical(a, b)) {
+    return true;
+  }
+  if (a is Map) {
+    if (b is! Map || a.length != b.length) {
+      return false;
+    }
+    for (final MapEntry(:key, :value) in a.entries) {
+      if (!b.containsKey(key) || !_jsonEquals(value, b[key])) {
+        return false;
+      }
+    }
+    return true;
+  }
+  if (a is List) {
+    if (b is! List || a.length != b.length) {
+      return false;
+    }
+    for (var index = 0; index < a.length; index += 1) {
+      if (!_jsonEquals(a[index], b[index])) {
+        return false;
+      }
+    }
+    return true;
+  }
+  return a == b;
+}
@@ -13,6 +13,7 @@ import 'package:hydrated_bloc/hydrated_bloc.dart';
 
 const String _chatCalendarStorageIdPrefix = 'chat_calendar_';
 const String _chatCalendarSyncStatePrefix = 'chat_calendar_sync_v1_';
+const String _chatCalendarReceiptsPrefix = 'chat_calendar_receipts_v1_';
 
 String chatCalendarStorageId(String chatJid) {
   return '$_chatCalendarStorageIdPrefix${_hashChatCalendarJid(chatJid)}';
@@ -22,6 +23,10 @@ String chatCalendarSyncStateKey(String chatJid) {
   return '$_chatCalendarSyncStatePrefix${_hashChatCalendarJid(chatJid)}';
 }
 
+String chatCalendarReceiptsKey(String chatJid) {
+  return '$_chatCalendarReceiptsPrefix${_hashChatCalendarJid(chatJid)}';
+}
+
 String _hashChatCalendarJid(String jid) {
   final normalized = normalizedAddressValueOrEmpty(jid);
   final bytes = utf8.encode(normalized);
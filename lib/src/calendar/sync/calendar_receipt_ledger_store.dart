@@ -0,0 +1,49 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+// Copyright (C) 2025-present Eliot Lew, Axichat Developers
+
+import 'package:axichat/src/calendar/storage/chat_calendar_storage.dart';
+import 'package:axichat/src/calendar/storage/storage_builders.dart';
+import 'package:hydrated_bloc/hydrated_bloc.dart';
+
+/// Keeps the receipt ledger of a calendar in calendar storage, so the delta
+/// watermarks peers hold for this device survive a restart.
+class CalendarReceiptLedgerStore {
+  const CalendarReceiptLedgerStore({Storage? storage}) : _storage = storage;
+
+  static String get personalKey =>
+      '${authStoragePrefix}personal_calendar_receipts_v1';
+
+  static String chatKey(String chatJid) =>
+      '$authStoragePrefix${chatCalendarReceiptsKey(chatJid)}';
+
+  final Storage? _storage;
+
+  String? read(String key) {
+    final raw = _resolvedStorage()?.read(key);
+    return raw is String ? raw : null;
+  }
+
+  Future<void> write(String key, String ledger) async {
+    final storage = _resolvedStorage();
+    if (storage == null) {
+      return;
+    }
+    await storage.write(key, ledger);
+  }
+
+  Future<void> delete(String key) async {
+    final storage = _resolvedStorage();
+    if (storage == null) {
+      return;
+    }
+    await storage.delete(key);
+  }
+
+  Storage? _resolvedStorage() {
+    try {
+      return _storage ?? HydratedBloc.storage;
+    } on StorageNotFound {
+      return null;
+    }
+  }
+}
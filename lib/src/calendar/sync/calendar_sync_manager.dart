@@ -4,12 +4,15 @@
 import 'dart:collection';
 import 'dart:convert';
 import 'dart:io';
+import 'dart:math' as math;
 
 import 'package:crypto/crypto.dart';
 import 'package:path/path.dart' as p;
 import 'package:path_provider/path_provider.dart';
+import 'package:uuid/uuid.dart';
 
 import 'package:axichat/src/calendar/models/calendar_availability.dart';
+import 'package:axichat/src/calendar/models/calendar_collection.dart';
 import 'package:axichat/src/calendar/models/calendar_ics_meta.dart';
 import 'package:axichat/src/calendar/models/calendar_exceptions.dart';
 import 'package:axichat/src/calendar/models/calendar_critical_path.dart';
@@ -19,6 +22,7 @@ import 'package:axichat/src/calendar/models/calendar_sync_message.dart';
 import 'package:axichat/src/calendar/models/calendar_task.dart';
 import 'package:axichat/src/calendar/models/day_event.dart';
 import 'package:axichat/src/storage/models/chat_models.dart';
+import 'package:axichat/src/calendar/sync/calendar_receipt_ledger_store.dart';
 import 'package:axichat/src/calendar/sync/calendar_snapshot_codec.dart';
 import 'package:axichat/src/calendar/sync/calendar_sync_state.dart';
 import 'package:axichat/src/common/safe_logging.dart';
@@ -38,6 +42,17 @@ const String _calendarSyncOperationAdd = 'add';
 const String _calendarSyncOperationUpdate = 'update';
 const String _calendarSyncOperationDelete = 'delete';
 const Duration _calendarSyncFutureTimestampTolerance = Duration(minutes: 2);
+const String _calendarReceiptTasks = 'tasks';
+const String _calendarReceiptDayEvents = 'day_events';
+const String _calendarReceiptJournals = 'journals';
+const String _calendarReceiptCriticalPaths = 'critical_paths';
+const String _calendarReceiptAvailability = 'availability';
+const String _calendarReceiptAvailabilityOverlays = 'availability_overlays';
+const String _calendarReceiptDeletedTasks = 'deleted_tasks';
+const String _calendarReceiptDeletedDayEvents = 'deleted_day_events';
+const String _calendarReceiptDeletedJournals = 'deleted_journals';
+const String _calendarReceiptDeletedCriticalPaths = 'deleted_critical_paths';
+const String _calendarReceiptCollection = 'collection';
 
 enum _CalendarOutboundUpdateResult {
   sentUpdate,
@@ -61,6 +76,8 @@ class CalendarSyncManager {
     Future<CalendarSnapshotUploadResult> Function(File file)? sendSnapshotFile,
     CalendarSyncState Function()? readSyncState,
     Future<void> Function(CalendarSyncState)? writeSyncState,
+    String? Function()? readReceiptLedger,
+    Future<void> Function(String ledger)? writeReceiptLedger,
     Future<void> Function(CalendarSnapshotPublishStatus status)?
     onSnapshotPublishStatusChanged,
   }) : _readModel = readModel,
@@ -72,6 +89,17 @@ class CalendarSyncManager {
        _sendSnapshotFile = sendSnapshotFile,
        _readSyncState = readSyncState ?? CalendarSyncState.read,
        _writeSyncState = writeSyncState ?? ((s) => s.write()),
+       _readReceiptLedger =
+           readReceiptLedger ??
+           (() => const CalendarReceiptLedgerStore().read(
+             CalendarReceiptLedgerStore.personalKey,
+           )),
+       _writeReceiptLedger =
+           writeReceiptLedger ??
+           ((ledger) => const CalendarReceiptLedgerStore().write(
+             CalendarReceiptLedgerStore.personalKey,
+             ledger,
+           )),
        _onSnapshotPublishStatusChanged = onSnapshotPublishStatusChanged;
 
   final CalendarModel Function() _readModel;
@@ -86,6 +114,8 @@ class CalendarSyncManager {
   _sendSnapshotFile;
   final CalendarSyncState Function() _readSyncState;
   final Future<void> Function(CalendarSyncState) _writeSyncState;
+  final String? Function() _readReceiptLedger;
+  final Future<void> Function(String ledger) _writeReceiptLedger;
   final Future<void> Function(CalendarSnapshotPublishStatus status)?
   _onSnapshotPublishStatusChanged;
   final ListQueue<
@@ -96,6 +126,8 @@ class CalendarSyncManager {
         ({CalendarSyncOutbound outbound, Future<void> Function()? onSent})
       >();
   Future<void>? _pendingFlush;
+  late final _CalendarReceiptLedger _receipts =
+      _CalendarReceiptLedger.restore(_readReceiptLedger());
 
   /// Handles an incoming calendar sync message.
   Future<bool> onCalendarMessage(CalendarSyncInbound inbound) async {
@@ -115,6 +147,9 @@ class CalendarSyncManager {
         case CalendarSyncType.snapshot:
           applied = await _handleSnapshotMessage(message, inbound: inbound);
           break;
+        case CalendarSyncType.delta:
+          applied = await _handleDeltaMessage(message, inbound: inbound);
+          break;
         default:
           SafeLogging.debugLog(
             'Unknown calendar sync message type: ${message.type}',
@@ -252,8 +287,58 @@ class CalendarSyncManager {
     );
   }
 
+  /// Merges the partial model carried by a delta and advances the watermark
+  /// for the peer that sent it.
+  Future<bool> _handleDeltaMessage(
+    CalendarSyncMessage message, {
+    required CalendarSyncInbound inbound,
+  }) async {
+    final Map<String, dynamic>? modelData = message.deltaModel;
+    if (modelData == null) {
+      await _recordHandledMessage(inbound: inbound);
+      return false;
+    }
+    final remoteModel = await _parseCalendarModel(
+      modelData,
+      inbound: inbound,
+      description: 'delta',
+    );
+    if (remoteModel == null) {
+      return false;
+    }
+    final String? checksum = message.checksum;
+    if (checksum != null && checksum != remoteModel.calculateChecksum()) {
+      SafeLogging.debugLog(
+        'Delta checksum mismatch - ignoring delta',
+        name: 'CalendarSyncManager',
+      );
+      await _recordHandledMessage(inbound: inbound);
+      return false;
+    }
+    final localModel = _readModel();
+    final mergedModel = normalizeCalendarModelForSync(
+      localModel.mergeWith(remoteModel),
+    );
+    if (mergedModel.checksum != localModel.checksum) {
+      await _applyModel(mergedModel);
+    }
+    CalendarSyncState state = _readSyncState();
+    final String? source = message.deltaSource;
+    final int? since = message.deltaSince;
+    final int? until = message.deltaUntil;
+    if (source != null && since != null && until != null) {
+      state = state.advanceDeltaWatermark(
+        source: source,
+        since: since,
+        until: until,
+      );
+    }
+    await _writeSyncState(_stateWithAdvancedCursor(state, inbound));
+    return true;
+  }
+
   Future<bool> _handleRequestMessage(
-    CalendarSyncMessage _, {
+    CalendarSyncMessage message, {
     required CalendarSyncInbound inbound,
   }) async {
     try {
@@ -268,6 +353,10 @@ class CalendarSyncManager {
         }
       }
       await _flushPendingEnvelopes();
+      if (await _maybeSendDelta(message)) {
+        await _recordHandledMessage(inbound: inbound);
+        return true;
+      }
       final sent = await _maybeSendSnapshot();
       await _recordHandledMessage(inbound: inbound);
       return sent;
@@ -318,7 +407,9 @@ class CalendarSyncManager {
         localModel.mergeWith(remoteModel),
       );
       await _applyModel(mergedModel);
-      await _recordHandledMessage(inbound: inbound);
+      await _writeSyncState(
+        _stateWithAdvancedCursor(_readSyncState(), inbound),
+      );
       return true;
     } catch (e) {
       SafeLogging.debugLog('Error handling full calendar message: $e');
@@ -619,6 +710,70 @@ class CalendarSyncManager {
     return false;
   }
 
+  Future<void> _persistReceipts() async {
+    if (!_receipts.takeDirty()) {
+      return;
+    }
+    try {
+      await _writeReceiptLedger(_receipts.toJson());
+    } on Exception catch (error) {
+      _receipts.markDirty();
+      SafeLogging.debugLog(
+        'Failed to persist calendar receipts: $error',
+        name: 'CalendarSyncManager',
+      );
+    }
+  }
+
+  /// Answers a request with the items this device received after the
+  /// requester's watermark for it, or with everything when it has none.
+  /// Returns false when a snapshot should be sent instead: the delta does
+  /// not fit in one envelope, or it is empty while the requester's checksum
+  /// says the calendars still differ.
+  Future<bool> _maybeSendDelta(CalendarSyncMessage request) async {
+    final CalendarModel current = _readModel();
+    final int until = _receipts.observe(current);
+    await _persistReceipts();
+    final int since = math.min(
+      request.deltaWatermarks[_receipts.source] ?? 0,
+      until,
+    );
+    final CalendarModel model = normalizeCalendarModelForSync(current);
+    final CalendarModel delta = _receipts.deltaSince(model, since);
+    if (!delta.hasCalendarData &&
+        !delta.hasTombstones &&
+        delta.collection == null) {
+      return request.checksum == model.calculateChecksum();
+    }
+    final String checksum = delta.calculateChecksum();
+    final syncMessage = CalendarSyncMessage.delta(
+      model: delta.copyWith(checksum: checksum).toJson(),
+      checksum: checksum,
+      source: _receipts.source,
+      since: since,
+      until: until,
+    );
+    final outbound = CalendarSyncOutbound(
+      envelope: jsonEncode({'calendar_sync': syncMessage.toJson()}),
+    );
+    if (!_canSendInlineEnvelope(outbound)) {
+      return false;
+    }
+    try {
+      await _sendEnvelope(outbound);
+    } on Exception catch (error) {
+      SafeLogging.debugLog(
+        'Queued calendar delta after send error: $error',
+        name: 'CalendarSyncManager',
+      );
+    }
+    SafeLogging.debugLog(
+      'Sent calendar delta (receipts: $since..$until)',
+      name: 'CalendarSyncManager',
+    );
+    return true;
+  }
+
   Future<({CalendarSyncOutbound outbound, String checksum})>
   _buildInlineSnapshotOutbound(CalendarModel model) async {
     final checksum = await CalendarSnapshotCodec.computeChecksumAsync(model);
@@ -781,7 +936,10 @@ class CalendarSyncManager {
       return;
     }
     await _flushPendingEnvelopes();
-    final syncMessage = CalendarSyncMessage.request();
+    final syncMessage = CalendarSyncMessage.request(
+      watermarks: _readSyncState().deltaWatermarks,
+      checksum: normalizeCalendarModelForSync(_readModel()).calculateChecksum(),
+    );
 
     final messageJson = jsonEncode({'calendar_sync': syncMessage.toJson()});
     await _sendEnvelope(CalendarSyncOutbound(envelope: messageJson));
@@ -1157,6 +1315,255 @@ DateTime _boundSyncInstant(DateTime value) {
 DateTime _resolveRemoteModifiedAt(DateTime entityModifiedAt) =>
     _normalizeSyncInstant(entityModifiedAt);
 
+typedef _CalendarReceipt = ({Object? value, String? digest, int position});
+
+const String _calendarReceiptLedgerSourceKey = 'source';
+const String _calendarReceiptLedgerPositionKey = 'position';
+const String _calendarReceiptLedgerEntriesKey = 'entries';
+const int _calendarReceiptDigestLength = 16;
+
+/// Numbers the item versions this device has held, in the order it first saw
+/// them locally. A peer's delta watermark is a position in this sequence, so
+/// an edit that arrives late or was authored offline still lands after every
+/// watermark handed out before it, whatever its `modifiedAt` says.
+///
+/// The ledger is persisted with a digest per item instead of the item, and
+/// compared by digest after a restart until the item is seen again. Items
+/// that disappear are kept as gone until they fall
+/// [CalendarSyncState.maxDeltaWatermarks] positions behind.
+final class _CalendarReceiptLedger {
+  _CalendarReceiptLedger._(this.source, this._position, this._entries)
+    : _dirty = false;
+
+  _CalendarReceiptLedger.fresh()
+    : source = const Uuid().v4(),
+      _position = 0,
+      _entries = <String, _CalendarReceipt>{},
+      _dirty = true;
+
+  /// Restores a ledger written by [toJson], or starts a fresh one under a
+  /// new [source] when there is none or it cannot be read.
+  factory _CalendarReceiptLedger.restore(String? raw) {
+    if (raw == null) {
+      return _CalendarReceiptLedger.fresh();
+    }
+    try {
+      final Object? decoded = jsonDecode(raw);
+      if (decoded is! Map<String, dynamic>) {
+        throw const FormatException('Receipt ledger is not an object');
+      }
+      final Object? source = decoded[_calendarReceiptLedgerSourceKey];
+      final Object? position = decoded[_calendarReceiptLedgerPositionKey];
+      final Object? entries = decoded[_calendarReceiptLedgerEntriesKey];
+      if (source is! String || position is! int || entries is! Map) {
+        throw const FormatException('Receipt ledger is incomplete');
+      }
+      final restored = <String, _CalendarReceipt>{};
+      for (final MapEntry(:key, :value) in entries.entries) {
+        if (key is! String || value is! List || value.isEmpty) {
+          throw const FormatException('Malformed receipt entry');
+        }
+        final Object? entryPosition = value.first;
+        final Object? digest = value.length > 1 ? value[1] : null;
+        if (entryPosition is! int || (digest != null && digest is! String)) {
+          throw const FormatException('Malformed receipt entry');
+        }
+        restored[key] = (
+          value: null,
+          digest: digest as String?,
+          position: entryPosition,
+        );
+      }
+      return _CalendarReceiptLedger._(source, position, restored);
+    } on FormatException catch (error) {
+      SafeLogging.debugLog(
+        'Discarding unreadable calendar receipts: $error',
+        name: 'CalendarSyncManager',
+      );
+      return _CalendarReceiptLedger.fresh();
+    }
+  }
+
+  final String source;
+  int _position;
+  final Map<String, _CalendarReceipt> _entries;
+  bool _dirty;
+
+  /// Whether the ledger changed since the last call.
+  bool takeDirty() {
+    final bool dirty = _dirty;
+    _dirty = false;
+    return dirty;
+  }
+
+  void markDirty() => _dirty = true;
+
+  /// Gives every item of [model] that differs from the version last seen the
+  /// next position, marks items that are gone, and returns the newest
+  /// position.
+  int observe(CalendarModel model) {
+    final int next = _position + 1;
+    bool changed = false;
+    final Set<String> seen = <String>{};
+    void visit(String field, Map<String, Object> items) {
+      for (final MapEntry(:key, :value) in items.entries) {
+        final String entryKey = '$field/$key';
+        seen.add(entryKey);
+        final previous = _entries[entryKey];
+        final Object? previousValue = previous?.value;
+        if (previousValue != null &&
+            (identical(previousValue, value) || previousValue == value)) {
+          continue;
+        }
+        final String? previousDigest = previous?.digest;
+        if (previous != null &&
+            previousValue == null &&
+            previousDigest != null &&
+            previousDigest == _calendarReceiptDigest(value)) {
+          _entries[entryKey] = (
+            value: value,
+            digest: previousDigest,
+            position: previous.position,
+          );
+          continue;
+        }
+        _entries[entryKey] = (value: value, digest: null, position: next);
+        changed = true;
+      }
+    }
+
+    visit(_calendarReceiptTasks, model.tasks);
+    visit(_calendarReceiptDayEvents, model.dayEvents);
+    visit(_calendarReceiptJournals, model.journals);
+    visit(_calendarReceiptCriticalPaths, model.criticalPaths);
+    visit(_calendarReceiptAvailability, model.availability);
+    visit(_calendarReceiptAvailabilityOverlays, model.availabilityOverlays);
+    visit(_calendarReceiptDeletedTasks, model.deletedTaskIds);
+    visit(_calendarReceiptDeletedDayEvents, model.deletedDayEventIds);
+    visit(_calendarReceiptDeletedJournals, model.deletedJournalIds);
+    visit(_calendarReceiptDeletedCriticalPaths, model.deletedCriticalPathIds);
+    final CalendarCollection? collection = model.collection;
+    visit(_calendarReceiptCollection, <String, Object>{
+      if (collection != null) '': collection,
+    });
+    if (changed) {
+      _position = next;
+      _dirty = true;
+    }
+    final int horizon = _position - CalendarSyncState.maxDeltaWatermarks;
+    for (final String entryKey in _entries.keys.toList()) {
+      if (seen.contains(entryKey)) {
+        continue;
+      }
+      final _CalendarReceipt entry = _entries[entryKey]!;
+      if (entry.value != null || entry.digest != null) {
+        _entries[entryKey] = (value: null, digest: null, position: _position);
+        _dirty = true;
+      } else if (entry.position < horizon) {
+        _entries.remove(entryKey);
+        _dirty = true;
+      }
+    }
+    return _position;
+  }
+
+  String toJson() {
+    final Map<String, List<Object>> entries = <String, List<Object>>{};
+    for (final MapEntry(:key, value: entry) in _entries.entries.toList()) {
+      final Object? value = entry.value;
+      String? digest = entry.digest;
+      if (digest == null && value != null) {
+        digest = _calendarReceiptDigest(value);
+        _entries[key] = (
+          value: value,
+          digest: digest,
+          position: entry.position,
+        );
+      }
+      entries[key] = <Object>[entry.position, if (digest != null) digest];
+    }
+    return jsonEncode(<String, Object>{
+      _calendarReceiptLedgerSourceKey: source,
+      _calendarReceiptLedgerPositionKey: _position,
+      _calendarReceiptLedgerEntriesKey: entries,
+    });
+  }
+
+  /// The items of [model] first seen after [since], as a partial model.
+  CalendarModel deltaSince(CalendarModel model, int since) {
+    bool isNew(String field, String key) =>
+        (_entries['$field/$key']?.position ?? _position + 1) > since;
+    Map<String, T> changed<T>(String field, Map<String, T> items) {
+      return <String, T>{
+        for (final MapEntry(:key, :value) in items.entries)
+          if (isNew(field, key)) key: value,
+      };
+    }
+
+    return CalendarModel(
+      tasks: changed(_calendarReceiptTasks, model.tasks),
+      dayEvents: changed(_calendarReceiptDayEvents, model.dayEvents),
+      journals: changed(_calendarReceiptJournals, model.journals),
+      criticalPaths: changed(
+        _calendarReceiptCriticalPaths,
+        model.criticalPaths,
+      ),
+      availability: changed(_calendarReceiptAvailability, model.availability),
+      availabilityOverlays: changed(
+        _calendarReceiptAvailabilityOverlays,
+        model.availabilityOverlays,
+      ),
+      collection: isNew(_calendarReceiptCollection, '')
+          ? model.collection
+          : null,
+      deletedTaskIds: changed(
+        _calendarReceiptDeletedTasks,
+        model.deletedTaskIds,
+      ),
+      deletedDayEventIds: changed(
+        _calendarReceiptDeletedDayEvents,
+        model.deletedDayEventIds,
+      ),
+      deletedJournalIds: changed(
+        _calendarReceiptDeletedJournals,
+        model.deletedJournalIds,
+      ),
+      deletedCriticalPathIds: changed(
+        _calendarReceiptDeletedCriticalPaths,
+        model.deletedCriticalPathIds,
+      ),
+      lastModified: model.lastModified,
+      checksum: '',
+    );
+  }
+}
+
+String _calendarReceiptDigest(Object value) {
+  final Object? json = switch (value) {
+    final DateTime instant => instant.toUtc().toIso8601String(),
+    final CalendarTask task => task.toJson(),
+    final DayEvent event => event.toJson(),
+    final CalendarJournal journal => journal.toJson(),
+    final CalendarCriticalPath path => path.toJson(),
+    final CalendarAvailability availability => availability.toJson(),
+    final CalendarAvailabilityOverlay overlay => overlay.toJson(),
+    final CalendarCollection collection => collection.toJson(),
+    _ => value.toString(),
+  };
+  return sha256
+      .convert(utf8.encode(jsonEncode(json)))
+      .toString()
+      .substring(0, _calendarReceiptDigestLength);
+}
+
+extension on CalendarModel {
+  bool get hasTombstones =>
+      deletedTaskIds.isNotEmpty ||
+      deletedDayEventIds.isNotEmpty ||
+      deletedJournalIds.isNotEmpty ||
+      deletedCriticalPathIds.isNotEmpty;
+}
+
 CalendarIcsMeta? _normalizeIcsMetaForSync(CalendarIcsMeta? meta) {
   if (meta == null) {
     return null;
@@ -108,6 +108,7 @@ class CalendarSyncState {
     this.lastVerifiedSnapshotAt,
     this.recoveryCursorStatus = CalendarRecoveryCursorStatus.unknown,
     this.snapshotPublishStatus = CalendarSnapshotPublishStatus.idle,
+    this.deltaWatermarks = const <String, int>{},
   });
 
   /// Legacy registered key for calendar sync state persisted outside the
@@ -115,6 +116,9 @@ class CalendarSyncState {
   static final stateKey = XmppStateStore.registerKey('calendar_sync_state_v1');
   static const Duration _futureTimestampTolerance = Duration(minutes: 2);
 
+  /// Sources a device keeps delta watermarks for.
+  static const int maxDeltaWatermarks = 8;
+
   final int schemaVersion;
 
   /// Number of locally published updates since the last snapshot.
@@ -161,6 +165,11 @@ class CalendarSyncState {
 
   final CalendarSnapshotPublishStatus snapshotPublishStatus;
 
+  /// Receipt position merged from each peer source, sent with requests so
+  /// peers can answer with a delta instead of a snapshot. Sources change
+  /// when a peer restarts, so only the most recently advanced are kept.
+  final Map<String, int> deltaWatermarks;
+
   bool get hasCompleteCoverage => coverageStatus.isComplete;
 
   bool get hasVerifiedRecoveryBoundary =>
@@ -192,6 +201,7 @@ class CalendarSyncState {
     Object? lastVerifiedSnapshotAt = _calendarSyncStateUnset,
     CalendarRecoveryCursorStatus? recoveryCursorStatus,
     CalendarSnapshotPublishStatus? snapshotPublishStatus,
+    Map<String, int>? deltaWatermarks,
   }) {
     final DateTime? resolvedLastAppliedTimestamp =
         lastAppliedTimestamp == _calendarSyncStateUnset
@@ -248,6 +258,7 @@ class CalendarSyncState {
       recoveryCursorStatus: recoveryCursorStatus ?? this.recoveryCursorStatus,
       snapshotPublishStatus:
           snapshotPublishStatus ?? this.snapshotPublishStatus,
+      deltaWatermarks: deltaWatermarks ?? this.deltaWatermarks,
     );
   }
 
@@ -261,6 +272,29 @@ class CalendarSyncState {
     return copyWith(updatesSinceSnapshot: 0);
   }
 
+  /// Advances the watermark for [source] to [until] after merging a delta
+  /// that covered (since, until]. A delta starting past the current
+  /// watermark answered another device's request and leaves a gap, so it
+  /// does not move it.
+  CalendarSyncState advanceDeltaWatermark({
+    required String source,
+    required int since,
+    required int until,
+  }) {
+    final current = deltaWatermarks[source] ?? 0;
+    if (since > current || until <= current) {
+      return this;
+    }
+    final watermarks = Map<String, int>.of(deltaWatermarks)..remove(source);
+    while (watermarks.length >= maxDeltaWatermarks) {
+      watermarks.remove(watermarks.keys.first);
+    }
+    watermarks[source] = until;
+    return copyWith(
+      deltaWatermarks: Map<String, int>.unmodifiable(watermarks),
+    );
+  }
+
   CalendarSyncState markHandled(CalendarSyncInbound inbound) {
     final rawPrevious = lastHandledTimestamp ?? lastAppliedTimestamp;
     final previous = rawPrevious == null
@@ -435,6 +469,7 @@ class CalendarSyncState {
       lastVerifiedSnapshotAt: lastVerifiedSnapshotAt,
       recoveryCursorStatus: CalendarRecoveryCursorStatus.unknown,
       snapshotPublishStatus: snapshotPublishStatus,
+      deltaWatermarks: deltaWatermarks,
     );
   }
 
@@ -463,6 +498,7 @@ class CalendarSyncState {
           .toIso8601String(),
       'recoveryCursorStatus': recoveryCursorStatus.wireValue,
       'snapshotPublishStatus': snapshotPublishStatus.wireValue,
+      'deltaWatermarks': deltaWatermarks,
     });
   }
 
@@ -484,6 +520,12 @@ class CalendarSyncState {
         map['lastVerifiedSnapshotAt'] != null
         ? DateTime.parse(map['lastVerifiedSnapshotAt'] as String).toUtc()
         : null;
+    final rawDeltaWatermarks = map['deltaWatermarks'];
+    final deltaWatermarks = <String, int>{
+      if (rawDeltaWatermarks is Map)
+        for (final MapEntry(:key, :value) in rawDeltaWatermarks.entries)
+          if (key is String && value is int) key: value,
+    };
     final snapshotCoverageStatus = schemaVersion < 4
         ? CalendarSnapshotCoverageStatus.unknown
         : CalendarSnapshotCoverageStatus.parse(
@@ -525,6 +567,7 @@ class CalendarSyncState {
       snapshotPublishStatus: CalendarSnapshotPublishStatus.parse(
         map['snapshotPublishStatus'] as String?,
       ),
+      deltaWatermarks: Map<String, int>.unmodifiable(deltaWatermarks),
     );
   }
 
@@ -587,7 +630,8 @@ class CalendarSyncState {
         'lastVerifiedSnapshotStanzaId: $lastVerifiedSnapshotStanzaId, '
         'lastVerifiedSnapshotAt: $lastVerifiedSnapshotAt, '
         'recoveryCursorStatus: $recoveryCursorStatus, '
-        'snapshotPublishStatus: $snapshotPublishStatus)';
+        'snapshotPublishStatus: $snapshotPublishStatus, '
+        'deltaWatermarks: $deltaWatermarks)';
   }
 
   @override
@@ -611,7 +655,8 @@ class CalendarSyncState {
         other.lastVerifiedSnapshotStanzaId == lastVerifiedSnapshotStanzaId &&
         other.lastVerifiedSnapshotAt == lastVerifiedSnapshotAt &&
         other.recoveryCursorStatus == recoveryCursorStatus &&
-        other.snapshotPublishStatus == snapshotPublishStatus;
+        other.snapshotPublishStatus == snapshotPublishStatus &&
+        _intMapEquals(other.deltaWatermarks, deltaWatermarks);
   }
 
   @override
@@ -634,6 +679,11 @@ class CalendarSyncState {
     lastVerifiedSnapshotAt,
     recoveryCursorStatus,
     snapshotPublishStatus,
+    Object.hashAllUnordered(
+      deltaWatermarks.entries.map(
+        (entry) => Object.hash(entry.key, entry.value),
+      ),
+    ),
   );
 }
 
@@ -704,4 +754,19 @@ class PersonalCalendarSyncStateStore {
   }
 }
 
+bool _intMapEquals(Map<String, int> a, Map<String, int> b) {
+  if (identical(a, b)) {
+    return true;
+  }
+  if (a.length != b.length) {
+    return false;
+  }
+  for (final MapEntry(:key, :value) in a.entries) {
+    if (b[key] != value) {
+      return false;
+    }
+  }
+  return true;
+}
+
 const Object _calendarSyncStateUnset = Object();
@@ -6,6 +6,7 @@ import 'dart:io';
 import 'package:axichat/src/calendar/models/calendar_model.dart';
 import 'package:axichat/src/calendar/models/calendar_sync_message.dart';
 import 'package:axichat/src/calendar/models/calendar_task.dart';
+import 'package:axichat/src/calendar/sync/calendar_receipt_ledger_store.dart';
 import 'package:axichat/src/calendar/sync/calendar_snapshot_codec.dart';
 import 'package:axichat/src/calendar/sync/calendar_sync_manager.dart';
 import 'package:axichat/src/calendar/sync/calendar_sync_state.dart';
@@ -195,6 +196,8 @@ class _ChatCalendarSession {
       sendSnapshotFile: sendSnapshotFile,
       readSyncState: readSyncState,
       writeSyncState: writeSyncState,
+      readReceiptLedger: readReceiptLedger,
+      writeReceiptLedger: writeReceiptLedger,
     );
   }
 
@@ -210,6 +213,16 @@ class _ChatCalendarSession {
   Future<void> writeSyncState(CalendarSyncState state) =>
       _syncStateStore.write(chatJid, state);
 
+  String? readReceiptLedger() => const CalendarReceiptLedgerStore().read(
+    CalendarReceiptLedgerStore.chatKey(chatJid),
+  );
+
+  Future<void> writeReceiptLedger(String ledger) =>
+      const CalendarReceiptLedgerStore().write(
+        CalendarReceiptLedgerStore.chatKey(chatJid),
+        ledger,
+      );
+
   Future<void> send(CalendarSyncOutbound outbound) async {
     if (_chatType == ChatType.note) {
       return;
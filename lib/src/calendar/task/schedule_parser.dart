@@ -105,13 +105,13 @@ bool _looksLikeExactPostalAddress(String candidate) {
   }
 
   final beforeSuffix = streetSegment.substring(0, suffixMatch.start);
-  if (!RegExp(r'[A-Za-z]').hasMatch(beforeSuffix)) {
+  if (!_asciiLetterPattern.hasMatch(beforeSuffix)) {
     return false;
   }
 
   final afterSuffix = remainder.substring(suffixMatch.end);
   if (afterSuffix.isNotEmpty &&
-      !RegExp(r'^[,A-Za-z0-9.\- ]+$').hasMatch(afterSuffix)) {
+      !_addressTailCharsPattern.hasMatch(afterSuffix)) {
     return false;
   }
 
@@ -336,7 +336,7 @@ bool _looksLikeToLocationPhrase(String source, int prepositionStart) {
   }
 
   final words = trailingSegment
-      .split(RegExp(r'\s+'))
+      .split(_whitespaceRunPattern)
       .where((word) => word.trim().isNotEmpty)
       .toList();
 
@@ -356,6 +356,469 @@ class ScheduleParseOptions {
   });
 }
 
+final RegExp _asciiLetterPattern = RegExp(r'[A-Za-z]');
+
+final RegExp _addressTailCharsPattern = RegExp(r'^[,A-Za-z0-9.\- ]+$');
+
+final RegExp _whitespaceRunPattern = RegExp(r'\s+');
+
+final RegExp _nextWeekdayPattern = RegExp(
+  r'\bnext\s+(mon|tue|tues|wed|thu|thur|thurs|fri|sat|sun|monday|tuesday|wednesday|thursday|friday|saturday|sunday)\b',
+  caseSensitive: false,
+);
+
+final RegExp _weekendPattern = RegExp(
+  r'\b(?:(this|next)\s+)?weekend\b',
+  caseSensitive: false,
+);
+
+final RegExp _approxPattern = RegExp(
+  r'\b(?:ish|around)\b',
+  caseSensitive: false,
+);
+
+final RegExp _atInToLocationPattern = RegExp(
+  r'\b(?<prep>at|in|to)\s+(?:the\s+)?(?<loc>[^,.;]+?)'
+  r'(?=(?:\s+(?:with|on|for|by|at|in|to)\b|[,.;]|$))',
+  caseSensitive: false,
+);
+
+final RegExp _atSignLocationPattern = RegExp(r"\B@\s*([A-Za-z0-9#&+\-' ]{2,})");
+
+final RegExp _withParticipantsPattern = RegExp(
+  r'\bwith\s+([^,.;]+)',
+  caseSensitive: false,
+);
+
+final RegExp _inviteParticipantsPattern = RegExp(
+  r'\binvite\s+([^,.;]+)',
+  caseSensitive: false,
+);
+
+final RegExp _withShorthandParticipantsPattern = RegExp(
+  r'\bw\/\s*([^,.;]+)',
+  caseSensitive: false,
+);
+
+final RegExp _clockRangePattern = RegExp(
+  r'\b(?:(\d{1,2})(?::(\d{2}))?\s*(?:a\.?m\.?|p\.?m\.?|am|pm)?)\s*[-–—]\s*'
+  r'(?:(\d{1,2})(?::(\d{2}))?\s*(?:a\.?m\.?|p\.?m\.?|am|pm)?)\b',
+  caseSensitive: false,
+);
+
+final RegExp _amPmPattern = RegExp(r'(am|pm)', caseSensitive: false);
+
+final RegExp _clockWithMeridiemPattern = RegExp(
+  r'\b\d{1,2}(:\d{2})?\s*(am|pm)\b',
+  caseSensitive: false,
+);
+
+final RegExp _inNumericRelativePattern = RegExp(
+  r'\bin\s+(\d+(?:\.\d+)?)\s+(minute|minutes|hour|hours|day|days|week|weeks)\b',
+  caseSensitive: false,
+);
+
+final RegExp _inWordRelativePattern = RegExp(
+  r'\bin\s+(?:a|an)?\s*(half|quarter|one|two|three|four|five|six|seven|eight|nine|ten|eleven|twelve|couple|few|several|dozen)\s+'
+  r'(minute|minutes|hour|hours|day|days|week|weeks)\b',
+  caseSensitive: false,
+);
+
+final RegExp _fromNowRelativePattern = RegExp(
+  r'\b(half|quarter|one|two|three|four|five|six|seven|eight|nine|ten|eleven|twelve|couple|few|several|dozen|\d+(?:\.\d+)?)\s+'
+  r'(minute|minutes|hour|hours|day|days|week|weeks)\s+from\s+now\b',
+  caseSensitive: false,
+);
+
+final RegExp _afterRelativePattern = RegExp(
+  r'\bafter\s+(?:a|an)?\s*(half|quarter|one|two|three|four|five|six|seven|eight|nine|ten|eleven|twelve|couple|few|several|dozen|\d+(?:\.\d+)?)\s+'
+  r'(minute|minutes|hour|hours|day|days|week|weeks)\b',
+  caseSensitive: false,
+);
+
+final RegExp _laterRelativePattern = RegExp(
+  r'\b(half|quarter|one|two|three|four|five|six|seven|eight|nine|ten|eleven|twelve|couple|few|several|dozen|\d+(?:\.\d+)?)\s+'
+  r'(minute|minutes|hour|hours|day|days|week|weeks)\s+later\b',
+  caseSensitive: false,
+);
+
+final RegExp _deadlineLeadInPattern = RegExp(
+  r'\b(?:by|before|no\s+later\s+than|not\s+later\s+than|due(?:\s+(?:on|by))?|deadline(?:\s*(?:is|:))?)\s+([^,.;]+)',
+  caseSensitive: false,
+);
+
+final RegExp _recurringCuePattern = RegExp(
+  r'\b(every|each|weekly|monthly|yearly|annually|biweekly|weekdays|weekends|mwf|tth|until|through)\b',
+  caseSensitive: false,
+);
+
+final RegExp _endOfPeriodPattern = RegExp(
+  r'\b(EOD|COB|end of day|EOW|end of week|EOM|end of month|EOY|end of year)\b',
+  caseSensitive: false,
+);
+
+final RegExp _bareNextWeekPattern = RegExp(r'^(?:the\s+)?next\s+(?:week|wk)$');
+
+final RegExp _weekdayWordMatcher = RegExp(
+  '\\b(?:$_weekdayWordPattern)\\b',
+  caseSensitive: false,
+);
+
+final RegExp _ordinalWeekdaySpanPattern = RegExp(
+  '\\b(?:the\\s+)?(?:first|second|third|fourth|last|\\d{1,2}(?:st|nd|rd|th))\\s+($_weekdayWordPattern)\\s+of\\s+(?:the\\s+)?(?:each\\s+|every\\s+)?month\\b',
+  caseSensitive: false,
+);
+
+final RegExp _recurrenceSpanPattern = RegExp(
+  r'\b(?:every|each|everyday|daily|weekly|monthly|yearly|annually|biweekly|weekday|weekdays|weekend|weekends|mwf|tth)\b[^,.;]*',
+  caseSensitive: false,
+);
+
+final RegExp _dailyPattern = RegExp(r'\bdaily\b');
+
+final RegExp _weeklyPattern = RegExp(r'\bweekly\b');
+
+final RegExp _biweeklyPattern = RegExp(r'\bbiweekly\b');
+
+final RegExp _monthlyPattern = RegExp(r'\bmonthly\b');
+
+final RegExp _yearlyPattern = RegExp(r'\byearly\b|\bannually\b');
+
+final RegExp _everyNPattern = RegExp(r'\b(?:every|each)\s+(other|\d+)\b');
+
+final RegExp _everyNUnitsPattern = RegExp(
+  r'\b(?:every|each)\s+(\d+)\s+(day|days|week|weeks|month|months|year|years)\b',
+);
+
+final RegExp _dailyUnitPattern = RegExp(
+  r'\b(?:everyday|(?:every|each)(?:\s+other)?\s+day(?:s)?)\b',
+  caseSensitive: false,
+);
+
+final RegExp _weeklyUnitPattern = RegExp(
+  r'\b(?:every|each)(?:\s+other)?\s+week(?:s)?\b',
+  caseSensitive: false,
+);
+
+final RegExp _monthlyUnitPattern = RegExp(
+  r'\b(?:every|each)(?:\s+other)?\s+month(?:s)?\b',
+  caseSensitive: false,
+);
+
+final RegExp _yearlyUnitPattern = RegExp(
+  r'\b(?:every|each)(?:\s+other)?\s+year(?:s)?\b',
+  caseSensitive: false,
+);
+
+final RegExp _weekdaysPattern = RegExp(
+  r'\bweekday(s)?\b',
+  caseSensitive: false,
+);
+
+final RegExp _weekendsPattern = RegExp(
+  r'\bweekend(s)?\b',
+  caseSensitive: false,
+);
+
+final RegExp _mwfPattern = RegExp(r'\bmwf\b', caseSensitive: false);
+
+final RegExp _tthPattern = RegExp(r'\btth\b', caseSensitive: false);
+
+final RegExp _ordinalWeekdayOfMonthPattern = RegExp(
+  '\\b(first|second|third|fourth|last)\\s+($_weekdayWordPattern)\\s+of\\s+(?:the\\s+)?(?:each\\s+|every\\s+)?month\\b',
+  caseSensitive: false,
+);
+
+final RegExp _numericOrdinalWeekdayOfMonthPattern = RegExp(
+  '\\b(?:the\\s+)?(\\d{1,2})(st|nd|rd|th)\\s+($_weekdayWordPattern)\\s+of\\s+(?:the\\s+)?(?:each\\s+|every\\s+)?month\\b',
+  caseSensitive: false,
+);
+
+final RegExp _monthDayPattern = RegExp(
+  r'\b(on\s+)?the\s+(\d{1,2})(st|nd|rd|th)?\s+(of\s+)?(each|every)?\s*month\b',
+  caseSensitive: false,
+);
+
+final RegExp _untilPattern = RegExp(
+  r'\b(until|till|til|through)\s+([^,.;]+)',
+  caseSensitive: false,
+);
+
+final RegExp _endOfYearPattern = RegExp(
+  r'\bEOY\b|\bend of (the )?year\b',
+  caseSensitive: false,
+);
+
+final RegExp _endOfMonthPattern = RegExp(
+  r'\bEOM\b|\bend of (the )?month\b',
+  caseSensitive: false,
+);
+
+final RegExp _nextYearPattern = RegExp(r'\bnext year\b', caseSensitive: false);
+
+final RegExp _occurrenceCountPattern = RegExp(
+  r'\bfor\s+(\d+)\s+(times|occurrences)\b',
+  caseSensitive: false,
+);
+
+final RegExp _durationLimitPattern = RegExp(
+  r'\bfor\s+(\d+)\s+(day|days|week|weeks|month|months|year|years)\b',
+  caseSensitive: false,
+);
+
+final RegExp _recurrenceKeywordPattern = RegExp(
+  r'\b(every|each|everyday|weekly|monthly|yearly|annually|biweekly|weekday|weekdays|weekend|weekends|mwf|tth)\b',
+  caseSensitive: false,
+);
+
+final RegExp _untilClausePattern = RegExp(
+  r'\b(until|through)\s+[^,.;]+',
+  caseSensitive: false,
+);
+
+final RegExp _occurrenceCountClausePattern = RegExp(
+  r'\bfor\s+\d+\s+(times|occurrences)\b',
+  caseSensitive: false,
+);
+
+final RegExp _recurrenceTimeAnchorPattern = RegExp(
+  '\\b(?:at|@|around)\\s+$_timeSnippetPattern',
+  caseSensitive: false,
+);
+
+final RegExp _ordinalSuffixPattern = RegExp(
+  r'(\d)(st|nd|rd|th)\b',
+  caseSensitive: false,
+);
+
+final RegExp _morningCuePattern = RegExp(r'\b(morning|sunrise|dawn)\b');
+
+final RegExp _eveningCuePattern = RegExp(
+  r'\b(tonight|evening|night|afternoon)\b',
+);
+
+final RegExp _thisTimeTomorrowPattern = RegExp(
+  r'\bthis time tomorrow\b',
+  caseSensitive: false,
+);
+
+final RegExp _dayAfterTomorrowPattern = RegExp(
+  r'\bday after tomorrow\b',
+  caseSensitive: false,
+);
+
+final RegExp _tomorrowPattern = RegExp(r'\btomorrow\b', caseSensitive: false);
+
+final RegExp _nextWeekdayNamePattern = RegExp(
+  r'\bnext\s+(monday|tuesday|wednesday|thursday|friday|saturday|sunday|mon|tue|wed|thu|fri|sat|sun)\b',
+  caseSensitive: false,
+);
+
+final RegExp _todayPattern = RegExp(r'\btoday\b', caseSensitive: false);
+
+final RegExp _tonightPattern = RegExp(r'\btonight\b', caseSensitive: false);
+
+final RegExp _thisPartOfDayPattern = RegExp(
+  r'\bthis\s+(morning|afternoon|evening|night)\b',
+  caseSensitive: false,
+);
+
+final RegExp _atClockWithMeridiemPattern = RegExp(
+  r'\b(?:at|@)\s*(\d{1,2})(?::(\d{2}))?\s*((?:a\.?m\.?|p\.?m\.?|am|pm))\b',
+  caseSensitive: false,
+);
+
+final RegExp _clockWithMeridiemCapturePattern = RegExp(
+  r'\b(\d{1,2})(?::(\d{2}))?\s*((?:a\.?m\.?|p\.?m\.?|am|pm))\b',
+  caseSensitive: false,
+);
+
+final RegExp _twentyFourHourClockPattern = RegExp(r'\b(\d{1,2}):(\d{2})\b');
+
+final RegExp _compactClockPattern = RegExp(
+  r'\b(?:at|@|around|from|by)\s*(\d{3,4})\b',
+  caseSensitive: false,
+);
+
+final RegExp _simpleHourPattern = RegExp(
+  r'\b(?:at|@|around|from|by)\s*(\d{1,2})(?![:\d])\b',
+  caseSensitive: false,
+);
+
+final RegExp _noonPattern = RegExp(r'\bnoon\b', caseSensitive: false);
+
+final RegExp _midnightPattern = RegExp(r'\bmidnight\b', caseSensitive: false);
+
+final RegExp _numericDatePattern = RegExp(r'\b(\d{1,2})[\/\-](\d{1,2})(?!\d)');
+
+final RegExp _numericDateWithYearPattern = RegExp(
+  r'\b(\d{1,2})[\/\-](\d{1,2})[\/\-](\d{2,4})\b',
+);
+
+final RegExp _nameSeparatorPattern = RegExp(
+  r'\s*(?:,|&| and )\s*',
+  caseSensitive: false,
+);
+
+final RegExp _locationLeadInPattern = RegExp(
+  r'^(?:at|in|to)\s+',
+  caseSensitive: false,
+);
+
+final RegExp _ordinalNumberPattern = RegExp(r'^\d{1,3}(?:st|nd|rd|th)?$');
+
+final RegExp _thisPeriodPattern = RegExp(
+  r'\bthis\s+(time|morning|afternoon|evening|night|week|weekend|month|year)\b',
+);
+
+final RegExp _nextPeriodPattern = RegExp(
+  r'\bnext\s+(week|weekend|month|year|mon|tue|tues|wed|thu|thur|thurs|fri|sat|sun'
+  r'|monday|tuesday|wednesday|thursday|friday|saturday|sunday)\b',
+);
+
+final RegExp _meridiemTimePattern = RegExp(
+  r'\b\d{1,2}(:\d{2})?\s*(?:a\.?m\.?|p\.?m\.?|am|pm)\b',
+);
+
+final RegExp _numericSpanPattern = RegExp(
+  r'\b\d+\s+(minute|hour|day|week|month|year)s?\b',
+);
+
+final RegExp _digitPattern = RegExp(r'\d');
+
+final RegExp _handlePattern = RegExp(r'^[a-z0-9_\-]+$', caseSensitive: false);
+
+final RegExp _trailingPunctuationPattern = RegExp(r'[ ,.;]+$');
+
+final RegExp _pmPattern = RegExp(r'p\.?m\.?|\bpm\b', caseSensitive: false);
+
+final RegExp _amPattern = RegExp(r'a\.?m\.?|\bam\b', caseSensitive: false);
+
+final RegExp _meridiemMarkerPattern = RegExp(
+  r'p\.?m\.?|a\.?m\.?|\bpm\b|\bam\b',
+);
+
+final RegExp _clockLeadInPattern = RegExp(r'^(at|around)\s+');
+
+final RegExp _colonClockPattern = RegExp(r'(\d{1,2}):(\d{2})');
+
+final RegExp _hourNotationPattern = RegExp(r'(\d{1,2})\s*h\s*(\d{1,2})?');
+
+final RegExp _tightHourNotationPattern = RegExp(r'(\d{1,2})h(\d{1,2})?');
+
+final RegExp _loneHourPattern = RegExp(r'\b(\d{1,2})\b');
+
+final RegExp _compositeDurationPattern = RegExp(
+  r'\b(?<hours>\d+(?:\.\d+)?)\s*h(?:ours?|rs?)?'
+  r'(?:\s*(?<minutes>\d+(?:\.\d+)?)\s*m(?:in(?:utes?)?)?)?\b',
+  caseSensitive: false,
+);
+
+final RegExp _tightCompositeDurationPattern = RegExp(
+  r'\b(?<hours>\d+)h(?<minutes>\d{1,2})m?\b',
+  caseSensitive: false,
+);
+
+final RegExp _bareDurationPattern = RegExp(
+  r'\b(?<value>half|quarter|an|a|one|two|three|four|five|six|seven|eight|nine|ten|eleven|twelve|\d+(?:\.\d+)?)\s*'
+  r'(?<unit>h|hr|hrs|hour|hours|m|min|mins|minute|minutes|day|days|week|weeks)\b',
+  caseSensitive: false,
+);
+
+final RegExp _trailingInPattern = RegExp(r'\bin\s*$', caseSensitive: false);
+
+final RegExp _trailingSeparatorPattern = RegExp(r'[,.:;!\/\\-]+$');
+
+final RegExp _icsWeekdayPattern = RegExp(
+  r'(MO|TU|WE|TH|FR|SA|SU)',
+  caseSensitive: false,
+);
+
+typedef _Shorthand = ({_ScheduleCue cue, RegExp pattern, String replacement});
+
+final List<_Shorthand> _shorthandReplacements = <_Shorthand>[
+  (
+    cue: _ScheduleCue.tomorrow,
+    pattern: RegExp(
+      r'\btmrw\b|\btmw\b|\btmo\b|\btom\b|\b2moro\b|\b2morrow\b|\btomm?or?ow\b',
+      caseSensitive: false,
+    ),
+    replacement: ' tomorrow ',
+  ),
+  (
+    cue: _ScheduleCue.tonight,
+    pattern: RegExp(r'\btonite\b', caseSensitive: false),
+    replacement: ' tonight ',
+  ),
+  (
+    cue: _ScheduleCue.withShorthand,
+    pattern: RegExp(r'\bw\/\b', caseSensitive: false),
+    replacement: ' with ',
+  ),
+  (
+    cue: _ScheduleCue.noonish,
+    pattern: RegExp(r'\bnoon-ish\b|\bnoonish\b', caseSensitive: false),
+    replacement: ' noon ',
+  ),
+  (
+    cue: _ScheduleCue.midday,
+    pattern: RegExp(r'\bmid-day\b|\bmidday\b', caseSensitive: false),
+    replacement: ' noon ',
+  ),
+  (
+    cue: _ScheduleCue.hours,
+    pattern: RegExp(r'\bhrs?\b', caseSensitive: false),
+    replacement: ' hours ',
+  ),
+  (
+    cue: _ScheduleCue.minutes,
+    pattern: RegExp(r'\bmins?\b', caseSensitive: false),
+    replacement: ' minutes ',
+  ),
+  (
+    cue: _ScheduleCue.after,
+    pattern: RegExp(r'\baftr\b', caseSensitive: false),
+    replacement: ' after ',
+  ),
+  (
+    cue: _ScheduleCue.night,
+    pattern: RegExp(r'\bnite\b', caseSensitive: false),
+    replacement: ' night ',
+  ),
+];
+
+final List<RegExp> _explicitRangePatterns = <RegExp>[
+  RegExp(
+    '\\bfrom\\s+(?<start>$_timeSnippetPattern)\\s+(?:to|till|til|until|through)\\s+(?<end>$_timeSnippetPattern)',
+    caseSensitive: false,
+  ),
+  RegExp(
+    '\\b(?<start>$_timeSnippetPattern)\\s+(?:to|till|til|until|through)\\s+(?<end>$_timeSnippetPattern)',
+    caseSensitive: false,
+  ),
+];
+
+final List<RegExp> _durationPhrasePatterns = <RegExp>[
+  RegExp(
+    r'\b(?:for|lasting|lasts?|runs?|running|going)(?:\s+for)?\s+'
+    r'(?<value>half|quarter|an|a|one|two|three|four|five|six|seven|eight|nine|ten|eleven|twelve|couple|few|several|dozen|\d+(?:\.\d+)?)\s*'
+    r'(?<unit>hours?|hrs?|hr|minutes?|mins?|min|seconds?|secs?|sec|days?|day|weeks?|week)\b',
+    caseSensitive: false,
+  ),
+  RegExp(
+    r'\b(?<value>half|quarter|an|a|one|two|three|four|five|six|seven|eight|nine|ten|eleven|twelve|couple|few|several|dozen|\d+(?:\.\d+)?)\s*'
+    r'(?<unit>hours?|hrs?|hr|minutes?|mins?|min|seconds?|secs?|sec|days?|day|weeks?|week)\s+'
+    r'(?:long|duration|straight)\b',
+    caseSensitive: false,
+  ),
+  RegExp(
+    r'\b(?<value>\d+(?:\.\d+)?)\s*'
+    r'(?<unit>hours?|hrs?|hr|minutes?|mins?|min|seconds?|secs?|sec|days?|day|weeks?|week)\s*'
+    r'(?:session|meeting|event)\b',
+    caseSensitive: false,
+  ),
+];
+
 /// ---------------------------------------------------------------------------
 /// Parser
 /// ---------------------------------------------------------------------------
@@ -372,8 +835,12 @@ class ScheduleParser {
         ? tz.TZDateTime.from(opts.reference!, opts.tzLocation)
         : tz.TZDateTime.now(opts.tzLocation);
 
+    // Stages are skipped when the words their patterns need are absent
+    final vocabulary = _ScheduleVocabulary.of(opts.policy);
+    final _VocabularyScan scanned = vocabulary.scan(original);
+
     // Normalize sloppy input
-    final normal = _normalize(original, base);
+    final normal = _normalize(original, base, scanned);
     final rawRelativeLabel = normal.relativeFallbackLabel;
     final String? relativeLabel = rawRelativeLabel == null
         ? null
@@ -387,14 +854,18 @@ class ScheduleParser {
     final _ConsumedPhraseTracker consumed = _ConsumedPhraseTracker();
 
     // DEADLINE: extract and strip from sentence
-    final _DeadlineParse dl = _extractDeadline(s, base);
+    final _DeadlineParse dl = _extractDeadline(s, base, vocabulary.scan(s));
     s = ' ${dl.cleaned} ';
     tz.TZDateTime? deadline = dl.deadline;
     flags.addAll(dl.flags);
     assumptions.addAll(dl.assumptions);
 
     // RECURRENCE: strip triggers but keep anchor words like "Friday 10"
-    final _RecurrenceParse rec = _parseRecurrence(s, base);
+    final _RecurrenceParse rec = _parseRecurrence(
+      s,
+      base,
+      vocabulary.scan(s),
+    );
     s = ' ${rec.cleaned} ';
     Recurrence? recurrence = rec.recurrence;
     if (recurrence != null) {
@@ -450,11 +921,7 @@ class ScheduleParser {
       }
 
       // Strict "next <weekday>"
-      if (opts.policy.strictNextWeekday &&
-          RegExp(
-            r'\bnext\s+(mon|tue|tues|wed|thu|thur|thurs|fri|sat|sun|monday|tuesday|wednesday|thursday|friday|saturday|sunday)\b',
-            caseSensitive: false,
-          ).hasMatch(s)) {
+      if (opts.policy.strictNextWeekday && _nextWeekdayPattern.hasMatch(s)) {
         final baseDay = tz.TZDateTime(
           opts.tzLocation,
           base.year,
@@ -562,11 +1029,7 @@ class ScheduleParser {
     }
 
     // Weekend shorthand
-    final weekendPattern = RegExp(
-      r'\b(?:(this|next)\s+)?weekend\b',
-      caseSensitive: false,
-    );
-    final weekendMatch = weekendPattern.firstMatch(s);
+    final weekendMatch = _weekendPattern.firstMatch(s);
     if (weekendMatch != null) {
       flags.add(AmbiguityFlag.relativeDate);
       final addAWeek = (weekendMatch.group(1)?.toLowerCase() == 'next');
@@ -589,13 +1052,12 @@ class ScheduleParser {
 
     // Approximate "ish"/"around"
     bool approximate = false;
-    final approxPattern = RegExp(r'\b(?:ish|around)\b', caseSensitive: false);
     Match? approxMatchInWorking;
     Match? approxMatchInOriginal;
     if (start != null) {
-      approxMatchInWorking = approxPattern.firstMatch(s);
+      approxMatchInWorking = _approxPattern.firstMatch(s);
       approxMatchInOriginal =
-          approxMatchInWorking ?? approxPattern.firstMatch(original);
+          approxMatchInWorking ?? _approxPattern.firstMatch(original);
     }
     if (start != null && approxMatchInOriginal != null) {
       approximate = true;
@@ -614,12 +1076,7 @@ class ScheduleParser {
 
     // Location: at/in/to …, @ …, or trailing hint
     String? location;
-    final atInToRegex = RegExp(
-      r'\b(?<prep>at|in|to)\s+(?:the\s+)?(?<loc>[^,.;]+?)'
-      r'(?=(?:\s+(?:with|on|for|by|at|in|to)\b|[,.;]|$))',
-      caseSensitive: false,
-    );
-    final atInToMatches = atInToRegex.allMatches(s).toList();
+    final atInToMatches = _atInToLocationPattern.allMatches(s).toList();
     for (final match in atInToMatches) {
       final preposition = match.namedGroup('prep')?.toLowerCase();
       final locGroup = match.namedGroup('loc');
@@ -648,7 +1105,7 @@ class ScheduleParser {
       break;
     }
     if (location == null && opts.policy.allowAtSignLocation) {
-      final atSig = RegExp(r"\B@\s*([A-Za-z0-9#&+\-' ]{2,})").firstMatch(s);
+      final atSig = _atSignLocationPattern.firstMatch(s);
       if (atSig != null) {
         final candidate = _pruneTemporalSuffix(
           _normalizeLocation(_clean(atSig.group(1)!)),
@@ -670,9 +1127,9 @@ class ScheduleParser {
     final participants = <String>[];
     final participantSeen = <String>{};
     for (final pat in [
-      RegExp(r'\bwith\s+([^,.;]+)', caseSensitive: false),
-      RegExp(r'\binvite\s+([^,.;]+)', caseSensitive: false),
-      RegExp(r'\bw\/\s*([^,.;]+)', caseSensitive: false),
+      _withParticipantsPattern,
+      _inviteParticipantsPattern,
+      _withShorthandParticipantsPattern,
     ]) {
       for (final match in pat.allMatches(s)) {
         final names = _splitNames(_clean(match.group(1)!));
@@ -721,21 +1178,14 @@ class ScheduleParser {
     }
 
     if (start != null && end == null) {
-      final range = RegExp(
-        r'\b(?:(\d{1,2})(?::(\d{2}))?\s*(?:a\.?m\.?|p\.?m\.?|am|pm)?)\s*[-–—]\s*'
-        r'(?:(\d{1,2})(?::(\d{2}))?\s*(?:a\.?m\.?|p\.?m\.?|am|pm)?)\b',
-        caseSensitive: false,
-      ).firstMatch(original);
+      final range = _clockRangePattern.firstMatch(original);
       if (range != null) {
         final sH = int.parse(range.group(1)!);
         final sM = range.group(2) == null ? 0 : int.parse(range.group(2)!);
         final eH = int.parse(range.group(3)!);
         final eM = range.group(4) == null ? 0 : int.parse(range.group(4)!);
         var sh = sH, eh = eH;
-        final hasAmPm = RegExp(
-          r'(am|pm)',
-          caseSensitive: false,
-        ).hasMatch(range.group(0)!);
+        final hasAmPm = _amPmPattern.hasMatch(range.group(0)!);
         if (!hasAmPm) {
           if (sh <= 12 && eh <= 12) {
             if (start.hour >= 12) {
@@ -795,10 +1245,10 @@ class ScheduleParser {
 
     // Priority (Eisenhower)
     final _PriorityResult pr = _parsePriority(
-      original: original,
       base: base,
       start: start,
       policy: opts.policy,
+      scanned: scanned,
     );
 
     // Title cleanup
@@ -812,7 +1262,7 @@ class ScheduleParser {
       location: location,
       consumedPhrases: consumed.phrases,
     );
-    title = title.replaceAll(RegExp(r'\s+'), ' ').trim();
+    title = title.replaceAll(_whitespaceRunPattern, ' ').trim();
     if (title.isEmpty) {
       title = _stripAppliedMetadata(
         original,
@@ -845,10 +1295,7 @@ class ScheduleParser {
       assumptions.add('Encountered ambiguous numeric date (DMY vs MDY).');
     }
     if (deadline != null &&
-        !RegExp(
-          r'\b\d{1,2}(:\d{2})?\s*(am|pm)\b',
-          caseSensitive: false,
-        ).hasMatch(original)) {
+        !_clockWithMeridiemPattern.hasMatch(original)) {
       confidence -= 0.05; // we assumed EOD for a date-only deadline
     }
     if (confidence < 0.2) confidence = 0.2;
@@ -874,38 +1321,26 @@ class ScheduleParser {
     );
   }
 
-  _Normalized _normalize(String text, tz.TZDateTime base) {
+  _Normalized _normalize(
+    String text,
+    tz.TZDateTime base,
+    _VocabularyScan scanned,
+  ) {
     String s = ' $text ';
     final flags = <AmbiguityFlag>{};
     final assumptions = <String>[];
     bool corrected = false;
 
-    final replacements = <RegExp, String>{
-      RegExp(
-        r'\btmrw\b|\btmw\b|\btmo\b|\btom\b|\b2moro\b|\b2morrow\b|\btomm?or?ow\b',
-        caseSensitive: false,
-      ): ' tomorrow ',
-      RegExp(r'\btonite\b', caseSensitive: false): ' tonight ',
-      RegExp(r'\bw\/\b', caseSensitive: false): ' with ',
-      RegExp(r'\bnoon-ish\b|\bnoonish\b', caseSensitive: false): ' noon ',
-      RegExp(r'\bmid-day\b|\bmidday\b', caseSensitive: false): ' noon ',
-      RegExp(r'\bhrs?\b', caseSensitive: false): ' hours ',
-      RegExp(r'\bmins?\b', caseSensitive: false): ' minutes ',
-      RegExp(r'\baftr\b', caseSensitive: false): ' after ',
-      RegExp(r'\bnite\b', caseSensitive: false): ' night ',
-    };
-    replacements.forEach((re, rep) {
+    for (final shorthand in _shorthandReplacements) {
+      if (!scanned.has(shorthand.cue)) continue;
       final before = s;
-      s = s.replaceAll(re, rep);
+      s = s.replaceAll(shorthand.pattern, shorthand.replacement);
       if (s != before) corrected = true;
-    });
+    }
 
     tz.TZDateTime? relative;
     String? relativeLabel;
-    final rel = RegExp(
-      r'\bin\s+(\d+(?:\.\d+)?)\s+(minute|minutes|hour|hours|day|days|week|weeks)\b',
-      caseSensitive: false,
-    ).firstMatch(s);
+    final rel = _inNumericRelativePattern.firstMatch(s);
     if (rel != null) {
       final double amount = double.parse(rel.group(1)!);
       final unit = rel.group(2)!.toLowerCase();
@@ -915,11 +1350,7 @@ class ScheduleParser {
         relativeLabel = rel.group(0)!;
       }
     } else {
-      final relWord = RegExp(
-        r'\bin\s+(?:a|an)?\s*(half|quarter|one|two|three|four|five|six|seven|eight|nine|ten|eleven|twelve|couple|few|several|dozen)\s+'
-        r'(minute|minutes|hour|hours|day|days|week|weeks)\b',
-        caseSensitive: false,
-      ).firstMatch(s);
+      final relWord = _inWordRelativePattern.firstMatch(s);
       if (relWord != null) {
         final double? amount = _parseDurationValue(relWord.group(1)!);
         final String unit = relWord.group(2)!.toLowerCase();
@@ -934,11 +1365,7 @@ class ScheduleParser {
     }
 
     if (relative == null) {
-      final fromNow = RegExp(
-        r'\b(half|quarter|one|two|three|four|five|six|seven|eight|nine|ten|eleven|twelve|couple|few|several|dozen|\d+(?:\.\d+)?)\s+'
-        r'(minute|minutes|hour|hours|day|days|week|weeks)\s+from\s+now\b',
-        caseSensitive: false,
-      ).firstMatch(s);
+      final fromNow = _fromNowRelativePattern.firstMatch(s);
       if (fromNow != null) {
         final double? amount = _parseDurationValue(fromNow.group(1)!);
         final String unit = fromNow.group(2)!.toLowerCase();
@@ -953,11 +1380,7 @@ class ScheduleParser {
     }
 
     if (relative == null) {
-      final afterMatch = RegExp(
-        r'\bafter\s+(?:a|an)?\s*(half|quarter|one|two|three|four|five|six|seven|eight|nine|ten|eleven|twelve|couple|few|several|dozen|\d+(?:\.\d+)?)\s+'
-        r'(minute|minutes|hour|hours|day|days|week|weeks)\b',
-        caseSensitive: false,
-      ).firstMatch(s);
+      final afterMatch = _afterRelativePattern.firstMatch(s);
       if (afterMatch != null) {
         final double? amount = _parseDurationValue(afterMatch.group(1)!);
         final String unit = afterMatch.group(2)!.toLowerCase();
@@ -972,11 +1395,7 @@ class ScheduleParser {
     }
 
     if (relative == null) {
-      final laterMatch = RegExp(
-        r'\b(half|quarter|one|two|three|four|five|six|seven|eight|nine|ten|eleven|twelve|couple|few|several|dozen|\d+(?:\.\d+)?)\s+'
-        r'(minute|minutes|hour|hours|day|days|week|weeks)\s+later\b',
-        caseSensitive: false,
-      ).firstMatch(s);
+      final laterMatch = _laterRelativePattern.firstMatch(s);
       if (laterMatch != null) {
         final double? amount = _parseDurationValue(laterMatch.group(1)!);
         final String unit = laterMatch.group(2)!.toLowerCase();
@@ -990,7 +1409,7 @@ class ScheduleParser {
       }
     }
 
-    s = s.replaceAll(RegExp(r'\s+'), ' ').trim();
+    s = s.replaceAll(_whitespaceRunPattern, ' ').trim();
 
     if (corrected) flags.add(AmbiguityFlag.typosCorrected);
 
@@ -1004,7 +1423,15 @@ class ScheduleParser {
     );
   }
 
-  _DeadlineParse _extractDeadline(String s, tz.TZDateTime base) {
+  _DeadlineParse _extractDeadline(
+    String s,
+    tz.TZDateTime base,
+    _VocabularyScan scanned,
+  ) {
+    if (!scanned.has(_ScheduleCue.deadlineLeadIn) &&
+        !scanned.has(_ScheduleCue.endOfPeriod)) {
+      return _DeadlineParse(s, null, <AmbiguityFlag>{}, <String>[]);
+    }
     String text = s;
     tz.TZDateTime? deadline;
     final flags = <AmbiguityFlag>{};
@@ -1019,17 +1446,14 @@ class ScheduleParser {
     );
 
     // Explicit phrases: by/before/no later than/due
-    final m = RegExp(
-      r'\b(?:by|before|no\s+later\s+than|not\s+later\s+than|due(?:\s+(?:on|by))?|deadline(?:\s*(?:is|:))?)\s+([^,.;]+)',
-      caseSensitive: false,
-    ).firstMatch(text);
+    final m = _deadlineLeadInPattern.firstMatch(text);
 
     if (m != null) {
       final st = m.start, en = m.end;
       final target = m.group(1)!.trim();
       final normalizedTarget = target
           .toLowerCase()
-          .replaceAll(RegExp(r'\s+'), ' ')
+          .replaceAll(_whitespaceRunPattern, ' ')
           .trim();
       bool interpretedDeadline = false;
 
@@ -1067,19 +1491,13 @@ class ScheduleParser {
       }
 
       text = ('${text.substring(0, st)} ${text.substring(en)}')
-          .replaceAll(RegExp(r'\s+'), ' ')
+          .replaceAll(_whitespaceRunPattern, ' ')
           .trim();
     } else {
       // EOD/EOW/EOM/EOY tokens as deadlines when not part of recurrence
-      final looksRecurring = RegExp(
-        r'\b(every|each|weekly|monthly|yearly|annually|biweekly|weekdays|weekends|mwf|tth|until|through)\b',
-        caseSensitive: false,
-      ).hasMatch(text);
+      final looksRecurring = _recurringCuePattern.hasMatch(text);
 
-      final eox = RegExp(
-        r'\b(EOD|COB|end of day|EOW|end of week|EOM|end of month|EOY|end of year)\b',
-        caseSensitive: false,
-      ).firstMatch(text);
+      final eox = _endOfPeriodPattern.firstMatch(text);
 
       if (eox != null && !looksRecurring) {
         tz.TZDateTime d;
@@ -1149,7 +1567,7 @@ class ScheduleParser {
         flags.add(AmbiguityFlag.eoxShortcut);
         final st = eox.start, en = eox.end;
         text = ('${text.substring(0, st)} ${text.substring(en)}')
-            .replaceAll(RegExp(r'\s+'), ' ')
+            .replaceAll(_whitespaceRunPattern, ' ')
             .trim();
       }
     }
@@ -1159,7 +1577,7 @@ class ScheduleParser {
 
   bool _isBareNextWeekPhrase(String target) {
     if (target.isEmpty) return false;
-    return RegExp(r'^(?:the\s+)?next\s+(?:week|wk)$').hasMatch(target);
+    return _bareNextWeekPattern.hasMatch(target);
   }
 
   tz.TZDateTime _nextWeekMondayDeadline(tz.TZDateTime base) {
@@ -1185,12 +1603,15 @@ class ScheduleParser {
     );
   }
 
-  _RecurrenceParse _parseRecurrence(String s, tz.TZDateTime base) {
-    final weekdayMatcher = RegExp(
-      '\\b(?:$_weekdayWordPattern)\\b',
-      caseSensitive: false,
-    );
-
+  _RecurrenceParse _parseRecurrence(
+    String s,
+    tz.TZDateTime base,
+    _VocabularyScan scanned,
+  ) {
+    if (!scanned.has(_ScheduleCue.recurrence) &&
+        (scanned.cues[_ScheduleCue.weekday] ?? 0) < 2) {
+      return _RecurrenceParse(s, null);
+    }
     int extendToBoundary(int index) {
       var cursor = index;
       while (cursor < s.length) {
@@ -1205,20 +1626,14 @@ class ScheduleParser {
 
     int? spanStart;
     int? spanEnd;
-    final ordinalSpan = RegExp(
-      '\\b(?:the\\s+)?(?:first|second|third|fourth|last|\\d{1,2}(?:st|nd|rd|th))\\s+($_weekdayWordPattern)\\s+of\\s+(?:the\\s+)?(?:each\\s+|every\\s+)?month\\b',
-      caseSensitive: false,
-    ).firstMatch(s);
+    final ordinalSpan = _ordinalWeekdaySpanPattern.firstMatch(s);
     if (ordinalSpan != null) {
       spanStart = ordinalSpan.start;
       spanEnd = extendToBoundary(ordinalSpan.end);
     }
 
     if (spanStart == null) {
-      final spanMatch = RegExp(
-        r'\b(?:every|each|everyday|daily|weekly|monthly|yearly|annually|biweekly|weekday|weekdays|weekend|weekends|mwf|tth)\b[^,.;]*',
-        caseSensitive: false,
-      ).firstMatch(s);
+      final spanMatch = _recurrenceSpanPattern.firstMatch(s);
       if (spanMatch != null) {
         spanStart = spanMatch.start;
         spanEnd = spanMatch.end;
@@ -1226,7 +1641,7 @@ class ScheduleParser {
     }
 
     if (spanStart == null) {
-      final looseMatches = weekdayMatcher.allMatches(s).toList();
+      final looseMatches = _weekdayWordMatcher.allMatches(s).toList();
       if (looseMatches.length >= 2) {
         spanStart = looseMatches.first.start;
         spanEnd = extendToBoundary(looseMatches.last.end);
@@ -1261,22 +1676,20 @@ class ScheduleParser {
       if (freq.isEmpty) freq = 'WEEKLY';
     }
 
-    if (RegExp(r'\bdaily\b').hasMatch(phrase)) freq = 'DAILY';
-    if (RegExp(r'\bweekly\b').hasMatch(phrase)) freq = 'WEEKLY';
-    if (RegExp(r'\bbiweekly\b').hasMatch(phrase)) {
+    if (_dailyPattern.hasMatch(phrase)) freq = 'DAILY';
+    if (_weeklyPattern.hasMatch(phrase)) freq = 'WEEKLY';
+    if (_biweeklyPattern.hasMatch(phrase)) {
       freq = 'WEEKLY';
       interval = 2;
     }
-    if (RegExp(r'\bmonthly\b').hasMatch(phrase)) {
+    if (_monthlyPattern.hasMatch(phrase)) {
       freq = 'MONTHLY';
     }
-    if (RegExp(r'\byearly\b|\bannually\b').hasMatch(phrase)) {
+    if (_yearlyPattern.hasMatch(phrase)) {
       freq = 'YEARLY';
     }
 
-    final mEveryN = RegExp(
-      r'\b(?:every|each)\s+(other|\d+)\b',
-    ).firstMatch(phrase);
+    final mEveryN = _everyNPattern.firstMatch(phrase);
     if (mEveryN != null) {
       if (mEveryN.group(1)!.toLowerCase() == 'other') {
         interval = 2;
@@ -1284,9 +1697,7 @@ class ScheduleParser {
         interval = int.tryParse(mEveryN.group(1)!) ?? 1;
       }
     }
-    final mEveryNUnits = RegExp(
-      r'\b(?:every|each)\s+(\d+)\s+(day|days|week|weeks|month|months|year|years)\b',
-    ).firstMatch(phrase);
+    final mEveryNUnits = _everyNUnitsPattern.firstMatch(phrase);
     if (mEveryNUnits != null) {
       final n = int.parse(mEveryNUnits.group(1)!);
       final unit = mEveryNUnits.group(2)!.toLowerCase();
@@ -1302,22 +1713,10 @@ class ScheduleParser {
       }
     }
 
-    final bool mentionsDailyUnit = RegExp(
-      r'\b(?:everyday|(?:every|each)(?:\s+other)?\s+day(?:s)?)\b',
-      caseSensitive: false,
-    ).hasMatch(phrase);
-    final bool mentionsWeeklyUnit = RegExp(
-      r'\b(?:every|each)(?:\s+other)?\s+week(?:s)?\b',
-      caseSensitive: false,
-    ).hasMatch(phrase);
-    final bool mentionsMonthlyUnit = RegExp(
-      r'\b(?:every|each)(?:\s+other)?\s+month(?:s)?\b',
-      caseSensitive: false,
-    ).hasMatch(phrase);
-    final bool mentionsYearlyUnit = RegExp(
-      r'\b(?:every|each)(?:\s+other)?\s+year(?:s)?\b',
-      caseSensitive: false,
-    ).hasMatch(phrase);
+    final bool mentionsDailyUnit = _dailyUnitPattern.hasMatch(phrase);
+    final bool mentionsWeeklyUnit = _weeklyUnitPattern.hasMatch(phrase);
+    final bool mentionsMonthlyUnit = _monthlyUnitPattern.hasMatch(phrase);
+    final bool mentionsYearlyUnit = _yearlyUnitPattern.hasMatch(phrase);
 
     if (freq.isEmpty && mentionsDailyUnit) {
       freq = 'DAILY';
@@ -1329,24 +1728,24 @@ class ScheduleParser {
       freq = 'YEARLY';
     }
 
-    if (RegExp(r'\bweekday(s)?\b', caseSensitive: false).hasMatch(phrase)) {
+    if (_weekdaysPattern.hasMatch(phrase)) {
       ensureWeekly();
       byday = ['MO', 'TU', 'WE', 'TH', 'FR'];
     }
-    if (RegExp(r'\bweekend(s)?\b', caseSensitive: false).hasMatch(phrase)) {
+    if (_weekendsPattern.hasMatch(phrase)) {
       ensureWeekly();
       byday = ['SA', 'SU'];
     }
-    if (RegExp(r'\bmwf\b', caseSensitive: false).hasMatch(phrase)) {
+    if (_mwfPattern.hasMatch(phrase)) {
       ensureWeekly();
       byday = ['MO', 'WE', 'FR'];
     }
-    if (RegExp(r'\btth\b', caseSensitive: false).hasMatch(phrase)) {
+    if (_tthPattern.hasMatch(phrase)) {
       ensureWeekly();
       byday = ['TU', 'TH'];
     }
 
-    final dayMatches = weekdayMatcher.allMatches(phrase).toList();
+    final dayMatches = _weekdayWordMatcher.allMatches(phrase).toList();
     if (dayMatches.isNotEmpty) {
       ensureWeekly();
       final seen = <String>{};
@@ -1356,10 +1755,7 @@ class ScheduleParser {
       }
     }
 
-    final mOrd = RegExp(
-      '\\b(first|second|third|fourth|last)\\s+($_weekdayWordPattern)\\s+of\\s+(?:the\\s+)?(?:each\\s+|every\\s+)?month\\b',
-      caseSensitive: false,
-    ).firstMatch(phrase);
+    final mOrd = _ordinalWeekdayOfMonthPattern.firstMatch(phrase);
     if (mOrd != null) {
       freq = 'MONTHLY';
       final ord = mOrd.group(1)!.toLowerCase();
@@ -1374,10 +1770,7 @@ class ScheduleParser {
       };
     }
 
-    final mNumericOrd = RegExp(
-      '\\b(?:the\\s+)?(\\d{1,2})(st|nd|rd|th)\\s+($_weekdayWordPattern)\\s+of\\s+(?:the\\s+)?(?:each\\s+|every\\s+)?month\\b',
-      caseSensitive: false,
-    ).firstMatch(phrase);
+    final mNumericOrd = _numericOrdinalWeekdayOfMonthPattern.firstMatch(phrase);
     if (mNumericOrd != null) {
       freq = 'MONTHLY';
       final ordValue = int.tryParse(mNumericOrd.group(1)!);
@@ -1389,26 +1782,17 @@ class ScheduleParser {
       }
     }
 
-    final mMonthDay = RegExp(
-      r'\b(on\s+)?the\s+(\d{1,2})(st|nd|rd|th)?\s+(of\s+)?(each|every)?\s*month\b',
-      caseSensitive: false,
-    ).firstMatch(phrase);
+    final mMonthDay = _monthDayPattern.firstMatch(phrase);
     if (mMonthDay != null) {
       freq = 'MONTHLY';
       bymonthday = int.parse(mMonthDay.group(2)!);
     }
 
     tz.TZDateTime? untilLocal;
-    final mUntil = RegExp(
-      r'\b(until|till|til|through)\s+([^,.;]+)',
-      caseSensitive: false,
-    ).firstMatch(phrase);
+    final mUntil = _untilPattern.firstMatch(phrase);
     if (mUntil != null) {
       final untilText = mUntil.group(2)!.trim();
-      if (RegExp(
-        r'\bEOY\b|\bend of (the )?year\b',
-        caseSensitive: false,
-      ).hasMatch(untilText)) {
+      if (_endOfYearPattern.hasMatch(untilText)) {
         untilLocal = tz.TZDateTime(
           opts.tzLocation,
           base.year,
@@ -1418,10 +1802,7 @@ class ScheduleParser {
           59,
           59,
         );
-      } else if (RegExp(
-        r'\bEOM\b|\bend of (the )?month\b',
-        caseSensitive: false,
-      ).hasMatch(untilText)) {
+      } else if (_endOfMonthPattern.hasMatch(untilText)) {
         final firstNext = (base.month == 12)
             ? tz.TZDateTime(opts.tzLocation, base.year + 1, 1, 1)
             : tz.TZDateTime(opts.tzLocation, base.year, base.month + 1, 1);
@@ -1450,10 +1831,7 @@ class ScheduleParser {
               59,
               59,
             );
-            if (RegExp(
-                  r'\bnext year\b',
-                  caseSensitive: false,
-                ).hasMatch(untilText) &&
+            if (_nextYearPattern.hasMatch(untilText) &&
                 dt.month == 1 &&
                 dt.day == 1) {
               dt = tz.TZDateTime(
@@ -1474,18 +1852,12 @@ class ScheduleParser {
       }
     }
 
-    final mCount = RegExp(
-      r'\bfor\s+(\d+)\s+(times|occurrences)\b',
-      caseSensitive: false,
-    ).firstMatch(phrase);
+    final mCount = _occurrenceCountPattern.firstMatch(phrase);
     if (mCount != null) {
       count = int.parse(mCount.group(1)!);
     }
 
-    final mDurationLimit = RegExp(
-      r'\bfor\s+(\d+)\s+(day|days|week|weeks|month|months|year|years)\b',
-      caseSensitive: false,
-    ).firstMatch(phrase);
+    final mDurationLimit = _durationLimitPattern.firstMatch(phrase);
     int? limitCount;
     if (mDurationLimit != null) {
       limitCount = int.tryParse(mDurationLimit.group(1)!);
@@ -1523,31 +1895,13 @@ class ScheduleParser {
     final anchorTextBase =
         (byday.isNotEmpty || bymonthday != null || bysetpos != null)
         ? phrase
-              .replaceAll(
-                RegExp(
-                  r'\b(every|each|everyday|weekly|monthly|yearly|annually|biweekly|weekday|weekdays|weekend|weekends|mwf|tth)\b',
-                  caseSensitive: false,
-                ),
-                '',
-              )
-              .replaceAll(
-                RegExp(r'\b(until|through)\s+[^,.;]+', caseSensitive: false),
-                '',
-              )
-              .replaceAll(
-                RegExp(
-                  r'\bfor\s+\d+\s+(times|occurrences)\b',
-                  caseSensitive: false,
-                ),
-                '',
-              )
+              .replaceAll(_recurrenceKeywordPattern, '')
+              .replaceAll(_untilClausePattern, '')
+              .replaceAll(_occurrenceCountClausePattern, '')
               .trim()
         : '';
     String anchorText = anchorTextBase;
-    final timeAnchorMatch = RegExp(
-      '\\b(?:at|@|around)\\s+$_timeSnippetPattern',
-      caseSensitive: false,
-    ).firstMatch(phrase);
+    final timeAnchorMatch = _recurrenceTimeAnchorPattern.firstMatch(phrase);
     if (timeAnchorMatch != null) {
       final snippet = phrase
           .substring(timeAnchorMatch.start, timeAnchorMatch.end)
@@ -1563,7 +1917,7 @@ class ScheduleParser {
     final cleaned =
         ('${s.substring(0, spanStart)} '
                 '${anchorText.isEmpty ? '' : anchorText} ${s.substring(spanEnd)}')
-            .replaceAll(RegExp(r'\s+'), ' ')
+            .replaceAll(_whitespaceRunPattern, ' ')
             .trim();
 
     return _RecurrenceParse(
@@ -1581,10 +1935,7 @@ class ScheduleParser {
   tz.TZDateTime? _parseLooseDateFallback(String text, tz.TZDateTime base) {
     var working = text.trim();
     if (working.isEmpty) return null;
-    working = working.replaceAll(
-      RegExp(r'(\d)(st|nd|rd|th)\b', caseSensitive: false),
-      r'$1',
-    );
+    working = working.replaceAll(_ordinalSuffixPattern, r'$1');
     final patterns = [
       DateFormat('MMMM d'),
       DateFormat('MMM d'),
@@ -1722,17 +2073,10 @@ class ScheduleParser {
     var anchorExplicit = false;
     var useReferenceTime = false;
     final lowerOriginal = original.toLowerCase();
-    final bool hasMorningCue = RegExp(
-      r'\b(morning|sunrise|dawn)\b',
-    ).hasMatch(lowerOriginal);
-    final bool hasEveningCue = RegExp(
-      r'\b(tonight|evening|night|afternoon)\b',
-    ).hasMatch(lowerOriginal);
-
-    Match? match = RegExp(
-      r'\bthis time tomorrow\b',
-      caseSensitive: false,
-    ).firstMatch(text);
+    final bool hasMorningCue = _morningCuePattern.hasMatch(lowerOriginal);
+    final bool hasEveningCue = _eveningCuePattern.hasMatch(lowerOriginal);
+
+    Match? match = _thisTimeTomorrowPattern.firstMatch(text);
     if (match != null) {
       anchor = anchor.add(const Duration(days: 1));
       anchorExplicit = true;
@@ -1743,10 +2087,7 @@ class ScheduleParser {
         'Mapped "${match.group(0)}" to ${_fmtDate(anchor)} at ${_hhmm(base.hour)}.',
       );
     } else {
-      match = RegExp(
-        r'\bday after tomorrow\b',
-        caseSensitive: false,
-      ).firstMatch(text);
+      match = _dayAfterTomorrowPattern.firstMatch(text);
       if (match != null) {
         anchor = anchor.add(const Duration(days: 2));
         anchorExplicit = true;
@@ -1756,7 +2097,7 @@ class ScheduleParser {
           'Interpreted "${match.group(0)}" as ${_fmtDate(anchor)}.',
         );
       } else {
-        match = RegExp(r'\btomorrow\b', caseSensitive: false).firstMatch(text);
+        match = _tomorrowPattern.firstMatch(text);
         if (match != null) {
           anchor = anchor.add(const Duration(days: 1));
           anchorExplicit = true;
@@ -1769,10 +2110,7 @@ class ScheduleParser {
       }
     }
 
-    match = RegExp(
-      r'\bnext\s+(monday|tuesday|wednesday|thursday|friday|saturday|sunday|mon|tue|wed|thu|fri|sat|sun)\b',
-      caseSensitive: false,
-    ).firstMatch(text);
+    match = _nextWeekdayNamePattern.firstMatch(text);
     if (match != null) {
       final weekday = _weekdayFromToken(match.group(1)!);
       if (weekday != null) {
@@ -1794,27 +2132,16 @@ class ScheduleParser {
       }
     }
 
-    consumeAnchor(RegExp(r'\btoday\b', caseSensitive: false));
-    consumeAnchor(RegExp(r'\btonight\b', caseSensitive: false));
-    consumeAnchor(
-      RegExp(
-        r'\bthis\s+(morning|afternoon|evening|night)\b',
-        caseSensitive: false,
-      ),
-    );
+    consumeAnchor(_todayPattern);
+    consumeAnchor(_tonightPattern);
+    consumeAnchor(_thisPartOfDayPattern);
 
-    Match? timeMatch = RegExp(
-      r'\b(?:at|@)\s*(\d{1,2})(?::(\d{2}))?\s*((?:a\.?m\.?|p\.?m\.?|am|pm))\b',
-      caseSensitive: false,
-    ).firstMatch(text);
+    Match? timeMatch = _atClockWithMeridiemPattern.firstMatch(text);
 
     var explicit24h = false;
-    timeMatch ??= RegExp(
-      r'\b(\d{1,2})(?::(\d{2}))?\s*((?:a\.?m\.?|p\.?m\.?|am|pm))\b',
-      caseSensitive: false,
-    ).firstMatch(text);
+    timeMatch ??= _clockWithMeridiemCapturePattern.firstMatch(text);
     if (timeMatch == null) {
-      timeMatch = RegExp(r'\b(\d{1,2}):(\d{2})\b').firstMatch(text);
+      timeMatch = _twentyFourHourClockPattern.firstMatch(text);
       explicit24h = timeMatch != null;
     }
     int? hour;
@@ -1822,10 +2149,7 @@ class ScheduleParser {
     bool ambiguousNoMeridiem = false;
     Match? compactMatch;
     if (timeMatch == null) {
-      compactMatch = RegExp(
-        r'\b(?:at|@|around|from|by)\s*(\d{3,4})\b',
-        caseSensitive: false,
-      ).firstMatch(text);
+      compactMatch = _compactClockPattern.firstMatch(text);
       if (compactMatch != null) {
         final digits = compactMatch.group(1)!;
         final int value = int.parse(digits);
@@ -1845,10 +2169,7 @@ class ScheduleParser {
     }
     Match? simpleHourMatch;
     if (timeMatch == null && hour == null) {
-      simpleHourMatch = RegExp(
-        r'\b(?:at|@|around|from|by)\s*(\d{1,2})(?![:\d])\b',
-        caseSensitive: false,
-      ).firstMatch(text);
+      simpleHourMatch = _simpleHourPattern.firstMatch(text);
       if (simpleHourMatch != null) {
         final value = int.parse(simpleHourMatch.group(1)!);
         if (value <= 23) {
@@ -1883,20 +2204,15 @@ class ScheduleParser {
       assumptions.add('Interpreted "${timeMatch.group(0)}" as ${_hhmm(hour)}.');
     }
 
-    if (hour == null &&
-        RegExp(r'\bnoon\b', caseSensitive: false).hasMatch(text)) {
+    if (hour == null && _noonPattern.hasMatch(text)) {
       hour = 12;
       minute = 0;
-      text = text.replaceFirst(RegExp(r'\bnoon\b', caseSensitive: false), ' ');
+      text = text.replaceFirst(_noonPattern, ' ');
       assumptions.add('Mapped "noon" to 12:00.');
-    } else if (hour == null &&
-        RegExp(r'\bmidnight\b', caseSensitive: false).hasMatch(text)) {
+    } else if (hour == null && _midnightPattern.hasMatch(text)) {
       hour = 0;
       minute = 0;
-      text = text.replaceFirst(
-        RegExp(r'\bmidnight\b', caseSensitive: false),
-        ' ',
-      );
+      text = text.replaceFirst(_midnightPattern, ' ');
       assumptions.add('Mapped "midnight" to 00:00.');
     } else if (hour == null && useReferenceTime) {
       hour = base.hour;
@@ -1969,22 +2285,21 @@ class ScheduleParser {
   String _fmtDate(tz.TZDateTime dt) => DateFormat('y-MM-dd').format(dt);
 
   _PriorityResult _parsePriority({
-    required String original,
     required tz.TZDateTime base,
     required tz.TZDateTime? start,
     required FuzzyPolicy policy,
+    required _VocabularyScan scanned,
   }) {
     bool important = false, urgent = false;
     final notes = <String>[];
     final tokensUsed = <String>{};
+    final Map<String, String> found = scanned.priorityMatches;
 
     String? matchToken(List<String> words) {
       for (final word in words) {
-        final regex = _priorityTokenRegex(word);
-        if (regex == null) continue;
-        final match = regex.firstMatch(original);
+        final match = found[_ScheduleVocabulary.keyFor(word)];
         if (match != null) {
-          return match.group(2);
+          return match;
         }
       }
       return null;
@@ -2055,11 +2370,9 @@ class ScheduleParser {
   }
 
   bool _looksLikeNumericAmbiguity(String s, bool preferDMY) {
-    final m = RegExp(r'\b(\d{1,2})[\/\-](\d{1,2})(?!\d)').firstMatch(s);
+    final m = _numericDatePattern.firstMatch(s);
     if (m == null) {
-      final y = RegExp(
-        r'\b(\d{1,2})[\/\-](\d{1,2})[\/\-](\d{2,4})\b',
-      ).firstMatch(s);
+      final y = _numericDateWithYearPattern.firstMatch(s);
       if (y == null) return false;
       final aa = int.parse(y.group(1)!);
       final bb = int.parse(y.group(2)!);
@@ -2071,7 +2384,7 @@ class ScheduleParser {
   }
 
   List<String> _splitNames(String s) => s
-      .split(RegExp(r'\s*(?:,|&| and )\s*', caseSensitive: false))
+      .split(_nameSeparatorPattern)
       .map((e) => e.trim())
       .where((e) => e.isNotEmpty)
       .toList(growable: false);
@@ -2088,7 +2401,7 @@ class ScheduleParser {
         return prefix.isEmpty ? ' ' : prefix;
       });
     }
-    return cleaned.replaceAll(RegExp(r'\s+'), ' ').trim();
+    return cleaned.replaceAll(_whitespaceRunPattern, ' ').trim();
   }
 
   String _stripAppliedMetadata(
@@ -2127,14 +2440,14 @@ class ScheduleParser {
       cleaned = cleaned.replaceAll(pattern, ' ');
     }
 
-    return cleaned.replaceAll(RegExp(r'\s+'), ' ').trim();
+    return cleaned.replaceAll(_whitespaceRunPattern, ' ').trim();
   }
 
   RegExp? _priorityTokenRegex(String raw) {
     final trimmed = raw.trim();
     if (trimmed.isEmpty) return null;
     final pattern = trimmed
-        .split(RegExp(r'\s+'))
+        .split(_whitespaceRunPattern)
         .map((segment) => RegExp.escape(segment))
         .join(r'\s+');
     if (pattern.isEmpty) return null;
@@ -2148,10 +2461,7 @@ class ScheduleParser {
     if (raw == null) return null;
     var value = raw.trim();
     if (value.isEmpty) return null;
-    value = value.replaceFirst(
-      RegExp(r'^(?:at|in|to)\s+', caseSensitive: false),
-      '',
-    );
+    value = value.replaceFirst(_locationLeadInPattern, '');
     value = value.trim();
     return value.isEmpty ? null : value;
   }
@@ -2171,7 +2481,7 @@ class ScheduleParser {
     }
     if (working.isEmpty) return null;
     if (trimmedTemporal &&
-        RegExp(r'^\d{1,3}(?:st|nd|rd|th)?$').hasMatch(working.toLowerCase())) {
+        _ordinalNumberPattern.hasMatch(working.toLowerCase())) {
       return null;
     }
     return working;
@@ -2188,25 +2498,16 @@ class ScheduleParser {
     if (lower.contains('this time ')) {
       return true;
     }
-    if (RegExp(
-      r'\bthis\s+(time|morning|afternoon|evening|night|week|weekend|month|year)\b',
-    ).hasMatch(lower)) {
+    if (_thisPeriodPattern.hasMatch(lower)) {
       return true;
     }
-    if (RegExp(
-      r'\bnext\s+(week|weekend|month|year|mon|tue|tues|wed|thu|thur|thurs|fri|sat|sun'
-      r'|monday|tuesday|wednesday|thursday|friday|saturday|sunday)\b',
-    ).hasMatch(lower)) {
+    if (_nextPeriodPattern.hasMatch(lower)) {
       return true;
     }
-    if (RegExp(
-      r'\b\d{1,2}(:\d{2})?\s*(?:a\.?m\.?|p\.?m\.?|am|pm)\b',
-    ).hasMatch(lower)) {
+    if (_meridiemTimePattern.hasMatch(lower)) {
       return true;
     }
-    if (RegExp(
-      r'\b\d+\s+(minute|hour|day|week|month|year)s?\b',
-    ).hasMatch(lower)) {
+    if (_numericSpanPattern.hasMatch(lower)) {
       return true;
     }
     return false;
@@ -2220,11 +2521,8 @@ class ScheduleParser {
     if (trimmed.contains('@')) return true;
     if (trimmed.startsWith('#')) return true;
     if (trimmed.length <= 2) return true;
-    final hasDigits = RegExp(r'\d').hasMatch(trimmed);
-    final isAlphaNum = RegExp(
-      r'^[a-z0-9_\-]+$',
-      caseSensitive: false,
-    ).hasMatch(trimmed);
+    final hasDigits = _digitPattern.hasMatch(trimmed);
+    final isAlphaNum = _handlePattern.hasMatch(trimmed);
     if (!hasDigits && isAlphaNum && trimmed.length <= 20) {
       return true;
     }
@@ -2232,9 +2530,9 @@ class ScheduleParser {
   }
 
   String _clean(String s) => s
-      .replaceAll(RegExp(r'\s+'), ' ')
+      .replaceAll(_whitespaceRunPattern, ' ')
       .trim()
-      .replaceAll(RegExp(r'[ ,.;]+$'), '');
+      .replaceAll(_trailingPunctuationPattern, '');
 
   String _removeSpanByIndex(String s, int index, int length) {
     if (index < 0 || index + length > s.length) return s;
@@ -2325,18 +2623,7 @@ class _ExplicitRange {
 }
 
 _ExplicitRange? _extractExplicitRange(String text) {
-  final patterns = <RegExp>[
-    RegExp(
-      '\\bfrom\\s+(?<start>$_timeSnippetPattern)\\s+(?:to|till|til|until|through)\\s+(?<end>$_timeSnippetPattern)',
-      caseSensitive: false,
-    ),
-    RegExp(
-      '\\b(?<start>$_timeSnippetPattern)\\s+(?:to|till|til|until|through)\\s+(?<end>$_timeSnippetPattern)',
-      caseSensitive: false,
-    ),
-  ];
-
-  for (final pattern in patterns) {
+  for (final pattern in _explicitRangePatterns) {
     final match = pattern.firstMatch(text);
     if (match == null) continue;
     final startRaw = match.namedGroup('start');
@@ -2399,42 +2686,36 @@ _ClockToken? _parseClockToken(String raw) {
     );
   }
 
-  final bool isPm = RegExp(
-    r'p\.?m\.?|\bpm\b',
-    caseSensitive: false,
-  ).hasMatch(value);
-  final bool isAm = RegExp(
-    r'a\.?m\.?|\bam\b',
-    caseSensitive: false,
-  ).hasMatch(value);
+  final bool isPm = _pmPattern.hasMatch(value);
+  final bool isAm = _amPattern.hasMatch(value);
   final bool hasMeridiem = isPm || isAm;
   value = value
-      .replaceAll(RegExp(r'p\.?m\.?|a\.?m\.?|\bpm\b|\bam\b'), ' ')
+      .replaceAll(_meridiemMarkerPattern, ' ')
       .trim();
-  value = value.replaceFirst(RegExp(r'^(at|around)\s+'), '');
+  value = value.replaceFirst(_clockLeadInPattern, '');
 
   int? hour;
   int minute = 0;
   bool was24Hour = false;
 
-  final colon = RegExp(r'(\d{1,2}):(\d{2})').firstMatch(value);
+  final colon = _colonClockPattern.firstMatch(value);
   if (colon != null) {
     hour = int.tryParse(colon.group(1)!);
     minute = int.tryParse(colon.group(2)!) ?? 0;
   } else {
-    final hNotation = RegExp(r'(\d{1,2})\s*h\s*(\d{1,2})?').firstMatch(value);
+    final hNotation = _hourNotationPattern.firstMatch(value);
     if (hNotation != null) {
       hour = int.tryParse(hNotation.group(1)!);
       minute = int.tryParse(hNotation.group(2) ?? '0') ?? 0;
       was24Hour = true;
     } else {
-      final tight = RegExp(r'(\d{1,2})h(\d{1,2})?').firstMatch(value);
+      final tight = _tightHourNotationPattern.firstMatch(value);
       if (tight != null) {
         hour = int.tryParse(tight.group(1)!);
         minute = int.tryParse(tight.group(2) ?? '0') ?? 0;
         was24Hour = true;
       } else {
-        final lone = RegExp(r'\b(\d{1,2})\b').firstMatch(value);
+        final lone = _loneHourPattern.firstMatch(value);
         if (lone != null) {
           hour = int.tryParse(lone.group(1)!);
         }
@@ -2509,28 +2790,7 @@ class _DurationExtraction {
 }
 
 _DurationExtraction? _extractDurationPhrase(String text) {
-  final List<RegExp> patterns = [
-    RegExp(
-      r'\b(?:for|lasting|lasts?|runs?|running|going)(?:\s+for)?\s+'
-      r'(?<value>half|quarter|an|a|one|two|three|four|five|six|seven|eight|nine|ten|eleven|twelve|couple|few|several|dozen|\d+(?:\.\d+)?)\s*'
-      r'(?<unit>hours?|hrs?|hr|minutes?|mins?|min|seconds?|secs?|sec|days?|day|weeks?|week)\b',
-      caseSensitive: false,
-    ),
-    RegExp(
-      r'\b(?<value>half|quarter|an|a|one|two|three|four|five|six|seven|eight|nine|ten|eleven|twelve|couple|few|several|dozen|\d+(?:\.\d+)?)\s*'
-      r'(?<unit>hours?|hrs?|hr|minutes?|mins?|min|seconds?|secs?|sec|days?|day|weeks?|week)\s+'
-      r'(?:long|duration|straight)\b',
-      caseSensitive: false,
-    ),
-    RegExp(
-      r'\b(?<value>\d+(?:\.\d+)?)\s*'
-      r'(?<unit>hours?|hrs?|hr|minutes?|mins?|min|seconds?|secs?|sec|days?|day|weeks?|week)\s*'
-      r'(?:session|meeting|event)\b',
-      caseSensitive: false,
-    ),
-  ];
-
-  for (final pattern in patterns) {
+  for (final pattern in _durationPhrasePatterns) {
     final match = pattern.firstMatch(text);
     if (match == null) continue;
     final Duration? duration = _durationFromCapture(
@@ -2547,12 +2807,7 @@ _DurationExtraction? _extractDurationPhrase(String text) {
     );
   }
 
-  final RegExp composite = RegExp(
-    r'\b(?<hours>\d+(?:\.\d+)?)\s*h(?:ours?|rs?)?'
-    r'(?:\s*(?<minutes>\d+(?:\.\d+)?)\s*m(?:in(?:utes?)?)?)?\b',
-    caseSensitive: false,
-  );
-  final compositeMatch = composite.firstMatch(text);
+  final compositeMatch = _compositeDurationPattern.firstMatch(text);
   if (compositeMatch != null) {
     final double hours = double.parse(
       compositeMatch.namedGroup('hours') ?? '0',
@@ -2580,11 +2835,7 @@ _DurationExtraction? _extractDurationPhrase(String text) {
     }
   }
 
-  final RegExp tightComposite = RegExp(
-    r'\b(?<hours>\d+)h(?<minutes>\d{1,2})m?\b',
-    caseSensitive: false,
-  );
-  final tightMatch = tightComposite.firstMatch(text);
+  final tightMatch = _tightCompositeDurationPattern.firstMatch(text);
   if (tightMatch != null) {
     final int hours = int.parse(tightMatch.namedGroup('hours')!);
     final int minutes = int.parse(tightMatch.namedGroup('minutes')!);
@@ -2600,15 +2851,10 @@ _DurationExtraction? _extractDurationPhrase(String text) {
     }
   }
 
-  final RegExp bare = RegExp(
-    r'\b(?<value>half|quarter|an|a|one|two|three|four|five|six|seven|eight|nine|ten|eleven|twelve|\d+(?:\.\d+)?)\s*'
-    r'(?<unit>h|hr|hrs|hour|hours|m|min|mins|minute|minutes|day|days|week|weeks)\b',
-    caseSensitive: false,
-  );
-  final bareMatch = bare.firstMatch(text);
+  final bareMatch = _bareDurationPattern.firstMatch(text);
   if (bareMatch != null) {
     final prefix = text.substring(0, bareMatch.start);
-    if (!RegExp(r'\bin\s*$', caseSensitive: false).hasMatch(prefix)) {
+    if (!_trailingInPattern.hasMatch(prefix)) {
       final Duration? duration = _durationFromCapture(
         bareMatch.namedGroup('value'),
         bareMatch.namedGroup('unit'),
@@ -2745,8 +2991,8 @@ class _ConsumedPhraseTracker {
     if (raw == null) return null;
     var value = raw.trim().toLowerCase();
     if (value.isEmpty) return null;
-    value = value.replaceAll(RegExp(r'\s+'), ' ');
-    value = value.replaceAll(RegExp(r'[,.:;!\/\\-]+$'), '').trim();
+    value = value.replaceAll(_whitespaceRunPattern, ' ');
+    value = value.replaceAll(_trailingSeparatorPattern, '').trim();
     return value.isEmpty ? null : value;
   }
 }
@@ -2801,6 +3047,255 @@ class _PriorityResult {
   _PriorityResult(this.quadrant, this.assumptions, this.triggerTokens);
 }
 
+const int _scheduleVocabularyCacheSize = 8;
+const int _scannedPrefixCacheSize = 16;
+const int _whitespaceKey = 0x20;
+
+/// Words whose presence a parse stage needs before its patterns can match.
+enum _ScheduleCue {
+  tomorrow,
+  tonight,
+  withShorthand,
+  noonish,
+  midday,
+  hours,
+  minutes,
+  after,
+  night,
+  deadlineLeadIn,
+  endOfPeriod,
+  recurrence,
+  weekday,
+}
+
+/// Word-start stems of each cue. A stem is a prefix of every word its
+/// stage's patterns can begin with, so a missing cue means the stage cannot
+/// match.
+const Map<_ScheduleCue, List<String>> _scheduleCueStems = {
+  _ScheduleCue.tomorrow: ['tm', 'tom', '2mor'],
+  _ScheduleCue.tonight: ['tonite'],
+  _ScheduleCue.withShorthand: ['w/'],
+  _ScheduleCue.noonish: ['noon'],
+  _ScheduleCue.midday: ['mid'],
+  _ScheduleCue.hours: ['hr'],
+  _ScheduleCue.minutes: ['min'],
+  _ScheduleCue.after: ['aftr'],
+  _ScheduleCue.night: ['nite'],
+  // "no/not later than" always contains "later".
+  _ScheduleCue.deadlineLeadIn: ['by', 'before', 'due', 'deadline', 'later'],
+  _ScheduleCue.endOfPeriod: ['eod', 'cob', 'eow', 'eom', 'eoy', 'end'],
+  _ScheduleCue.recurrence: [
+    'every',
+    'each',
+    'daily',
+    'week',
+    'month',
+    'yearly',
+    'annually',
+    'biweekly',
+    'mwf',
+    'tth',
+  ],
+  _ScheduleCue.weekday: ['mon', 'tue', 'wed', 'thu', 'fri', 'sat', 'sun'],
+};
+
+/// The cue stems and a policy's priority words compiled into one trie, so
+/// the parser walks its input once per stage instead of running every
+/// pattern over it.
+///
+/// Cues match case-insensitively at any word start, like the `\b` of the
+/// patterns they gate. Priority words follow the per-word patterns they
+/// replace: case-insensitive, whitespace inside a word matches any
+/// whitespace run, and a match must start and end at a separator.
+///
+/// While a field is typed into, each parse repeats the previous input plus a
+/// few characters, so the scan state at the last token boundary that no
+/// earlier walk reads past is kept per prefix and resumed from.
+final class _ScheduleVocabulary {
+  _ScheduleVocabulary._(Iterable<String> words) {
+    _scheduleCueStems.forEach((cue, stems) {
+      for (final stem in stems) {
+        _insert(stem).cue = cue;
+      }
+    });
+    for (final word in words) {
+      final key = keyFor(word);
+      if (key.isEmpty) continue;
+      _insert(key).word = key;
+    }
+  }
+
+  /// Policies are rebuilt from config on every parse, so vocabularies are
+  /// cached by their words rather than by policy instance.
+  factory _ScheduleVocabulary.of(FuzzyPolicy policy) {
+    final words = <String>[
+      ...policy.importantWords,
+      ...policy.notImportantWords,
+      ...policy.urgentWords,
+      ...policy.notUrgentWords,
+    ];
+    final cacheKey = words.join('\u0000');
+    final cached = _cache[cacheKey];
+    if (cached != null) return cached;
+    if (_cache.length >= _scheduleVocabularyCacheSize) _cache.clear();
+    return _cache[cacheKey] = _ScheduleVocabulary._(words);
+  }
+
+  static final Map<String, _ScheduleVocabulary> _cache = {};
+
+  final _VocabularyNode _root = _VocabularyNode();
+
+  /// Least recently used first.
+  final Map<String, _VocabularyScan> _prefixes = {};
+
+  static String keyFor(String word) => word
+      .trim()
+      .toLowerCase()
+      .split(_whitespaceRunPattern)
+      .where((segment) => segment.isNotEmpty)
+      .join(' ');
+
+  _VocabularyNode _insert(String key) {
+    var node = _root;
+    for (final unit in key.codeUnits) {
+      node = node.children.putIfAbsent(unit, _VocabularyNode.new);
+    }
+    return node;
+  }
+
+  _VocabularyScan scan(String input) {
+    String? resumedFrom;
+    for (final prefix in _prefixes.keys) {
+      if (input.startsWith(prefix) &&
+          prefix.length > (resumedFrom?.length ?? 0)) {
+        resumedFrom = prefix;
+      }
+    }
+    final resumed = resumedFrom == null ? null : _prefixes.remove(resumedFrom);
+    if (resumedFrom != null) _prefixes[resumedFrom] = resumed!;
+    final cues = <_ScheduleCue, int>{...?resumed?.cues};
+    final matches = <String, String>{...?resumed?.priorityMatches};
+
+    final from = resumedFrom?.length ?? 0;
+    // One past the furthest index any walk so far has read.
+    var reach = from;
+    int? cut;
+    _VocabularyScan? atCut;
+    for (var start = from; start < input.length; start++) {
+      final previous = start > 0 ? input.codeUnitAt(start - 1) : null;
+      if (start > from && reach <= start && _isWhitespace(previous!)) {
+        cut = start;
+        atCut = _VocabularyScan({...cues}, {...matches});
+      }
+      final cueStart = previous == null || !_isWordUnit(previous);
+      final wordStart = previous == null || _isTokenSeparator(previous);
+      if (!cueStart && !wordStart) continue;
+      var node = _root;
+      var index = start;
+      while (node.children.isNotEmpty) {
+        if (index == input.length) {
+          reach = input.length + 1;
+          break;
+        }
+        final unit = input.codeUnitAt(index);
+        final _VocabularyNode? next;
+        if (_isWhitespace(unit)) {
+          next = node.children[_whitespaceKey];
+          index++;
+          if (next != null) {
+            while (index < input.length &&
+                _isWhitespace(input.codeUnitAt(index))) {
+              index++;
+            }
+            if (index + 1 > reach) reach = index + 1;
+          }
+        } else {
+          next = node.children[_foldCase(unit)];
+          index++;
+        }
+        if (index > reach) reach = index;
+        if (next == null) break;
+        node = next;
+        final cue = node.cue;
+        if (cue != null && cueStart) cues[cue] = (cues[cue] ?? 0) + 1;
+        final word = node.word;
+        if (word != null && wordStart) {
+          if (index + 1 > reach) reach = index + 1;
+          if (index == input.length ||
+              _isTokenSeparator(input.codeUnitAt(index))) {
+            matches.putIfAbsent(word, () => input.substring(start, index));
+          }
+        }
+      }
+    }
+
+    if (cut != null) {
+      _prefixes[input.substring(0, cut)] = atCut!;
+      if (_prefixes.length > _scannedPrefixCacheSize) {
+        _prefixes.remove(_prefixes.keys.first);
+      }
+    }
+    return _VocabularyScan(cues, matches);
+  }
+
+  static int _foldCase(int unit) {
+    if (unit >= 0x41 && unit <= 0x5a) return unit + 0x20;
+    if (unit < 0x80) return unit;
+    final lower = String.fromCharCode(unit).toLowerCase();
+    return lower.length == 1 ? lower.codeUnitAt(0) : unit;
+  }
+
+  /// `\w`
+  static bool _isWordUnit(int unit) =>
+      (unit >= 0x30 && unit <= 0x39) ||
+      (unit >= 0x41 && unit <= 0x5a) ||
+      (unit >= 0x61 && unit <= 0x7a) ||
+      unit == 0x5f;
+
+  /// `[\s,:;!\-\/]`
+  static bool _isTokenSeparator(int unit) =>
+      _isWhitespace(unit) ||
+      unit == 0x2c ||
+      unit == 0x3a ||
+      unit == 0x3b ||
+      unit == 0x21 ||
+      unit == 0x2d ||
+      unit == 0x2f;
+
+  /// The characters `\s` matches.
+  static bool _isWhitespace(int unit) =>
+      (unit >= 0x09 && unit <= 0x0d) ||
+      unit == 0x20 ||
+      unit == 0xa0 ||
+      unit == 0x1680 ||
+      (unit >= 0x2000 && unit <= 0x200a) ||
+      unit == 0x2028 ||
+      unit == 0x2029 ||
+      unit == 0x202f ||
+      unit == 0x205f ||
+      unit == 0x3000 ||
+      unit == 0xfeff;
+}
+
+final class _VocabularyNode {
+  final Map<int, _VocabularyNode> children = <int, _VocabularyNode>{};
+  _ScheduleCue? cue;
+  String? word;
+}
+
+final class _VocabularyScan {
+  const _VocabularyScan(this.cues, this.priorityMatches);
+
+  /// How many word starts each cue was found at.
+  final Map<_ScheduleCue, int> cues;
+
+  /// The leftmost occurrence of each priority word, keyed by
+  /// [_ScheduleVocabulary.keyFor] and holding the text as written.
+  final Map<String, String> priorityMatches;
+
+  bool has(_ScheduleCue cue) => cues.containsKey(cue);
+}
+
 class _RecurrenceSpec {
   const _RecurrenceSpec({
     required this.frequency,
@@ -3167,10 +3662,7 @@ class _RecurrenceMath {
   }
 
   static int? _weekdayFromIcs(String token) {
-    final match = RegExp(
-      r'(MO|TU|WE|TH|FR|SA|SU)',
-      caseSensitive: false,
-    ).firstMatch(token.toUpperCase());
+    final match = _icsWeekdayPattern.firstMatch(token.toUpperCase());
     if (match == null) return null;
     return switch (match.group(1)) {
       'MO' => DateTime.monday,
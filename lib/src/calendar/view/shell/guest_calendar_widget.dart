@@ -539,8 +539,19 @@ class _GuestTransferMenuState extends State<_GuestTransferMenu> {
   final CalendarTransferService _transferService =
       const CalendarTransferService();
   bool _exporting = false;
+  double? _transferProgress;
   ({int? taskCount, bool isFullModel})? _pendingImport;
 
+  void _handleTransferProgress(int done, int total) {
+    final double? progress = nextCalendarTransferProgress(
+      _transferProgress,
+      done,
+      total,
+    );
+    if (!mounted || progress == null) return;
+    setState(() => _transferProgress = progress);
+  }
+
   @override
   Widget build(BuildContext context) {
     final bool hasCalendarData = widget.state.model.hasCalendarData;
@@ -564,6 +575,7 @@ class _GuestTransferMenuState extends State<_GuestTransferMenu> {
               )
             : null,
         busy: busy,
+        progress: _transferProgress,
       ),
     );
   }
@@ -623,6 +635,7 @@ class _GuestTransferMenuState extends State<_GuestTransferMenu> {
           : await _transferService.exportIcs(
               model: model,
               fileNamePrefix: _guestCalendarExportFilePrefix,
+              onProgress: _handleTransferProgress,
             );
       if (!mounted) return;
       final savePath = await saveCalendarExport(file: file);
@@ -636,7 +649,12 @@ class _GuestTransferMenuState extends State<_GuestTransferMenu> {
         l10n.calendarGuestExportFailed(error.toString()),
       );
     } finally {
-      if (mounted) setState(() => _exporting = false);
+      if (mounted) {
+        setState(() {
+          _exporting = false;
+          _transferProgress = null;
+        });
+      }
     }
   }
 
@@ -670,7 +688,22 @@ class _GuestTransferMenuState extends State<_GuestTransferMenu> {
         return;
       }
       final file = File(path);
-      final importResult = await _transferService.importFromFile(file);
+      if (!mounted) return;
+      setState(() => _exporting = true);
+      final CalendarImportResult importResult;
+      try {
+        importResult = await _transferService.importFromFile(
+          file,
+          onProgress: _handleTransferProgress,
+        );
+      } finally {
+        if (mounted) {
+          setState(() {
+            _exporting = false;
+            _transferProgress = null;
+          });
+        }
+      }
       if (importResult.isFullModel && importResult.model != null) {
         final importedModel = importResult.model!;
         if (!importedModel.hasCalendarData) {
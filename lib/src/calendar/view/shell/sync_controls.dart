@@ -27,6 +27,9 @@ import 'package:axichat/src/calendar/view/shell/responsive_helper.dart';
 
 const bool _defaultShowTransferMenu = true;
 const bool _defaultTransferMenuGhost = false;
+
+/// Smallest change in transfer progress worth a rebuild.
+const double _calendarTransferProgressStep = 0.01;
 const List<CalendarView> _calendarTransferMenuViewOrder = <CalendarView>[
   CalendarView.day,
   CalendarView.week,
@@ -181,10 +184,21 @@ class _CalendarTransferMenuState extends State<CalendarTransferMenu> {
   final CalendarTransferService _transferService =
       const CalendarTransferService();
   bool _exporting = false;
+  double? _transferProgress;
   ({int? taskCount, bool isFullModel})? _pendingImport;
 
   CalendarState get state => widget.state;
 
+  void _handleTransferProgress(int done, int total) {
+    final double? progress = nextCalendarTransferProgress(
+      _transferProgress,
+      done,
+      total,
+    );
+    if (!mounted || progress == null) return;
+    setState(() => _transferProgress = progress);
+  }
+
   @override
   Widget build(BuildContext context) {
     final bool disabled = state.isSyncing || state.isLoading || _exporting;
@@ -199,6 +213,7 @@ class _CalendarTransferMenuState extends State<CalendarTransferMenu> {
         onImport: _handleImportCalendar,
         additionalActions: widget.additionalActions,
         busy: disabled,
+        progress: _transferProgress,
         ghost: widget.ghost,
         selected: widget.selected,
       ),
@@ -266,7 +281,10 @@ class _CalendarTransferMenuState extends State<CalendarTransferMenu> {
     try {
       final file = format == CalendarExportFormat.json
           ? await _transferService.exportModel(model: model)
-          : await _transferService.exportIcs(model: model);
+          : await _transferService.exportIcs(
+              model: model,
+              onProgress: _handleTransferProgress,
+            );
       if (!mounted) return;
       final savePath = await saveCalendarExport(file: file);
       if (savePath == null || savePath.trim().isEmpty) return;
@@ -280,7 +298,10 @@ class _CalendarTransferMenuState extends State<CalendarTransferMenu> {
       );
     } finally {
       if (mounted) {
-        setState(() => _exporting = false);
+        setState(() {
+          _exporting = false;
+          _transferProgress = null;
+        });
       }
     }
   }
@@ -318,8 +339,13 @@ class _CalendarTransferMenuState extends State<CalendarTransferMenu> {
       return;
     }
     final file = File(path);
+    if (!mounted) return;
+    setState(() => _exporting = true);
     try {
-      final result = await _transferService.importFromFile(file);
+      final result = await _transferService.importFromFile(
+        file,
+        onProgress: _handleTransferProgress,
+      );
       if (result.isFullModel && result.model != null) {
         final importedModel = result.model!;
         if (!importedModel.hasCalendarData) {
@@ -351,6 +377,13 @@ class _CalendarTransferMenuState extends State<CalendarTransferMenu> {
         context,
         l10n.calendarTransferImportFailedWithError(error.toString()),
       );
+    } finally {
+      if (mounted) {
+        setState(() {
+          _exporting = false;
+          _transferProgress = null;
+        });
+      }
     }
   }
 }
@@ -506,6 +539,7 @@ class CalendarTransferMenuButton extends StatelessWidget {
     required this.onImport,
     this.additionalActions,
     this.busy = false,
+    this.progress,
     this.ghost = _defaultTransferMenuGhost,
     this.selected = false,
   });
@@ -515,12 +549,23 @@ class CalendarTransferMenuButton extends StatelessWidget {
   final VoidCallback onImport;
   final List<AxiMenuAction>? additionalActions;
   final bool busy;
+
+  /// Fraction of a running export or import; replaces the menu while set.
+  final double? progress;
   final bool ghost;
   final bool selected;
 
   @override
   Widget build(BuildContext context) {
     final l10n = context.l10n;
+    final double? progress = this.progress;
+    if (progress != null) {
+      final String percent = '${(progress * 100).round()}%';
+      return AxiTooltip(
+        builder: (_) => Text(percent),
+        child: AxiProgressIndicator(value: progress, semanticsLabel: percent),
+      );
+    }
     final bool canExport = hasCalendarData && !busy;
     final bool canImport = !busy;
     return AxiMore(
@@ -544,3 +589,18 @@ class CalendarTransferMenuButton extends StatelessWidget {
     );
   }
 }
+
+/// The progress fraction to show for [done] of [total], or null when it has
+/// not moved enough since [current] to be worth a rebuild.
+double? nextCalendarTransferProgress(double? current, int done, int total) {
+  if (total <= 0) {
+    return null;
+  }
+  final double next = (done / total).clamp(0.0, 1.0);
+  if (current != null &&
+      next < 1 &&
+      next - current < _calendarTransferProgressStep) {
+    return null;
+  }
+  return next;
+}
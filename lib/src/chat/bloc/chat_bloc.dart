@@ -19,6 +19,7 @@ import 'package:axichat/src/calendar/interop/calendar_transfer_service.dart';
 import 'package:axichat/src/chat/models/chat_message.dart';
 import 'package:axichat/src/chat/models/pending_attachment.dart';
 import 'package:axichat/src/chat/models/pinned_message_item.dart';
+import 'package:axichat/src/chat/models/prepared_message_pipeline.dart';
 import 'package:axichat/src/chat/models/rfc_email_group.dart';
 import 'package:axichat/src/common/chat_subject_codec.dart';
 import 'package:axichat/src/common/address_tools.dart';
@@ -406,6 +407,9 @@ class ChatBloc extends Bloc<ChatEvent, ChatState> {
                ? messageService as OmemoService
                : null),
        _mucService = mucService,
+       _preparedMessages = PreparedMessagePipeline(
+         store: () => messageService.preparedMessageStore,
+       ),
        _chatArchiveSessionId = messageService.createChatArchiveSession(),
        _settingsSnapshot = settings,
        super(
@@ -433,6 +437,7 @@ class ChatBloc extends Bloc<ChatEvent, ChatState> {
       _onChatEmailContentPreparationUpdated,
     );
     on<_ChatEmailOriginalContentUpdated>(_onChatEmailOriginalContentUpdated);
+    on<_ChatPreparedMessagesReady>(_onChatPreparedMessagesReady);
     on<_ChatEmailFullMessageDownloaded>(_onChatEmailFullMessageDownloaded);
     on<ChatRenderedMessagesHydrationRequested>(
       _onChatRenderedMessagesHydrationRequested,
@@ -670,6 +675,7 @@ class ChatBloc extends Bloc<ChatEvent, ChatState> {
   EmailService? _emailService;
   final OmemoService? _omemoService;
   final MucService _mucService;
+  final PreparedMessagePipeline _preparedMessages;
   ChatSettingsSnapshot _settingsSnapshot;
 
   final Logger _log = Logger('ChatBloc');
@@ -728,6 +734,7 @@ class ChatBloc extends Bloc<ChatEvent, ChatState> {
       EmailOriginalContentSnapshot.empty;
   Map<EmailContentJobKey, Message> _pendingUnreadDividerEmailContentMessages =
       const <EmailContentJobKey, Message>{};
+  String? _preparedWindowAnchorStanzaId;
   Future<void> _autoDownloadQueue = Future<void>.value();
   int _messageSubscriptionGeneration = 0;
   List<RosterItem> _roomRosterItems = const <RosterItem>[];
@@ -3069,6 +3076,7 @@ class ChatBloc extends Bloc<ChatEvent, ChatState> {
       );
       hydrationQueued = true;
     }
+    _prepareTimelineMessages(filteredItems);
     await _maybeBootstrapUnreadWindow(
       chat: chat,
       filteredOutCount: preparedSourceCount - filteredItems.length,
@@ -3254,6 +3262,60 @@ class ChatBloc extends Bloc<ChatEvent, ChatState> {
     return true;
   }
 
+  void _prepareTimelineMessages(List<Message> messages) {
+    unawaited(
+      _preparedMessages
+          .prepare(
+            messages,
+            anchorStanzaId: _preparedWindowAnchorStanzaId,
+            emailFullHtmlByDeltaId: state.emailFullHtmlByDeltaId,
+          )
+          .then((changed) {
+            if (changed && !isClosed) {
+              add(const _ChatPreparedMessagesReady());
+            }
+          })
+          .catchError((Object error, StackTrace stackTrace) {
+            _log.fine(
+              'Timeline message preparation failed.',
+              error,
+              stackTrace,
+            );
+          }),
+    );
+  }
+
+  /// Moves the prepared window to the newest of [renderedMessages] once the
+  /// timeline scrolls away from where it was last prepared.
+  void _anchorPreparedMessages(List<Message> renderedMessages) {
+    final renderedIds = <String>{
+      for (final message in renderedMessages) message.stanzaID,
+    };
+    String? anchor;
+    for (final message in state.items) {
+      if (renderedIds.contains(message.stanzaID)) {
+        anchor = message.stanzaID;
+        break;
+      }
+    }
+    if (anchor == null || anchor == _preparedWindowAnchorStanzaId) {
+      return;
+    }
+    _preparedWindowAnchorStanzaId = anchor;
+    _prepareTimelineMessages(state.items);
+  }
+
+  void _onChatPreparedMessagesReady(
+    _ChatPreparedMessagesReady event,
+    Emitter<ChatState> emit,
+  ) {
+    emit(
+      state.copyWith(
+        preparedMessageRevision: state.preparedMessageRevision + 1,
+      ),
+    );
+  }
+
   bool _reportVisibleEmailContentMessages(Iterable<Message> messages) {
     final emailService = _emailService;
     if (emailService == null) {
@@ -3862,6 +3924,7 @@ class ChatBloc extends Bloc<ChatEvent, ChatState> {
         'allowOffWindow': event.allowOffWindowEmailContentHydration,
       },
     );
+    _anchorPreparedMessages(messages);
     final emailContentReported = _reportVisibleEmailContentMessages(messages);
     final emailQuotedTextQueued = _maybeRequestVisibleEmailQuotedText(
       messages,
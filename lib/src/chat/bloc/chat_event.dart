@@ -103,6 +103,13 @@ final class _ChatPresentationHydrationRequested extends ChatEvent {
   ];
 }
 
+final class _ChatPreparedMessagesReady extends ChatEvent {
+  const _ChatPreparedMessagesReady();
+
+  @override
+  List<Object?> get props => [];
+}
+
 final class _ChatEmailContentPreparationUpdated extends ChatEvent {
   const _ChatEmailContentPreparationUpdated(this.snapshot);
 
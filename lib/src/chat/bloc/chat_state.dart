@@ -251,6 +251,7 @@ abstract class ChatState with _$ChatState {
     @Default(<int>{}) Set<int> emailFullHtmlUnavailable,
     @Default(<int>{}) Set<int> emailFullMessageLoading,
     @Default(0) int emailContentPreparationRevision,
+    @Default(0) int preparedMessageRevision,
     @Default(<int, String>{}) Map<int, String> emailQuotedTextByDeltaId,
     @Default(<int>{}) Set<int> emailQuotedTextLoading,
     @Default(<int>{}) Set<int> emailQuotedTextUnavailable,
@@ -0,0 +1,119 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+// Copyright (C) 2025-present Eliot Lew, Axichat Developers
+
+import 'dart:math' as math;
+
+import 'package:axichat/src/common/html_content.dart';
+import 'package:axichat/src/storage/models.dart';
+import 'package:axichat/src/storage/prepared_message_store.dart';
+
+const int _preparedMessageWindow = 40;
+const String _fullHtmlKeySuffix = '#full';
+
+/// Prepares render data for the messages a chat is about to show, ahead of
+/// the timeline projection, which only reads what is already cached.
+///
+/// Each pass hashes the window's HTML and derives whatever is missing on a
+/// worker isolate, restoring from and saving to [PreparedMessageStore] so a
+/// reopened chat starts warm.
+class PreparedMessagePipeline {
+  PreparedMessagePipeline({
+    required Future<PreparedMessageStore>? Function() store,
+    this.windowSize = _preparedMessageWindow,
+  }) : _store = store;
+
+  final Future<PreparedMessageStore>? Function() _store;
+
+  /// Messages prepared per pass: the page on screen plus lookahead, mostly
+  /// toward older messages.
+  final int windowSize;
+
+  /// Prepares [windowSize] of [messages], newest first as the timeline
+  /// stream delivers them, starting a quarter window above
+  /// [anchorStanzaId], the newest message on screen. Without an anchor in
+  /// [messages] the window starts at the newest message. Completes with
+  /// whether anything became available that the current projection did not
+  /// have.
+  Future<bool> prepare(
+    List<Message> messages, {
+    String? anchorStanzaId,
+    Map<int, String> emailFullHtmlByDeltaId = const <int, String>{},
+  }) async {
+    final anchor = anchorStanzaId == null
+        ? -1
+        : messages.indexWhere((message) => message.stanzaID == anchorStanzaId);
+    final start = anchor < 0 ? 0 : math.max(0, anchor - windowSize ~/ 4);
+    final candidates = <({String storeKey, String html})>[];
+    for (final message in messages.skip(start).take(windowSize)) {
+      final html = message.normalizedHtmlBody;
+      if (html != null) {
+        candidates.add((storeKey: message.stanzaID, html: html));
+      }
+      final deltaMessageId = message.deltaMsgId;
+      final fullHtml = deltaMessageId == null
+          ? null
+          : HtmlContentCodec.normalizeHtml(
+              emailFullHtmlByDeltaId[deltaMessageId],
+            );
+      if (fullHtml != null && fullHtml != html) {
+        candidates.add((
+          storeKey: '${message.stanzaID}$_fullHtmlKeySuffix',
+          html: fullHtml,
+        ));
+      }
+    }
+    if (candidates.isEmpty) {
+      return false;
+    }
+    await HtmlContentCodec.precomputeEmailDerivationKeys(
+      candidates.map((candidate) => candidate.html),
+    );
+    final store = await _store();
+    await store?.load();
+
+    var changed = false;
+    final missing = <({String storeKey, String html, String revision})>[];
+    for (final candidate in candidates) {
+      final revision = HtmlContentCodec.emailDerivationKey(candidate.html);
+      final cached = HtmlContentCodec.cachedEmailDerivationForKey(revision);
+      if (cached != null) {
+        store?.put(
+          candidate.storeKey,
+          PreparedMessage(revision: revision, emailHtml: cached),
+        );
+        continue;
+      }
+      final stored = store?.lookup(candidate.storeKey, revision);
+      if (stored != null) {
+        HtmlContentCodec.restoreEmailDerivation(revision, stored.emailHtml);
+        changed = true;
+        continue;
+      }
+      missing.add((
+        storeKey: candidate.storeKey,
+        html: candidate.html,
+        revision: revision,
+      ));
+    }
+    if (missing.isEmpty) {
+      return changed;
+    }
+    await HtmlContentCodec.precacheEmailDerivations(
+      missing.map((candidate) => candidate.html),
+    );
+    for (final candidate in missing) {
+      final derived = HtmlContentCodec.cachedEmailDerivationForKey(
+        candidate.revision,
+      );
+      if (derived == null) {
+        continue;
+      }
+      store?.put(
+        candidate.storeKey,
+        PreparedMessage(revision: candidate.revision, emailHtml: derived),
+      );
+      changed = true;
+    }
+    return changed;
+  }
+}
@@ -8211,7 +8211,9 @@ class _ChatState extends State<Chat> {
                                   previous.emailFullMessageLoading !=
                                       current.emailFullMessageLoading ||
                                   previous.emailContentPreparationRevision !=
-                                      current.emailContentPreparationRevision)
+                                      current.emailContentPreparationRevision ||
+                                  previous.preparedMessageRevision !=
+                                      current.preparedMessageRevision)
                         : previous.scrollTargetRequestId !=
                               current.scrollTargetRequestId),
                 listener: (_, state) {
@@ -8324,6 +8326,8 @@ class _ChatState extends State<Chat> {
                         current.emailFullHtmlByDeltaId ||
                     previous.emailFullHtmlUnavailable !=
                         current.emailFullHtmlUnavailable ||
+                    previous.preparedMessageRevision !=
+                        current.preparedMessageRevision ||
                     previous.scrollTargetMessageId !=
                         current.scrollTargetMessageId ||
                     previous.initialUnreadBootstrapStatus !=
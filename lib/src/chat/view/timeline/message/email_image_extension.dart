@@ -10,6 +10,7 @@ import 'dart:typed_data';
 import 'package:axichat/src/app.dart';
 import 'package:axichat/src/common/html_content.dart';
 import 'package:axichat/src/common/media_decode_safety.dart';
+import 'package:axichat/src/common/memory_budget.dart';
 import 'package:axichat/src/common/network_safety.dart';
 import 'package:axichat/src/common/ui/ui.dart';
 import 'package:axichat/src/localization/localization_extensions.dart';
@@ -71,6 +72,14 @@ int emailImageByteCacheSizeBytesForTesting() {
 }
 
 class _EmailImageByteCache {
+  _EmailImageByteCache() {
+    MemoryBudget.instance.register(
+      'Email images',
+      sizeBytes: () => _sizeBytes,
+      trim: _trimTo,
+    );
+  }
+
   static const int _maxEntries = 64;
   static const int _maxSizeBytes = 24 * 1024 * 1024;
 
@@ -111,12 +120,22 @@ class _EmailImageByteCache {
 
   void _evictIfNeeded() {
     while (_entries.length > _maxEntries || _sizeBytes > _maxSizeBytes) {
-      final oldestKey = _entries.keys.first;
-      final oldestBytes = _entries.remove(oldestKey);
-      if (oldestBytes == null) continue;
-      _sizeBytes -= oldestBytes.length;
+      _evictOldest();
+    }
+  }
+
+  void _trimTo(int targetBytes) {
+    while (_entries.isNotEmpty && _sizeBytes > targetBytes) {
+      _evictOldest();
     }
   }
+
+  void _evictOldest() {
+    final oldestKey = _entries.keys.first;
+    final oldestBytes = _entries.remove(oldestKey);
+    if (oldestBytes == null) return;
+    _sizeBytes -= oldestBytes.length;
+  }
 }
 
 /// Creates a flutter_html extension for inline email images.
@@ -23,6 +23,7 @@ import 'package:axichat/src/chats/view/contact_rename_dialog.dart';
 import 'package:axichat/src/common/export_file_saver.dart';
 import 'package:axichat/src/common/env.dart';
 import 'package:axichat/src/common/request_status.dart';
+import 'package:axichat/src/common/startup/startup_trace.dart';
 import 'package:axichat/src/common/ui/ui.dart';
 import 'package:axichat/src/contacts/bloc/contacts_cubit.dart';
 import 'package:axichat/src/contacts/view/contacts_list.dart';
@@ -214,6 +215,7 @@ class _ChatsListBody extends StatelessWidget {
                   ),
                 );
               } else {
+                startupTrace.markChatListShown();
                 final visibleItems = state.visibleItems;
                 Widget body;
                 if (visibleItems.isEmpty) {
@@ -5,6 +5,10 @@ import 'package:axichat/src/common/address_tools.dart';
 import 'package:axichat/src/common/email_validation.dart';
 import 'package:axichat/src/common/endpoint_config.dart';
 
+/// Best values cached per trie node: enough to fill a suggestion list even
+/// when a few of them are excluded.
+const int _rankedTrieTopCount = 16;
+
 const List<String> _popularAddressAutocompleteDomains = <String>[
   EndpointConfig.defaultDomain,
   'gmail.com',
@@ -28,10 +32,13 @@ const List<String> _popularAddressAutocompleteDomains = <String>[
   'tutanota.com',
 ];
 
+/// Completes a partially typed address from the addresses in [addressIndex]
+/// and from [knownDomains]. Callers keep the index in their state and
+/// [AddressAutocompleteIndex.sync] it when their address list changes.
 List<String> addressAutocompleteSuggestions({
   required String input,
   required Iterable<String> knownDomains,
-  Iterable<String> knownAddresses = const <String>[],
+  required AddressAutocompleteIndex addressIndex,
   Iterable<String> excludedAddresses = const <String>[],
   String? primaryDomain,
   bool requireEmailAddress = true,
@@ -46,8 +53,6 @@ List<String> addressAutocompleteSuggestions({
       .map(normalizedAddressValue)
       .whereType<String>()
       .toSet();
-  final normalizedPrimaryDomain = _normalizedAutocompleteDomain(primaryDomain);
-  final knownDomainCounts = _knownDomainCounts(knownAddresses);
   final results = <String>[];
   final seen = <String>{};
 
@@ -75,84 +80,21 @@ List<String> addressAutocompleteSuggestions({
     return results.length >= limit;
   }
 
-  for (final address in knownAddresses) {
-    if (query.isEmpty || address.toLowerCase().startsWith(query)) {
-      if (add(address)) {
-        return List<String>.unmodifiable(results);
-      }
+  for (final address in addressIndex._addressesWithPrefix(query)) {
+    if (add(address)) {
+      return List<String>.unmodifiable(results);
     }
   }
 
   final parts = addressAutocompleteParts(trimmed);
   if (parts != null) {
-    final typedDomain = parts.domainPart.toLowerCase();
-    final normalizedLocal = parts.localPart.toLowerCase();
-    final knownAddressKeys = knownAddresses
-        .map(normalizedAddressValue)
-        .whereType<String>()
-        .toSet();
-    final candidateDomains = <String>{
-      ...knownDomains.map(_normalizedAutocompleteDomain).whereType<String>(),
-      ...knownDomainCounts.keys,
-      ?normalizedPrimaryDomain,
-    };
-    final domainEntries =
-        candidateDomains
-            .map(
-              (domain) => (
-                domain: domain,
-                knownCount: knownDomainCounts[domain] ?? 0,
-                hasExactAddress: knownAddressKeys.contains(
-                  '$normalizedLocal@$domain',
-                ),
-              ),
-            )
-            .where((entry) {
-              if (typedDomain.isEmpty) {
-                return entry.domain == normalizedPrimaryDomain ||
-                    entry.domain == EndpointConfig.defaultDomain ||
-                    entry.knownCount > 0 ||
-                    _popularDomainRank(entry.domain) != null;
-              }
-              return entry.domain.startsWith(typedDomain);
-            })
-            .toList()
-          ..sort((a, b) {
-            if (a.hasExactAddress != b.hasExactAddress) {
-              return a.hasExactAddress ? -1 : 1;
-            }
-            final aSection = _domainAutocompleteSection(
-              domain: a.domain,
-              knownCount: a.knownCount,
-              primaryDomain: normalizedPrimaryDomain,
-            );
-            final bSection = _domainAutocompleteSection(
-              domain: b.domain,
-              knownCount: b.knownCount,
-              primaryDomain: normalizedPrimaryDomain,
-            );
-            if (aSection != bSection) {
-              return aSection.compareTo(bSection);
-            }
-            if (aSection == _AutocompleteDomainSection.known.index &&
-                a.knownCount != b.knownCount) {
-              return b.knownCount.compareTo(a.knownCount);
-            }
-            final aRank = _popularDomainRank(a.domain);
-            final bRank = _popularDomainRank(b.domain);
-            if (aRank != null || bRank != null) {
-              if (aRank == null) {
-                return 1;
-              }
-              if (bRank == null) {
-                return -1;
-              }
-              return aRank.compareTo(bRank);
-            }
-            return a.domain.compareTo(b.domain);
-          });
-    for (final entry in domainEntries) {
-      if (add('${parts.localPart}@${entry.domain}')) {
+    for (final domain in addressIndex._domainCompletions(
+      localPart: parts.localPart.toLowerCase(),
+      typedDomain: parts.domainPart.toLowerCase(),
+      knownDomains: _AutocompleteDomainList.of(knownDomains),
+      primaryDomain: _normalizedAutocompleteDomain(primaryDomain),
+    )) {
+      if (add('${parts.localPart}@$domain')) {
         return List<String>.unmodifiable(results);
       }
     }
@@ -161,28 +103,484 @@ List<String> addressAutocompleteSuggestions({
   return List<String>.unmodifiable(results);
 }
 
+/// Known addresses and their domains in compressed tries, so a keystroke
+/// costs a walk down the typed prefix instead of a scan of every address.
+///
+/// Addresses rank by recency: the order they were last synced in, which for
+/// the recipient address table is `last_seen` descending. Domains rank by
+/// how many known addresses use them. Every trie node keeps its best few
+/// entries, so the top of any prefix is read off directly.
+///
+/// [sync] applies a new address list as a diff against the indexed one.
+/// When the table's triggers bump or add a few addresses, only those are
+/// restamped and reinserted; the trie is not rebuilt.
+final class AddressAutocompleteIndex {
+  AddressAutocompleteIndex();
+
+  final Map<String, _IndexedAddress> _entries = <String, _IndexedAddress>{};
+  final Map<String, int> _normalizedCounts = <String, int>{};
+  final Map<String, _IndexedDomain> _domains = <String, _IndexedDomain>{};
+  final _RankedTrie<_IndexedAddress> _addressTrie =
+      _RankedTrie<_IndexedAddress>(_compareAddressRecency);
+  final _RankedTrie<_IndexedDomain> _domainTrie = _RankedTrie<_IndexedDomain>(
+    _compareDomainFrequency,
+  );
+  int _clock = 0;
+
+  int get length => _entries.length;
+
+  /// Makes the index hold exactly [addresses], most recent first.
+  void sync(Iterable<String> addresses) {
+    final keys = <String>[];
+    final values = <String>[];
+    final seen = <String>{};
+    for (final address in addresses) {
+      final key = address.toLowerCase();
+      if (seen.add(key)) {
+        keys.add(key);
+        values.add(address);
+      }
+    }
+    // The longest tail already indexed in the same relative order keeps its
+    // stamps; everything in front of it is new or was bumped.
+    var boundary = keys.length;
+    var floor = 0;
+    while (boundary > 0) {
+      final existing = _entries[keys[boundary - 1]];
+      if (existing == null ||
+          existing.stamp <= floor ||
+          existing.address != values[boundary - 1]) {
+        break;
+      }
+      floor = existing.stamp;
+      boundary -= 1;
+    }
+    final domainDeltas = <String, int>{};
+    for (var position = boundary - 1; position >= 0; position -= 1) {
+      _remove(keys[position], domainDeltas);
+      _insert(keys[position], values[position], domainDeltas);
+    }
+    if (_entries.length > keys.length) {
+      final stale = _entries.keys
+          .where((key) => !seen.contains(key))
+          .toList(growable: false);
+      for (final key in stale) {
+        _remove(key, domainDeltas);
+      }
+    }
+    domainDeltas.forEach(_adjustDomain);
+  }
+
+  void _insert(String key, String address, Map<String, int> domainDeltas) {
+    final entry = _IndexedAddress(
+      address: address,
+      normalized: normalizedAddressValue(address),
+      stamp: _clock += 1,
+    );
+    _entries[key] = entry;
+    _addressTrie.insert(key, entry);
+    final normalized = entry.normalized;
+    if (normalized == null) {
+      return;
+    }
+    final count = _normalizedCounts[normalized] ?? 0;
+    _normalizedCounts[normalized] = count + 1;
+    final domain = addressDomainPart(normalized);
+    if (count == 0 && domain != null) {
+      domainDeltas[domain] = (domainDeltas[domain] ?? 0) + 1;
+    }
+  }
+
+  void _remove(String key, Map<String, int> domainDeltas) {
+    final entry = _entries.remove(key);
+    if (entry == null) {
+      return;
+    }
+    _addressTrie.remove(key, entry);
+    final normalized = entry.normalized;
+    if (normalized == null) {
+      return;
+    }
+    final count = _normalizedCounts[normalized]! - 1;
+    if (count > 0) {
+      _normalizedCounts[normalized] = count;
+      return;
+    }
+    _normalizedCounts.remove(normalized);
+    final domain = addressDomainPart(normalized);
+    if (domain != null) {
+      domainDeltas[domain] = (domainDeltas[domain] ?? 0) - 1;
+    }
+  }
+
+  void _adjustDomain(String domain, int delta) {
+    if (delta == 0) {
+      return;
+    }
+    final existing = _domains[domain];
+    final count = (existing?.count ?? 0) + delta;
+    if (existing != null) {
+      _domainTrie.remove(domain, existing);
+    }
+    if (count <= 0) {
+      _domains.remove(domain);
+      return;
+    }
+    final next = _IndexedDomain(domain: domain, count: count);
+    _domains[domain] = next;
+    _domainTrie.insert(domain, next);
+  }
+
+  int _knownCount(String domain) => _domains[domain]?.count ?? 0;
+
+  Iterable<String> _addressesWithPrefix(String prefix) =>
+      _addressTrie.withPrefix(prefix).map((entry) => entry.address);
+
+  /// Domains to complete `localPart@typedDomain` with, best first. Domains
+  /// where that exact address is already known lead; the rest follow in
+  /// section order without sorting the candidates as a whole.
+  Iterable<String> _domainCompletions({
+    required String localPart,
+    required String typedDomain,
+    required _AutocompleteDomainList knownDomains,
+    required String? primaryDomain,
+  }) sync* {
+    int compare(String a, String b) {
+      final aSection = _domainAutocompleteSection(
+        domain: a,
+        knownCount: _knownCount(a),
+        primaryDomain: primaryDomain,
+      );
+      final bSection = _domainAutocompleteSection(
+        domain: b,
+        knownCount: _knownCount(b),
+        primaryDomain: primaryDomain,
+      );
+      if (aSection != bSection) {
+        return aSection.compareTo(bSection);
+      }
+      if (aSection == _AutocompleteDomainSection.known.index &&
+          _knownCount(a) != _knownCount(b)) {
+        return _knownCount(b).compareTo(_knownCount(a));
+      }
+      return _comparePopularDomains(a, b);
+    }
+
+    final exactDomains = <String>{
+      for (final entry in _addressTrie.withPrefix('$localPart@$typedDomain'))
+        if (addressDomainPart(entry.normalized) case final domain?
+            when _normalizedCounts.containsKey('$localPart@$domain'))
+          domain,
+    }.toList()..sort(compare);
+    yield* exactDomains;
+
+    const defaultDomain = EndpointConfig.defaultDomain;
+    bool pending(String domain) =>
+        domain.startsWith(typedDomain) && !exactDomains.contains(domain);
+
+    if (primaryDomain != null && pending(primaryDomain)) {
+      yield primaryDomain;
+    }
+    if (defaultDomain != primaryDomain &&
+        pending(defaultDomain) &&
+        (_knownCount(defaultDomain) > 0 ||
+            knownDomains.contains(defaultDomain))) {
+      yield defaultDomain;
+    }
+    for (final entry in _domainTrie.withPrefix(typedDomain)) {
+      final domain = entry.domain;
+      if (domain != primaryDomain &&
+          domain != defaultDomain &&
+          !exactDomains.contains(domain)) {
+        yield domain;
+      }
+    }
+    bool unknown(String domain) =>
+        domain != primaryDomain &&
+        domain != defaultDomain &&
+        _knownCount(domain) == 0 &&
+        knownDomains.contains(domain);
+    for (final domain in _popularAddressAutocompleteDomains) {
+      if (pending(domain) && unknown(domain)) {
+        yield domain;
+      }
+    }
+    if (typedDomain.isEmpty) {
+      return;
+    }
+    for (final domain in knownDomains.withPrefix(typedDomain)) {
+      if (unknown(domain) && _popularDomainRank(domain) == null) {
+        yield domain;
+      }
+    }
+  }
+}
+
 int? _popularDomainRank(String domain) {
   final index = _popularAddressAutocompleteDomains.indexOf(domain);
   return index < 0 ? null : index;
 }
 
-Map<String, int> _knownDomainCounts(Iterable<String> knownAddresses) {
-  final addressesByDomain = <String, Set<String>>{};
-  for (final address in knownAddresses) {
-    final normalizedAddress = normalizedAddressValue(address);
-    if (normalizedAddress == null) {
-      continue;
+/// Popular providers first, by popularity, then everything else by name.
+int _comparePopularDomains(String a, String b) {
+  final aRank = _popularDomainRank(a);
+  final bRank = _popularDomainRank(b);
+  if (aRank != null || bRank != null) {
+    if (aRank == null) {
+      return 1;
     }
-    final domain = addressDomainPart(normalizedAddress);
-    if (domain == null || domain.isEmpty) {
-      continue;
+    if (bRank == null) {
+      return -1;
+    }
+    return aRank.compareTo(bRank);
+  }
+  return a.compareTo(b);
+}
+
+int _compareAddressRecency(_IndexedAddress a, _IndexedAddress b) =>
+    b.stamp.compareTo(a.stamp);
+
+int _compareDomainFrequency(_IndexedDomain a, _IndexedDomain b) {
+  if (a.count != b.count) {
+    return b.count.compareTo(a.count);
+  }
+  return _comparePopularDomains(a.domain, b.domain);
+}
+
+final class _IndexedAddress {
+  const _IndexedAddress({
+    required this.address,
+    required this.normalized,
+    required this.stamp,
+  });
+
+  final String address;
+  final String? normalized;
+
+  /// Higher is more recent.
+  final int stamp;
+}
+
+final class _IndexedDomain {
+  const _IndexedDomain({required this.domain, required this.count});
+
+  final String domain;
+  final int count;
+}
+
+/// A radix trie whose nodes cache the [_rankedTrieTopCount] best values
+/// beneath them under [_compare], which must be a total order.
+final class _RankedTrie<T extends Object> {
+  _RankedTrie(this._compare);
+
+  final Comparator<T> _compare;
+  final _RankedTrieNode<T> _root = _RankedTrieNode<T>('');
+
+  /// Values under [prefix], best first. The cached top values come for free;
+  /// going past them collects and sorts the whole subtree.
+  Iterable<T> withPrefix(String prefix) sync* {
+    final node = _find(prefix);
+    if (node == null) {
+      return;
+    }
+    final top = List<T>.of(node.top);
+    yield* top;
+    if (top.length < _rankedTrieTopCount) {
+      return;
+    }
+    final all = <T>[];
+    _collect(node, all);
+    all.sort(_compare);
+    yield* all.skip(top.length);
+  }
+
+  void insert(String key, T value) {
+    var node = _root;
+    var rest = key;
+    while (true) {
+      _offer(node.top, value);
+      if (rest.isEmpty) {
+        node.value = value;
+        return;
+      }
+      final unit = rest.codeUnitAt(0);
+      var child = node.children[unit];
+      if (child == null) {
+        node.children[unit] = _RankedTrieNode<T>(rest)
+          ..value = value
+          ..top.add(value);
+        return;
+      }
+      final shared = _sharedPrefixLength(child.edge, rest);
+      if (shared < child.edge.length) {
+        final split = _RankedTrieNode<T>(child.edge.substring(0, shared))
+          ..top.addAll(child.top);
+        child.edge = child.edge.substring(shared);
+        split.children[child.edge.codeUnitAt(0)] = child;
+        node.children[unit] = split;
+        child = split;
+      }
+      node = child;
+      rest = rest.substring(shared);
+    }
+  }
+
+  void remove(String key, T value) {
+    final path = <_RankedTrieNode<T>>[_root];
+    var rest = key;
+    while (rest.isNotEmpty) {
+      final child = path.last.children[rest.codeUnitAt(0)];
+      if (child == null || !rest.startsWith(child.edge)) {
+        return;
+      }
+      rest = rest.substring(child.edge.length);
+      path.add(child);
+    }
+    if (!identical(path.last.value, value)) {
+      return;
+    }
+    path.last.value = null;
+    for (var depth = path.length - 1; depth >= 0; depth -= 1) {
+      final node = path[depth];
+      if (depth > 0 && node.value == null && node.children.length <= 1) {
+        final parent = path[depth - 1];
+        final unit = node.edge.codeUnitAt(0);
+        if (node.children.isEmpty) {
+          parent.children.remove(unit);
+        } else {
+          final child = node.children.values.single;
+          child.edge = '${node.edge}${child.edge}';
+          parent.children[unit] = child;
+        }
+        continue;
+      }
+      // A value missing from a node's best is missing from its ancestors'.
+      if (!node.top.contains(value)) {
+        return;
+      }
+      _rerank(node);
+    }
+  }
+
+  _RankedTrieNode<T>? _find(String prefix) {
+    var node = _root;
+    var rest = prefix;
+    while (rest.isNotEmpty) {
+      final child = node.children[rest.codeUnitAt(0)];
+      if (child == null) {
+        return null;
+      }
+      if (rest.length <= child.edge.length) {
+        return child.edge.startsWith(rest) ? child : null;
+      }
+      if (!rest.startsWith(child.edge)) {
+        return null;
+      }
+      rest = rest.substring(child.edge.length);
+      node = child;
+    }
+    return node;
+  }
+
+  void _offer(List<T> top, T value) {
+    var index = top.length;
+    while (index > 0 && _compare(value, top[index - 1]) < 0) {
+      index -= 1;
+    }
+    if (index >= _rankedTrieTopCount) {
+      return;
+    }
+    top.insert(index, value);
+    if (top.length > _rankedTrieTopCount) {
+      top.removeLast();
+    }
+  }
+
+  void _rerank(_RankedTrieNode<T> node) {
+    final candidates = <T>[
+      ?node.value,
+      for (final child in node.children.values) ...child.top,
+    ]..sort(_compare);
+    node.top
+      ..clear()
+      ..addAll(candidates.take(_rankedTrieTopCount));
+  }
+
+  static void _collect<T extends Object>(
+    _RankedTrieNode<T> node,
+    List<T> values,
+  ) {
+    final value = node.value;
+    if (value != null) {
+      values.add(value);
+    }
+    for (final child in node.children.values) {
+      _collect(child, values);
+    }
+  }
+
+  static int _sharedPrefixLength(String a, String b) {
+    final length = a.length < b.length ? a.length : b.length;
+    var index = 0;
+    while (index < length && a.codeUnitAt(index) == b.codeUnitAt(index)) {
+      index += 1;
+    }
+    return index;
+  }
+}
+
+final class _RankedTrieNode<T extends Object> {
+  _RankedTrieNode(this.edge);
+
+  /// The key fragment on the edge from the parent; empty only at the root.
+  String edge;
+  T? value;
+  final Map<int, _RankedTrieNode<T>> children = <int, _RankedTrieNode<T>>{};
+  final List<T> top = <T>[];
+}
+
+/// Caller-supplied domains, normalized and sorted once per collection so a
+/// prefix is a binary search rather than a scan.
+final class _AutocompleteDomainList {
+  _AutocompleteDomainList._(this._sorted) : _members = _sorted.toSet();
+
+  factory _AutocompleteDomainList.of(Iterable<String> domains) =>
+      _lists[domains] ??= _AutocompleteDomainList._(
+        domains
+            .map(_normalizedAutocompleteDomain)
+            .whereType<String>()
+            .toSet()
+            .toList()
+          ..sort(),
+      );
+
+  static final Expando<_AutocompleteDomainList> _lists =
+      Expando<_AutocompleteDomainList>('AutocompleteDomainList');
+
+  final List<String> _sorted;
+  final Set<String> _members;
+
+  bool contains(String domain) => _members.contains(domain);
+
+  Iterable<String> withPrefix(String prefix) sync* {
+    var low = 0;
+    var high = _sorted.length;
+    while (low < high) {
+      final middle = (low + high) >> 1;
+      if (_sorted[middle].compareTo(prefix) < 0) {
+        low = middle + 1;
+      } else {
+        high = middle;
+      }
+    }
+    for (var index = low; index < _sorted.length; index += 1) {
+      final domain = _sorted[index];
+      if (!domain.startsWith(prefix)) {
+        return;
+      }
+      yield domain;
     }
-    (addressesByDomain[domain] ??= <String>{}).add(normalizedAddress);
   }
-  return {
-    for (final entry in addressesByDomain.entries)
-      entry.key: entry.value.length,
-  };
 }
 
 String? _normalizedAutocompleteDomain(String? raw) {
@@ -0,0 +1,71 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+// Copyright (C) 2025-present Eliot Lew, Axichat Developers
+
+import 'dart:ui' as ui;
+
+import 'package:flutter/widgets.dart';
+
+/// Renders [child] into the newest [ui.FlutterView] when the app was started
+/// with [runWidget] instead of [runApp].
+///
+/// The Linux runner's background mode keeps one headless engine alive and
+/// adds a view per window, so views come and go at runtime. While no window
+/// is open [child] is not mounted at all; state above this widget survives.
+/// Under [runApp] there is already a [View] ancestor and [child] is returned
+/// unchanged.
+class DesktopViewHost extends StatefulWidget {
+  const DesktopViewHost({super.key, required this.child});
+
+  final Widget child;
+
+  @override
+  State<DesktopViewHost> createState() => _DesktopViewHostState();
+}
+
+class _DesktopViewHostState extends State<DesktopViewHost>
+    with WidgetsBindingObserver {
+  ui.FlutterView? _view;
+
+  @override
+  void initState() {
+    super.initState();
+    WidgetsBinding.instance.addObserver(this);
+    _view = _newestView();
+  }
+
+  @override
+  void dispose() {
+    WidgetsBinding.instance.removeObserver(this);
+    super.dispose();
+  }
+
+  // Views being added or removed are reported as a metrics change.
+  @override
+  void didChangeMetrics() {
+    final ui.FlutterView? view = _newestView();
+    if (view?.viewId == _view?.viewId) return;
+    setState(() => _view = view);
+  }
+
+  static ui.FlutterView? _newestView() {
+    ui.FlutterView? newest;
+    for (final view in WidgetsBinding.instance.platformDispatcher.views) {
+      if (newest == null || view.viewId > newest.viewId) {
+        newest = view;
+      }
+    }
+    return newest;
+  }
+
+  @override
+  Widget build(BuildContext context) {
+    if (View.maybeOf(context) != null) return widget.child;
+    final ui.FlutterView? view = _view;
+    return ViewCollection(
+      views: [
+        if (view != null)
+          View(key: ValueKey(view.viewId), view: view, child: widget.child),
+      ],
+    );
+  }
+}
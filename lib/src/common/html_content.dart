@@ -591,6 +591,9 @@ pre, code {
 
   static const int _maxEmailDerivationEntries = 256;
   static const int _maxEmailDerivationCacheBytes = 4 * 1024 * 1024;
+  // Part of the cache budget above, set aside for remembered content keys,
+  // which hold on to the HTML they were computed from.
+  static const int _maxEmailDerivationKeyMemoBytes = 1024 * 1024;
   static final LinkedHashMap<
     String,
     ({EmailHtmlDerivation derivation, int retainedBytes})
@@ -602,6 +605,9 @@ pre, code {
       >();
   static int _emailDerivationCacheBytes = 0;
   static final Set<String> _emailDerivationPrecacheKeys = <String>{};
+  static final LinkedHashMap<String, String> _emailDerivationKeysByHtml =
+      LinkedHashMap<String, String>();
+  static int _emailDerivationKeyMemoBytes = 0;
 
   static EmailHtmlDerivation emailDerivations(String normalizedHtml) {
     final key = _emailDerivationCacheKey(normalizedHtml);
@@ -660,6 +666,7 @@ pre, code {
         List<String>.unmodifiable(pending),
       );
       for (final item in derivations) {
+        final key = item['key'];
         final normalizedHtml = item['normalizedHtml'];
         final preparedFlutterHtml = item['preparedFlutterHtml'];
         final visibleBodyText = item['visibleBodyText'];
@@ -668,7 +675,8 @@ pre, code {
         final containsBlockedWebViewContent =
             item['containsBlockedWebViewContent'];
         final containsCidImages = item['containsCidImages'];
-        if (normalizedHtml is! String ||
+        if (key is! String ||
+            normalizedHtml is! String ||
             preparedFlutterHtml is! String ||
             visibleBodyText is! String ||
             isPlainTextHtml is! bool ||
@@ -677,7 +685,7 @@ pre, code {
             containsCidImages is! bool) {
           continue;
         }
-        _putEmailDerivation(_emailDerivationCacheKey(normalizedHtml), (
+        _putEmailDerivation(key, (
           preparedFlutterHtml: preparedFlutterHtml,
           visibleBodyText: visibleBodyText,
           isPlainTextHtml: isPlainTextHtml,
@@ -694,6 +702,45 @@ pre, code {
     return true;
   }
 
+  /// Content key the derivation cache and persisted prepared messages use
+  /// for [normalizedHtml]; it changes whenever the HTML does.
+  static String emailDerivationKey(String normalizedHtml) =>
+      _emailDerivationCacheKey(normalizedHtml);
+
+  /// Hashes [normalizedHtmlBodies] off the UI isolate so later lookups for
+  /// them are a map hit.
+  static Future<void> precomputeEmailDerivationKeys(
+    Iterable<String> normalizedHtmlBodies,
+  ) async {
+    final pending = <String>[
+      for (final normalizedHtml in normalizedHtmlBodies)
+        if (!_emailDerivationKeysByHtml.containsKey(normalizedHtml))
+          normalizedHtml,
+    ];
+    if (pending.isEmpty) {
+      return;
+    }
+    final keys = await compute(_emailDerivationKeysForCache, pending);
+    for (var index = 0; index < pending.length; index += 1) {
+      _rememberEmailDerivationKey(pending[index], keys[index]);
+    }
+  }
+
+  static EmailHtmlDerivation? cachedEmailDerivationForKey(String key) =>
+      _cachedEmailDerivationForKey(key);
+
+  /// Puts a derivation prepared earlier, for example one read back from
+  /// disk, into the in-memory cache.
+  static void restoreEmailDerivation(
+    String key,
+    EmailHtmlDerivation derivation,
+  ) {
+    if (_emailDerivationsByDigest.containsKey(key)) {
+      return;
+    }
+    _putEmailDerivation(key, derivation);
+  }
+
   static EmailHtmlDerivation? _cachedEmailDerivationForKey(String key) {
     final cached = _emailDerivationsByDigest.remove(key);
     if (cached == null) {
@@ -715,7 +762,8 @@ pre, code {
     );
     _emailDerivationCacheBytes += retainedBytes;
     while (_emailDerivationsByDigest.length > _maxEmailDerivationEntries ||
-        _emailDerivationCacheBytes > _maxEmailDerivationCacheBytes) {
+        _emailDerivationCacheBytes >
+            _maxEmailDerivationCacheBytes - _maxEmailDerivationKeyMemoBytes) {
       final removed = _emailDerivationsByDigest.remove(
         _emailDerivationsByDigest.keys.first,
       );
@@ -727,10 +775,39 @@ pre, code {
   }
 
   static String _emailDerivationCacheKey(String normalizedHtml) {
+    final remembered = _emailDerivationKeysByHtml[normalizedHtml];
+    if (remembered != null) {
+      return remembered;
+    }
+    final key = _computeEmailDerivationKey(normalizedHtml);
+    _rememberEmailDerivationKey(normalizedHtml, key);
+    return key;
+  }
+
+  static String _computeEmailDerivationKey(String normalizedHtml) {
     final digest = sha256.convert(utf8.encode(normalizedHtml));
     return '${normalizedHtml.length}:$digest';
   }
 
+  static void _rememberEmailDerivationKey(String normalizedHtml, String key) {
+    final retainedBytes = normalizedHtml.length + key.length;
+    if (retainedBytes > _maxEmailDerivationKeyMemoBytes) {
+      return;
+    }
+    final replaced = _emailDerivationKeysByHtml.remove(normalizedHtml);
+    if (replaced != null) {
+      _emailDerivationKeyMemoBytes -= normalizedHtml.length + replaced.length;
+    }
+    _emailDerivationKeysByHtml[normalizedHtml] = key;
+    _emailDerivationKeyMemoBytes += retainedBytes;
+    while (_emailDerivationKeysByHtml.length > _maxEmailDerivationEntries ||
+        _emailDerivationKeyMemoBytes > _maxEmailDerivationKeyMemoBytes) {
+      final oldest = _emailDerivationKeysByHtml.keys.first;
+      final removed = _emailDerivationKeysByHtml.remove(oldest)!;
+      _emailDerivationKeyMemoBytes -= oldest.length + removed.length;
+    }
+  }
+
   static int _emailDerivationRetainedBytes(
     String key,
     EmailHtmlDerivation derivation,
@@ -747,6 +824,8 @@ pre, code {
   static void resetEmailDerivationCacheForTesting() {
     _emailDerivationsByDigest.clear();
     _emailDerivationPrecacheKeys.clear();
+    _emailDerivationKeysByHtml.clear();
+    _emailDerivationKeyMemoBytes = 0;
     _emailDerivationCacheBytes = 0;
   }
 
@@ -4028,6 +4107,12 @@ class _HtmlNodeBudget {
   }
 }
 
+List<String> _emailDerivationKeysForCache(List<String> normalizedHtmlBodies) =>
+    <String>[
+      for (final normalizedHtml in normalizedHtmlBodies)
+        HtmlContentCodec._computeEmailDerivationKey(normalizedHtml),
+    ];
+
 List<Map<String, Object>> _deriveEmailHtmlDerivationsForCache(
   List<String> normalizedHtmlBodies,
 ) {
@@ -4038,6 +4123,7 @@ List<Map<String, Object>> _deriveEmailHtmlDerivationsForCache(
       allowRemoteImages: false,
     );
     derivations.add(<String, Object>{
+      'key': HtmlContentCodec._computeEmailDerivationKey(normalizedHtml),
       'normalizedHtml': normalizedHtml,
       'preparedFlutterHtml': preparedFlutterHtml,
       'visibleBodyText': HtmlContentCodec.toPlainText(
@@ -0,0 +1,186 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+// Copyright (C) 2025-present Eliot Lew, Axichat Developers
+
+import 'dart:async';
+import 'dart:io';
+import 'dart:isolate';
+import 'dart:math' as math;
+
+import 'package:logging/logging.dart';
+
+const int _keyedIsolatePoolMaxDefaultSize = 4;
+
+typedef KeyedIsolateTask<R> = FutureOr<R> Function();
+
+/// A fixed set of long-lived worker isolates. Every task carries a partition
+/// key; tasks with equal keys always run on the same worker in submission
+/// order, while tasks with different keys spread across the pool.
+///
+/// Tasks are closures and are copied to the worker when submitted, so they
+/// see a snapshot of whatever they capture. Top-level state touched by a task
+/// lives in the worker, which lets per-key state stay on one isolate.
+final class KeyedIsolatePool {
+  KeyedIsolatePool({int? size, this.debugName = 'keyed-isolate-pool'})
+    : size = math.max(1, size ?? defaultSize);
+
+  static final Logger _log = Logger('KeyedIsolatePool');
+
+  static int get defaultSize => math.max(
+    1,
+    math.min(_keyedIsolatePoolMaxDefaultSize, Platform.numberOfProcessors - 1),
+  );
+
+  final int size;
+  final String debugName;
+  late final List<_KeyedIsolateWorker> _workers = List.generate(
+    size,
+    (index) => _KeyedIsolateWorker('$debugName-$index'),
+  );
+  bool _closed = false;
+
+  int workerFor(Object key) => key.hashCode.abs() % size;
+
+  Future<R> run<R>(Object key, KeyedIsolateTask<R> task) {
+    if (_closed) {
+      throw StateError('$debugName is closed.');
+    }
+    return _workers[workerFor(key)].run(task);
+  }
+
+  Future<void> close() async {
+    if (_closed) return;
+    _closed = true;
+    await Future.wait(_workers.map((worker) => worker.close()));
+  }
+}
+
+final class _KeyedIsolateWorker {
+  _KeyedIsolateWorker(this.debugName);
+
+  final String debugName;
+  Future<SendPort>? _sendPort;
+  ReceivePort? _replies;
+  final Map<int, void Function(_KeyedIsolateResponse)> _pending =
+      <int, void Function(_KeyedIsolateResponse)>{};
+  int _nextTaskId = 0;
+
+  /// Completes once every task submitted so far has finished.
+  Future<void> _tail = Future<void>.value();
+
+  /// Serializes hand-off to the isolate so an inline fallback cannot be
+  /// overtaken by a later task.
+  Future<void> _sendTail = Future<void>.value();
+
+  Future<R> run<R>(KeyedIsolateTask<R> task) {
+    final previous = _tail;
+    final completer = Completer<R>();
+    _sendTail = _sendTail.then((_) => _send(task, completer, previous));
+    final result = completer.future;
+    _tail = result.then<void>((_) {}, onError: (Object _) {});
+    return result;
+  }
+
+  Future<void> _send<R>(
+    KeyedIsolateTask<R> task,
+    Completer<R> completer,
+    Future<void> previous,
+  ) async {
+    int? taskId;
+    try {
+      final sendPort = await (_sendPort ??= _spawn());
+      taskId = _nextTaskId++;
+      _pending[taskId] = (response) {
+        final error = response.error;
+        if (error != null) {
+          completer.completeError(error, error.stackTrace);
+        } else {
+          completer.complete(response.value as R);
+        }
+      };
+      sendPort.send(_KeyedIsolateRequest(taskId, task));
+      return;
+    } on ArgumentError catch (error) {
+      // The task captured something that cannot cross isolates. Run it here,
+      // after everything already queued on this worker.
+      _pending.remove(taskId);
+      KeyedIsolatePool._log.fine(
+        'Running task inline on $debugName; not sendable: ${error.message}',
+      );
+    } catch (error, stackTrace) {
+      completer.completeError(error, stackTrace);
+      return;
+    }
+    await previous;
+    try {
+      completer.complete(await task());
+    } catch (error, stackTrace) {
+      completer.completeError(error, stackTrace);
+    }
+  }
+
+  Future<SendPort> _spawn() async {
+    final replies = ReceivePort('$debugName-replies');
+    _replies = replies;
+    final ready = Completer<SendPort>();
+    replies.listen((message) {
+      switch (message) {
+        case SendPort port:
+          ready.complete(port);
+        case _KeyedIsolateResponse response:
+          _pending.remove(response.taskId)?.call(response);
+      }
+    });
+    await Isolate.spawn<SendPort>(
+      _keyedIsolateWorkerMain,
+      replies.sendPort,
+      debugName: debugName,
+    );
+    return ready.future;
+  }
+
+  Future<void> close() async {
+    await _tail;
+    final sendPort = await _sendPort;
+    sendPort?.send(null);
+    _replies?.close();
+    _replies = null;
+    _sendPort = null;
+  }
+}
+
+final class _KeyedIsolateRequest {
+  const _KeyedIsolateRequest(this.taskId, this.task);
+
+  final int taskId;
+  final KeyedIsolateTask<Object?> task;
+}
+
+final class _KeyedIsolateResponse {
+  const _KeyedIsolateResponse(this.taskId, {this.value, this.error});
+
+  final int taskId;
+  final Object? value;
+  final RemoteError? error;
+}
+
+Future<void> _keyedIsolateWorkerMain(SendPort replies) async {
+  final requests = ReceivePort();
+  replies.send(requests.sendPort);
+  await for (final message in requests) {
+    if (message is! _KeyedIsolateRequest) {
+      requests.close();
+      break;
+    }
+    try {
+      final value = await message.task();
+      replies.send(_KeyedIsolateResponse(message.taskId, value: value));
+    } catch (error, stackTrace) {
+      replies.send(
+        _KeyedIsolateResponse(
+          message.taskId,
+          error: RemoteError(error.toString(), stackTrace.toString()),
+        ),
+      );
+    }
+  }
+}
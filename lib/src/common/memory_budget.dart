@@ -0,0 +1,275 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+// Copyright (C) 2025-present Eliot Lew, Axichat Developers
+
+import 'dart:async';
+import 'dart:io';
+
+import 'package:flutter/foundation.dart';
+import 'package:flutter/widgets.dart';
+import 'package:logging/logging.dart';
+
+const int _defaultCacheBudgetBytes = 96 << 20;
+const int _defaultRssSoftLimitBytes = 768 << 20;
+const Duration _defaultSampleInterval = Duration(seconds: 30);
+const int _rssRetrimGrowthBytes = 32 << 20;
+
+enum MemoryPressure {
+  none,
+  moderate,
+  critical;
+
+  bool get isCritical => this == MemoryPressure.critical;
+}
+
+/// Shrinks a cache to at most `targetBytes`. Zero means drop everything.
+typedef MemoryBudgetTrim = void Function(int targetBytes);
+
+class MemoryCacheUsage {
+  const MemoryCacheUsage({required this.name, required this.bytes});
+
+  final String name;
+  final int bytes;
+}
+
+class MemoryBudgetSnapshot {
+  const MemoryBudgetSnapshot({
+    required this.caches,
+    required this.budgetBytes,
+    required this.rssBytes,
+    required this.rssSoftLimitBytes,
+    required this.lastPressure,
+    required this.trimCount,
+    required this.rssTrimStreak,
+    this.lastTrimAt,
+  });
+
+  static const empty = MemoryBudgetSnapshot(
+    caches: <MemoryCacheUsage>[],
+    budgetBytes: 0,
+    rssBytes: null,
+    rssSoftLimitBytes: 0,
+    lastPressure: MemoryPressure.none,
+    trimCount: 0,
+    rssTrimStreak: 0,
+  );
+
+  final List<MemoryCacheUsage> caches;
+  final int budgetBytes;
+  final int? rssBytes;
+  final int rssSoftLimitBytes;
+  final MemoryPressure lastPressure;
+  final int trimCount;
+
+  /// Resident-set trims since the resident set last dropped below its soft
+  /// limit. Above one, the excess is growing outside the registered caches.
+  final int rssTrimStreak;
+  final DateTime? lastTrimAt;
+
+  int get cacheBytes =>
+      caches.fold<int>(0, (total, cache) => total + cache.bytes);
+}
+
+class MemoryBudgetRegistration {
+  MemoryBudgetRegistration._(this._budget, this._entry);
+
+  final MemoryBudget _budget;
+  final _MemoryBudgetEntry _entry;
+
+  void unregister() => _budget._unregister(_entry);
+}
+
+class _MemoryBudgetEntry {
+  _MemoryBudgetEntry({
+    required this.name,
+    required this.sizeBytes,
+    required this.trim,
+  });
+
+  final String name;
+  final int Function() sizeBytes;
+  final MemoryBudgetTrim trim;
+}
+
+/// Process-wide accounting for in-memory caches.
+///
+/// Caches register a size getter and a trim callback. The combined size is
+/// held under [budgetBytes] by trimming every cache by the same fraction, and
+/// memory pressure (the platform's `didHaveMemoryPressure`, desktop low-memory
+/// warnings, or resident set size above [rssSoftLimitBytes]) halves or
+/// empties them regardless of the budget. Trimming caches rarely returns
+/// pages to the system right away, so a resident set that stays above the
+/// limit is only trimmed for again once it has grown further.
+class MemoryBudget with WidgetsBindingObserver {
+  MemoryBudget._({
+    this.budgetBytes = _defaultCacheBudgetBytes,
+    this.rssSoftLimitBytes = _defaultRssSoftLimitBytes,
+    this.sampleInterval = _defaultSampleInterval,
+  });
+
+  static final MemoryBudget instance = MemoryBudget._();
+
+  static final Logger _log = Logger('MemoryBudget');
+
+  final int budgetBytes;
+  final int rssSoftLimitBytes;
+  final Duration sampleInterval;
+
+  final List<_MemoryBudgetEntry> _entries = <_MemoryBudgetEntry>[];
+  final ValueNotifier<MemoryBudgetSnapshot> _usage =
+      ValueNotifier<MemoryBudgetSnapshot>(MemoryBudgetSnapshot.empty);
+  Timer? _sampleTimer;
+  MemoryPressure _lastPressure = MemoryPressure.none;
+  DateTime? _lastTrimAt;
+  int _trimCount = 0;
+  int? _rssAtLastRssTrim;
+  int _rssTrimStreak = 0;
+
+  /// Updated on every sample and trim; drives the diagnostics panel.
+  ValueListenable<MemoryBudgetSnapshot> get usage => _usage;
+
+  bool get isStarted => _sampleTimer != null;
+
+  MemoryBudgetRegistration register(
+    String name, {
+    required int Function() sizeBytes,
+    required MemoryBudgetTrim trim,
+  }) {
+    final entry = _MemoryBudgetEntry(
+      name: name,
+      sizeBytes: sizeBytes,
+      trim: trim,
+    );
+    _entries.add(entry);
+    return MemoryBudgetRegistration._(this, entry);
+  }
+
+  void _unregister(_MemoryBudgetEntry entry) {
+    _entries.remove(entry);
+  }
+
+  void start(WidgetsBinding binding) {
+    if (isStarted) return;
+    binding.addObserver(this);
+    _sampleTimer = Timer.periodic(sampleInterval, (_) => sample());
+    sample();
+  }
+
+  void stop(WidgetsBinding binding) {
+    binding.removeObserver(this);
+    _sampleTimer?.cancel();
+    _sampleTimer = null;
+  }
+
+  @override
+  void didHaveMemoryPressure() {
+    relieve(MemoryPressure.critical, reason: 'platform');
+  }
+
+  /// Enforces the cache budget and escalates to a moderate trim when the
+  /// process as a whole is above its resident set soft limit and has grown
+  /// since the last such trim.
+  MemoryBudgetSnapshot sample() {
+    final int? rss = _currentRss();
+    if (rss == null || rss <= rssSoftLimitBytes) {
+      _rssAtLastRssTrim = null;
+      _rssTrimStreak = 0;
+    } else if (_shouldTrimForRss(rss)) {
+      _rssAtLastRssTrim = rss;
+      _rssTrimStreak += 1;
+      if (_rssTrimStreak > 1) {
+        _log.warning(
+          'Resident set still above its soft limit after '
+          '${_rssTrimStreak - 1} cache trims: ${_mebibytes(rss)} MiB',
+        );
+      }
+      return relieve(MemoryPressure.moderate, reason: 'rss');
+    }
+    final int total = _cacheBytes();
+    if (total > budgetBytes) {
+      _trimProportionally(total, budgetBytes);
+      _recordTrim(MemoryPressure.none, reason: 'budget', before: total);
+    }
+    return _publish(rss: rss);
+  }
+
+  MemoryBudgetSnapshot relieve(
+    MemoryPressure pressure, {
+    required String reason,
+  }) {
+    if (pressure == MemoryPressure.none) {
+      return sample();
+    }
+    final int before = _cacheBytes();
+    for (final entry in List<_MemoryBudgetEntry>.of(_entries)) {
+      final int target = pressure.isCritical ? 0 : entry.sizeBytes() ~/ 2;
+      _trimEntry(entry, target);
+    }
+    _recordTrim(pressure, reason: reason, before: before);
+    return _publish(rss: _currentRss());
+  }
+
+  bool _shouldTrimForRss(int rss) {
+    final int? trimmedAt = _rssAtLastRssTrim;
+    return trimmedAt == null || rss - trimmedAt >= _rssRetrimGrowthBytes;
+  }
+
+  void _trimProportionally(int total, int target) {
+    for (final entry in List<_MemoryBudgetEntry>.of(_entries)) {
+      final int size = entry.sizeBytes();
+      if (size <= 0) continue;
+      _trimEntry(entry, size * target ~/ total);
+    }
+  }
+
+  void _trimEntry(_MemoryBudgetEntry entry, int targetBytes) {
+    try {
+      entry.trim(targetBytes);
+    } on Exception catch (error, stackTrace) {
+      _log.warning('Failed to trim ${entry.name}.', error, stackTrace);
+    }
+  }
+
+  void _recordTrim(
+    MemoryPressure pressure, {
+    required String reason,
+    required int before,
+  }) {
+    _lastPressure = pressure;
+    _lastTrimAt = DateTime.now();
+    _trimCount += 1;
+    _log.info(
+      'Trimmed caches ($reason, ${pressure.name}): '
+      '${_mebibytes(before)} -> ${_mebibytes(_cacheBytes())} MiB',
+    );
+  }
+
+  int _cacheBytes() {
+    var total = 0;
+    for (final entry in _entries) {
+      total += entry.sizeBytes();
+    }
+    return total;
+  }
+
+  MemoryBudgetSnapshot _publish({required int? rss}) {
+    final snapshot = MemoryBudgetSnapshot(
+      caches: List<MemoryCacheUsage>.unmodifiable(<MemoryCacheUsage>[
+        for (final entry in _entries)
+          MemoryCacheUsage(name: entry.name, bytes: entry.sizeBytes()),
+      ]),
+      budgetBytes: budgetBytes,
+      rssBytes: rss,
+      rssSoftLimitBytes: rssSoftLimitBytes,
+      lastPressure: _lastPressure,
+      trimCount: _trimCount,
+      rssTrimStreak: _rssTrimStreak,
+      lastTrimAt: _lastTrimAt,
+    );
+    _usage.value = snapshot;
+    return snapshot;
+  }
+
+  static int? _currentRss() => kIsWeb ? null : ProcessInfo.currentRss;
+
+  static String _mebibytes(int bytes) => (bytes / (1 << 20)).toStringAsFixed(1);
+}
@@ -0,0 +1,277 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+// Copyright (C) 2025-present Eliot Lew, Axichat Developers
+
+const int _hamtBitsPerLevel = 5;
+const int _hamtLevelMask = 0x1f;
+const int _hamtHashMask = 0x3fffffff;
+
+/// An immutable hash map with structural sharing. [put] and [remove] copy
+/// only the O(log32 n) nodes on the path to the key, so deriving a new
+/// version from a large map costs a handful of small allocations instead of
+/// a full copy, and older versions stay valid.
+///
+/// Iteration order follows key hashes, not insertion.
+final class PersistentHashMap<K, V> {
+  const PersistentHashMap.empty() : _root = null, length = 0;
+
+  const PersistentHashMap._(this._root, this.length);
+
+  factory PersistentHashMap.of(Map<K, V> source) {
+    var map = PersistentHashMap<K, V>.empty();
+    for (final entry in source.entries) {
+      map = map.put(entry.key, entry.value);
+    }
+    return map;
+  }
+
+  final Object? _root;
+  final int length;
+
+  bool get isEmpty => length == 0;
+
+  bool get isNotEmpty => length != 0;
+
+  V? operator [](Object? key) => _lookup(key)?.value;
+
+  bool containsKey(Object? key) => _lookup(key) != null;
+
+  PersistentHashMap<K, V> put(K key, V value) {
+    final change = _HamtChange();
+    final root = _put(
+      _root,
+      _HamtEntry<K, V>(_hash(key), key, value),
+      0,
+      change,
+    );
+    if (identical(root, _root)) {
+      return this;
+    }
+    return PersistentHashMap._(root, change.added ? length + 1 : length);
+  }
+
+  PersistentHashMap<K, V> remove(Object? key) {
+    final root = _remove(_root, key, _hash(key), 0);
+    if (identical(root, _root)) {
+      return this;
+    }
+    return PersistentHashMap._(root, length - 1);
+  }
+
+  Iterable<MapEntry<K, V>> get entries => _entries(_root);
+
+  Iterable<K> get keys => entries.map((entry) => entry.key);
+
+  Iterable<V> get values => entries.map((entry) => entry.value);
+
+  _HamtEntry<K, V>? _lookup(Object? key) {
+    final hash = _hash(key);
+    var node = _root;
+    var shift = 0;
+    while (true) {
+      switch (node) {
+        case null:
+          return null;
+        case _HamtEntry<K, V> entry:
+          return entry.hash == hash && entry.key == key ? entry : null;
+        case _HamtCollision<K, V> collision:
+          if (collision.hash != hash) return null;
+          for (final entry in collision.entries) {
+            if (entry.key == key) return entry;
+          }
+          return null;
+        case _HamtBranch branch:
+          final bit = 1 << ((hash >> shift) & _hamtLevelMask);
+          if (branch.bitmap & bit == 0) return null;
+          node = branch.children[_bitCount(branch.bitmap & (bit - 1))];
+          shift += _hamtBitsPerLevel;
+      }
+    }
+  }
+
+  static int _hash(Object? key) => key.hashCode & _hamtHashMask;
+
+  static Object _put<K, V>(
+    Object? node,
+    _HamtEntry<K, V> entry,
+    int shift,
+    _HamtChange change,
+  ) {
+    switch (node) {
+      case null:
+        change.added = true;
+        return entry;
+      case _HamtEntry<K, V> existing:
+        if (existing.hash == entry.hash && existing.key == entry.key) {
+          return identical(existing.value, entry.value) ? existing : entry;
+        }
+        change.added = true;
+        return _merge<K, V>(existing, entry, shift);
+      case _HamtCollision<K, V> collision:
+        if (collision.hash != entry.hash) {
+          final bit = 1 << ((collision.hash >> shift) & _hamtLevelMask);
+          return _put(
+            _HamtBranch(bit, <Object>[collision]),
+            entry,
+            shift,
+            change,
+          );
+        }
+        final entries = List<_HamtEntry<K, V>>.of(collision.entries);
+        final index = entries.indexWhere((item) => item.key == entry.key);
+        if (index == -1) {
+          change.added = true;
+          entries.add(entry);
+        } else if (identical(entries[index].value, entry.value)) {
+          return collision;
+        } else {
+          entries[index] = entry;
+        }
+        return _HamtCollision<K, V>(collision.hash, entries);
+      case _HamtBranch branch:
+        final bit = 1 << ((entry.hash >> shift) & _hamtLevelMask);
+        final index = _bitCount(branch.bitmap & (bit - 1));
+        if (branch.bitmap & bit == 0) {
+          change.added = true;
+          return _HamtBranch(
+            branch.bitmap | bit,
+            List<Object>.of(branch.children)..insert(index, entry),
+          );
+        }
+        final child = branch.children[index];
+        final next = _put(child, entry, shift + _hamtBitsPerLevel, change);
+        if (identical(next, child)) {
+          return branch;
+        }
+        return _HamtBranch(
+          branch.bitmap,
+          List<Object>.of(branch.children)..[index] = next,
+        );
+    }
+    throw StateError('Unknown node ${node.runtimeType}');
+  }
+
+  static Object _merge<K, V>(
+    _HamtEntry<K, V> left,
+    _HamtEntry<K, V> right,
+    int shift,
+  ) {
+    if (left.hash == right.hash) {
+      return _HamtCollision<K, V>(left.hash, <_HamtEntry<K, V>>[left, right]);
+    }
+    final leftIndex = (left.hash >> shift) & _hamtLevelMask;
+    final rightIndex = (right.hash >> shift) & _hamtLevelMask;
+    if (leftIndex == rightIndex) {
+      return _HamtBranch(1 << leftIndex, <Object>[
+        _merge<K, V>(left, right, shift + _hamtBitsPerLevel),
+      ]);
+    }
+    return _HamtBranch(
+      (1 << leftIndex) | (1 << rightIndex),
+      leftIndex < rightIndex ? <Object>[left, right] : <Object>[right, left],
+    );
+  }
+
+  /// Returns [node] when [key] is absent and null when the subtree empties.
+  static Object? _remove<K, V>(
+    Object? node,
+    Object? key,
+    int hash,
+    int shift,
+  ) {
+    switch (node) {
+      case null:
+        return null;
+      case _HamtEntry<K, V> entry:
+        return entry.hash == hash && entry.key == key ? null : entry;
+      case _HamtCollision<K, V> collision:
+        if (collision.hash != hash) return collision;
+        final index = collision.entries.indexWhere((item) => item.key == key);
+        if (index == -1) return collision;
+        if (collision.entries.length == 2) {
+          return collision.entries[1 - index];
+        }
+        return _HamtCollision<K, V>(
+          hash,
+          List<_HamtEntry<K, V>>.of(collision.entries)..removeAt(index),
+        );
+      case _HamtBranch branch:
+        final bit = 1 << ((hash >> shift) & _hamtLevelMask);
+        if (branch.bitmap & bit == 0) return branch;
+        final index = _bitCount(branch.bitmap & (bit - 1));
+        final child = branch.children[index];
+        final next = _remove<K, V>(
+          child,
+          key,
+          hash,
+          shift + _hamtBitsPerLevel,
+        );
+        if (identical(next, child)) return branch;
+        if (next == null) {
+          if (branch.children.length == 1) return null;
+          final children = List<Object>.of(branch.children)..removeAt(index);
+          if (children.length == 1 && children.single is! _HamtBranch) {
+            return children.single;
+          }
+          return _HamtBranch(branch.bitmap & ~bit, children);
+        }
+        if (branch.children.length == 1 && next is! _HamtBranch) {
+          return next;
+        }
+        return _HamtBranch(
+          branch.bitmap,
+          List<Object>.of(branch.children)..[index] = next,
+        );
+    }
+    throw StateError('Unknown node ${node.runtimeType}');
+  }
+
+  static Iterable<MapEntry<K, V>> _entries<K, V>(Object? node) sync* {
+    switch (node) {
+      case null:
+        return;
+      case _HamtEntry<K, V> entry:
+        yield MapEntry<K, V>(entry.key, entry.value);
+      case _HamtCollision<K, V> collision:
+        for (final entry in collision.entries) {
+          yield MapEntry<K, V>(entry.key, entry.value);
+        }
+      case _HamtBranch branch:
+        for (final child in branch.children) {
+          yield* _entries<K, V>(child);
+        }
+    }
+  }
+
+  static int _bitCount(int value) {
+    var count = value - ((value >> 1) & 0x55555555);
+    count = (count & 0x33333333) + ((count >> 2) & 0x33333333);
+    count = (count + (count >> 4)) & 0x0f0f0f0f;
+    return ((count * 0x01010101) & 0xffffffff) >> 24;
+  }
+}
+
+final class _HamtChange {
+  bool added = false;
+}
+
+final class _HamtEntry<K, V> {
+  const _HamtEntry(this.hash, this.key, this.value);
+
+  final int hash;
+  final K key;
+  final V value;
+}
+
+final class _HamtCollision<K, V> {
+  const _HamtCollision(this.hash, this.entries);
+
+  final int hash;
+  final List<_HamtEntry<K, V>> entries;
+}
+
+final class _HamtBranch {
+  const _HamtBranch(this.bitmap, this.children);
+
+  final int bitmap;
+  final List<Object> children;
+}
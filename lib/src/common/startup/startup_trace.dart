@@ -0,0 +1,326 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+// Copyright (C) 2025-present Eliot Lew, Axichat Developers
+
+// ignore_for_file: avoid_print
+
+import 'dart:async';
+import 'dart:convert';
+import 'dart:developer' as developer;
+import 'dart:io';
+
+import 'package:flutter/foundation.dart';
+import 'package:flutter/services.dart';
+import 'package:flutter/widgets.dart';
+import 'package:logging/logging.dart';
+
+enum StartupPhase {
+  dartMain('dart_main'),
+  storageReady('storage_ready'),
+  notificationsReady('notifications_ready'),
+  runApp('run_app'),
+  firstFrameRasterized('first_frame_rasterized'),
+  sqlcipherOpen('sqlcipher_open'),
+  warmStartLoaded('warm_start_loaded'),
+  deltaAccountsOpen('delta_accounts_open'),
+  chatListShown('chat_list_shown'),
+  chatListPainted('chat_list_painted');
+
+  const StartupPhase(this.traceName);
+
+  final String traceName;
+}
+
+@immutable
+final class StartupTraceMark {
+  const StartupTraceMark({
+    required this.name,
+    required this.timestampMicros,
+    required this.source,
+    this.durationMicros,
+  });
+
+  final String name;
+  final int timestampMicros;
+  final StartupTraceSource source;
+  final int? durationMicros;
+}
+
+enum StartupTraceSource {
+  native(1, 'native runner'),
+  dart(2, 'dart ui');
+
+  const StartupTraceSource(this.threadId, this.label);
+
+  final int threadId;
+  final String label;
+}
+
+@immutable
+final class StartupTraceSummary {
+  const StartupTraceSummary({
+    required this.timeToFirstFrame,
+    required this.timeToChatList,
+  });
+
+  final Duration? timeToFirstFrame;
+  final Duration? timeToChatList;
+
+  bool get reachedChatList => timeToChatList != null;
+
+  String toReportLine() {
+    String format(Duration? value) =>
+        value == null ? 'n/a' : (value.inMicroseconds / 1000).toStringAsFixed(1);
+    return 'startup-trace: '
+        'time_to_first_frame_ms=${format(timeToFirstFrame)} '
+        'time_to_chat_list_ms=${format(timeToChatList)}';
+  }
+}
+
+/// Collects startup phase marks from the native runner and the Dart side on
+/// one monotonic timeline.
+///
+/// Marks use [developer.Timeline.now], which reads the same `CLOCK_MONOTONIC`
+/// source as `g_get_monotonic_time` in the Linux runner, so native and Dart
+/// timestamps merge without rebasing.
+class StartupTrace {
+  StartupTrace({
+    MethodChannel? channel,
+    Map<String, String>? environment,
+    int Function()? clock,
+  }) : _channel = channel ?? const MethodChannel(_channelName),
+       _environment = environment,
+       _clock = clock ?? (() => developer.Timeline.now);
+
+  static const String _channelName = 'im.axi.axichat/startup_trace';
+  static const String outputPathEnvironmentKey = 'AXICHAT_STARTUP_TRACE';
+  static const String exitEnvironmentKey = 'AXICHAT_STARTUP_TRACE_EXIT';
+  static const String timeoutEnvironmentKey = 'AXICHAT_STARTUP_TRACE_TIMEOUT';
+  static const Duration _defaultTimeout = Duration(seconds: 60);
+  static const String _traceCategory = 'startup';
+  static final Logger _log = Logger('StartupTrace');
+
+  final MethodChannel _channel;
+  final Map<String, String>? _environment;
+  final int Function() _clock;
+  final List<StartupTraceMark> _marks = <StartupTraceMark>[];
+  final Map<StartupPhase, int> _openSpans = <StartupPhase, int>{};
+  final Set<StartupPhase> _recorded = <StartupPhase>{};
+  Timer? _timeout;
+  bool _finished = false;
+
+  List<StartupTraceMark> get marks => List.unmodifiable(_marks);
+
+  String? get _outputPath {
+    if (kIsWeb) return null;
+    final environment = _environment ?? Platform.environment;
+    final path = environment[outputPathEnvironmentKey]?.trim();
+    return path == null || path.isEmpty ? null : path;
+  }
+
+  bool get _exitWhenDone {
+    if (kIsWeb) return false;
+    final environment = _environment ?? Platform.environment;
+    return environment[exitEnvironmentKey] == '1';
+  }
+
+  Duration get _timeoutDuration {
+    if (kIsWeb) return _defaultTimeout;
+    final environment = _environment ?? Platform.environment;
+    final seconds = int.tryParse(environment[timeoutEnvironmentKey] ?? '');
+    return seconds == null || seconds <= 0
+        ? _defaultTimeout
+        : Duration(seconds: seconds);
+  }
+
+  /// Records [phase] once; later marks for the same phase are ignored so
+  /// reconnects and rebuilds do not skew the startup timeline.
+  void mark(StartupPhase phase) {
+    if (_finished || !_recorded.add(phase)) return;
+    _marks.add(
+      StartupTraceMark(
+        name: phase.traceName,
+        timestampMicros: _clock(),
+        source: StartupTraceSource.dart,
+      ),
+    );
+  }
+
+  void begin(StartupPhase phase) {
+    if (_finished || _recorded.contains(phase)) return;
+    _openSpans.putIfAbsent(phase, _clock);
+  }
+
+  void end(StartupPhase phase) {
+    final start = _openSpans.remove(phase);
+    if (start == null || !_recorded.add(phase)) return;
+    _marks.add(
+      StartupTraceMark(
+        name: phase.traceName,
+        timestampMicros: start,
+        source: StartupTraceSource.dart,
+        durationMicros: _clock() - start,
+      ),
+    );
+  }
+
+  Future<T> span<T>(StartupPhase phase, Future<T> Function() operation) async {
+    begin(phase);
+    try {
+      return await operation();
+    } finally {
+      end(phase);
+    }
+  }
+
+  /// Arms the on-demand export when [outputPathEnvironmentKey] is set and
+  /// starts the fallback timeout for sessions that never reach the chat list.
+  void start(WidgetsBinding binding) {
+    mark(StartupPhase.dartMain);
+    unawaited(
+      binding.waitUntilFirstFrameRasterized.then((_) {
+        mark(StartupPhase.firstFrameRasterized);
+      }),
+    );
+    if (_outputPath == null) return;
+    _timeout ??= Timer(_timeoutDuration, () => unawaited(finish()));
+  }
+
+  void markChatListShown() {
+    if (_finished || _recorded.contains(StartupPhase.chatListShown)) return;
+    mark(StartupPhase.chatListShown);
+    WidgetsBinding.instance.addPostFrameCallback((_) {
+      mark(StartupPhase.chatListPainted);
+      if (_outputPath != null) {
+        unawaited(finish());
+      }
+    });
+  }
+
+  Future<List<StartupTraceMark>> _loadNativeMarks() async {
+    if (kIsWeb) return const <StartupTraceMark>[];
+    try {
+      final raw = await _channel.invokeListMethod<Object?>('getNativeMarks');
+      if (raw == null) return const <StartupTraceMark>[];
+      final marks = <StartupTraceMark>[];
+      for (final entry in raw) {
+        if (entry is! Map) continue;
+        final name = entry['name'];
+        final timestamp = entry['timestampMicros'];
+        if (name is! String || timestamp is! int) continue;
+        marks.add(
+          StartupTraceMark(
+            name: name,
+            timestampMicros: timestamp,
+            source: StartupTraceSource.native,
+          ),
+        );
+      }
+      return marks;
+    } on MissingPluginException {
+      return const <StartupTraceMark>[];
+    } on PlatformException catch (error, stackTrace) {
+      _log.fine('Failed to read native startup marks.', error, stackTrace);
+      return const <StartupTraceMark>[];
+    }
+  }
+
+  Future<List<StartupTraceMark>> collect() async {
+    final merged = <StartupTraceMark>[...await _loadNativeMarks(), ..._marks]
+      ..sort((a, b) => a.timestampMicros.compareTo(b.timestampMicros));
+    return merged;
+  }
+
+  StartupTraceSummary summarize(List<StartupTraceMark> marks) {
+    if (marks.isEmpty) {
+      return const StartupTraceSummary(
+        timeToFirstFrame: null,
+        timeToChatList: null,
+      );
+    }
+    final origin = marks.first.timestampMicros;
+    int? timestampOf(String name) {
+      for (final mark in marks) {
+        if (mark.name == name) return mark.timestampMicros;
+      }
+      return null;
+    }
+
+    Duration? since(int? timestamp) =>
+        timestamp == null ? null : Duration(microseconds: timestamp - origin);
+
+    final firstFrame =
+        timestampOf(nativeFirstFrameMarkName) ??
+        timestampOf(StartupPhase.firstFrameRasterized.traceName);
+    final chatList = timestampOf(StartupPhase.chatListPainted.traceName);
+    return StartupTraceSummary(
+      timeToFirstFrame: since(firstFrame),
+      timeToChatList: since(chatList),
+    );
+  }
+
+  /// Chrome trace / Perfetto JSON for [marks].
+  String encodeChromeTrace(List<StartupTraceMark> marks) {
+    final processId = kIsWeb ? 0 : pid;
+    final events = <Map<String, Object?>>[
+      for (final source in StartupTraceSource.values)
+        <String, Object?>{
+          'name': 'thread_name',
+          'ph': 'M',
+          'pid': processId,
+          'tid': source.threadId,
+          'args': <String, Object?>{'name': source.label},
+        },
+      for (final mark in marks)
+        <String, Object?>{
+          'name': mark.name,
+          'cat': _traceCategory,
+          'ph': mark.durationMicros == null ? 'i' : 'X',
+          if (mark.durationMicros == null) 's': 'p',
+          if (mark.durationMicros != null) 'dur': mark.durationMicros,
+          'ts': mark.timestampMicros,
+          'pid': processId,
+          'tid': mark.source.threadId,
+        },
+    ];
+    return jsonEncode(<String, Object?>{
+      'traceEvents': events,
+      'displayTimeUnit': 'ms',
+    });
+  }
+
+  Future<StartupTraceSummary> writeTo(File file) async {
+    final marks = await collect();
+    await file.parent.create(recursive: true);
+    await file.writeAsString(encodeChromeTrace(marks), flush: true);
+    return summarize(marks);
+  }
+
+  /// Writes the configured trace once and, in headless CI mode, prints the
+  /// summary and exits with a status reflecting whether the chat list was
+  /// reached.
+  Future<void> finish() async {
+    final path = _outputPath;
+    if (_finished || path == null) return;
+    _finished = true;
+    _timeout?.cancel();
+    _timeout = null;
+    final StartupTraceSummary summary;
+    try {
+      summary = await writeTo(File(path));
+    } on FileSystemException catch (error, stackTrace) {
+      _log.warning('Failed to write startup trace.', error, stackTrace);
+      if (_exitWhenDone) exit(2);
+      return;
+    }
+    if (!_exitWhenDone) {
+      _log.info(summary.toReportLine());
+      return;
+    }
+    print(summary.toReportLine());
+    exit(summary.reachedChatList ? 0 : 1);
+  }
+
+  static const String nativeFirstFrameMarkName = 'native_first_frame';
+}
+
+final startupTrace = StartupTrace();
@@ -0,0 +1,222 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+// Copyright (C) 2025-present Eliot Lew, Axichat Developers
+
+import 'dart:math' as math;
+
+/// One contiguous replacement in a text buffer: [removed] at [start] became
+/// [inserted]. An edit only holds the characters it touched, so history and
+/// span bookkeeping stay proportional to the edit rather than the document.
+final class TextEdit {
+  const TextEdit({
+    required this.start,
+    required this.removed,
+    required this.inserted,
+  });
+
+  /// The smallest edit turning [before] into [after], found by trimming the
+  /// common prefix and suffix. Returns null when the strings are equal.
+  static TextEdit? between(String before, String after) {
+    if (identical(before, after)) return null;
+    final int limit = math.min(before.length, after.length);
+    var prefix = 0;
+    while (prefix < limit &&
+        before.codeUnitAt(prefix) == after.codeUnitAt(prefix)) {
+      prefix += 1;
+    }
+    if (prefix == before.length && prefix == after.length) return null;
+    var suffix = 0;
+    final int suffixLimit = limit - prefix;
+    while (suffix < suffixLimit &&
+        before.codeUnitAt(before.length - 1 - suffix) ==
+            after.codeUnitAt(after.length - 1 - suffix)) {
+      suffix += 1;
+    }
+    return TextEdit(
+      start: prefix,
+      removed: before.substring(prefix, before.length - suffix),
+      inserted: after.substring(prefix, after.length - suffix),
+    );
+  }
+
+  final int start;
+  final String removed;
+  final String inserted;
+
+  int get removedEnd => start + removed.length;
+
+  int get insertedEnd => start + inserted.length;
+
+  int get lengthDelta => inserted.length - removed.length;
+
+  String apply(String text) => text.replaceRange(start, removedEnd, inserted);
+
+  String revert(String text) => text.replaceRange(start, insertedEnd, removed);
+
+  /// Maps [offset] in the text before this edit to the text after it. An
+  /// offset strictly inside the removed range has no counterpart and maps
+  /// to null.
+  int? mapOffset(int offset) {
+    if (offset <= start) return offset;
+    if (offset >= removedEnd) return offset + lengthDelta;
+    return null;
+  }
+
+  /// Whether `[rangeStart, rangeEnd)` in the text before this edit touches
+  /// the replaced region, including ranges the edit extends at either end.
+  bool touches(int rangeStart, int rangeEnd) =>
+      rangeStart <= removedEnd && rangeEnd >= start;
+
+  /// Folds [next], applied right after this edit, into a single edit when
+  /// the two are adjacent: continued typing, backspacing into just-typed
+  /// text, or forward deletes at the same caret. Returns null otherwise.
+  TextEdit? followedBy(TextEdit next) {
+    if (next.removed.isEmpty && next.start == insertedEnd) {
+      return TextEdit(
+        start: start,
+        removed: removed,
+        inserted: inserted + next.inserted,
+      );
+    }
+    if (next.inserted.isEmpty &&
+        next.removedEnd == insertedEnd &&
+        next.start >= start) {
+      return TextEdit(
+        start: start,
+        removed: removed,
+        inserted: inserted.substring(0, next.start - start),
+      );
+    }
+    if (next.inserted.isEmpty && inserted.isEmpty) {
+      if (next.start == start) {
+        return TextEdit(
+          start: start,
+          removed: removed + next.removed,
+          inserted: '',
+        );
+      }
+      if (next.removedEnd == start) {
+        return TextEdit(
+          start: next.start,
+          removed: next.removed + removed,
+          inserted: '',
+        );
+      }
+    }
+    return null;
+  }
+
+  @override
+  bool operator ==(Object other) =>
+      other is TextEdit &&
+      other.start == start &&
+      other.removed == removed &&
+      other.inserted == inserted;
+
+  @override
+  int get hashCode => Object.hash(start, removed, inserted);
+}
+
+final class _TextEditEntry<S> {
+  _TextEditEntry({
+    required this.edit,
+    required this.before,
+    required this.after,
+    required this.startedAt,
+  });
+
+  TextEdit edit;
+  final S before;
+  S after;
+  final DateTime startedAt;
+}
+
+/// Undo and redo stacks of [TextEdit]s rather than document snapshots.
+///
+/// [S] is the editor state restored alongside the text, typically the
+/// selection. An edit adjacent to the previous one merges into its undo step
+/// while that step is younger than [coalesceWindow], so continuous typing
+/// undoes in chunks the way the framework's throttled history does.
+final class TextEditHistory<S> {
+  TextEditHistory({
+    this.maxEntries = 200,
+    this.coalesceWindow = const Duration(milliseconds: 500),
+  });
+
+  final int maxEntries;
+  final Duration coalesceWindow;
+
+  final List<_TextEditEntry<S>> _undo = <_TextEditEntry<S>>[];
+  final List<_TextEditEntry<S>> _redo = <_TextEditEntry<S>>[];
+  bool _sealed = true;
+
+  bool get canUndo => _undo.isNotEmpty;
+
+  bool get canRedo => _redo.isNotEmpty;
+
+  /// Characters held by both stacks; a measure of history memory.
+  int get retainedCodeUnits {
+    var total = 0;
+    for (final entry in _undo.followedBy(_redo)) {
+      total += entry.edit.removed.length + entry.edit.inserted.length;
+    }
+    return total;
+  }
+
+  void record(TextEdit edit, {required S before, required S after}) {
+    _redo.clear();
+    final DateTime now = DateTime.now();
+    final last = _undo.isEmpty ? null : _undo.last;
+    if (!_sealed &&
+        last != null &&
+        now.difference(last.startedAt) <= coalesceWindow) {
+      final merged = last.edit.followedBy(edit);
+      if (merged != null) {
+        last
+          ..edit = merged
+          ..after = after;
+        return;
+      }
+    }
+    _undo.add(
+      _TextEditEntry<S>(
+        edit: edit,
+        before: before,
+        after: after,
+        startedAt: now,
+      ),
+    );
+    _sealed = false;
+    if (_undo.length > maxEntries) {
+      _undo.removeAt(0);
+    }
+  }
+
+  /// Stops the next [record] from merging into the current undo step.
+  void seal() {
+    _sealed = true;
+  }
+
+  /// Reverts the latest edit on [text], which must be the text that edit
+  /// produced. Returns null when there is nothing to undo.
+  (String, S)? undo(String text) {
+    if (_undo.isEmpty) return null;
+    final entry = _undo.removeLast();
+    _redo.add(entry);
+    _sealed = true;
+    return (entry.edit.revert(text), entry.before);
+  }
+
+  (String, S)? redo(String text) {
+    if (_redo.isEmpty) return null;
+    final entry = _redo.removeLast();
+    _undo.add(entry);
+    _sealed = true;
+    return (entry.edit.apply(text), entry.after);
+  }
+
+  void clear() {
+    _undo.clear();
+    _redo.clear();
+    _sealed = true;
+  }
+}
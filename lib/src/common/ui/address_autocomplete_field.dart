@@ -9,7 +9,7 @@ import 'package:axichat/src/common/ui/ui.dart';
 import 'package:flutter/material.dart';
 import 'package:shadcn_ui/shadcn_ui.dart';
 
-class AddressAutocompleteField extends StatelessWidget {
+class AddressAutocompleteField extends StatefulWidget {
   const AddressAutocompleteField({
     super.key,
     required this.controller,
@@ -41,15 +41,37 @@ class AddressAutocompleteField extends StatelessWidget {
   final bool requireEmailAddress;
   final Object? tapRegionGroup;
 
+  @override
+  State<AddressAutocompleteField> createState() =>
+      _AddressAutocompleteFieldState();
+}
+
+class _AddressAutocompleteFieldState extends State<AddressAutocompleteField> {
+  final AddressAutocompleteIndex _addressIndex = AddressAutocompleteIndex();
+
+  @override
+  void initState() {
+    super.initState();
+    _addressIndex.sync(widget.knownAddresses);
+  }
+
+  @override
+  void didUpdateWidget(covariant AddressAutocompleteField oldWidget) {
+    super.didUpdateWidget(oldWidget);
+    if (!identical(oldWidget.knownAddresses, widget.knownAddresses)) {
+      _addressIndex.sync(widget.knownAddresses);
+    }
+  }
+
   @override
   Widget build(BuildContext context) {
     return RawAutocomplete<String>(
-      textEditingController: controller,
-      focusNode: focusNode,
+      textEditingController: widget.controller,
+      focusNode: widget.focusNode,
       displayStringForOption: (option) => option,
       onSelected: (value) {
-        onChanged(value);
-        focusNode.requestFocus();
+        widget.onChanged(value);
+        widget.focusNode.requestFocus();
       },
       optionsBuilder: (value) {
         if (value.text.trim().isEmpty) {
@@ -57,10 +79,10 @@ class AddressAutocompleteField extends StatelessWidget {
         }
         return addressAutocompleteSuggestions(
           input: value.text,
-          knownDomains: suggestionDomains,
-          knownAddresses: knownAddresses,
-          primaryDomain: primaryDomain,
-          requireEmailAddress: requireEmailAddress,
+          knownDomains: widget.suggestionDomains,
+          addressIndex: _addressIndex,
+          primaryDomain: widget.primaryDomain,
+          requireEmailAddress: widget.requireEmailAddress,
         );
       },
       optionsViewBuilder: (context, onSelected, options) =>
@@ -71,23 +93,23 @@ class AddressAutocompleteField extends StatelessWidget {
           mainAxisSize: MainAxisSize.min,
           children: [
             AxiTextInput(
-              groupId: tapRegionGroup,
+              groupId: widget.tapRegionGroup,
               controller: controller,
               focusNode: focusNode,
-              enabled: enabled,
+              enabled: widget.enabled,
               autocorrect: false,
               keyboardType: TextInputType.emailAddress,
               textCapitalization: TextCapitalization.none,
-              textInputAction: textInputAction,
-              placeholder: placeholder,
-              onChanged: onChanged,
-              onSubmitted: onSubmitted,
+              textInputAction: widget.textInputAction,
+              placeholder: widget.placeholder,
+              onChanged: widget.onChanged,
+              onSubmitted: widget.onSubmitted,
             ),
-            if (error != null)
+            if (widget.error != null)
               Padding(
                 padding: inputSubtextInsets,
                 child: Text(
-                  error!,
+                  widget.error!,
                   style: context.textTheme.small.copyWith(
                     color: context.colorScheme.destructive,
                   ),
@@ -6815,7 +6815,7 @@ class EditableTextState extends State<EditableText>
               debugLabel: kReleaseMode ? null : 'EditableText',
               child: MouseRegion(
                 cursor: widget.mouseCursor ?? SystemMouseCursors.text,
-                child: UndoHistory<TextEditingValue>(
+                child: AxiUndoHistory(
                   value: widget.controller,
                   onTriggered: (TextEditingValue value) {
                     userUpdateTextEditingValue(
@@ -6857,15 +6857,6 @@ class EditableTextState extends State<EditableText>
                         return oldValue.text != newValue.text ||
                             oldValue.composing != newValue.composing;
                       },
-                  undoStackModifier: (TextEditingValue value) {
-                    // On Android we should discard the composing region when pushing
-                    // a new entry to the undo stack. This prevents the TextInputPlugin
-                    // from restarting the input on every undo/redo when the composing
-                    // region is changed by the framework.
-                    return defaultTargetPlatform == TargetPlatform.android
-                        ? value.copyWith(composing: TextRange.empty)
-                        : value;
-                  },
                   focusNode: widget.focusNode,
                   controller: widget.undoController,
                   child: Focus(
@@ -10,12 +10,16 @@ class AxiProgressIndicator extends StatelessWidget {
     this.color,
     this.semanticsLabel,
     this.controller,
+    this.value,
   });
 
   final Color? color;
   final String? semanticsLabel;
   final AnimationController? controller;
 
+  /// Fraction complete; null spins indeterminately.
+  final double? value;
+
   @override
   Widget build(BuildContext context) {
     return Padding(
@@ -25,6 +29,7 @@ class AxiProgressIndicator extends StatelessWidget {
         child: CircularProgressIndicator(
           color: color ?? context.colorScheme.foreground,
           controller: controller,
+          value: value,
           semanticsLabel: semanticsLabel,
           strokeWidth: context.sizing.progressIndicatorStrokeWidth,
         ),
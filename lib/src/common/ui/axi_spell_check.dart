@@ -2,8 +2,7 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the assets/licenses/flutter_bsd.txt file.
 
-import 'dart:math' as math;
-
+import 'package:axichat/src/common/text_edit.dart';
 import 'package:flutter/foundation.dart';
 import 'package:flutter/painting.dart';
 import 'package:flutter/services.dart'
@@ -95,78 +94,35 @@ class SpellCheckConfiguration {
 
 // Methods for displaying spell check results:
 
+/// Carries [results] for [resultsText] over to [newText] through the single
+/// edit between them: spans before the edit keep their range, spans after it
+/// shift by the length change, and spans the edit touches are dropped until
+/// the next spell check pass. Cost is one prefix/suffix scan plus one pass
+/// over the spans, independent of how many words moved.
 List<SuggestionSpan> _correctSpellCheckResults(
   String newText,
   String resultsText,
   List<SuggestionSpan> results,
 ) {
+  final TextEdit? edit = TextEdit.between(resultsText, newText);
+  if (edit == null) {
+    return results;
+  }
   final List<SuggestionSpan> correctedSpellCheckResults = <SuggestionSpan>[];
-  int spanPointer = 0;
-  int offset = 0;
-
-  // Assumes that the order of spans has not been jumbled for optimization
-  // purposes, and will only search since the previously found span.
-  int searchStart = 0;
-
-  while (spanPointer < results.length) {
-    final SuggestionSpan currentSpan = results[spanPointer];
-    final String currentSpanText = resultsText.substring(
-      currentSpan.range.start,
-      currentSpan.range.end,
-    );
-    final int spanLength = currentSpan.range.end - currentSpan.range.start;
-
-    // Try finding SuggestionSpan from resultsText in new text.
-    final String escapedText = RegExp.escape(currentSpanText);
-    final RegExp currentSpanTextRegexp = RegExp('\\b$escapedText\\b');
-    final int foundIndex = newText
-        .substring(searchStart)
-        .indexOf(currentSpanTextRegexp);
-
-    // Check whether word was found exactly where expected or elsewhere in the newText.
-    final bool currentSpanFoundExactly =
-        currentSpan.range.start == foundIndex + searchStart;
-    final bool currentSpanFoundExactlyWithOffset =
-        currentSpan.range.start + offset == foundIndex + searchStart;
-    final bool currentSpanFoundElsewhere = foundIndex >= 0;
-
-    if (currentSpanFoundExactly || currentSpanFoundExactlyWithOffset) {
-      // currentSpan was found at the same index in newText and resultsText
-      // or at the same index with the previously calculated adjustment by
-      // the offset value, so apply it to new text by adding it to the list of
-      // corrected results.
-      final SuggestionSpan adjustedSpan = SuggestionSpan(
-        TextRange(
-          start: currentSpan.range.start + offset,
-          end: currentSpan.range.end + offset,
+  for (final SuggestionSpan span in results) {
+    if (span.range.end <= edit.start) {
+      correctedSpellCheckResults.add(span);
+    } else if (span.range.start > edit.removedEnd) {
+      correctedSpellCheckResults.add(
+        SuggestionSpan(
+          TextRange(
+            start: span.range.start + edit.lengthDelta,
+            end: span.range.end + edit.lengthDelta,
+          ),
+          span.suggestions,
         ),
-        currentSpan.suggestions,
       );
-
-      // Start search for the next misspelled word at the end of currentSpan.
-      searchStart = math.min(
-        currentSpan.range.end + 1 + offset,
-        newText.length,
-      );
-      correctedSpellCheckResults.add(adjustedSpan);
-    } else if (currentSpanFoundElsewhere) {
-      // Word was pushed forward but not modified.
-      final int adjustedSpanStart = searchStart + foundIndex;
-      final int adjustedSpanEnd = adjustedSpanStart + spanLength;
-      final SuggestionSpan adjustedSpan = SuggestionSpan(
-        TextRange(start: adjustedSpanStart, end: adjustedSpanEnd),
-        currentSpan.suggestions,
-      );
-
-      // Start search for the next misspelled word at the end of the
-      // adjusted currentSpan.
-      searchStart = math.min(adjustedSpanEnd + 1, newText.length);
-      // Adjust offset to reflect the difference between where currentSpan
-      // was positioned in resultsText versus in newText.
-      offset = adjustedSpanStart - currentSpan.range.start;
-      correctedSpellCheckResults.add(adjustedSpan);
     }
-    spanPointer++;
   }
   return correctedSpellCheckResults;
 }
@@ -0,0 +1,267 @@
+// Copyright 2014 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the assets/licenses/flutter_bsd.txt file.
+//
+// Modifications Copyright (C) 2025-present Eliot Lew, Axichat Developers.
+
+import 'package:axichat/src/common/text_edit.dart';
+import 'package:flutter/foundation.dart';
+import 'package:flutter/services.dart';
+import 'package:flutter/widgets.dart';
+
+/// [UndoHistory] for text, keeping [TextEdit]s instead of whole
+/// [TextEditingValue] snapshots.
+///
+/// Each accepted change is diffed against the last committed value, so a
+/// step costs the characters it touched rather than a copy of the document.
+/// Restored values carry the recorded selection and no composing region.
+class AxiUndoHistory extends StatefulWidget {
+  const AxiUndoHistory({
+    super.key,
+    required this.value,
+    required this.onTriggered,
+    required this.focusNode,
+    this.shouldChangeUndoStack,
+    this.controller,
+    required this.child,
+  });
+
+  final ValueNotifier<TextEditingValue> value;
+
+  /// Same contract as [UndoHistory.shouldChangeUndoStack]; rejected values
+  /// are folded into the next accepted one.
+  final bool Function(TextEditingValue? oldValue, TextEditingValue newValue)?
+  shouldChangeUndoStack;
+
+  final void Function(TextEditingValue value) onTriggered;
+
+  final FocusNode focusNode;
+
+  final UndoHistoryController? controller;
+
+  final Widget child;
+
+  @override
+  State<AxiUndoHistory> createState() => _AxiUndoHistoryState();
+}
+
+class _AxiUndoHistoryState extends State<AxiUndoHistory>
+    with UndoManagerClient {
+  final TextEditHistory<TextSelection> _history =
+      TextEditHistory<TextSelection>();
+
+  /// The value the top of the undo stack produced.
+  TextEditingValue? _committed;
+  TextEditingValue? _lastValue;
+
+  /// Every value the listener saw, accepted or not, so an undo restores the
+  /// caret from just before the edit rather than from the last commit.
+  TextEditingValue? _seen;
+  bool _duringTrigger = false;
+
+  UndoHistoryController? _controller;
+
+  UndoHistoryController get _effectiveController =>
+      widget.controller ?? (_controller ??= UndoHistoryController());
+
+  @override
+  bool get canUndo => _history.canUndo;
+
+  @override
+  bool get canRedo => _history.canRedo;
+
+  @override
+  void undo() {
+    _commitPending();
+    final committed = _committed;
+    if (committed == null) return;
+    _restore(_history.undo(committed.text));
+  }
+
+  @override
+  void redo() {
+    _commitPending();
+    final committed = _committed;
+    if (committed == null) return;
+    _restore(_history.redo(committed.text));
+  }
+
+  @override
+  void handlePlatformUndo(UndoDirection direction) {
+    switch (direction) {
+      case UndoDirection.undo:
+        undo();
+      case UndoDirection.redo:
+        redo();
+    }
+  }
+
+  void _undoFromIntent(UndoTextIntent intent) => undo();
+
+  void _redoFromIntent(RedoTextIntent intent) => redo();
+
+  void _push() {
+    final TextEditingValue value = widget.value.value;
+    final TextEditingValue? seen = _seen;
+    _seen = value;
+    if (_duringTrigger || value == _lastValue) return;
+    if (!(widget.shouldChangeUndoStack?.call(_lastValue, value) ?? true)) {
+      return;
+    }
+    _lastValue = value;
+    _commit(value, previous: seen);
+  }
+
+  void _commit(TextEditingValue value, {TextEditingValue? previous}) {
+    final TextEditingValue? committed = _committed;
+    _committed = value;
+    if (committed == null) return;
+    final TextEdit? edit = TextEdit.between(committed.text, value.text);
+    if (edit == null) return;
+    _history.record(
+      edit,
+      before: previous?.text == committed.text
+          ? previous!.selection
+          : committed.selection,
+      after: value.selection,
+    );
+    _updateState();
+  }
+
+  void _commitPending() {
+    final TextEditingValue value = widget.value.value;
+    if (_committed?.text == value.text) return;
+    _commit(value);
+    _history.seal();
+  }
+
+  void _restore((String, TextSelection)? result) {
+    if (result == null) return;
+    final (String text, TextSelection selection) = result;
+    final TextEditingValue value = TextEditingValue(
+      text: text,
+      selection: selection.isValid && selection.end <= text.length
+          ? selection
+          : TextSelection.collapsed(offset: text.length),
+    );
+    _committed = value;
+    _lastValue = value;
+    _seen = value;
+    _duringTrigger = true;
+    try {
+      widget.onTriggered(value);
+    } finally {
+      _duringTrigger = false;
+    }
+    _updateState();
+  }
+
+  void _reset() {
+    _history.clear();
+    _committed = null;
+    _lastValue = null;
+    _seen = null;
+    _push();
+    // Called from didUpdateWidget; listeners of the controller may rebuild.
+    WidgetsBinding.instance.addPostFrameCallback((_) {
+      if (mounted) _updateState();
+    });
+  }
+
+  void _updateState() {
+    _effectiveController.value = UndoHistoryValue(
+      canUndo: canUndo,
+      canRedo: canRedo,
+    );
+
+    if (defaultTargetPlatform != TargetPlatform.iOS) {
+      return;
+    }
+
+    if (UndoManager.client == this) {
+      UndoManager.setUndoState(canUndo: canUndo, canRedo: canRedo);
+    }
+  }
+
+  void _handleFocus() {
+    if (!widget.focusNode.hasFocus) {
+      if (UndoManager.client == this) {
+        UndoManager.client = null;
+      }
+      _history.seal();
+      return;
+    }
+    UndoManager.client = this;
+    _updateState();
+  }
+
+  @override
+  void initState() {
+    super.initState();
+    _push();
+    widget.value.addListener(_push);
+    _handleFocus();
+    widget.focusNode.addListener(_handleFocus);
+    _effectiveController.onUndo.addListener(undo);
+    _effectiveController.onRedo.addListener(redo);
+  }
+
+  @override
+  void didUpdateWidget(AxiUndoHistory oldWidget) {
+    super.didUpdateWidget(oldWidget);
+    if (widget.value != oldWidget.value) {
+      oldWidget.value.removeListener(_push);
+      widget.value.addListener(_push);
+      // Recorded edits only apply to the text they were taken from.
+      _reset();
+    }
+    if (widget.focusNode != oldWidget.focusNode) {
+      oldWidget.focusNode.removeListener(_handleFocus);
+      widget.focusNode.addListener(_handleFocus);
+    }
+    if (widget.controller != oldWidget.controller) {
+      final UndoHistoryController? previous =
+          oldWidget.controller ?? _controller;
+      previous?.onUndo.removeListener(undo);
+      previous?.onRedo.removeListener(redo);
+      _controller?.dispose();
+      _controller = null;
+      _effectiveController.onUndo.addListener(undo);
+      _effectiveController.onRedo.addListener(redo);
+    }
+  }
+
+  @override
+  void dispose() {
+    if (UndoManager.client == this) {
+      UndoManager.client = null;
+    }
+    widget.value.removeListener(_push);
+    widget.focusNode.removeListener(_handleFocus);
+    _effectiveController.onUndo.removeListener(undo);
+    _effectiveController.onRedo.removeListener(redo);
+    _controller?.dispose();
+    super.dispose();
+  }
+
+  @override
+  Widget build(BuildContext context) {
+    return Actions(
+      actions: <Type, Action<Intent>>{
+        UndoTextIntent: Action<UndoTextIntent>.overridable(
+          context: context,
+          defaultAction: CallbackAction<UndoTextIntent>(
+            onInvoke: _undoFromIntent,
+          ),
+        ),
+        RedoTextIntent: Action<RedoTextIntent>.overridable(
+          context: context,
+          defaultAction: CallbackAction<RedoTextIntent>(
+            onInvoke: _redoFromIntent,
+          ),
+        ),
+      },
+      child: widget.child,
+    );
+  }
+}
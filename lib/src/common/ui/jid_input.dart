@@ -8,7 +8,7 @@ import 'package:axichat/src/localization/localization_extensions.dart';
 import 'package:flutter/material.dart';
 import 'package:shadcn_ui/shadcn_ui.dart';
 
-class JidInput extends StatelessWidget {
+class JidInput extends StatefulWidget {
   const JidInput({
     super.key,
     required this.onChanged,
@@ -32,21 +32,42 @@ class JidInput extends StatelessWidget {
   final TextInputAction? textInputAction;
   final ValueChanged<String>? onSubmitted;
 
+  @override
+  State<JidInput> createState() => _JidInputState();
+}
+
+class _JidInputState extends State<JidInput> {
+  final AddressAutocompleteIndex _addressIndex = AddressAutocompleteIndex();
+
+  @override
+  void initState() {
+    super.initState();
+    _addressIndex.sync(widget.jidOptions);
+  }
+
+  @override
+  void didUpdateWidget(covariant JidInput oldWidget) {
+    super.didUpdateWidget(oldWidget);
+    if (!identical(oldWidget.jidOptions, widget.jidOptions)) {
+      _addressIndex.sync(widget.jidOptions);
+    }
+  }
+
   @override
   Widget build(BuildContext context) {
     return Autocomplete<String>(
-      initialValue: initialValue == null
+      initialValue: widget.initialValue == null
           ? null
-          : TextEditingValue(text: initialValue!),
-      onSelected: onChanged,
+          : TextEditingValue(text: widget.initialValue!),
+      onSelected: widget.onChanged,
       optionsBuilder: (value) {
         if (value.text.isEmpty) {
           return const <String>[];
         }
         return addressAutocompleteSuggestions(
           input: value.text,
-          knownDomains: suggestionDomains,
-          knownAddresses: jidOptions,
+          knownDomains: widget.suggestionDomains,
+          addressIndex: _addressIndex,
           requireEmailAddress: false,
         );
       },
@@ -82,8 +103,8 @@ class JidInput extends StatelessWidget {
           focusNode: focus,
           autocorrect: false,
           keyboardType: TextInputType.emailAddress,
-          textInputAction: textInputAction,
-          enabled: enabled,
+          textInputAction: widget.textInputAction,
+          enabled: widget.enabled,
           placeholder: Text(context.l10n.jidInputPlaceholder),
           // description: describe
           //     ? const Padding(
@@ -91,8 +112,8 @@ class JidInput extends StatelessWidget {
           //         child: Text('e.g: john@xmpp.social'),
           //       )
           //     : null,
-          onChanged: onChanged,
-          onSubmitted: onSubmitted,
+          onChanged: widget.onChanged,
+          onSubmitted: widget.onSubmitted,
           // validator: (text) {
           //   if (text.isEmpty) {
           //     return 'Enter a JID';
@@ -106,7 +127,7 @@ class JidInput extends StatelessWidget {
           // },
         );
         final errorText =
-            error ??
+            widget.error ??
             (!focus.hasFocus &&
                     controller.text.isNotEmpty &&
                     !AddressStringExtensions(controller.text).isValidJid
@@ -102,6 +102,8 @@ class _RecipientChipsBarState extends State<RecipientChipsBar>
   List<Chat> _availableAutocompleteChats = const <Chat>[];
   Set<String> _knownDomains = const <String>{};
   Set<String> _knownAddresses = const <String>{};
+  final AddressAutocompleteIndex _knownAddressIndex =
+      AddressAutocompleteIndex();
 
   @override
   void initState() {
@@ -130,6 +132,7 @@ class _RecipientChipsBarState extends State<RecipientChipsBar>
     _availableAutocompleteChats = pools.availableChats;
     _knownDomains = pools.domains;
     _knownAddresses = pools.addresses;
+    _knownAddressIndex.sync(_knownAddresses);
     _updateOwnJid(widget.selfJid);
   }
 
@@ -229,7 +232,6 @@ class _RecipientChipsBarState extends State<RecipientChipsBar>
     final barBackground = chipsBarBackground(context, colors);
     final availableAutocompleteChats = _availableAutocompleteChats;
     final knownDomains = _knownDomains;
-    final knownAddresses = _knownAddresses;
     const double autocompleteFieldOuterPadding = 8.0;
     const double autocompleteFieldInnerPadding = 12.0;
     final spacing = context.spacing;
@@ -411,7 +413,6 @@ class _RecipientChipsBarState extends State<RecipientChipsBar>
                             raw,
                             availableAutocompleteChats,
                             knownDomains,
-                            knownAddresses,
                             primaryDomain: primaryDomain,
                             shareTokenSignatureEnabled:
                                 shareTokenSignatureEnabled,
@@ -591,7 +592,7 @@ class _RecipientChipsBarState extends State<RecipientChipsBar>
     final pools = _computeSuggestionPools();
     if (listEquals(pools.availableChats, _availableAutocompleteChats) &&
         setEquals(pools.domains, _knownDomains) &&
-        setEquals(pools.addresses, _knownAddresses)) {
+        _sameAddressOrder(pools.addresses, _knownAddresses)) {
       return;
     }
     setState(() {
@@ -599,8 +600,14 @@ class _RecipientChipsBarState extends State<RecipientChipsBar>
       _knownDomains = pools.domains;
       _knownAddresses = pools.addresses;
     });
+    _knownAddressIndex.sync(_knownAddresses);
   }
 
+  /// Addresses are ordered by recency, so a bump that keeps the same set
+  /// still has to reach the index.
+  static bool _sameAddressOrder(Set<String> a, Set<String> b) =>
+      listEquals(a.toList(growable: false), b.toList(growable: false));
+
   KeyEventResult _handleKeyEvent(FocusNode node, KeyEvent event) {
     if (event is! KeyDownEvent) return KeyEventResult.ignored;
     if (event.logicalKey == LogicalKeyboardKey.arrowDown) {
@@ -985,8 +992,7 @@ class _RecipientChipsBarState extends State<RecipientChipsBar>
   Iterable<Contact> _autocompleteOptions(
     String raw,
     List<Chat> candidates,
-    Set<String> knownDomains,
-    Set<String> knownAddresses, {
+    Set<String> knownDomains, {
     required String primaryDomain,
     required bool shareTokenSignatureEnabled,
     required Set<String> excludedKeys,
@@ -1039,7 +1045,7 @@ class _RecipientChipsBarState extends State<RecipientChipsBar>
       for (final address in addressAutocompleteSuggestions(
         input: trimmed,
         knownDomains: knownDomains,
-        knownAddresses: knownAddresses,
+        addressIndex: _knownAddressIndex,
         excludedAddresses: excludedKeys,
         primaryDomain: primaryDomain,
         limit: maxSuggestions - results.length,
@@ -1062,7 +1068,7 @@ class _RecipientChipsBarState extends State<RecipientChipsBar>
     for (final address in addressAutocompleteSuggestions(
       input: trimmed,
       knownDomains: knownDomains,
-      knownAddresses: knownAddresses,
+      addressIndex: _knownAddressIndex,
       excludedAddresses: excludedKeys,
       primaryDomain: primaryDomain,
       limit: maxSuggestions - results.length,
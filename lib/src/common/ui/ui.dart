@@ -57,6 +57,7 @@ export 'axi_tab_bar.dart';
 export 'axi_tap_bounce.dart';
 export 'axi_editable_text.dart';
 export 'axi_text_selection.dart';
+export 'axi_undo_history.dart';
 export 'axi_text_field.dart';
 export 'axi_text_form_field.dart';
 export 'axi_text_input.dart';
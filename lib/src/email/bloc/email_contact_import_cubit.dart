@@ -6,6 +6,7 @@ import 'dart:io';
 import 'package:axichat/src/email/service/email_contact_import_service.dart';
 import 'package:axichat/src/email/service/email_service.dart';
 import 'package:bloc/bloc.dart';
+import 'package:delta_ffi/delta_safe.dart';
 import 'package:equatable/equatable.dart';
 
 part 'email_contact_import_state.dart';
@@ -31,6 +32,40 @@ class EmailContactImportCubit extends Cubit<EmailContactImportState> {
     }
   }
 
+  Future<void> inspectPublicKeyring(File file) async {
+    emit(const EmailContactImportInProgress());
+    try {
+      final List<DeltaOpenPgpKeyringEntry> keys = await _importService
+          .inspectPublicKeyring(file: file);
+      emit(
+        EmailContactImportKeyringConfirmationRequired(file: file, keys: keys),
+      );
+    } on EmailContactImportException catch (error) {
+      emit(EmailContactImportFailure(_failureReasonFor(error)));
+    }
+  }
+
+  Future<void> importPublicKeyring({
+    required File file,
+    required Set<String> confirmedFingerprints,
+  }) async {
+    if (confirmedFingerprints.isEmpty) {
+      reset();
+      return;
+    }
+    emit(const EmailContactImportInProgress());
+    try {
+      final EmailContactImportSummary summary = await _importService
+          .importPublicKeyring(
+            file: file,
+            confirmedFingerprints: confirmedFingerprints,
+          );
+      emit(EmailContactImportSuccess(summary));
+    } on EmailContactImportException catch (error) {
+      emit(EmailContactImportFailure(_failureReasonFor(error)));
+    }
+  }
+
   void reset() => emit(const EmailContactImportInitial());
 
   EmailContactImportFailureReason _failureReasonFor(
@@ -18,6 +18,20 @@ final class EmailContactImportInProgress extends EmailContactImportState {
   const EmailContactImportInProgress();
 }
 
+final class EmailContactImportKeyringConfirmationRequired
+    extends EmailContactImportState {
+  const EmailContactImportKeyringConfirmationRequired({
+    required this.file,
+    required this.keys,
+  });
+
+  final File file;
+  final List<DeltaOpenPgpKeyringEntry> keys;
+
+  @override
+  List<Object?> get props => [file.path, keys];
+}
+
 final class EmailContactImportSuccess extends EmailContactImportState {
   const EmailContactImportSuccess(this.summary);
 
@@ -5,10 +5,10 @@ import 'dart:async';
 import 'dart:io';
 import 'dart:isolate';
 
-import 'package:archive/archive_io.dart';
 import 'package:axichat/src/common/app_owned_storage.dart';
 import 'package:axichat/src/common/file_name_safety.dart';
 import 'package:axichat/src/email/models/email_attachment.dart';
+import 'package:axichat/src/email/service/streaming_zip.dart';
 import 'package:path/path.dart' as p;
 
 const String emailAttachmentBundleDirName = emailAttachmentTempDirectoryName;
@@ -256,12 +256,12 @@ Future<void> _writeBundle(Map<String, Object?> payload) async {
   if (rawFiles is! List) {
     throw const EmailAttachmentBundleInvalidPayloadException();
   }
-  final encoder = ZipFileEncoder()..create(rawPath);
+  final written = <String, StreamingZipEntry>{};
+  final writer = await StreamingZipWriter.create(rawPath);
   try {
     for (final entry in rawFiles) {
       final bundleEntry = _parseBundlePayloadEntry(entry);
       final filePath = bundleEntry.path;
-      final fileName = bundleEntry.name;
       final entityType = FileSystemEntity.typeSync(
         filePath,
         followLinks: false,
@@ -276,15 +276,20 @@ Future<void> _writeBundle(Map<String, Object?> payload) async {
       if (!file.existsSync()) {
         throw EmailAttachmentBundleMissingFileException(path: filePath);
       }
-      if (file.lengthSync() != bundleEntry.size) {
+      final zipEntry = await writer.addFile(file, bundleEntry.name);
+      // The size is re-checked against what was actually streamed so a file
+      // that changed after selection is rejected rather than half-bundled.
+      if (zipEntry.size != bundleEntry.size) {
         throw EmailAttachmentBundleInvalidArchiveException(path: filePath);
       }
-      await encoder.addFile(file, fileName);
+      written[zipEntry.name] = zipEntry;
     }
+  } on StreamingZipFormatException {
+    throw EmailAttachmentBundleInvalidArchiveException(path: rawPath);
   } finally {
-    await encoder.close();
+    await writer.close();
   }
-  _validateBundle(rawPath, rawFiles);
+  await _validateBundle(rawPath, rawFiles, written);
 }
 
 _BundlePayloadEntry _parseBundlePayloadEntry(Object? entry) {
@@ -306,52 +311,55 @@ _BundlePayloadEntry _parseBundlePayloadEntry(Object? entry) {
   return _BundlePayloadEntry(path: filePath, name: fileName, size: fileSize);
 }
 
-void _validateBundle(String zipPath, List<Object?> rawFiles) {
+/// Re-reads the finished archive through its central directory and streams
+/// every entry back through the CRC check, without holding any entry in
+/// memory.
+Future<void> _validateBundle(
+  String zipPath,
+  List<Object?> rawFiles,
+  Map<String, StreamingZipEntry> written,
+) async {
   if (rawFiles.isEmpty) {
     throw EmailAttachmentBundleInvalidArchiveException(path: zipPath);
   }
-  final Archive archive;
+  final StreamingZipReader reader;
   try {
-    archive = ZipDecoder().decodeBytes(File(zipPath).readAsBytesSync());
+    reader = await StreamingZipReader.open(zipPath);
   } on Exception {
     throw EmailAttachmentBundleInvalidArchiveException(path: zipPath);
   }
-  final archiveFiles = archive.files
-      .where((entry) => entry.isFile)
-      .toList(growable: false);
-  if (archiveFiles.length != rawFiles.length) {
-    throw EmailAttachmentBundleInvalidArchiveException(path: zipPath);
-  }
-  final filesByName = <String, ArchiveFile>{
-    for (final entry in archiveFiles) entry.name: entry,
-  };
-  if (filesByName.length != rawFiles.length) {
-    throw EmailAttachmentBundleInvalidArchiveException(path: zipPath);
-  }
-  for (final rawEntry in rawFiles) {
-    final expectedEntry = _parseBundlePayloadEntry(rawEntry);
-    final archiveEntry = filesByName[expectedEntry.name];
-    if (archiveEntry == null || archiveEntry.size != expectedEntry.size) {
+  try {
+    final archiveFiles = reader.entries
+        .where((entry) => entry.isFile)
+        .toList(growable: false);
+    if (archiveFiles.length != rawFiles.length) {
       throw EmailAttachmentBundleInvalidArchiveException(path: zipPath);
     }
-    final sourceBytes = File(expectedEntry.path).readAsBytesSync();
-    final archivedBytes = archiveEntry.content;
-    if (!_bytesEqual(sourceBytes, archivedBytes)) {
+    final filesByName = <String, StreamingZipEntry>{
+      for (final entry in archiveFiles) entry.name: entry,
+    };
+    if (filesByName.length != rawFiles.length) {
       throw EmailAttachmentBundleInvalidArchiveException(path: zipPath);
     }
-  }
-}
-
-bool _bytesEqual(List<int> left, List<int> right) {
-  if (left.length != right.length) {
-    return false;
-  }
-  for (var index = 0; index < left.length; index += 1) {
-    if (left[index] != right[index]) {
-      return false;
+    for (final rawEntry in rawFiles) {
+      final expectedEntry = _parseBundlePayloadEntry(rawEntry);
+      final archiveEntry = filesByName[expectedEntry.name];
+      final writtenEntry = written[expectedEntry.name];
+      if (archiveEntry == null ||
+          writtenEntry == null ||
+          archiveEntry.size != expectedEntry.size ||
+          archiveEntry.crc32 != writtenEntry.crc32) {
+        throw EmailAttachmentBundleInvalidArchiveException(path: zipPath);
+      }
+      await reader.openEntry(archiveEntry).drain<void>();
     }
+  } on StreamingZipFormatException {
+    throw EmailAttachmentBundleInvalidArchiveException(path: zipPath);
+  } on FileSystemException {
+    throw EmailAttachmentBundleInvalidArchiveException(path: zipPath);
+  } finally {
+    await reader.close();
   }
-  return true;
 }
 
 final class _BundlePayloadEntry {
@@ -10,6 +10,7 @@ import 'package:axichat/src/common/email_validation.dart';
 import 'package:axichat/src/email/service/delta_chat_exception.dart';
 import 'package:axichat/src/email/service/email_service.dart';
 import 'package:axichat/src/email/util/email_address.dart';
+import 'package:delta_ffi/delta_safe.dart';
 import 'package:path/path.dart' as p;
 
 const int _byteOrderMark = 0xfeff;
@@ -120,22 +121,49 @@ const Set<String> _nicknameHeaderKeys = <String>{
 const String _csvExtension = 'csv';
 const String _vcardExtension = 'vcf';
 const String _vcardAlternateExtension = 'vcard';
+const String _ascExtension = 'asc';
+const String _pgpExtension = 'pgp';
+const String _gpgExtension = 'gpg';
 const int _emptyCount = 0;
+const String _keyringDuplicateReason = 'duplicate_address';
+const String _keyringUnconfirmedReason = 'unconfirmed';
+const Set<String> _keyringInvalidReasons = <String>{
+  'invalid_key',
+  'no_encryption_capability',
+  'no_address',
+};
 const List<String> _csvExtensions = <String>[_csvExtension];
 const List<String> _vcardExtensions = <String>[
   _vcardExtension,
   _vcardAlternateExtension,
 ];
+const List<String> _keyringExtensions = <String>[
+  _ascExtension,
+  _pgpExtension,
+  _gpgExtension,
+];
 
-enum EmailContactImportFormat { gmail, outlook, yahoo, genericCsv, vcard }
+enum EmailContactImportFormat {
+  gmail,
+  outlook,
+  yahoo,
+  genericCsv,
+  vcard,
+  openPgpKeyring,
+}
 
 extension EmailContactImportFormatMetadata on EmailContactImportFormat {
   bool get isVcard => this == EmailContactImportFormat.vcard;
 
-  bool get isCsv => !isVcard;
+  bool get isOpenPgpKeyring => this == EmailContactImportFormat.openPgpKeyring;
+
+  bool get isCsv => !isVcard && !isOpenPgpKeyring;
 
-  List<String> get allowedExtensions =>
-      isVcard ? _vcardExtensions : _csvExtensions;
+  List<String> get allowedExtensions => switch (this) {
+    EmailContactImportFormat.vcard => _vcardExtensions,
+    EmailContactImportFormat.openPgpKeyring => _keyringExtensions,
+    _ => _csvExtensions,
+  };
 }
 
 enum EmailContactImportFailureReason {
@@ -253,6 +281,106 @@ class EmailContactImportService {
     return _importContacts(contacts);
   }
 
+  /// Lists the importable keys of an armored OpenPGP keyring (several public
+  /// keys in one file) so the user can confirm each identity before import.
+  Future<List<DeltaOpenPgpKeyringEntry>> inspectPublicKeyring({
+    required File file,
+  }) async {
+    if (!_emailService.hasActiveSession) {
+      throw const EmailContactImportNoEmailAccountException();
+    }
+    _validateFileExtension(
+      file,
+      format: EmailContactImportFormat.openPgpKeyring,
+    );
+    final List<DeltaOpenPgpKeyringEntry> entries;
+    try {
+      entries = await _emailService.inspectTrustedContactPublicKeyring(file);
+    } on EmailContactKeyNoActiveAccountException {
+      throw const EmailContactImportNoEmailAccountException();
+    } on EmailContactKeyUnsupportedFormatException {
+      throw const EmailContactImportUnsupportedFileTypeException();
+    } on EmailContactKeyException {
+      throw const EmailContactImportFailedException();
+    }
+    final List<DeltaOpenPgpKeyringEntry> usable = entries
+        .where(
+          (entry) =>
+              entry.reason == null &&
+              entry.fingerprint != null &&
+              entry.address != null,
+        )
+        .toList(growable: false);
+    if (usable.isEmpty) {
+      throw const EmailContactImportNoContactsException();
+    }
+    return usable;
+  }
+
+  /// Imports the keys of an armored OpenPGP keyring that the user confirmed
+  /// by fingerprint as trusted key contacts in a single native batch.
+  Future<EmailContactImportSummary> importPublicKeyring({
+    required File file,
+    required Set<String> confirmedFingerprints,
+  }) async {
+    if (!_emailService.hasActiveSession) {
+      throw const EmailContactImportNoEmailAccountException();
+    }
+    final List<DeltaOpenPgpKeyringEntry> entries;
+    try {
+      entries = (await _emailService.importTrustedContactPublicKeyring(
+        file,
+        confirmedFingerprints: confirmedFingerprints,
+      )).where((entry) => entry.reason != _keyringUnconfirmedReason).toList();
+    } on EmailContactKeyNoActiveAccountException {
+      throw const EmailContactImportNoEmailAccountException();
+    } on EmailContactKeyUnsupportedFormatException {
+      throw const EmailContactImportUnsupportedFileTypeException();
+    } on EmailContactKeyException {
+      throw const EmailContactImportFailedException();
+    }
+    if (entries.isEmpty) {
+      throw const EmailContactImportNoContactsException();
+    }
+    int duplicates = _startIndex;
+    int invalid = _startIndex;
+    int failed = _startIndex;
+    int imported = _startIndex;
+    for (final entry in entries) {
+      final String? reason = entry.reason;
+      if (entry.isImported) {
+        imported += _nextIndex;
+      } else if (reason == _keyringDuplicateReason) {
+        duplicates += _nextIndex;
+      } else if (_keyringInvalidReasons.contains(reason)) {
+        invalid += _nextIndex;
+      } else {
+        failed += _nextIndex;
+      }
+    }
+    if (imported > _startIndex) {
+      try {
+        await _emailService.syncContactsFromCore();
+      } on EmailServiceException {
+        throw const EmailContactImportFailedException();
+      } on EmailProvisioningException {
+        throw const EmailContactImportFailedException();
+      } on DeltaChatException {
+        throw const EmailContactImportFailedException();
+      }
+    }
+    if (imported == _startIndex && failed > _startIndex) {
+      throw const EmailContactImportFailedException();
+    }
+    return EmailContactImportSummary(
+      total: entries.length,
+      imported: imported,
+      duplicates: duplicates,
+      invalid: invalid,
+      failed: failed,
+    );
+  }
+
   void _validateFileExtension(
     File file, {
     required EmailContactImportFormat format,
@@ -917,6 +917,7 @@ class EmailService {
 
   static const int _defaultPageSize = 50;
   static const int _fanOutConcurrentOps = 4;
+  static const int _fanOutAttachmentBatchSize = 8;
   static const int _contactHydrationConcurrentOps = 6;
   static const int _attachmentFanOutWarningBytes = 8 * 1024 * 1024;
   static const int _deltaMessageIdUnset = DeltaMessageId.none;
@@ -2235,6 +2236,92 @@ class EmailService {
     }
   }
 
+  /// Lists the keys of an armored keyring file without importing any, so
+  /// the user can confirm each key's identity before it is trusted.
+  Future<List<DeltaOpenPgpKeyringEntry>> inspectTrustedContactPublicKeyring(
+    File source,
+  ) async {
+    await _ensureReady();
+    final account = await _requireActiveEncryptionAccountForContactKey();
+    try {
+      final armored = await _readArmoredPublicKeys(source);
+      return await _transport.inspectOpenPgpKeyring(
+        armoredKeyring: armored,
+        accountId: account.deltaAccountId,
+      );
+    } on EmailContactKeyException {
+      rethrow;
+    } on DeltaSafeException {
+      throw const EmailContactKeyUnsupportedFormatException();
+    } on FileSystemException {
+      throw const EmailContactKeyUnsupportedFormatException();
+    } on FormatException {
+      throw const EmailContactKeyUnsupportedFormatException();
+    }
+  }
+
+  /// Imports the keys of an armored keyring file whose fingerprints the user
+  /// confirmed, in one native call. A user ID is only the key owner's claim,
+  /// so no other key is imported. Keys that were skipped or failed keep
+  /// their native reason in the returned entries.
+  Future<List<DeltaOpenPgpKeyringEntry>> importTrustedContactPublicKeyring(
+    File source, {
+    required Set<String> confirmedFingerprints,
+  }) async {
+    await _ensureReady();
+    final account = await _requireActiveEncryptionAccountForContactKey();
+    try {
+      final armored = await _readArmoredPublicKeys(source);
+      final entries = await _transport.importContactPublicKeyring(
+        armoredKeyring: armored,
+        confirmedFingerprints: confirmedFingerprints.toList(growable: false),
+        accountId: account.deltaAccountId,
+      );
+      final importedAt = DateTime.timestamp();
+      final keys = <EmailTrustedContactKey>[];
+      for (final entry in entries) {
+        final normalized = normalizedAddressValue(entry.address ?? '');
+        final fingerprint = entry.fingerprint;
+        if (!entry.isImported ||
+            normalized == null ||
+            normalized.isEmpty ||
+            fingerprint == null ||
+            !confirmedFingerprints.contains(fingerprint) ||
+            entry.contactId! <= DeltaContactId.lastSpecial ||
+            entry.chatId! <= DeltaChatId.lastSpecial) {
+          continue;
+        }
+        keys.add(
+          EmailTrustedContactKey(
+            deltaAccountId: account.deltaAccountId,
+            normalizedAddress: normalized,
+            fingerprint: fingerprint,
+            deltaContactId: entry.contactId!,
+            deltaChatId: entry.chatId!,
+            identityBinding: EmailOpenPgpIdentityBinding.userConfirmed,
+            userIds: entry.userIds,
+            importedAt: importedAt,
+          ),
+        );
+      }
+      if (keys.isNotEmpty) {
+        final db = await _databaseBuilder();
+        await db.upsertEmailTrustedContactKeys(
+          keys.map((key) => key.toData()).toList(growable: false),
+        );
+      }
+      return entries;
+    } on EmailContactKeyException {
+      rethrow;
+    } on DeltaSafeException {
+      throw const EmailContactKeyImportFailedException();
+    } on FileSystemException {
+      throw const EmailContactKeyImportFailedException();
+    } on FormatException {
+      throw const EmailContactKeyImportFailedException();
+    }
+  }
+
   Future<void> removeTrustedContactPublicKey(String address) async {
     await _ensureReady();
     final account = await _requireActiveEncryptionAccountForContactKey();
@@ -4553,6 +4640,31 @@ class EmailService {
         existingShare?.originatorDcMsgId != null;
     int? originatorMsgId;
 
+    ({
+      String chatJid,
+      Chat chat,
+      FanOutRecipientState state,
+      int? msgId,
+      Object? error,
+    })
+    failedFor(Chat entry, Object error, StackTrace stackTrace) {
+      final targetId = entry.deltaChatId != null
+          ? 'dc-${entry.deltaChatId}'
+          : 'unresolved-recipient';
+      _log.warning(
+        'Failed to send fan-out message to $targetId',
+        error,
+        stackTrace,
+      );
+      return (
+        chatJid: entry.jid,
+        chat: entry,
+        state: FanOutRecipientState.failed,
+        msgId: null,
+        error: error,
+      );
+    }
+
     Future<
       ({
         String chatJid,
@@ -4567,43 +4679,21 @@ class EmailService {
         final binding = await _bindEmailChat(entry);
         final chatId = binding.deltaChatId;
         final mode = _outgoingEncryptionModeForAccount(binding.account);
-        int msgId;
-        if (hasAttachment) {
-          final updatedAttachment = attachment.copyWith(
-            caption: captionPayload.transmitText,
-          );
-          msgId = await _guardDeltaOperation(
-            operation: 'fan-out attachment',
-            body: () => _transport.sendAttachment(
-              chatId: chatId,
-              attachment: updatedAttachment,
-              subject: effectiveSubject,
-              shareId: effectiveShareId,
-              captionOverride: captionPayload.displayText,
-              htmlCaption: captionPayload.htmlBody,
-              quotingStanzaId: quotedStanzaId,
-              accountId: binding.deltaAccountId,
-              forcePlaintext: mode.forcePlaintext,
-              skipAutocrypt: mode.skipAutocrypt,
-            ),
-          );
-        } else {
-          msgId = await _guardDeltaOperation(
-            operation: 'fan-out message',
-            body: () => _transport.sendText(
-              chatId: chatId,
-              body: effectiveBodyPayload.transmitText,
-              subject: effectiveSubject,
-              shareId: effectiveShareId,
-              localBodyOverride: effectiveBodyPayload.displayText,
-              htmlBody: effectiveBodyPayload.htmlBody,
-              quotingStanzaId: quotedStanzaId,
-              accountId: binding.deltaAccountId,
-              forcePlaintext: mode.forcePlaintext,
-              skipAutocrypt: mode.skipAutocrypt,
-            ),
-          );
-        }
+        final msgId = await _guardDeltaOperation(
+          operation: 'fan-out message',
+          body: () => _transport.sendText(
+            chatId: chatId,
+            body: effectiveBodyPayload.transmitText,
+            subject: effectiveSubject,
+            shareId: effectiveShareId,
+            localBodyOverride: effectiveBodyPayload.displayText,
+            htmlBody: effectiveBodyPayload.htmlBody,
+            quotingStanzaId: quotedStanzaId,
+            accountId: binding.deltaAccountId,
+            forcePlaintext: mode.forcePlaintext,
+            skipAutocrypt: mode.skipAutocrypt,
+          ),
+        );
         return (
           chatJid: entry.jid,
           chat: binding.chat,
@@ -4612,22 +4702,136 @@ class EmailService {
           error: null,
         );
       } on Exception catch (error, stackTrace) {
-        final targetId = entry.deltaChatId != null
-            ? 'dc-${entry.deltaChatId}'
-            : 'unresolved-recipient';
-        _log.warning(
-          'Failed to send fan-out message to $targetId',
-          error,
-          stackTrace,
-        );
-        return (
-          chatJid: entry.jid,
-          chat: entry,
-          state: FanOutRecipientState.failed,
-          msgId: null,
-          error: error,
+        return failedFor(entry, error, stackTrace);
+      }
+    }
+
+    // Attachments go out in one transport call per account and encryption
+    // mode, batched so no single worker call queues too many copies; the file
+    // is attached once per batch rather than once per recipient, and core
+    // then only renders and encrypts each recipient's copy.
+    Future<
+      List<
+        ({
+          String chatJid,
+          Chat chat,
+          FanOutRecipientState state,
+          int? msgId,
+          Object? error,
+        })
+      >
+    >
+    sendAttachmentTo(List<Chat> entries, EmailAttachment attachment) async {
+      final resultsByJid =
+          <
+            String,
+            ({
+              String chatJid,
+              Chat chat,
+              FanOutRecipientState state,
+              int? msgId,
+              Object? error,
+            })
+          >{};
+      final groups =
+          <
+            (int, bool, bool),
+            List<({Chat entry, _EmailChatBinding binding})>
+          >{};
+      for (
+        var index = 0;
+        index < entries.length;
+        index += _fanOutConcurrentOps
+      ) {
+        final chunk = entries.skip(index).take(_fanOutConcurrentOps);
+        await Future.wait(
+          chunk.map((entry) async {
+            try {
+              final binding = await _bindEmailChat(entry);
+              final mode = _outgoingEncryptionModeForAccount(binding.account);
+              groups.putIfAbsent(
+                (
+                  binding.deltaAccountId,
+                  mode.forcePlaintext,
+                  mode.skipAutocrypt,
+                ),
+                () => <({Chat entry, _EmailChatBinding binding})>[],
+              ).add((entry: entry, binding: binding));
+            } on Exception catch (error, stackTrace) {
+              resultsByJid[entry.jid] = failedFor(entry, error, stackTrace);
+            }
+          }),
         );
       }
+      final updatedAttachment = attachment.copyWith(
+        caption: captionPayload.transmitText,
+      );
+      for (final MapEntry(
+            key: (accountId, forcePlaintext, skipAutocrypt),
+            value: members,
+          )
+          in groups.entries) {
+        for (
+          var index = 0;
+          index < members.length;
+          index += _fanOutAttachmentBatchSize
+        ) {
+          final group = members
+              .skip(index)
+              .take(_fanOutAttachmentBatchSize)
+              .toList(growable: false);
+          try {
+            final sent = await _guardDeltaOperation(
+              operation: 'fan-out attachment',
+              body: () => _transport.fanOutAttachment(
+                chatIds: [
+                  for (final bound in group) bound.binding.deltaChatId,
+                ],
+                attachment: updatedAttachment,
+                subject: effectiveSubject,
+                shareId: effectiveShareId,
+                captionOverride: captionPayload.displayText,
+                htmlCaption: captionPayload.htmlBody,
+                quotingStanzaId: quotedStanzaId,
+                accountId: accountId,
+                forcePlaintext: forcePlaintext,
+                skipAutocrypt: skipAutocrypt,
+              ),
+            );
+            final sentByChatId = <int, DeltaFanOutSendResult>{
+              for (final result in sent) result.chatId: result,
+            };
+            for (final (:entry, :binding) in group) {
+              final result = sentByChatId[binding.deltaChatId];
+              resultsByJid[entry.jid] = result != null && result.isSent
+                  ? (
+                      chatJid: entry.jid,
+                      chat: binding.chat,
+                      state: FanOutRecipientState.sent,
+                      msgId: result.msgId,
+                      error: null,
+                    )
+                  : failedFor(
+                      entry,
+                      DeltaChatExceptionMapper.fromCoreMessage(
+                        operation: 'fan-out attachment',
+                        message: result?.error,
+                      ),
+                      StackTrace.current,
+                    );
+            }
+          } on Exception catch (error, stackTrace) {
+            for (final bound in group) {
+              resultsByJid[bound.entry.jid] = failedFor(
+                bound.entry,
+                error,
+                stackTrace,
+              );
+            }
+          }
+        }
+      }
+      return [for (final entry in entries) resultsByJid[entry.jid]!];
     }
 
     final results =
@@ -4641,16 +4845,20 @@ class EmailService {
           })
         >[];
     final targetsToSend = targetChatsByJid.values.toList(growable: false);
-    for (
-      var index = 0;
-      index < targetsToSend.length;
-      index += _fanOutConcurrentOps
-    ) {
-      final chunk = targetsToSend
-          .skip(index)
-          .take(_fanOutConcurrentOps)
-          .toList();
-      results.addAll(await Future.wait(chunk.map(sendTo)));
+    if (hasAttachment) {
+      results.addAll(await sendAttachmentTo(targetsToSend, attachment));
+    } else {
+      for (
+        var index = 0;
+        index < targetsToSend.length;
+        index += _fanOutConcurrentOps
+      ) {
+        final chunk = targetsToSend
+            .skip(index)
+            .take(_fanOutConcurrentOps)
+            .toList();
+        results.addAll(await Future.wait(chunk.map(sendTo)));
+      }
     }
 
     for (final result in results) {
@@ -10766,6 +10974,14 @@ class EmailService {
   }
 
   Future<String> _readSingleArmoredPublicKey(File source) async {
+    final text = await _readArmoredPublicKeys(source);
+    if (_armorMarkerCount(text, _publicKeyArmorBegin) != 1) {
+      throw const EmailContactKeyUnsupportedFormatException();
+    }
+    return text;
+  }
+
+  Future<String> _readArmoredPublicKeys(File source) async {
     final sourceType = await FileSystemEntity.type(
       source.path,
       followLinks: false,
@@ -10781,8 +10997,7 @@ class EmailService {
     if (text.contains(_privateKeyArmorBegin)) {
       throw const EmailContactKeyUnsupportedFormatException();
     }
-    final publicBlockCount = _armorMarkerCount(text, _publicKeyArmorBegin);
-    if (publicBlockCount != 1) {
+    if (_armorMarkerCount(text, _publicKeyArmorBegin) == 0) {
       throw const EmailContactKeyUnsupportedFormatException();
     }
     return text;
@@ -0,0 +1,510 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+// Copyright (C) 2025-present Eliot Lew, Axichat Developers
+
+import 'dart:async';
+import 'dart:convert';
+import 'dart:io';
+import 'dart:math' as math;
+import 'dart:typed_data';
+
+import 'package:archive/archive.dart' show getCrc32;
+import 'package:path/path.dart' as p;
+
+/// Chunk size used for every read, write and (de)compression step, so peak
+/// memory stays bounded regardless of archive or entry size.
+const int streamingZipChunkSize = 64 * 1024;
+
+const int _localHeaderSignature = 0x04034b50;
+const int _centralHeaderSignature = 0x02014b50;
+const int _endOfCentralDirectorySignature = 0x06054b50;
+const int _localHeaderSize = 30;
+const int _centralHeaderSize = 46;
+const int _endOfCentralDirectorySize = 22;
+const int _maxCommentSize = 0xffff;
+const int _maxUint16 = 0xffff;
+const int _maxUint32 = 0xffffffff;
+const int _localHeaderCrcOffset = 14;
+const int _versionNeeded = 20;
+const int _versionMadeByUnix = (3 << 8) | _versionNeeded;
+const int _flagEncrypted = 0x0001;
+const int _flagUtf8Name = 0x0800;
+const int _methodStored = 0;
+const int _methodDeflated = 8;
+const int _unixFileTypeMask = 0xf000;
+const int _unixSymlinkType = 0xa000;
+const int _unixRegularFileMode = 0x81a4;
+const int _dosEpochYear = 1980;
+const int _maxCentralDirectoryBytes = 16 * 1024 * 1024;
+
+/// Extensions whose content is already compressed; deflating them again only
+/// burns CPU, so they are stored.
+const Set<String> _storedExtensions = <String>{
+  '.7z',
+  '.avif',
+  '.gif',
+  '.gz',
+  '.heic',
+  '.jpeg',
+  '.jpg',
+  '.m4a',
+  '.mkv',
+  '.mov',
+  '.mp3',
+  '.mp4',
+  '.ogg',
+  '.opus',
+  '.png',
+  '.webm',
+  '.webp',
+  '.xz',
+  '.zip',
+};
+
+final class StreamingZipFormatException extends FormatException {
+  const StreamingZipFormatException(super.message);
+}
+
+final class StreamingZipEntry {
+  const StreamingZipEntry({
+    required this.name,
+    required this.method,
+    required this.flags,
+    required this.crc32,
+    required this.compressedSize,
+    required this.size,
+    required this.localHeaderOffset,
+    required this.externalAttributes,
+    required this.versionMadeBy,
+  });
+
+  final String name;
+  final int method;
+  final int flags;
+  final int crc32;
+  final int compressedSize;
+  final int size;
+  final int localHeaderOffset;
+  final int externalAttributes;
+  final int versionMadeBy;
+
+  bool get isDirectory => name.endsWith('/');
+
+  bool get isFile => !isDirectory && !isSymbolicLink;
+
+  bool get isSymbolicLink =>
+      (versionMadeBy >> 8) == 3 &&
+      ((externalAttributes >> 16) & _unixFileTypeMask) == _unixSymlinkType;
+
+  bool get isEncrypted => flags & _flagEncrypted != 0;
+}
+
+/// Writes a zip archive entry by entry, streaming each source file through a
+/// bounded buffer. Local headers are patched in place once an entry's CRC and
+/// sizes are known, so no data descriptors are needed.
+final class StreamingZipWriter {
+  StreamingZipWriter._(this._file);
+
+  static Future<StreamingZipWriter> create(String path) async {
+    return StreamingZipWriter._(await File(path).open(mode: FileMode.write));
+  }
+
+  final RandomAccessFile _file;
+  final List<_CentralDirectoryRecord> _records = <_CentralDirectoryRecord>[];
+  final Uint8List _buffer = Uint8List(streamingZipChunkSize);
+  int _offset = 0;
+  bool _closed = false;
+
+  /// Appends [source] as [name] and returns the written entry.
+  Future<StreamingZipEntry> addFile(File source, String name) async {
+    if (_closed) {
+      throw StateError('StreamingZipWriter is closed');
+    }
+    if (_records.length >= _maxUint16) {
+      throw const StreamingZipFormatException('Too many zip entries');
+    }
+    final nameBytes = utf8.encode(name);
+    if (nameBytes.length > _maxUint16) {
+      throw const StreamingZipFormatException('Zip entry name too long');
+    }
+    final method = _storedExtensions.contains(p.extension(name).toLowerCase())
+        ? _methodStored
+        : _methodDeflated;
+    final dosTime = _DosTimestamp.from(await source.lastModified());
+    final headerOffset = _offset;
+    await _writeBytes(
+      _localHeader(
+        nameBytes: nameBytes,
+        method: method,
+        timestamp: dosTime,
+        crc32: 0,
+        compressedSize: 0,
+        size: 0,
+      ),
+    );
+
+    final deflater = method == _methodDeflated
+        ? RawZLibFilter.deflateFilter(raw: true)
+        : null;
+    var crc = 0;
+    var size = 0;
+    var compressedSize = 0;
+    final input = await source.open();
+    try {
+      while (true) {
+        final read = await input.readInto(_buffer);
+        if (read == 0) break;
+        final chunk = Uint8List.sublistView(_buffer, 0, read);
+        crc = getCrc32(chunk, crc);
+        size += read;
+        if (deflater == null) {
+          await _writeBytes(chunk);
+          compressedSize += read;
+        } else {
+          deflater.process(chunk, 0, read);
+          compressedSize += await _drainFilter(deflater, end: false);
+        }
+      }
+      if (deflater != null) {
+        deflater.process(const <int>[], 0, 0);
+        compressedSize += await _drainFilter(deflater, end: true);
+      }
+    } finally {
+      await input.close();
+    }
+    if (size > _maxUint32 || compressedSize > _maxUint32) {
+      throw const StreamingZipFormatException('Zip64 entries not supported');
+    }
+
+    await _file.setPosition(headerOffset + _localHeaderCrcOffset);
+    final patch = ByteData(12)
+      ..setUint32(0, crc, Endian.little)
+      ..setUint32(4, compressedSize, Endian.little)
+      ..setUint32(8, size, Endian.little);
+    await _file.writeFrom(patch.buffer.asUint8List());
+    await _file.setPosition(_offset);
+
+    final entry = StreamingZipEntry(
+      name: name,
+      method: method,
+      flags: _flagUtf8Name,
+      crc32: crc,
+      compressedSize: compressedSize,
+      size: size,
+      localHeaderOffset: headerOffset,
+      externalAttributes: _unixRegularFileMode << 16,
+      versionMadeBy: _versionMadeByUnix,
+    );
+    _records.add(
+      _CentralDirectoryRecord(
+        entry: entry,
+        nameBytes: nameBytes,
+        timestamp: dosTime,
+      ),
+    );
+    return entry;
+  }
+
+  Future<void> close() async {
+    if (_closed) return;
+    _closed = true;
+    try {
+      final centralDirectoryOffset = _offset;
+      for (final record in _records) {
+        await _writeBytes(_centralHeader(record));
+      }
+      final centralDirectorySize = _offset - centralDirectoryOffset;
+      if (centralDirectoryOffset > _maxUint32) {
+        throw const StreamingZipFormatException('Zip64 archives not supported');
+      }
+      final end = ByteData(_endOfCentralDirectorySize)
+        ..setUint32(0, _endOfCentralDirectorySignature, Endian.little)
+        ..setUint16(8, _records.length, Endian.little)
+        ..setUint16(10, _records.length, Endian.little)
+        ..setUint32(12, centralDirectorySize, Endian.little)
+        ..setUint32(16, centralDirectoryOffset, Endian.little);
+      await _writeBytes(end.buffer.asUint8List());
+      await _file.flush();
+    } finally {
+      await _file.close();
+    }
+  }
+
+  Future<void> _writeBytes(List<int> bytes) async {
+    await _file.writeFrom(bytes);
+    _offset += bytes.length;
+  }
+
+  Future<int> _drainFilter(RawZLibFilter filter, {required bool end}) async {
+    var written = 0;
+    while (true) {
+      final out = filter.processed(flush: false, end: end);
+      if (out == null) break;
+      await _writeBytes(out);
+      written += out.length;
+    }
+    return written;
+  }
+}
+
+/// Reads a zip archive through its central directory without loading it into
+/// memory. Entry data is decompressed in chunks and checked against the
+/// recorded CRC-32 and size as it streams.
+final class StreamingZipReader {
+  StreamingZipReader._(this._file, this.entries);
+
+  static Future<StreamingZipReader> open(String path) async {
+    final file = await File(path).open();
+    try {
+      final entries = await _readCentralDirectory(file);
+      return StreamingZipReader._(file, List.unmodifiable(entries));
+    } on Object {
+      await file.close();
+      rethrow;
+    }
+  }
+
+  final RandomAccessFile _file;
+  final List<StreamingZipEntry> entries;
+
+  /// Streams the uncompressed content of [entry]. Entries must be read one at
+  /// a time since they share the underlying file handle.
+  Stream<List<int>> openEntry(StreamingZipEntry entry) async* {
+    if (entry.isEncrypted) {
+      throw const StreamingZipFormatException('Encrypted zip entry');
+    }
+    if (entry.method != _methodStored && entry.method != _methodDeflated) {
+      throw const StreamingZipFormatException('Unsupported zip method');
+    }
+    await _file.setPosition(entry.localHeaderOffset);
+    final header = await _readExactly(_file, _localHeaderSize);
+    final headerData = ByteData.sublistView(header);
+    if (headerData.getUint32(0, Endian.little) != _localHeaderSignature) {
+      throw const StreamingZipFormatException('Invalid local header');
+    }
+    final nameLength = headerData.getUint16(26, Endian.little);
+    final extraLength = headerData.getUint16(28, Endian.little);
+    await _file.setPosition(
+      entry.localHeaderOffset + _localHeaderSize + nameLength + extraLength,
+    );
+
+    final inflater = entry.method == _methodDeflated
+        ? RawZLibFilter.inflateFilter(raw: true)
+        : null;
+    final buffer = Uint8List(streamingZipChunkSize);
+    var remaining = entry.compressedSize;
+    var crc = 0;
+    var produced = 0;
+    List<int> account(List<int> chunk) {
+      produced += chunk.length;
+      if (produced > entry.size) {
+        throw const StreamingZipFormatException('Zip entry larger than stated');
+      }
+      crc = getCrc32(chunk, crc);
+      return chunk;
+    }
+
+    while (remaining > 0) {
+      final read = await _file.readInto(
+        buffer,
+        0,
+        math.min(buffer.length, remaining),
+      );
+      if (read == 0) {
+        throw const StreamingZipFormatException('Truncated zip entry');
+      }
+      remaining -= read;
+      if (inflater == null) {
+        yield account(buffer.sublist(0, read));
+        continue;
+      }
+      inflater.process(buffer, 0, read);
+      while (true) {
+        final out = inflater.processed(flush: false);
+        if (out == null) break;
+        yield account(out);
+      }
+    }
+    if (inflater != null) {
+      inflater.process(const <int>[], 0, 0);
+      while (true) {
+        final out = inflater.processed(flush: false, end: true);
+        if (out == null) break;
+        yield account(out);
+      }
+    }
+    if (produced != entry.size || crc != entry.crc32) {
+      throw const StreamingZipFormatException('Zip entry checksum mismatch');
+    }
+  }
+
+  Future<void> close() => _file.close();
+}
+
+final class _CentralDirectoryRecord {
+  const _CentralDirectoryRecord({
+    required this.entry,
+    required this.nameBytes,
+    required this.timestamp,
+  });
+
+  final StreamingZipEntry entry;
+  final List<int> nameBytes;
+  final _DosTimestamp timestamp;
+}
+
+final class _DosTimestamp {
+  const _DosTimestamp(this.time, this.date);
+
+  factory _DosTimestamp.from(DateTime value) {
+    final local = value.toLocal();
+    if (local.year < _dosEpochYear) {
+      return const _DosTimestamp(0, (1 << 5) | 1);
+    }
+    final time =
+        (local.hour << 11) | (local.minute << 5) | (local.second ~/ 2);
+    final date =
+        ((local.year - _dosEpochYear) << 9) | (local.month << 5) | local.day;
+    return _DosTimestamp(time, date);
+  }
+
+  final int time;
+  final int date;
+}
+
+Uint8List _localHeader({
+  required List<int> nameBytes,
+  required int method,
+  required _DosTimestamp timestamp,
+  required int crc32,
+  required int compressedSize,
+  required int size,
+}) {
+  final header = ByteData(_localHeaderSize + nameBytes.length)
+    ..setUint32(0, _localHeaderSignature, Endian.little)
+    ..setUint16(4, _versionNeeded, Endian.little)
+    ..setUint16(6, _flagUtf8Name, Endian.little)
+    ..setUint16(8, method, Endian.little)
+    ..setUint16(10, timestamp.time, Endian.little)
+    ..setUint16(12, timestamp.date, Endian.little)
+    ..setUint32(14, crc32, Endian.little)
+    ..setUint32(18, compressedSize, Endian.little)
+    ..setUint32(22, size, Endian.little)
+    ..setUint16(26, nameBytes.length, Endian.little)
+    ..setUint16(28, 0, Endian.little);
+  final bytes = header.buffer.asUint8List();
+  bytes.setRange(_localHeaderSize, bytes.length, nameBytes);
+  return bytes;
+}
+
+Uint8List _centralHeader(_CentralDirectoryRecord record) {
+  final entry = record.entry;
+  final nameBytes = record.nameBytes;
+  final header = ByteData(_centralHeaderSize + nameBytes.length)
+    ..setUint32(0, _centralHeaderSignature, Endian.little)
+    ..setUint16(4, entry.versionMadeBy, Endian.little)
+    ..setUint16(6, _versionNeeded, Endian.little)
+    ..setUint16(8, entry.flags, Endian.little)
+    ..setUint16(10, entry.method, Endian.little)
+    ..setUint16(12, record.timestamp.time, Endian.little)
+    ..setUint16(14, record.timestamp.date, Endian.little)
+    ..setUint32(16, entry.crc32, Endian.little)
+    ..setUint32(20, entry.compressedSize, Endian.little)
+    ..setUint32(24, entry.size, Endian.little)
+    ..setUint16(28, nameBytes.length, Endian.little)
+    ..setUint32(38, entry.externalAttributes, Endian.little)
+    ..setUint32(42, entry.localHeaderOffset, Endian.little);
+  final bytes = header.buffer.asUint8List();
+  bytes.setRange(_centralHeaderSize, bytes.length, nameBytes);
+  return bytes;
+}
+
+Future<List<StreamingZipEntry>> _readCentralDirectory(
+  RandomAccessFile file,
+) async {
+  final length = await file.length();
+  if (length < _endOfCentralDirectorySize) {
+    throw const StreamingZipFormatException('Not a zip archive');
+  }
+  final tailLength = math.min(
+    length,
+    _endOfCentralDirectorySize + _maxCommentSize,
+  );
+  await file.setPosition(length - tailLength);
+  final tail = await _readExactly(file, tailLength);
+  final tailData = ByteData.sublistView(tail);
+  var endOffset = -1;
+  for (
+    var index = tailLength - _endOfCentralDirectorySize;
+    index >= 0;
+    index -= 1
+  ) {
+    if (tailData.getUint32(index, Endian.little) ==
+        _endOfCentralDirectorySignature) {
+      endOffset = index;
+      break;
+    }
+  }
+  if (endOffset < 0) {
+    throw const StreamingZipFormatException('Missing end of central directory');
+  }
+  final entryCount = tailData.getUint16(endOffset + 10, Endian.little);
+  final directorySize = tailData.getUint32(endOffset + 12, Endian.little);
+  final directoryOffset = tailData.getUint32(endOffset + 16, Endian.little);
+  final absoluteEndOffset = length - tailLength + endOffset;
+  if (directoryOffset + directorySize > absoluteEndOffset ||
+      directorySize > _maxCentralDirectoryBytes) {
+    throw const StreamingZipFormatException('Invalid central directory');
+  }
+
+  await file.setPosition(directoryOffset);
+  final directory = await _readExactly(file, directorySize);
+  final data = ByteData.sublistView(directory);
+  final entries = <StreamingZipEntry>[];
+  var cursor = 0;
+  for (var index = 0; index < entryCount; index += 1) {
+    if (cursor + _centralHeaderSize > directory.length ||
+        data.getUint32(cursor, Endian.little) != _centralHeaderSignature) {
+      throw const StreamingZipFormatException('Invalid central header');
+    }
+    final nameLength = data.getUint16(cursor + 28, Endian.little);
+    final extraLength = data.getUint16(cursor + 30, Endian.little);
+    final commentLength = data.getUint16(cursor + 32, Endian.little);
+    final nameStart = cursor + _centralHeaderSize;
+    final next = nameStart + nameLength + extraLength + commentLength;
+    if (next > directory.length) {
+      throw const StreamingZipFormatException('Invalid central header');
+    }
+    final localHeaderOffset = data.getUint32(cursor + 42, Endian.little);
+    final compressedSize = data.getUint32(cursor + 20, Endian.little);
+    if (localHeaderOffset + _localHeaderSize + compressedSize >
+        directoryOffset) {
+      throw const StreamingZipFormatException('Zip entry out of bounds');
+    }
+    entries.add(
+      StreamingZipEntry(
+        name: utf8.decode(
+          directory.sublist(nameStart, nameStart + nameLength),
+          allowMalformed: true,
+        ),
+        versionMadeBy: data.getUint16(cursor + 4, Endian.little),
+        flags: data.getUint16(cursor + 8, Endian.little),
+        method: data.getUint16(cursor + 10, Endian.little),
+        crc32: data.getUint32(cursor + 16, Endian.little),
+        compressedSize: compressedSize,
+        size: data.getUint32(cursor + 24, Endian.little),
+        externalAttributes: data.getUint32(cursor + 38, Endian.little),
+        localHeaderOffset: localHeaderOffset,
+      ),
+    );
+    cursor = next;
+  }
+  return entries;
+}
+
+Future<Uint8List> _readExactly(RandomAccessFile file, int length) async {
+  final bytes = await file.read(length);
+  if (bytes.length != length) {
+    throw const StreamingZipFormatException('Truncated zip archive');
+  }
+  return bytes;
+}
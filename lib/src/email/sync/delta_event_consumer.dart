@@ -16,6 +16,7 @@ import 'package:axichat/src/common/safe_logging.dart';
 import 'package:axichat/src/common/synthetic_forward.dart';
 import 'package:axichat/src/common/transport.dart';
 import 'package:axichat/src/email/service/delta_error_mapper.dart';
+import 'package:axichat/src/email/sync/delta_event_replay.dart';
 import 'package:axichat/src/email/util/async_queue.dart';
 import 'package:axichat/src/email/util/email_address.dart';
 import 'package:axichat/src/email/util/email_header_safety.dart'
@@ -821,7 +822,7 @@ class DeltaEventConsumer {
     Future<T> Function<T>(Future<T> Function() operation)?
     databaseOperationTracker,
   }) : _databaseBuilder = databaseBuilder,
-       _core = core,
+       _core = RecordingDeltaEventCore.wrapIfEnabled(core),
        _localizationsProvider = localizationsProvider,
        _selfJidProvider = selfJidProvider,
        _xmppSelfJidProvider = xmppSelfJidProvider,
@@ -1322,6 +1323,10 @@ class DeltaEventConsumer {
   }
 
   Future<void> handle(DeltaCoreEvent event) {
+    final core = _core;
+    if (core is RecordingDeltaEventCore) {
+      core.recordEvent(event);
+    }
     return _eventQueue.run(() => _handleSerialized(event));
   }
 
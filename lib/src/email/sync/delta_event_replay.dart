@@ -0,0 +1,835 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+// Copyright (C) 2025-present Eliot Lew, Axichat Developers
+
+import 'dart:async';
+import 'dart:convert';
+import 'dart:io';
+
+import 'package:axichat/src/email/sync/delta_event_consumer.dart';
+import 'package:crypto/crypto.dart';
+import 'package:delta_ffi/delta_safe.dart';
+import 'package:logging/logging.dart';
+import 'package:path/path.dart' as p;
+
+/// Directory [DeltaEventConsumer]s record their core traffic into, for
+/// `tool/delta_event_replay_bench.dart`. Recordings hold message content in
+/// the clear; only set this for accounts whose mail may leave the device.
+const String deltaEventRecordingDirectory = String.fromEnvironment(
+  'AXI_DELTA_EVENT_RECORDING_DIR',
+);
+
+const int _recordingVersion = 1;
+const String _headerTag = 'h';
+const String _eventTag = 'e';
+const String _responseTag = 'r';
+
+String _chatlistKey(int flags) => 'chatlist $flags';
+String _chatMessageIdsKey(int chatId, int? beforeMessageId) =>
+    'chatMessageIds $chatId ${beforeMessageId ?? ''}';
+String _messageKey(int messageId) => 'message $messageId';
+String _messageStatusKey(int messageId) => 'messageStatus $messageId';
+const String _freshMessageIdsKey = 'freshMessageIds';
+String _freshMessageCountKey(int chatId) => 'freshMessageCount $chatId';
+String _downloadFullMessageKey(int messageId) =>
+    'downloadFullMessage $messageId';
+String _rfc724MidKey(int messageId) => 'rfc724Mid $messageId';
+String _messageInfoKey(int messageId) => 'messageInfo $messageId';
+String _mimeHeadersKey(int messageId) => 'mimeHeaders $messageId';
+String _debugInfoKey(int messageId) => 'debugInfo $messageId';
+String _rfc822BodyKey(int messageId) => 'rfc822Body $messageId';
+String _quotedMessageKey(int messageId) => 'quotedMessage $messageId';
+String _publicKeyImportKey(String address) => 'publicKeyImport $address';
+String _sendCapabilitiesKey(int chatId) => 'sendCapabilities $chatId';
+String _chatKey(int chatId) => 'chat $chatId';
+
+/// A recorded Delta core session: the events the core delivered, in order,
+/// and what each core call returned between them.
+///
+/// A response is tagged with its epoch, the number of events delivered
+/// before it was recorded. Lines are JSON arrays; a recording stopped
+/// mid-line still decodes, and gzipped files are accepted as they are.
+final class DeltaEventRecording {
+  DeltaEventRecording._({
+    required this.accountId,
+    required this.supportsMessageRfc724Mid,
+    required this.supportsMessageInfo,
+    required this.supportsMessageDebugInfo,
+    required this.events,
+    required this.digest,
+    required Map<String, _ResponseTrack> responses,
+  }) : _responses = responses;
+
+  factory DeltaEventRecording.decode(List<int> bytes) {
+    final plain = bytes.length >= 2 && bytes[0] == 0x1f && bytes[1] == 0x8b
+        ? gzip.decode(bytes)
+        : bytes;
+    final events = <DeltaCoreEvent>[];
+    final responses = <String, _ResponseTrack>{};
+    ({int accountId, bool rfc724Mid, bool info, bool debugInfo})? header;
+    final lines = const LineSplitter().convert(
+      utf8.decode(plain, allowMalformed: true),
+    );
+    for (final line in lines) {
+      final Object? entry;
+      try {
+        entry = jsonDecode(line);
+      } on FormatException {
+        continue;
+      }
+      switch (entry) {
+        case [
+              _headerTag,
+              _recordingVersion,
+              final int accountId,
+              final bool rfc724Mid,
+              final bool info,
+              final bool debugInfo,
+            ]
+            when header == null:
+          header = (
+            accountId: accountId,
+            rfc724Mid: rfc724Mid,
+            info: info,
+            debugInfo: debugInfo,
+          );
+        case [
+          _eventTag,
+          final int type,
+          final int data1,
+          final int data2,
+          final String? data1Text,
+          final String? data2Text,
+        ]:
+          events.add(
+            DeltaCoreEvent(
+              type: type,
+              data1: data1,
+              data2: data2,
+              data1Text: data1Text,
+              data2Text: data2Text,
+            ),
+          );
+        case [_responseTag, final String key, final Object? value]:
+          (responses[key] ??= _ResponseTrack()).add(events.length, value);
+      }
+    }
+    if (header == null) {
+      throw const FormatException('Not a Delta event recording.');
+    }
+    return DeltaEventRecording._(
+      accountId: header.accountId,
+      supportsMessageRfc724Mid: header.rfc724Mid,
+      supportsMessageInfo: header.info,
+      supportsMessageDebugInfo: header.debugInfo,
+      events: List<DeltaCoreEvent>.unmodifiable(events),
+      digest: sha256.convert(plain).toString().substring(0, 12),
+      responses: responses,
+    );
+  }
+
+  final int accountId;
+  final bool supportsMessageRfc724Mid;
+  final bool supportsMessageInfo;
+  final bool supportsMessageDebugInfo;
+  final List<DeltaCoreEvent> events;
+
+  /// Identifies the session contents, so runs on different commits can be
+  /// checked to have replayed the same thing.
+  final String digest;
+
+  final Map<String, _ResponseTrack> _responses;
+
+  int get responseCount => _responses.values.fold<int>(
+    0,
+    (total, track) => total + track.length,
+  );
+}
+
+final class _ResponseTrack {
+  final List<int> _epochs = <int>[];
+  final List<Object?> _values = <Object?>[];
+
+  int get length => _values.length;
+
+  void add(int epoch, Object? value) {
+    _epochs.add(epoch);
+    _values.add(value);
+  }
+
+  /// The last value recorded at or before [epoch]; a call made earlier than
+  /// anything recorded gets the first value.
+  Object? at(int epoch) {
+    var low = 0;
+    var high = _epochs.length;
+    while (low < high) {
+      final mid = (low + high) >> 1;
+      if (_epochs[mid] <= epoch) {
+        low = mid + 1;
+      } else {
+        high = mid;
+      }
+    }
+    return _values[low == 0 ? 0 : low - 1];
+  }
+}
+
+/// Passes calls through to a real core and writes the events it is handed
+/// and each response to [sink] as a [DeltaEventRecording].
+///
+/// A response identical to the last one for the same call is not written
+/// again; replay serves the latest response anyway.
+final class RecordingDeltaEventCore implements DeltaEventCore {
+  RecordingDeltaEventCore(this._delegate, {required StringSink sink})
+    : _sink = sink;
+
+  static final Logger _log = Logger('RecordingDeltaEventCore');
+
+  /// Wraps [core] in a recorder writing under [deltaEventRecordingDirectory]
+  /// when that is set.
+  static DeltaEventCore wrapIfEnabled(DeltaEventCore core) {
+    if (deltaEventRecordingDirectory.isEmpty) {
+      return core;
+    }
+    Directory(deltaEventRecordingDirectory).createSync(recursive: true);
+    final file = File(
+      p.join(
+        deltaEventRecordingDirectory,
+        'delta-events-${DateTime.now().microsecondsSinceEpoch}.jsonl',
+      ),
+    );
+    final sink = file.openWrite();
+    unawaited(
+      sink.done.catchError((Object error, StackTrace stackTrace) {
+        _log.warning('Delta event recording stopped.', error, stackTrace);
+      }),
+    );
+    _log.info('Recording Delta core traffic to ${file.path}.');
+    return RecordingDeltaEventCore(core, sink: sink);
+  }
+
+  final DeltaEventCore _delegate;
+  final StringSink _sink;
+  final Map<String, String> _lastLineByKey = <String, String>{};
+  bool _headerWritten = false;
+
+  void recordEvent(DeltaCoreEvent event) {
+    _writeLine(
+      jsonEncode(<Object?>[
+        _eventTag,
+        event.type,
+        event.data1,
+        event.data2,
+        event.data1Text,
+        event.data2Text,
+      ]),
+    );
+  }
+
+  void _recordResponse(String key, Object? value) {
+    final line = jsonEncode(<Object?>[_responseTag, key, value]);
+    if (_lastLineByKey[key] == line) {
+      return;
+    }
+    _lastLineByKey[key] = line;
+    _writeLine(line);
+  }
+
+  void _writeLine(String line) {
+    if (!_headerWritten) {
+      // Written lazily: a context core only knows its account once opened.
+      _headerWritten = true;
+      _sink.writeln(
+        jsonEncode(<Object?>[
+          _headerTag,
+          _recordingVersion,
+          _delegate.accountId,
+          _delegate.supportsMessageRfc724Mid,
+          _delegate.supportsMessageInfo,
+          _delegate.supportsMessageDebugInfo,
+        ]),
+      );
+    }
+    _sink.writeln(line);
+  }
+
+  Future<T> _record<T>(
+    String key,
+    Future<T> Function() call,
+    Object? Function(T value) encode,
+  ) async {
+    final value = await call();
+    _recordResponse(key, encode(value));
+    return value;
+  }
+
+  @override
+  int get accountId => _delegate.accountId;
+
+  @override
+  bool get supportsMessageRfc724Mid => _delegate.supportsMessageRfc724Mid;
+
+  @override
+  bool get supportsMessageInfo => _delegate.supportsMessageInfo;
+
+  @override
+  bool get supportsMessageDebugInfo => _delegate.supportsMessageDebugInfo;
+
+  @override
+  Future<List<DeltaChatlistEntry>> getChatlist({int flags = 0}) => _record(
+    _chatlistKey(flags),
+    () => _delegate.getChatlist(flags: flags),
+    _encodeChatlist,
+  );
+
+  @override
+  Future<List<int>> getChatMessageIds({
+    required int chatId,
+    int? beforeMessageId,
+  }) => _record(
+    _chatMessageIdsKey(chatId, beforeMessageId),
+    () => _delegate.getChatMessageIds(
+      chatId: chatId,
+      beforeMessageId: beforeMessageId,
+    ),
+    (ids) => ids,
+  );
+
+  @override
+  Future<DeltaMessage?> getMessage(int messageId) => _record(
+    _messageKey(messageId),
+    () => _delegate.getMessage(messageId),
+    _encodeMessage,
+  );
+
+  @override
+  Future<DeltaMessageStatus?> getMessageStatus(int messageId) => _record(
+    _messageStatusKey(messageId),
+    () => _delegate.getMessageStatus(messageId),
+    _encodeMessageStatus,
+  );
+
+  /// Recorded per message, so a replay can serve any other batching.
+  @override
+  Future<List<DeltaMessage>> getMessages(List<int> messageIds) async {
+    final messages = await _delegate.getMessages(messageIds);
+    final byId = <int, DeltaMessage>{
+      for (final message in messages) message.id: message,
+    };
+    for (final messageId in messageIds) {
+      _recordResponse(_messageKey(messageId), _encodeMessage(byId[messageId]));
+    }
+    return messages;
+  }
+
+  @override
+  Future<List<DeltaMessageStatus>> getMessageStatuses(
+    List<int> messageIds,
+  ) async {
+    final statuses = await _delegate.getMessageStatuses(messageIds);
+    final byId = <int, DeltaMessageStatus>{
+      for (final status in statuses) status.id: status,
+    };
+    for (final messageId in messageIds) {
+      _recordResponse(
+        _messageStatusKey(messageId),
+        _encodeMessageStatus(byId[messageId]),
+      );
+    }
+    return statuses;
+  }
+
+  @override
+  Future<List<int>> getFreshMessageIds() =>
+      _record(_freshMessageIdsKey, _delegate.getFreshMessageIds, (ids) => ids);
+
+  @override
+  Future<DeltaFreshMessageCount> getFreshMessageCountSafe(int chatId) =>
+      _record(
+        _freshMessageCountKey(chatId),
+        () => _delegate.getFreshMessageCountSafe(chatId),
+        (count) => <Object?>[count.count, count.supported],
+      );
+
+  @override
+  Future<bool> downloadFullMessage(int messageId) => _record(
+    _downloadFullMessageKey(messageId),
+    () => _delegate.downloadFullMessage(messageId),
+    (started) => started,
+  );
+
+  @override
+  Future<String?> getMessageRfc724Mid(int messageId) => _record(
+    _rfc724MidKey(messageId),
+    () => _delegate.getMessageRfc724Mid(messageId),
+    (value) => value,
+  );
+
+  @override
+  Future<String?> getMessageInfo(int messageId) => _record(
+    _messageInfoKey(messageId),
+    () => _delegate.getMessageInfo(messageId),
+    (value) => value,
+  );
+
+  @override
+  Future<String?> getMessageMimeHeaders(int messageId) => _record(
+    _mimeHeadersKey(messageId),
+    () => _delegate.getMessageMimeHeaders(messageId),
+    (value) => value,
+  );
+
+  @override
+  Future<String?> getMessageDebugInfo(int messageId) => _record(
+    _debugInfoKey(messageId),
+    () => _delegate.getMessageDebugInfo(messageId),
+    (value) => value,
+  );
+
+  @override
+  Future<DeltaMessageRfc822Body?> getMessageRfc822Body(int messageId) =>
+      _record(
+        _rfc822BodyKey(messageId),
+        () => _delegate.getMessageRfc822Body(messageId),
+        (body) => body == null
+            ? null
+            : <Object?>[body.plainText, body.htmlBody],
+      );
+
+  @override
+  Future<DeltaQuotedMessage?> getQuotedMessage(int messageId) => _record(
+    _quotedMessageKey(messageId),
+    () => _delegate.getQuotedMessage(messageId),
+    (quoted) => quoted == null ? null : <Object?>[quoted.id, quoted.text],
+  );
+
+  @override
+  Future<DeltaContactPublicKeyImport> importContactPublicKey({
+    required String address,
+    required String displayName,
+    required String armoredPublicKey,
+  }) => _record(
+    _publicKeyImportKey(address),
+    () => _delegate.importContactPublicKey(
+      address: address,
+      displayName: displayName,
+      armoredPublicKey: armoredPublicKey,
+    ),
+    _encodePublicKeyImport,
+  );
+
+  @override
+  Future<DeltaChatSendCapabilities> chatSendCapabilities(int chatId) =>
+      _record(
+        _sendCapabilitiesKey(chatId),
+        () => _delegate.chatSendCapabilities(chatId),
+        (capabilities) => <Object?>[
+          capabilities.exists,
+          capabilities.canSend,
+          capabilities.isEncrypted,
+        ],
+      );
+
+  @override
+  Future<DeltaChat?> getChat(int chatId) =>
+      _record(_chatKey(chatId), () => _delegate.getChat(chatId), _encodeChat);
+}
+
+/// Serves a [DeltaEventRecording] as a core, each call completing after
+/// [latency].
+///
+/// Calls answer as the recorded core did at [epoch], which the driver
+/// advances as it hands events to the consumer. Calls the recording never
+/// saw answer as an empty core would.
+final class ReplayDeltaEventCore implements DeltaEventCore {
+  ReplayDeltaEventCore(this.recording, {this.latency = Duration.zero});
+
+  final DeltaEventRecording recording;
+  final Duration latency;
+
+  /// Number of recorded events delivered so far.
+  int epoch = 0;
+
+  /// Core calls served, for comparing how chatty the consumer is.
+  int callCount = 0;
+
+  Future<T> _serve<T>(
+    String key,
+    T Function(Object? value) decode,
+    T fallback,
+  ) async {
+    callCount += 1;
+    if (latency > Duration.zero) {
+      await Future<void>.delayed(latency);
+    }
+    final track = recording._responses[key];
+    return track == null ? fallback : decode(track.at(epoch));
+  }
+
+  @override
+  int get accountId => recording.accountId;
+
+  @override
+  bool get supportsMessageRfc724Mid => recording.supportsMessageRfc724Mid;
+
+  @override
+  bool get supportsMessageInfo => recording.supportsMessageInfo;
+
+  @override
+  bool get supportsMessageDebugInfo => recording.supportsMessageDebugInfo;
+
+  @override
+  Future<List<DeltaChatlistEntry>> getChatlist({int flags = 0}) => _serve(
+    _chatlistKey(flags),
+    _decodeChatlist,
+    const <DeltaChatlistEntry>[],
+  );
+
+  @override
+  Future<List<int>> getChatMessageIds({
+    required int chatId,
+    int? beforeMessageId,
+  }) => _serve(
+    _chatMessageIdsKey(chatId, beforeMessageId),
+    _decodeIds,
+    const <int>[],
+  );
+
+  @override
+  Future<DeltaMessage?> getMessage(int messageId) =>
+      _serve(_messageKey(messageId), _decodeMessage, null);
+
+  @override
+  Future<DeltaMessageStatus?> getMessageStatus(int messageId) =>
+      _serve(_messageStatusKey(messageId), _decodeMessageStatus, null);
+
+  @override
+  Future<List<DeltaMessage>> getMessages(List<int> messageIds) async {
+    final messages = <DeltaMessage>[];
+    for (final messageId in messageIds) {
+      final message = await getMessage(messageId);
+      if (message != null) {
+        messages.add(message);
+      }
+    }
+    return messages;
+  }
+
+  @override
+  Future<List<DeltaMessageStatus>> getMessageStatuses(
+    List<int> messageIds,
+  ) async {
+    final statuses = <DeltaMessageStatus>[];
+    for (final messageId in messageIds) {
+      final status = await getMessageStatus(messageId);
+      if (status != null) {
+        statuses.add(status);
+      }
+    }
+    return statuses;
+  }
+
+  @override
+  Future<List<int>> getFreshMessageIds() =>
+      _serve(_freshMessageIdsKey, _decodeIds, const <int>[]);
+
+  @override
+  Future<DeltaFreshMessageCount> getFreshMessageCountSafe(int chatId) =>
+      _serve(
+        _freshMessageCountKey(chatId),
+        (value) => switch (value) {
+          [final int count, final bool supported] => DeltaFreshMessageCount(
+            count: count,
+            supported: supported,
+          ),
+          _ => const DeltaFreshMessageCount.unsupported(),
+        },
+        const DeltaFreshMessageCount.unsupported(),
+      );
+
+  @override
+  Future<bool> downloadFullMessage(int messageId) => _serve(
+    _downloadFullMessageKey(messageId),
+    (value) => value == true,
+    false,
+  );
+
+  @override
+  Future<String?> getMessageRfc724Mid(int messageId) =>
+      _serve(_rfc724MidKey(messageId), _decodeString, null);
+
+  @override
+  Future<String?> getMessageInfo(int messageId) =>
+      _serve(_messageInfoKey(messageId), _decodeString, null);
+
+  @override
+  Future<String?> getMessageMimeHeaders(int messageId) =>
+      _serve(_mimeHeadersKey(messageId), _decodeString, null);
+
+  @override
+  Future<String?> getMessageDebugInfo(int messageId) =>
+      _serve(_debugInfoKey(messageId), _decodeString, null);
+
+  @override
+  Future<DeltaMessageRfc822Body?> getMessageRfc822Body(int messageId) =>
+      _serve(
+        _rfc822BodyKey(messageId),
+        (value) => switch (value) {
+          [final String? plainText, final String? htmlBody] =>
+            DeltaMessageRfc822Body(plainText: plainText, htmlBody: htmlBody),
+          _ => null,
+        },
+        null,
+      );
+
+  @override
+  Future<DeltaQuotedMessage?> getQuotedMessage(int messageId) => _serve(
+    _quotedMessageKey(messageId),
+    (value) => switch (value) {
+      [final int? id, final String? text] => DeltaQuotedMessage(
+        id: id,
+        text: text,
+      ),
+      _ => null,
+    },
+    null,
+  );
+
+  @override
+  Future<DeltaContactPublicKeyImport> importContactPublicKey({
+    required String address,
+    required String displayName,
+    required String armoredPublicKey,
+  }) async {
+    final imported = await _serve(
+      _publicKeyImportKey(address),
+      _decodePublicKeyImport,
+      null,
+    );
+    if (imported == null) {
+      throw DeltaOperationException('No recorded key import for $address.');
+    }
+    return imported;
+  }
+
+  @override
+  Future<DeltaChatSendCapabilities> chatSendCapabilities(int chatId) => _serve(
+    _sendCapabilitiesKey(chatId),
+    (value) => switch (value) {
+      [final bool exists, final bool? canSend, final bool? isEncrypted] =>
+        DeltaChatSendCapabilities(
+          exists: exists,
+          canSend: canSend,
+          isEncrypted: isEncrypted,
+        ),
+      _ => const DeltaChatSendCapabilities(exists: false),
+    },
+    const DeltaChatSendCapabilities(exists: false),
+  );
+
+  @override
+  Future<DeltaChat?> getChat(int chatId) =>
+      _serve(_chatKey(chatId), _decodeChat, null);
+}
+
+int? _encodeTimestamp(DateTime? timestamp) => timestamp?.millisecondsSinceEpoch;
+
+DateTime? _decodeTimestamp(int? millis) => millis == null
+    ? null
+    : DateTime.fromMillisecondsSinceEpoch(millis, isUtc: true).toLocal();
+
+String? _decodeString(Object? value) => value is String ? value : null;
+
+List<int> _decodeIds(Object? value) => value is List<Object?>
+    ? <int>[
+        for (final id in value)
+          if (id is int) id,
+      ]
+    : const <int>[];
+
+Object? _encodeChatlist(List<DeltaChatlistEntry> entries) => <int>[
+  for (final entry in entries) ...<int>[entry.chatId, entry.msgId],
+];
+
+List<DeltaChatlistEntry> _decodeChatlist(Object? value) {
+  final ids = _decodeIds(value);
+  return <DeltaChatlistEntry>[
+    for (var index = 0; index + 1 < ids.length; index += 2)
+      DeltaChatlistEntry(chatId: ids[index], msgId: ids[index + 1]),
+  ];
+}
+
+Object? _encodeMessage(DeltaMessage? message) => message == null
+    ? null
+    : <Object?>[
+        message.id,
+        message.chatId,
+        message.text,
+        message.html,
+        message.subject,
+        message.viewType,
+        message.infoType,
+        message.state,
+        message.filePath,
+        message.fileName,
+        message.fileMime,
+        message.fileSize,
+        message.width,
+        message.height,
+        _encodeTimestamp(message.timestamp),
+        message.isOutgoing,
+        message.downloadState,
+        message.error,
+        message.showPadlock,
+      ];
+
+DeltaMessage? _decodeMessage(Object? value) => switch (value) {
+  [
+    final int id,
+    final int chatId,
+    final String? text,
+    final String? html,
+    final String? subject,
+    final int? viewType,
+    final int? infoType,
+    final int? state,
+    final String? filePath,
+    final String? fileName,
+    final String? fileMime,
+    final int? fileSize,
+    final int? width,
+    final int? height,
+    final int? timestamp,
+    final bool isOutgoing,
+    final int? downloadState,
+    final String? error,
+    final bool showPadlock,
+  ] =>
+    DeltaMessage(
+      id: id,
+      chatId: chatId,
+      text: text,
+      html: html,
+      subject: subject,
+      viewType: viewType,
+      infoType: infoType,
+      state: state,
+      filePath: filePath,
+      fileName: fileName,
+      fileMime: fileMime,
+      fileSize: fileSize,
+      width: width,
+      height: height,
+      timestamp: _decodeTimestamp(timestamp),
+      isOutgoing: isOutgoing,
+      downloadState: downloadState,
+      error: error,
+      showPadlock: showPadlock,
+    ),
+  _ => null,
+};
+
+Object? _encodeMessageStatus(DeltaMessageStatus? status) => status == null
+    ? null
+    : <Object?>[
+        status.id,
+        status.chatId,
+        status.state,
+        _encodeTimestamp(status.timestamp),
+        status.isOutgoing,
+        status.error,
+        status.showPadlock,
+      ];
+
+DeltaMessageStatus? _decodeMessageStatus(Object? value) => switch (value) {
+  [
+    final int id,
+    final int chatId,
+    final int? state,
+    final int? timestamp,
+    final bool isOutgoing,
+    final String? error,
+    final bool showPadlock,
+  ] =>
+    DeltaMessageStatus(
+      id: id,
+      chatId: chatId,
+      state: state,
+      timestamp: _decodeTimestamp(timestamp),
+      isOutgoing: isOutgoing,
+      error: error,
+      showPadlock: showPadlock,
+    ),
+  _ => null,
+};
+
+Object? _encodeChat(DeltaChat? chat) => chat == null
+    ? null
+    : <Object?>[
+        chat.id,
+        chat.name,
+        chat.contactAddress,
+        chat.contactId,
+        chat.contactName,
+        chat.type,
+      ];
+
+DeltaChat? _decodeChat(Object? value) => switch (value) {
+  [
+    final int id,
+    final String? name,
+    final String? contactAddress,
+    final int? contactId,
+    final String? contactName,
+    final int? type,
+  ] =>
+    DeltaChat(
+      id: id,
+      name: name,
+      contactAddress: contactAddress,
+      contactId: contactId,
+      contactName: contactName,
+      type: type,
+    ),
+  _ => null,
+};
+
+Object? _encodePublicKeyImport(DeltaContactPublicKeyImport imported) =>
+    <Object?>[
+      imported.metadata.kind.name,
+      imported.metadata.fingerprint,
+      imported.metadata.userIds,
+      imported.metadata.hasExpectedAddress,
+      imported.metadata.hasEncryptionCapability,
+      imported.contactId,
+      imported.chatId,
+    ];
+
+DeltaContactPublicKeyImport? _decodePublicKeyImport(Object? value) {
+  if (value
+      case [
+        final String kindName,
+        final String fingerprint,
+        final List<Object?> userIds,
+        final bool hasExpectedAddress,
+        final bool hasEncryptionCapability,
+        final int contactId,
+        final int chatId,
+      ]) {
+    final kind = DeltaOpenPgpKeyKind.values.asNameMap()[kindName];
+    if (kind == null) {
+      return null;
+    }
+    return DeltaContactPublicKeyImport(
+      metadata: DeltaOpenPgpKeyMetadata(
+        kind: kind,
+        fingerprint: fingerprint,
+        userIds: userIds.whereType<String>().toList(growable: false),
+        hasExpectedAddress: hasExpectedAddress,
+        hasEncryptionCapability: hasEncryptionCapability,
+      ),
+      contactId: contactId,
+      chatId: chatId,
+    );
+  }
+  return null;
+}
@@ -0,0 +1,541 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+// Copyright (C) 2025-present Eliot Lew, Axichat Developers
+
+import 'dart:async';
+import 'dart:convert';
+import 'dart:isolate';
+import 'dart:typed_data';
+
+import 'package:delta_ffi/delta_safe.dart';
+
+/// Strings at least this long travel as transferred UTF-8 bytes rather than
+/// being copied into the receiving isolate's heap.
+const int _emailDeltaRpcInlineStringLimit = 4096;
+
+const int _emailDeltaRpcNullLength = -1;
+
+/// Read calls served on the binary lane. The opcode on the wire is the
+/// value's index, so new ops go at the end.
+enum EmailDeltaRpcOp {
+  getMessage(_EmailDeltaRpcResult.message),
+  getMessageStatus(_EmailDeltaRpcResult.status),
+  getMessages(_EmailDeltaRpcResult.messages),
+  getMessageStatuses(_EmailDeltaRpcResult.statuses),
+  hydrateMessages(_EmailDeltaRpcResult.none),
+  getChatMessageIds(_EmailDeltaRpcResult.ids),
+  messageIdsAfter(_EmailDeltaRpcResult.ids),
+  getFreshMessageIds(_EmailDeltaRpcResult.ids),
+  getMessageMimeHeaders(_EmailDeltaRpcResult.text),
+  getMessageFullHtml(_EmailDeltaRpcResult.text),
+  getMessageRfc822Body(_EmailDeltaRpcResult.rfc822Body);
+
+  const EmailDeltaRpcOp(this._result);
+
+  final _EmailDeltaRpcResult _result;
+}
+
+enum _EmailDeltaRpcResult {
+  none,
+  message,
+  status,
+  messages,
+  statuses,
+  ids,
+  text,
+  rfc822Body,
+}
+
+final class EmailDeltaRpcLaneClosedException implements Exception {
+  const EmailDeltaRpcLaneClosedException();
+
+  @override
+  String toString() => 'EmailDeltaRpcLaneClosedException';
+}
+
+/// Packs message ids for a request argument.
+Object emailDeltaRpcIds(List<int> ids) => TransferableTypedData.fromList(
+  <TypedData>[Int64List.fromList(ids)],
+);
+
+/// Reads ids packed with [emailDeltaRpcIds].
+List<int> emailDeltaRpcIdsArgument(Object? value) =>
+    _unpackIds(value as TransferableTypedData);
+
+/// The calling side of the lane. Calls made in the same microtask go out as
+/// one port message, and any number may be in flight at once; replies are
+/// matched back by request id.
+///
+/// Request frames repeat `id, opcode, args`; reply frames repeat
+/// `id, ok, value`, where a failed call's value is whatever the server's
+/// `encodeError` produced.
+final class EmailDeltaRpcLaneClient {
+  EmailDeltaRpcLaneClient._(
+    this._responses,
+    this._requests,
+    this._decodeError,
+  ) {
+    _responses.listen(_handleFrame);
+  }
+
+  /// Opens a lane, handing [open] the port replies should go to and
+  /// expecting the server's request port back.
+  static Future<EmailDeltaRpcLaneClient> connect(
+    Future<SendPort> Function(SendPort replyPort) open, {
+    required Object Function(Object? error) decodeError,
+  }) async {
+    final responses = ReceivePort('email-delta-rpc-lane');
+    try {
+      final requests = await open(responses.sendPort);
+      return EmailDeltaRpcLaneClient._(responses, requests, decodeError);
+    } on Exception {
+      responses.close();
+      rethrow;
+    }
+  }
+
+  final ReceivePort _responses;
+  final SendPort _requests;
+  final Object Function(Object? error) _decodeError;
+  final Map<int, (EmailDeltaRpcOp, Completer<Object?>)> _pending =
+      <int, (EmailDeltaRpcOp, Completer<Object?>)>{};
+  List<Object?>? _outbox;
+  int _nextId = 0;
+  bool _closed = false;
+
+  Future<Object?> call(EmailDeltaRpcOp op, List<Object?> args) {
+    if (_closed) {
+      return Future<Object?>.error(const EmailDeltaRpcLaneClosedException());
+    }
+    final id = _nextId += 1;
+    final completer = Completer<Object?>();
+    _pending[id] = (op, completer);
+    final outbox = _outbox;
+    if (outbox == null) {
+      _outbox = <Object?>[id, op.index, args];
+      scheduleMicrotask(_flush);
+    } else {
+      outbox
+        ..add(id)
+        ..add(op.index)
+        ..add(args);
+    }
+    return completer.future;
+  }
+
+  void close() {
+    if (_closed) {
+      return;
+    }
+    _closed = true;
+    _outbox = null;
+    _responses.close();
+    _failPending(const EmailDeltaRpcLaneClosedException());
+  }
+
+  void _flush() {
+    final outbox = _outbox;
+    _outbox = null;
+    if (outbox != null && !_closed) {
+      _requests.send(outbox);
+    }
+  }
+
+  void _handleFrame(Object? frame) {
+    if (frame is! List || frame.length % 3 != 0) {
+      // The calls this frame answers cannot be told apart from the rest, so
+      // fail them all rather than leave some waiting forever.
+      _failPending(StateError('Malformed Delta RPC reply frame.'));
+      return;
+    }
+    for (var index = 0; index < frame.length; index += 3) {
+      final pending = _pending.remove(frame[index]);
+      if (pending == null) {
+        continue;
+      }
+      final (op, completer) = pending;
+      final value = frame[index + 2];
+      try {
+        if (frame[index + 1] != true) {
+          completer.completeError(_decodeError(value));
+        } else {
+          completer.complete(_decodeResult(op, value));
+        }
+      } catch (error, stackTrace) {
+        completer.completeError(error, stackTrace);
+      }
+    }
+  }
+
+  void _failPending(Object error) {
+    final pending = _pending.values.toList(growable: false);
+    _pending.clear();
+    for (final (_, completer) in pending) {
+      completer.completeError(error);
+    }
+  }
+}
+
+/// The serving side of the lane. Each request runs as soon as its frame
+/// arrives; replies that finish in the same microtask share a frame.
+final class EmailDeltaRpcLaneServer {
+  EmailDeltaRpcLaneServer({
+    required SendPort replyPort,
+    required Future<Object?> Function(EmailDeltaRpcOp op, List<Object?> args)
+    handler,
+    required Object? Function(Object error) encodeError,
+  }) : _replies = replyPort,
+       _handler = handler,
+       _encodeError = encodeError {
+    _requests.listen(_handleFrame);
+  }
+
+  final ReceivePort _requests = ReceivePort('email-delta-rpc-lane-server');
+  final SendPort _replies;
+  final Future<Object?> Function(EmailDeltaRpcOp op, List<Object?> args)
+  _handler;
+  final Object? Function(Object error) _encodeError;
+  List<Object?>? _outbox;
+  bool _closed = false;
+
+  SendPort get sendPort => _requests.sendPort;
+
+  void close() {
+    _closed = true;
+    _outbox = null;
+    _requests.close();
+  }
+
+  void _handleFrame(Object? frame) {
+    if (frame is! List) {
+      return;
+    }
+    for (var index = 0; index + 2 < frame.length; index += 3) {
+      final id = frame[index];
+      if (id is! int) {
+        continue;
+      }
+      final opcode = frame[index + 1];
+      final args = frame[index + 2];
+      if (opcode is! int || args is! List<Object?>) {
+        _reply(
+          id,
+          false,
+          _encodeError(StateError('Malformed Delta RPC request $id.')),
+        );
+        continue;
+      }
+      unawaited(_serve(id, opcode, args));
+    }
+  }
+
+  Future<void> _serve(int id, int opcode, List<Object?> args) async {
+    Object? value;
+    var ok = true;
+    try {
+      if (opcode < 0 || opcode >= EmailDeltaRpcOp.values.length) {
+        throw StateError('Unknown Delta RPC opcode $opcode.');
+      }
+      final op = EmailDeltaRpcOp.values[opcode];
+      value = _encodeResult(op, await _handler(op, args));
+    } catch (error) {
+      ok = false;
+      value = _encodeError(error);
+    }
+    _reply(id, ok, value);
+  }
+
+  void _reply(int id, bool ok, Object? value) {
+    if (_closed) {
+      return;
+    }
+    final outbox = _outbox;
+    if (outbox == null) {
+      _outbox = <Object?>[id, ok, value];
+      scheduleMicrotask(_flush);
+    } else {
+      outbox
+        ..add(id)
+        ..add(ok)
+        ..add(value);
+    }
+  }
+
+  void _flush() {
+    final outbox = _outbox;
+    _outbox = null;
+    if (outbox != null && !_closed) {
+      _replies.send(outbox);
+    }
+  }
+}
+
+Object? _encodeResult(EmailDeltaRpcOp op, Object? value) {
+  if (value == null) {
+    return null;
+  }
+  switch (op._result) {
+    case _EmailDeltaRpcResult.none:
+      return null;
+    case _EmailDeltaRpcResult.ids:
+      return emailDeltaRpcIds(value as List<int>);
+    case _EmailDeltaRpcResult.text:
+      final text = value as String;
+      return text.length < _emailDeltaRpcInlineStringLimit
+          ? text
+          : TransferableTypedData.fromList(<TypedData>[utf8.encode(text)]);
+    case _EmailDeltaRpcResult.message:
+      return (_EmailDeltaRpcWriter()..message(value as DeltaMessage))
+          .transferable();
+    case _EmailDeltaRpcResult.status:
+      return (_EmailDeltaRpcWriter()..status(value as DeltaMessageStatus))
+          .transferable();
+    case _EmailDeltaRpcResult.messages:
+      final messages = value as List<DeltaMessage>;
+      final writer = _EmailDeltaRpcWriter()..integer(messages.length);
+      messages.forEach(writer.message);
+      return writer.transferable();
+    case _EmailDeltaRpcResult.statuses:
+      final statuses = value as List<DeltaMessageStatus>;
+      final writer = _EmailDeltaRpcWriter()..integer(statuses.length);
+      statuses.forEach(writer.status);
+      return writer.transferable();
+    case _EmailDeltaRpcResult.rfc822Body:
+      final body = value as DeltaMessageRfc822Body;
+      return (_EmailDeltaRpcWriter()
+            ..string(body.plainText)
+            ..string(body.htmlBody))
+          .transferable();
+  }
+}
+
+Object? _decodeResult(EmailDeltaRpcOp op, Object? value) {
+  switch (op._result) {
+    case _EmailDeltaRpcResult.none:
+      return null;
+    case _EmailDeltaRpcResult.ids:
+      return value == null
+          ? const <int>[]
+          : _unpackIds(value as TransferableTypedData);
+    case _EmailDeltaRpcResult.text:
+      if (value is TransferableTypedData) {
+        return utf8.decode(value.materialize().asUint8List());
+      }
+      return value as String?;
+    case _EmailDeltaRpcResult.message:
+      return value == null ? null : _EmailDeltaRpcReader(value).message();
+    case _EmailDeltaRpcResult.status:
+      return value == null ? null : _EmailDeltaRpcReader(value).status();
+    case _EmailDeltaRpcResult.messages:
+      if (value == null) {
+        return const <DeltaMessage>[];
+      }
+      final reader = _EmailDeltaRpcReader(value);
+      return List<DeltaMessage>.generate(
+        reader.integer(),
+        (_) => reader.message(),
+        growable: false,
+      );
+    case _EmailDeltaRpcResult.statuses:
+      if (value == null) {
+        return const <DeltaMessageStatus>[];
+      }
+      final reader = _EmailDeltaRpcReader(value);
+      return List<DeltaMessageStatus>.generate(
+        reader.integer(),
+        (_) => reader.status(),
+        growable: false,
+      );
+    case _EmailDeltaRpcResult.rfc822Body:
+      if (value == null) {
+        return null;
+      }
+      final reader = _EmailDeltaRpcReader(value);
+      return DeltaMessageRfc822Body(
+        plainText: reader.string(),
+        htmlBody: reader.string(),
+      );
+  }
+}
+
+List<int> _unpackIds(TransferableTypedData value) {
+  final buffer = value.materialize();
+  return buffer.asInt64List(
+    0,
+    buffer.lengthInBytes ~/ Int64List.bytesPerElement,
+  );
+}
+
+/// Little-endian fields in declaration order; nullable values carry a
+/// presence byte and strings a byte length.
+final class _EmailDeltaRpcWriter {
+  Uint8List _bytes = Uint8List(256);
+  late ByteData _data = ByteData.sublistView(_bytes);
+  int _length = 0;
+
+  TransferableTypedData transferable() => TransferableTypedData.fromList(
+    <TypedData>[Uint8List.sublistView(_bytes, 0, _length)],
+  );
+
+  void integer(int value) {
+    _reserve(8);
+    _data.setInt64(_length, value, Endian.little);
+    _length += 8;
+  }
+
+  void nullableInteger(int? value) {
+    flag(value != null);
+    if (value != null) {
+      integer(value);
+    }
+  }
+
+  void flag(bool value) {
+    _reserve(1);
+    _bytes[_length] = value ? 1 : 0;
+    _length += 1;
+  }
+
+  void string(String? value) {
+    if (value == null) {
+      _reserve(4);
+      _data.setInt32(_length, _emailDeltaRpcNullLength, Endian.little);
+      _length += 4;
+      return;
+    }
+    final encoded = utf8.encode(value);
+    _reserve(4 + encoded.length);
+    _data.setInt32(_length, encoded.length, Endian.little);
+    _bytes.setRange(_length + 4, _length + 4 + encoded.length, encoded);
+    _length += 4 + encoded.length;
+  }
+
+  void timestamp(DateTime? value) {
+    flag(value != null);
+    if (value != null) {
+      integer(value.microsecondsSinceEpoch);
+      flag(value.isUtc);
+    }
+  }
+
+  void message(DeltaMessage message) {
+    integer(message.id);
+    integer(message.chatId);
+    string(message.text);
+    string(message.html);
+    string(message.subject);
+    nullableInteger(message.viewType);
+    nullableInteger(message.infoType);
+    nullableInteger(message.state);
+    string(message.filePath);
+    string(message.fileName);
+    string(message.fileMime);
+    nullableInteger(message.fileSize);
+    nullableInteger(message.width);
+    nullableInteger(message.height);
+    timestamp(message.timestamp);
+    flag(message.isOutgoing);
+    nullableInteger(message.downloadState);
+    string(message.error);
+    flag(message.showPadlock);
+  }
+
+  void status(DeltaMessageStatus status) {
+    integer(status.id);
+    integer(status.chatId);
+    nullableInteger(status.state);
+    timestamp(status.timestamp);
+    flag(status.isOutgoing);
+    string(status.error);
+    flag(status.showPadlock);
+  }
+
+  void _reserve(int count) {
+    if (_length + count <= _bytes.length) {
+      return;
+    }
+    var capacity = _bytes.length * 2;
+    while (capacity < _length + count) {
+      capacity *= 2;
+    }
+    _bytes = Uint8List(capacity)..setRange(0, _length, _bytes);
+    _data = ByteData.sublistView(_bytes);
+  }
+}
+
+final class _EmailDeltaRpcReader {
+  _EmailDeltaRpcReader(Object value)
+    : _bytes = (value as TransferableTypedData).materialize().asUint8List() {
+    _data = ByteData.sublistView(_bytes);
+  }
+
+  final Uint8List _bytes;
+  late final ByteData _data;
+  int _offset = 0;
+
+  int integer() {
+    final value = _data.getInt64(_offset, Endian.little);
+    _offset += 8;
+    return value;
+  }
+
+  int? nullableInteger() => flag() ? integer() : null;
+
+  bool flag() {
+    final value = _bytes[_offset] != 0;
+    _offset += 1;
+    return value;
+  }
+
+  String? string() {
+    final length = _data.getInt32(_offset, Endian.little);
+    _offset += 4;
+    if (length == _emailDeltaRpcNullLength) {
+      return null;
+    }
+    final value = utf8.decode(
+      Uint8List.sublistView(_bytes, _offset, _offset + length),
+    );
+    _offset += length;
+    return value;
+  }
+
+  DateTime? timestamp() {
+    if (!flag()) {
+      return null;
+    }
+    final microseconds = integer();
+    return DateTime.fromMicrosecondsSinceEpoch(microseconds, isUtc: flag());
+  }
+
+  DeltaMessage message() => DeltaMessage(
+    id: integer(),
+    chatId: integer(),
+    text: string(),
+    html: string(),
+    subject: string(),
+    viewType: nullableInteger(),
+    infoType: nullableInteger(),
+    state: nullableInteger(),
+    filePath: string(),
+    fileName: string(),
+    fileMime: string(),
+    fileSize: nullableInteger(),
+    width: nullableInteger(),
+    height: nullableInteger(),
+    timestamp: timestamp(),
+    isOutgoing: flag(),
+    downloadState: nullableInteger(),
+    error: string(),
+    showPadlock: flag(),
+  );
+
+  DeltaMessageStatus status() => DeltaMessageStatus(
+    id: integer(),
+    chatId: integer(),
+    state: nullableInteger(),
+    timestamp: timestamp(),
+    isOutgoing: flag(),
+    error: string(),
+    showPadlock: flag(),
+  );
+}
@@ -8,6 +8,7 @@ import 'package:axichat/src/common/address_tools.dart';
 import 'package:axichat/src/common/app_owned_storage.dart';
 import 'package:axichat/src/common/email_validation.dart';
 import 'package:axichat/src/common/html_content.dart';
+import 'package:axichat/src/common/startup/startup_trace.dart';
 import 'package:axichat/src/common/transport.dart';
 import 'package:axichat/src/email/models/email_attachment.dart';
 import 'package:axichat/src/email/util/delta_jids.dart';
@@ -61,6 +62,10 @@ const String _accountHydrationFailedLog =
     'Failed to hydrate email account address.';
 const int _deltaMessageIdUnset = DeltaMessageId.none;
 const bool _defaultScheduleAccountHydration = true;
+// Each account stops this much before the shared window closes, so the
+// slowest server is reported as a timeout instead of running the clock out.
+const Duration _backgroundFetchAccountHeadroom = Duration(seconds: 2);
+const Duration _backgroundFetchMinAccountBudget = Duration(seconds: 3);
 const Set<String> _deltaSensitiveConfigKeys = <String>{
   _deltaConfigKeyMailPassword,
   _deltaConfigKeySendPassword,
@@ -276,6 +281,15 @@ abstract interface class EmailDeltaRuntime implements ChatTransport {
     required String armoredPublicKey,
     int? accountId,
   });
+  Future<List<DeltaOpenPgpKeyringEntry>> inspectOpenPgpKeyring({
+    required String armoredKeyring,
+    int? accountId,
+  });
+  Future<List<DeltaOpenPgpKeyringEntry>> importContactPublicKeyring({
+    required String armoredKeyring,
+    required List<String> confirmedFingerprints,
+    int? accountId,
+  });
   Future<EmailDeltaImexResult> runImex({
     required int mode,
     required String path,
@@ -309,6 +323,22 @@ abstract interface class EmailDeltaRuntime implements ChatTransport {
     bool forcePlaintext = false,
     bool skipAutocrypt = false,
   });
+
+  /// Sends [attachment] to every chat in [chatIds] with the file attached
+  /// once. Results follow [chatIds] order; a chat whose copy could not be
+  /// queued carries the error instead of a message id.
+  Future<List<DeltaFanOutSendResult>> fanOutAttachment({
+    required List<int> chatIds,
+    required EmailAttachment attachment,
+    String? subject,
+    String? shareId,
+    String? captionOverride,
+    String? htmlCaption,
+    String? quotingStanzaId,
+    int? accountId,
+    bool forcePlaintext = false,
+    bool skipAutocrypt = false,
+  });
   Future<bool> blockContact(String address, {int? accountId});
   Future<bool> unblockContact(String address, {int? accountId});
   Future<bool> markNoticedChat(int chatId, {int? accountId});
@@ -1087,12 +1117,45 @@ class EmailDeltaTransport implements EmailDeltaRuntime {
         }
         return await context.backgroundFetch(timeout);
       }
-      return await accounts.backgroundFetch(timeout);
+      final report = await accounts.backgroundFetchReport(
+        timeout,
+        accountTimeout: _backgroundFetchAccountBudget(timeout),
+      );
+      if (report == null) {
+        return await accounts.backgroundFetch(timeout);
+      }
+      _logBackgroundFetchReport(report);
+      return !report.cancelled;
     } finally {
       await _detachBackgroundFetchEventSubscriptions(temporarySubscriptions);
     }
   }
 
+  Duration _backgroundFetchAccountBudget(Duration timeout) {
+    final budget = timeout - _backgroundFetchAccountHeadroom;
+    return budget < _backgroundFetchMinAccountBudget
+        ? _backgroundFetchMinAccountBudget
+        : budget;
+  }
+
+  void _logBackgroundFetchReport(DeltaBackgroundFetchReport report) {
+    final slow = report.accounts.where(
+      (account) => account.status != DeltaAccountFetchStatus.done,
+    );
+    for (final account in slow) {
+      _log.warning(
+        'Background fetch for account ${account.accountId} ended with '
+        '${account.status.name} after ${account.duration.inMilliseconds}ms'
+        '${account.error == null ? '' : ': ${account.error}'}',
+      );
+    }
+    _log.fine(
+      'Background fetch of ${report.accounts.length} accounts fetched '
+      '${report.fetched} messages in ${report.duration.inMilliseconds}ms'
+      '${report.cancelled ? ' (cancelled)' : ''}.',
+    );
+  }
+
   @override
   Future<bool> performExistingHistoryImportFetch(
     Duration timeout, {
@@ -1418,6 +1481,58 @@ class EmailDeltaTransport implements EmailDeltaRuntime {
     );
   }
 
+  @override
+  Future<List<DeltaOpenPgpKeyringEntry>> inspectOpenPgpKeyring({
+    required String armoredKeyring,
+    int? accountId,
+  }) async {
+    if (_databasePrefix == null || _databasePassphrase == null) {
+      throw StateError('Transport not initialized');
+    }
+    await _ensureContextReady();
+    final session = await _ensureSession(accountId: accountId);
+    final context = session?.context;
+    if (context == null) {
+      throw StateError('Transport not initialized');
+    }
+    final entries = await context.inspectOpenPgpKeyring(armoredKeyring);
+    if (entries == null) {
+      throw const DeltaOperationException(
+        'Delta FFI missing required symbol '
+        'axichat_dc_inspect_openpgp_keyring',
+      );
+    }
+    return entries;
+  }
+
+  @override
+  Future<List<DeltaOpenPgpKeyringEntry>> importContactPublicKeyring({
+    required String armoredKeyring,
+    required List<String> confirmedFingerprints,
+    int? accountId,
+  }) async {
+    if (_databasePrefix == null || _databasePassphrase == null) {
+      throw StateError('Transport not initialized');
+    }
+    await _ensureContextReady();
+    final session = await _ensureSession(accountId: accountId);
+    final context = session?.context;
+    if (context == null) {
+      throw StateError('Transport not initialized');
+    }
+    final entries = await context.importContactPublicKeys(
+      armoredKeyring,
+      confirmedFingerprints: confirmedFingerprints.toSet(),
+    );
+    if (entries == null) {
+      throw const DeltaOperationException(
+        'Delta FFI missing required symbol '
+        'axichat_dc_import_contact_public_keys',
+      );
+    }
+    return entries;
+  }
+
   @override
   Future<EmailDeltaImexResult> runImex({
     required int mode,
@@ -1444,8 +1559,7 @@ class EmailDeltaTransport implements EmailDeltaRuntime {
       return await _runImexForContext(
         context: context,
         accountId: resolvedAccountId,
-        mode: mode,
-        path: path,
+        start: () => context.startImex(mode: mode, path: path),
         timeout: timeout,
       );
     } finally {
@@ -1883,11 +1997,13 @@ class EmailDeltaTransport implements EmailDeltaRuntime {
     if (prefix == null || passphrase == null) {
       throw StateError('Transport not initialized');
     }
-    if (_useAccounts) {
-      await _openAccountsContext(prefix, passphrase);
-      return;
-    }
-    await _openSingleContext(prefix, passphrase);
+    await startupTrace.span(StartupPhase.deltaAccountsOpen, () async {
+      if (_useAccounts) {
+        await _openAccountsContext(prefix, passphrase);
+        return;
+      }
+      await _openSingleContext(prefix, passphrase);
+    });
   }
 
   Future<void> _openSingleContext(String prefix, String passphrase) async {
@@ -1960,11 +2076,15 @@ class EmailDeltaTransport implements EmailDeltaRuntime {
       exportDirectory = await _createLegacyMigrationExportDirectory(
         databaseFile,
       );
+      final exportContext = sourceContext;
+      final exportPath = exportDirectory.path;
       final exportResult = await _runImexForContext(
-        context: sourceContext,
+        context: exportContext,
         accountId: selected.accountId,
-        mode: DeltaImexMode.exportBackup,
-        path: exportDirectory.path,
+        start: () => exportContext.startImex(
+          mode: DeltaImexMode.exportBackup,
+          path: exportPath,
+        ),
         timeout: const Duration(minutes: 5),
       );
       final backupPath = await _legacyMigrationBackupPath(
@@ -1972,17 +2092,20 @@ class EmailDeltaTransport implements EmailDeltaRuntime {
         exportResult: exportResult,
       );
 
-      targetContext = await _delta.createContext(
+      final importContext = await _delta.createContext(
         databasePath: databaseFile.path,
         osName: Platform.operatingSystem,
       );
+      targetContext = importContext;
       targetCreated = true;
-      await targetContext.open(passphrase: passphrase);
+      await importContext.open(passphrase: passphrase);
       await _runImexForContext(
-        context: targetContext,
+        context: importContext,
         accountId: DeltaAccountDefaults.singleContextId,
-        mode: DeltaImexMode.importBackup,
-        path: backupPath,
+        start: () => importContext.startImex(
+          mode: DeltaImexMode.importBackup,
+          path: backupPath,
+        ),
         timeout: const Duration(minutes: 5),
       );
       migrated = true;
@@ -2164,8 +2287,7 @@ class EmailDeltaTransport implements EmailDeltaRuntime {
   Future<EmailDeltaImexResult> _runImexForContext({
     required DeltaContextHandle context,
     required int accountId,
-    required int mode,
-    required String path,
+    required Future<void> Function() start,
     required Duration timeout,
   }) async {
     final exportedPaths = <String>[];
@@ -2217,7 +2339,7 @@ class EmailDeltaTransport implements EmailDeltaRuntime {
       },
     );
     try {
-      await context.startImex(mode: mode, path: path);
+      await start();
       return await completer.future.timeout(timeout);
     } on TimeoutException {
       await context.stopOngoingProcess();
@@ -2432,11 +2554,16 @@ class EmailDeltaTransport implements EmailDeltaRuntime {
       fallbackPath: attachment.path,
     );
     final sanitizedMimeType = sanitizeEmailMimeType(attachment.mimeType);
+    final blobPath = await _importAttachmentBlob(
+      context,
+      path: attachment.path,
+      fileName: sanitizedFileName,
+    );
     if (!_persistEvents) {
       return context.sendFileMessage(
         chatId: chatId,
         viewType: _viewTypeFor(attachment),
-        filePath: attachment.path,
+        filePath: blobPath,
         fileName: sanitizedFileName,
         mimeType: sanitizedMimeType,
         text: attachment.caption,
@@ -2459,7 +2586,7 @@ class EmailDeltaTransport implements EmailDeltaRuntime {
       send: () => context.sendFileMessage(
         chatId: chatId,
         viewType: _viewTypeFor(attachment),
-        filePath: attachment.path,
+        filePath: blobPath,
         fileName: sanitizedFileName,
         mimeType: sanitizedMimeType,
         text: attachment.caption,
@@ -2478,6 +2605,181 @@ class EmailDeltaTransport implements EmailDeltaRuntime {
     return msgId;
   }
 
+  @override
+  Future<List<DeltaFanOutSendResult>> fanOutAttachment({
+    required List<int> chatIds,
+    required EmailAttachment attachment,
+    String? subject,
+    String? shareId,
+    String? captionOverride,
+    String? htmlCaption,
+    String? quotingStanzaId,
+    int? accountId,
+    bool forcePlaintext = false,
+    bool skipAutocrypt = false,
+  }) async {
+    final session = await _ensureSession(accountId: accountId);
+    if (session == null) {
+      throw StateError('Transport not initialized');
+    }
+    final context = session.context;
+    final resolvedAccountId = session.accountId;
+    final sanitizedSubject = sanitizeEmailSubjectValue(subject);
+    final coreSubject = subjectForDeltaCore(subject);
+    final sanitizedFileName = sanitizeEmailAttachmentFilename(
+      attachment.fileName,
+      fallbackPath: attachment.path,
+    );
+    final sanitizedMimeType = sanitizeEmailMimeType(attachment.mimeType);
+    final viewType = _viewTypeFor(attachment);
+    final blobPath = await _importAttachmentBlob(
+      context,
+      path: attachment.path,
+      fileName: sanitizedFileName,
+    );
+
+    final failed = <int, DeltaFanOutSendResult>{};
+    final readyChats = <int, Chat>{};
+    if (_persistEvents) {
+      for (final chatId in chatIds) {
+        try {
+          readyChats[chatId] = await _requireReadyOutgoingChat(
+            chatId: chatId,
+            accountId: resolvedAccountId,
+            context: context,
+          );
+        } on Exception catch (error) {
+          failed[chatId] = DeltaFanOutSendResult(
+            chatId: chatId,
+            error: '$error',
+          );
+        }
+      }
+    }
+    final pending = chatIds
+        .where((chatId) => !failed.containsKey(chatId))
+        .toList(growable: false);
+
+    // Core has no per-message switch for skipping Autocrypt in the native
+    // fan-out, so those sends, and libraries without the export, queue one
+    // copy at a time against the blob imported above.
+    // A failed native call fails every chat in it, so each still gets its
+    // failed-outgoing record below.
+    List<DeltaFanOutSendResult>? sent;
+    if (!skipAutocrypt && pending.isNotEmpty) {
+      try {
+        sent = await context.fanOutFileMessage(
+          chatIds: pending,
+          viewType: viewType,
+          filePath: blobPath,
+          fileName: sanitizedFileName,
+          mimeType: sanitizedMimeType,
+          text: attachment.caption,
+          subject: coreSubject,
+          html: htmlCaption,
+          forcePlaintext: forcePlaintext,
+        );
+      } on DeltaSafeException catch (error) {
+        sent = [
+          for (final chatId in pending)
+            DeltaFanOutSendResult(chatId: chatId, error: error.message),
+        ];
+      }
+    }
+    sent ??= [
+      for (final chatId in pending)
+        await _fanOutCopy(
+          chatId,
+          () => context.sendFileMessage(
+            chatId: chatId,
+            viewType: viewType,
+            filePath: blobPath,
+            fileName: sanitizedFileName,
+            mimeType: sanitizedMimeType,
+            text: attachment.caption,
+            subject: coreSubject,
+            html: htmlCaption,
+            forcePlaintext: forcePlaintext,
+            skipAutocrypt: skipAutocrypt,
+          ),
+        ),
+    ];
+
+    final resultsByChat = <int, DeltaFanOutSendResult>{
+      ...failed,
+      for (final result in sent) result.chatId: result,
+    };
+    if (_persistEvents) {
+      for (final MapEntry(key: chatId, value: chat) in readyChats.entries) {
+        final result = resultsByChat[chatId];
+        if (result != null && result.isSent) {
+          await _recordSentOutgoing(
+            session: session,
+            chatId: chatId,
+            accountId: resolvedAccountId,
+            msgId: result.msgId!,
+            quotingStanzaId: quotingStanzaId,
+            shareId: shareId,
+          );
+          continue;
+        }
+        await _recordFailedOutgoing(
+          chatId: chatId,
+          accountId: resolvedAccountId,
+          chat: chat,
+          body: attachment.caption,
+          subject: sanitizedSubject,
+          quotingStanzaId: quotingStanzaId,
+          localBodyOverride: captionOverride,
+          htmlBody: htmlCaption,
+        );
+      }
+    }
+    return [
+      for (final chatId in chatIds)
+        resultsByChat[chatId] ??
+            DeltaFanOutSendResult(chatId: chatId, error: 'not sent'),
+    ];
+  }
+
+  Future<DeltaFanOutSendResult> _fanOutCopy(
+    int chatId,
+    Future<int> Function() send,
+  ) async {
+    try {
+      return DeltaFanOutSendResult(chatId: chatId, msgId: await send());
+    } on DeltaSafeException catch (error) {
+      return DeltaFanOutSendResult(chatId: chatId, error: error.message);
+    }
+  }
+
+  /// Places the attachment in the blob directory without rewriting it where
+  /// the filesystem allows, so core's deduplicating import finds it already
+  /// in place. Falls back to the original path, which core then copies.
+  Future<String> _importAttachmentBlob(
+    DeltaContextHandle context, {
+    required String path,
+    required String fileName,
+  }) async {
+    try {
+      final imported = await context.importBlob(
+        filePath: path,
+        fileName: fileName,
+      );
+      if (imported == null) {
+        return path;
+      }
+      _log.fine(
+        'Imported attachment blob via ${imported.strategy.name} '
+        '(${imported.bytes} bytes, deduplicated: ${imported.deduplicated}).',
+      );
+      return imported.path;
+    } on DeltaSafeException catch (error, stackTrace) {
+      _log.fine('Attachment blob import failed.', error, stackTrace);
+      return path;
+    }
+  }
+
   @override
   Future<int> createContact({
     required String address,
@@ -2587,6 +2889,25 @@ class EmailDeltaTransport implements EmailDeltaRuntime {
       );
       rethrow;
     }
+    await _recordSentOutgoing(
+      session: session,
+      chatId: chatId,
+      accountId: accountId,
+      msgId: msgId,
+      quotingStanzaId: quotingStanzaId,
+      shareId: shareId,
+    );
+    return msgId;
+  }
+
+  Future<void> _recordSentOutgoing({
+    required _DeltaAccountSession session,
+    required int chatId,
+    required int accountId,
+    required int msgId,
+    String? quotingStanzaId,
+    String? shareId,
+  }) async {
     await session.consumer?.hydrateMessage(msgId);
     final db = await _databaseBuilder();
     if (shareId != null) {
@@ -2606,7 +2927,6 @@ class EmailDeltaTransport implements EmailDeltaRuntime {
         quotingStanzaId: quotingStanzaId,
       );
     }
-    return msgId;
   }
 
   Future<void> _patchOutgoingQuote({
@@ -8,6 +8,7 @@ import 'dart:ui' as ui;
 
 import 'package:axichat/src/common/app_owned_storage.dart';
 import 'package:axichat/src/email/models/email_attachment.dart';
+import 'package:axichat/src/email/transport/email_delta_rpc_lane.dart';
 import 'package:axichat/src/email/transport/email_delta_transport.dart';
 import 'package:axichat/src/localization/app_localizations.dart';
 import 'package:axichat/src/storage/database.dart';
@@ -143,11 +144,25 @@ String _emailDeltaRpcErrorMessage(Object error) {
   return 'Delta worker request failed with ${error.runtimeType}.';
 }
 
-Object _emailDeltaRpcExceptionFromRpcError(json_rpc.RpcException exception) {
-  final message = exception.message.isNotEmpty
-      ? exception.message
+Object _emailDeltaRpcExceptionFromRpcError(json_rpc.RpcException exception) =>
+    _emailDeltaRpcException(exception.message, exception.data);
+
+/// Rebuilds a failure reported on the binary lane, which carries the same
+/// message and error payload as a JSON-RPC error.
+Object _emailDeltaRpcLaneError(Object? error) {
+  final [message as String, data] = error as List<Object?>;
+  return _emailDeltaRpcException(message, data);
+}
+
+Object? _emailDeltaRpcLaneErrorPayload(Object error) => <Object?>[
+  _emailDeltaRpcErrorMessage(error),
+  _emailDeltaRpcErrorPayload(error),
+];
+
+Object _emailDeltaRpcException(String rawMessage, Object? data) {
+  final message = rawMessage.isNotEmpty
+      ? rawMessage
       : 'Delta worker request failed.';
-  final data = exception.data;
   final details = data is Map ? data : const <Object?, Object?>{};
   return switch (details['type']) {
     'DeltaConfigurationTimeoutException' =>
@@ -190,7 +205,11 @@ String? _opFromRpcMethod(String method) {
 }
 
 Object? _encodeEmailDeltaRpcValue(Object? value) {
-  if (value == null || value is bool || value is num || value is String) {
+  if (value == null ||
+      value is bool ||
+      value is num ||
+      value is String ||
+      value is SendPort) {
     return value;
   }
   if (value is Duration) {
@@ -254,6 +273,19 @@ Object? _encodeEmailDeltaRpcValue(Object? value) {
       'chatId': value.chatId,
     };
   }
+  if (value is DeltaOpenPgpKeyringEntry) {
+    return {
+      _emailDeltaRpcTypeKey: 'DeltaOpenPgpKeyringEntry',
+      'index': value.index,
+      'fingerprint': value.fingerprint,
+      'address': value.address,
+      'displayName': value.displayName,
+      'userIds': _encodeEmailDeltaRpcValue(value.userIds),
+      'contactId': value.contactId,
+      'chatId': value.chatId,
+      'reason': value.reason,
+    };
+  }
   if (value is DeltaContactPublicKeyRemoval) {
     return {
       _emailDeltaRpcTypeKey: 'DeltaContactPublicKeyRemoval',
@@ -278,6 +310,14 @@ Object? _encodeEmailDeltaRpcValue(Object? value) {
       'isEncrypted': value.isEncrypted,
     };
   }
+  if (value is DeltaFanOutSendResult) {
+    return {
+      _emailDeltaRpcTypeKey: 'DeltaFanOutSendResult',
+      'chatId': value.chatId,
+      'msgId': value.msgId,
+      'error': value.error,
+    };
+  }
   if (value is DeltaChatlistEntry) {
     return {
       _emailDeltaRpcTypeKey: 'DeltaChatlistEntry',
@@ -445,6 +485,16 @@ Object? _decodeEmailDeltaRpcValue(Object? value) {
       contactId: _intValue(map['contactId']),
       chatId: _intValue(map['chatId']),
     ),
+    'DeltaOpenPgpKeyringEntry' => DeltaOpenPgpKeyringEntry(
+      index: _intValue(map['index']),
+      fingerprint: _nullableStringValue(map['fingerprint']),
+      address: _nullableStringValue(map['address']),
+      displayName: _nullableStringValue(map['displayName']),
+      userIds: _stringListValue(map['userIds']),
+      contactId: _nullableIntValue(map['contactId']),
+      chatId: _nullableIntValue(map['chatId']),
+      reason: _nullableStringValue(map['reason']),
+    ),
     'DeltaContactPublicKeyRemoval' => DeltaContactPublicKeyRemoval(
       contactId: _intValue(map['contactId']),
       chatId: _intValue(map['chatId']),
@@ -460,6 +510,11 @@ Object? _decodeEmailDeltaRpcValue(Object? value) {
       canSend: _nullableBoolValue(map['canSend']),
       isEncrypted: _nullableBoolValue(map['isEncrypted']),
     ),
+    'DeltaFanOutSendResult' => DeltaFanOutSendResult(
+      chatId: _intValue(map['chatId']),
+      msgId: _nullableIntValue(map['msgId']),
+      error: _nullableStringValue(map['error']),
+    ),
     'DeltaChatlistEntry' => DeltaChatlistEntry(
       chatId: _intValue(map['chatId']),
       msgId: _intValue(map['msgId']),
@@ -644,6 +699,8 @@ class EmailDeltaWorkerRuntime implements EmailDeltaRuntime {
   ReceivePort? _runtimeOwnerPort;
   Isolate? _isolate;
   json_rpc.Peer? _peer;
+  EmailDeltaRpcLaneClient? _rpcLane;
+  Future<EmailDeltaRpcLaneClient>? _rpcLaneOpening;
   String? _databasePrefix;
   String? _databasePassphrase;
   String? _runtimeOwnerName;
@@ -998,6 +1055,8 @@ class EmailDeltaWorkerRuntime implements EmailDeltaRuntime {
     _exitPort = null;
     _errorPort?.close();
     _errorPort = null;
+    _rpcLane?.close();
+    _rpcLane = null;
     final peer = _peer;
     _peer = null;
     if (peer != null && requestDispose) {
@@ -1147,6 +1206,47 @@ class EmailDeltaWorkerRuntime implements EmailDeltaRuntime {
     return _decodeEmailDeltaRpcValue(result) as T;
   }
 
+  /// Sends a hot read call over the binary lane instead of JSON-RPC. The
+  /// lane is opened through [_invoke], so worker startup, initialization,
+  /// and recovery behave the same for both.
+  Future<T> _invokeLane<T>(EmailDeltaRpcOp op, List<Object?> args) async {
+    final lane = await _ensureRpcLane();
+    try {
+      return await lane.call(op, args).timeout(_requestTimeout) as T;
+    } on TimeoutException catch (error, stackTrace) {
+      await _recoverAfterTimedOutRequest(op.name, error, stackTrace);
+      throw const EmailDeltaWorkerRuntimeException(
+        'Delta worker request timed out.',
+      );
+    } on EmailDeltaRpcLaneClosedException {
+      throw const EmailDeltaWorkerRuntimeException('Delta worker stopped.');
+    }
+  }
+
+  Future<EmailDeltaRpcLaneClient> _ensureRpcLane() async {
+    final lane = _rpcLane;
+    if (lane != null) {
+      await _ensureWorkerInitialized();
+      return lane;
+    }
+    return _rpcLaneOpening ??= _openRpcLane().whenComplete(() {
+      _rpcLaneOpening = null;
+    });
+  }
+
+  Future<EmailDeltaRpcLaneClient> _openRpcLane() async {
+    final lane = await EmailDeltaRpcLaneClient.connect(
+      (replyPort) => _invoke<SendPort>('openRpcLane', {'replyPort': replyPort}),
+      decodeError: _emailDeltaRpcLaneError,
+    );
+    if (_peer == null) {
+      lane.close();
+      throw const EmailDeltaWorkerRuntimeException('Delta worker stopped.');
+    }
+    _rpcLane = lane;
+    return lane;
+  }
+
   Future<void> _recoverAfterTimedOutRequest(
     String op,
     TimeoutException error,
@@ -1576,6 +1676,32 @@ class EmailDeltaWorkerRuntime implements EmailDeltaRuntime {
     'accountId': accountId,
   });
 
+  @override
+  Future<List<DeltaOpenPgpKeyringEntry>> inspectOpenPgpKeyring({
+    required String armoredKeyring,
+    int? accountId,
+  }) async {
+    final result = await _invoke<List<Object?>>('inspectOpenPgpKeyring', {
+      'armoredKeyring': armoredKeyring,
+      'accountId': accountId,
+    });
+    return result.cast<DeltaOpenPgpKeyringEntry>().toList(growable: false);
+  }
+
+  @override
+  Future<List<DeltaOpenPgpKeyringEntry>> importContactPublicKeyring({
+    required String armoredKeyring,
+    required List<String> confirmedFingerprints,
+    int? accountId,
+  }) async {
+    final result = await _invoke<List<Object?>>('importContactPublicKeyring', {
+      'armoredKeyring': armoredKeyring,
+      'confirmedFingerprints': confirmedFingerprints,
+      'accountId': accountId,
+    });
+    return result.cast<DeltaOpenPgpKeyringEntry>().toList(growable: false);
+  }
+
   @override
   Future<EmailDeltaImexResult> runImex({
     required int mode,
@@ -1643,6 +1769,34 @@ class EmailDeltaWorkerRuntime implements EmailDeltaRuntime {
     'skipAutocrypt': skipAutocrypt,
   });
 
+  @override
+  Future<List<DeltaFanOutSendResult>> fanOutAttachment({
+    required List<int> chatIds,
+    required EmailAttachment attachment,
+    String? subject,
+    String? shareId,
+    String? captionOverride,
+    String? htmlCaption,
+    String? quotingStanzaId,
+    int? accountId,
+    bool forcePlaintext = false,
+    bool skipAutocrypt = false,
+  }) async {
+    final result = await _invoke<List<Object?>>('fanOutAttachment', {
+      'chatIds': chatIds,
+      'attachment': attachment,
+      'subject': subject,
+      'shareId': shareId,
+      'captionOverride': captionOverride,
+      'htmlCaption': htmlCaption,
+      'quotingStanzaId': quotingStanzaId,
+      'accountId': accountId,
+      'forcePlaintext': forcePlaintext,
+      'skipAutocrypt': skipAutocrypt,
+    });
+    return result.cast<DeltaFanOutSendResult>().toList(growable: false);
+  }
+
   @override
   Future<int> ensureChatForAddress({
     required String address,
@@ -1721,7 +1875,7 @@ class EmailDeltaWorkerRuntime implements EmailDeltaRuntime {
 
   @override
   Future<List<int>> getFreshMessageIds({int? accountId}) =>
-      _invoke<List<int>>('getFreshMessageIds', {'accountId': accountId});
+      _invokeLane<List<int>>(EmailDeltaRpcOp.getFreshMessageIds, [accountId]);
 
   @override
   Future<int> maxMessageId({int? accountId}) =>
@@ -1732,11 +1886,11 @@ class EmailDeltaWorkerRuntime implements EmailDeltaRuntime {
     required int afterId,
     required int limit,
     int? accountId,
-  }) => _invoke<List<int>>('messageIdsAfter', {
-    'afterId': afterId,
-    'limit': limit,
-    'accountId': accountId,
-  });
+  }) => _invokeLane<List<int>>(EmailDeltaRpcOp.messageIdsAfter, [
+    afterId,
+    limit,
+    accountId,
+  ]);
 
   @override
   Future<bool> deleteMessages(List<int> messageIds, {int? accountId}) =>
@@ -1761,18 +1915,18 @@ class EmailDeltaWorkerRuntime implements EmailDeltaRuntime {
     required int chatId,
     int? beforeMessageId,
     int? accountId,
-  }) => _invoke<List<int>>('getChatMessageIds', {
-    'chatId': chatId,
-    'beforeMessageId': beforeMessageId,
-    'accountId': accountId,
-  });
+  }) => _invokeLane<List<int>>(EmailDeltaRpcOp.getChatMessageIds, [
+    chatId,
+    beforeMessageId,
+    accountId,
+  ]);
 
   @override
   Future<void> hydrateMessages(List<int> messageIds, {int? accountId}) =>
-      _invoke<void>('hydrateMessages', {
-        'messageIds': messageIds,
-        'accountId': accountId,
-      });
+      _invokeLane<void>(EmailDeltaRpcOp.hydrateMessages, [
+        emailDeltaRpcIds(messageIds),
+        accountId,
+      ]);
 
   @override
   Future<bool> setChatVisibility({
@@ -1851,50 +2005,44 @@ class EmailDeltaWorkerRuntime implements EmailDeltaRuntime {
 
   @override
   Future<DeltaMessage?> getMessage(int messageId, {int? accountId}) =>
-      _invoke<DeltaMessage?>('getMessage', {
-        'messageId': messageId,
-        'accountId': accountId,
-      });
+      _invokeLane<DeltaMessage?>(EmailDeltaRpcOp.getMessage, [
+        messageId,
+        accountId,
+      ]);
 
   @override
   Future<DeltaMessageStatus?> getMessageStatus(
     int messageId, {
     int? accountId,
-  }) => _invoke<DeltaMessageStatus?>('getMessageStatus', {
-    'messageId': messageId,
-    'accountId': accountId,
-  });
+  }) => _invokeLane<DeltaMessageStatus?>(EmailDeltaRpcOp.getMessageStatus, [
+    messageId,
+    accountId,
+  ]);
 
   @override
   Future<List<DeltaMessage>> getMessages(
     List<int> messageIds, {
     int? accountId,
-  }) async {
-    final result = await _invoke<List<Object?>>('getMessages', {
-      'messageIds': messageIds,
-      'accountId': accountId,
-    });
-    return result.whereType<DeltaMessage>().toList(growable: false);
-  }
+  }) => _invokeLane<List<DeltaMessage>>(EmailDeltaRpcOp.getMessages, [
+    emailDeltaRpcIds(messageIds),
+    accountId,
+  ]);
 
   @override
   Future<List<DeltaMessageStatus>> getMessageStatuses(
     List<int> messageIds, {
     int? accountId,
-  }) async {
-    final result = await _invoke<List<Object?>>('getMessageStatuses', {
-      'messageIds': messageIds,
-      'accountId': accountId,
-    });
-    return result.whereType<DeltaMessageStatus>().toList(growable: false);
-  }
+  }) => _invokeLane<List<DeltaMessageStatus>>(
+    EmailDeltaRpcOp.getMessageStatuses,
+    [emailDeltaRpcIds(messageIds), accountId],
+  );
 
   @override
   Future<String?> getMessageMimeHeaders(int messageId, {int? accountId}) =>
-      _invoke<String?>('getMessageMimeHeaders', {
-        'messageId': messageId,
-        'accountId': accountId,
-      });
+      _invokeLane<String?>(EmailDeltaRpcOp.getMessageMimeHeaders, [
+        messageId,
+        accountId,
+      ]);
 
   @override
   Future<String?> getMessageRfc724Mid(int messageId, {int? accountId}) =>
@@ -1919,19 +2067,19 @@ class EmailDeltaWorkerRuntime implements EmailDeltaRuntime {
 
   @override
   Future<String?> getMessageFullHtml(int messageId, {int? accountId}) =>
-      _invoke<String?>('getMessageFullHtml', {
-        'messageId': messageId,
-        'accountId': accountId,
-      });
+      _invokeLane<String?>(EmailDeltaRpcOp.getMessageFullHtml, [
+        messageId,
+        accountId,
+      ]);
 
   @override
   Future<DeltaMessageRfc822Body?> getMessageRfc822Body(
     int messageId, {
     int? accountId,
-  }) => _invoke<DeltaMessageRfc822Body?>('getMessageRfc822Body', {
-    'messageId': messageId,
-    'accountId': accountId,
-  });
+  }) => _invokeLane<DeltaMessageRfc822Body?>(
+    EmailDeltaRpcOp.getMessageRfc822Body,
+    [messageId, accountId],
+  );
 
   @override
   Future<List<int>> getContactIds({
@@ -2011,6 +2159,7 @@ final class _EmailDeltaWorkerServer {
   final String? _xmppSelfJid;
   ReceivePort? _workerOwnerPort;
   json_rpc.Peer? _peer;
+  EmailDeltaRpcLaneServer? _rpcLane;
   int _activeRequests = 0;
   Completer<void>? _idleCompleter;
   Completer<void>? _gateOpened;
@@ -2108,6 +2257,8 @@ final class _EmailDeltaWorkerServer {
   }
 
   Future<void> dispose() async {
+    _rpcLane?.close();
+    _rpcLane = null;
     try {
       await _transport.dispose();
     } finally {
@@ -2136,7 +2287,7 @@ final class _EmailDeltaWorkerServer {
   Future<Object?> _dispatchTracked(String op, json_rpc.Parameters params) {
     final payload = _decodedRpcParams(params);
     if (!_exclusiveOps.contains(op)) {
-      return _runShared(op, payload);
+      return _runShared(() => _dispatch(op, payload));
     }
     final previous = _exclusiveTail;
     final run = () async {
@@ -2155,14 +2306,14 @@ final class _EmailDeltaWorkerServer {
     return run;
   }
 
-  Future<Object?> _runShared(String op, Map<String, Object?> payload) async {
+  Future<Object?> _runShared(Future<Object?> Function() request) async {
     while (_exclusiveGateClosed) {
       final gate = _gateOpened ??= Completer<void>();
       await gate.future;
     }
     _activeRequests += 1;
     try {
-      return await _dispatch(op, payload);
+      return await request();
     } finally {
       _activeRequests -= 1;
       if (_activeRequests == 0) {
@@ -2179,10 +2330,81 @@ final class _EmailDeltaWorkerServer {
     }
   }
 
+  Future<Object?> _dispatchLane(EmailDeltaRpcOp op, List<Object?> args) {
+    return _runShared(() async {
+      switch (op) {
+        case EmailDeltaRpcOp.getMessage:
+          return _transport.getMessage(
+            args[0] as int,
+            accountId: args[1] as int?,
+          );
+        case EmailDeltaRpcOp.getMessageStatus:
+          return _transport.getMessageStatus(
+            args[0] as int,
+            accountId: args[1] as int?,
+          );
+        case EmailDeltaRpcOp.getMessages:
+          return _transport.getMessages(
+            emailDeltaRpcIdsArgument(args[0]),
+            accountId: args[1] as int?,
+          );
+        case EmailDeltaRpcOp.getMessageStatuses:
+          return _transport.getMessageStatuses(
+            emailDeltaRpcIdsArgument(args[0]),
+            accountId: args[1] as int?,
+          );
+        case EmailDeltaRpcOp.hydrateMessages:
+          await _transport.hydrateMessages(
+            emailDeltaRpcIdsArgument(args[0]),
+            accountId: args[1] as int?,
+          );
+          return null;
+        case EmailDeltaRpcOp.getChatMessageIds:
+          return _transport.getChatMessageIds(
+            chatId: args[0] as int,
+            beforeMessageId: args[1] as int?,
+            accountId: args[2] as int?,
+          );
+        case EmailDeltaRpcOp.messageIdsAfter:
+          return _transport.messageIdsAfter(
+            afterId: args[0] as int,
+            limit: args[1] as int,
+            accountId: args[2] as int?,
+          );
+        case EmailDeltaRpcOp.getFreshMessageIds:
+          return _transport.getFreshMessageIds(accountId: args[0] as int?);
+        case EmailDeltaRpcOp.getMessageMimeHeaders:
+          return _transport.getMessageMimeHeaders(
+            args[0] as int,
+            accountId: args[1] as int?,
+          );
+        case EmailDeltaRpcOp.getMessageFullHtml:
+          return _transport.getMessageFullHtml(
+            args[0] as int,
+            accountId: args[1] as int?,
+          );
+        case EmailDeltaRpcOp.getMessageRfc822Body:
+          return _transport.getMessageRfc822Body(
+            args[0] as int,
+            accountId: args[1] as int?,
+          );
+      }
+    });
+  }
+
   Future<Object?> _dispatch(String op, Map<String, Object?> payload) async {
     switch (op) {
       case 'runtimeState':
         return _runtimeState();
+      case 'openRpcLane':
+        _rpcLane?.close();
+        final lane = EmailDeltaRpcLaneServer(
+          replyPort: payload['replyPort'] as SendPort,
+          handler: _dispatchLane,
+          encodeError: _emailDeltaRpcLaneErrorPayload,
+        );
+        _rpcLane = lane;
+        return lane.sendPort;
       case 'updateEmailEncryptionBetaSettings':
         _transport.updateEmailEncryptionBetaSettings(
           (payload['enabledByAddress'] as Map).cast<String, bool>(),
@@ -2333,6 +2555,19 @@ final class _EmailDeltaWorkerServer {
           armoredPublicKey: payload['armoredPublicKey'] as String,
           accountId: payload['accountId'] as int?,
         );
+      case 'inspectOpenPgpKeyring':
+        return _transport.inspectOpenPgpKeyring(
+          armoredKeyring: payload['armoredKeyring'] as String,
+          accountId: payload['accountId'] as int?,
+        );
+      case 'importContactPublicKeyring':
+        return _transport.importContactPublicKeyring(
+          armoredKeyring: payload['armoredKeyring'] as String,
+          confirmedFingerprints: _stringListValue(
+            payload['confirmedFingerprints'],
+          ),
+          accountId: payload['accountId'] as int?,
+        );
       case 'runImex':
         return _transport.runImex(
           mode: payload['mode'] as int,
@@ -2369,6 +2604,19 @@ final class _EmailDeltaWorkerServer {
           forcePlaintext: payload['forcePlaintext'] as bool,
           skipAutocrypt: payload['skipAutocrypt'] as bool,
         );
+      case 'fanOutAttachment':
+        return _transport.fanOutAttachment(
+          chatIds: _intListValue(payload['chatIds']),
+          attachment: payload['attachment'] as EmailAttachment,
+          subject: payload['subject'] as String?,
+          shareId: payload['shareId'] as String?,
+          captionOverride: payload['captionOverride'] as String?,
+          htmlCaption: payload['htmlCaption'] as String?,
+          quotingStanzaId: payload['quotingStanzaId'] as String?,
+          accountId: payload['accountId'] as int?,
+          forcePlaintext: payload['forcePlaintext'] as bool,
+          skipAutocrypt: payload['skipAutocrypt'] as bool,
+        );
       case 'ensureChatForAddress':
         return _transport.ensureChatForAddress(
           address: payload['address'] as String,
@@ -2416,18 +2664,8 @@ final class _EmailDeltaWorkerServer {
           payload['chatId'] as int,
           accountId: payload['accountId'] as int?,
         );
-      case 'getFreshMessageIds':
-        return _transport.getFreshMessageIds(
-          accountId: payload['accountId'] as int?,
-        );
       case 'maxMessageId':
         return _transport.maxMessageId(accountId: payload['accountId'] as int?);
-      case 'messageIdsAfter':
-        return _transport.messageIdsAfter(
-          afterId: payload['afterId'] as int,
-          limit: payload['limit'] as int,
-          accountId: payload['accountId'] as int?,
-        );
       case 'deleteMessages':
         return _transport.deleteMessages(
           (payload['messageIds'] as List).cast<int>(),
@@ -2439,18 +2677,6 @@ final class _EmailDeltaWorkerServer {
           query: payload['query'] as String,
           accountId: payload['accountId'] as int?,
         );
-      case 'getChatMessageIds':
-        return _transport.getChatMessageIds(
-          chatId: payload['chatId'] as int,
-          beforeMessageId: payload['beforeMessageId'] as int?,
-          accountId: payload['accountId'] as int?,
-        );
-      case 'hydrateMessages':
-        await _transport.hydrateMessages(
-          (payload['messageIds'] as List).cast<int>(),
-          accountId: payload['accountId'] as int?,
-        );
-        return null;
       case 'setChatVisibility':
         return _transport.setChatVisibility(
           chatId: payload['chatId'] as int,
@@ -2495,31 +2721,6 @@ final class _EmailDeltaWorkerServer {
           payload['chatId'] as int,
           accountId: payload['accountId'] as int?,
         );
-      case 'getMessage':
-        return _transport.getMessage(
-          payload['messageId'] as int,
-          accountId: payload['accountId'] as int?,
-        );
-      case 'getMessageStatus':
-        return _transport.getMessageStatus(
-          payload['messageId'] as int,
-          accountId: payload['accountId'] as int?,
-        );
-      case 'getMessages':
-        return _transport.getMessages(
-          (payload['messageIds'] as List).cast<int>(),
-          accountId: payload['accountId'] as int?,
-        );
-      case 'getMessageStatuses':
-        return _transport.getMessageStatuses(
-          (payload['messageIds'] as List).cast<int>(),
-          accountId: payload['accountId'] as int?,
-        );
-      case 'getMessageMimeHeaders':
-        return _transport.getMessageMimeHeaders(
-          payload['messageId'] as int,
-          accountId: payload['accountId'] as int?,
-        );
       case 'getMessageRfc724Mid':
         return _transport.getMessageRfc724Mid(
           payload['messageId'] as int,
@@ -2535,16 +2736,6 @@ final class _EmailDeltaWorkerServer {
           payload['messageId'] as int,
           accountId: payload['accountId'] as int?,
         );
-      case 'getMessageFullHtml':
-        return _transport.getMessageFullHtml(
-          payload['messageId'] as int,
-          accountId: payload['accountId'] as int?,
-        );
-      case 'getMessageRfc822Body':
-        return _transport.getMessageRfc822Body(
-          payload['messageId'] as int,
-          accountId: payload['accountId'] as int?,
-        );
       case 'getContactIds':
         return _transport.getContactIds(
           flags: payload['flags'] as int,
@@ -148,18 +148,60 @@ class _EmailContactImportDialogState extends State<EmailContactImportDialog> {
     if (file == null) {
       return;
     }
+    if (_format.isOpenPgpKeyring) {
+      context.read<EmailContactImportCubit>().inspectPublicKeyring(file);
+      return;
+    }
     context.read<EmailContactImportCubit>().importContacts(
       file: file,
       format: _format,
     );
   }
 
+  Future<void> _confirmKeyringKeys(
+    EmailContactImportKeyringConfirmationRequired state,
+  ) async {
+    final l10n = context.l10n;
+    final confirmedFingerprints = <String>{};
+    for (final key in state.keys) {
+      final identities = key.userIds.isEmpty
+          ? l10n.emailEncryptionKeyIdentityNoIdentities
+          : key.userIds.join(', ');
+      final confirmed = await confirm(
+        context,
+        title: l10n.contactEmailEncryptionIdentityWarningTitle,
+        message: l10n.emailContactsImportKeyringConfirmBody(
+          key.address!,
+          key.fingerprint!,
+          identities,
+        ),
+        confirmLabel: l10n.commonContinue,
+        cancelLabel: l10n.commonCancel,
+        destructiveConfirm: false,
+      );
+      if (!mounted) {
+        return;
+      }
+      if (confirmed == true) {
+        confirmedFingerprints.add(key.fingerprint!);
+      }
+    }
+    await context.read<EmailContactImportCubit>().importPublicKeyring(
+      file: state.file,
+      confirmedFingerprints: confirmedFingerprints,
+    );
+  }
+
   @override
   Widget build(BuildContext context) {
     final l10n = context.l10n;
     final spacing = context.spacing;
     return BlocConsumer<EmailContactImportCubit, EmailContactImportState>(
       listener: (context, state) {
+        if (state is EmailContactImportKeyringConfirmationRequired) {
+          _confirmKeyringKeys(state);
+          return;
+        }
         final showToast = ShadToaster.maybeOf(context)?.show;
         if (showToast == null) {
           return;
@@ -193,7 +235,9 @@ class _EmailContactImportDialogState extends State<EmailContactImportDialog> {
         }
       },
       builder: (context, state) {
-        final bool loading = state is EmailContactImportInProgress;
+        final bool loading =
+            state is EmailContactImportInProgress ||
+            state is EmailContactImportKeyringConfirmationRequired;
         final bool importEnabled = _selectedFile != null && !loading;
         final String fileLabel =
             _selectedFileName ?? l10n.emailContactsImportNoFile;
@@ -295,6 +339,8 @@ extension EmailContactImportFormatLabel on EmailContactImportFormat {
         return l10n.emailContactsImportFormatGenericCsv;
       case EmailContactImportFormat.vcard:
         return l10n.emailContactsImportFormatVcard;
+      case EmailContactImportFormat.openPgpKeyring:
+        return l10n.emailContactsImportFormatOpenPgpKeyring;
     }
   }
 }
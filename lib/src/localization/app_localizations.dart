@@ -8785,6 +8785,22 @@ abstract class AppLocalizations {
   /// **'vCard (VCF)'**
   String get emailContactsImportFormatVcard;
 
+  /// No description provided for @emailContactsImportFormatOpenPgpKeyring.
+  ///
+  /// In en, this message translates to:
+  /// **'OpenPGP keyring'**
+  String get emailContactsImportFormatOpenPgpKeyring;
+
+  /// No description provided for @emailContactsImportKeyringConfirmBody.
+  ///
+  /// In en, this message translates to:
+  /// **'Trust this key for {address}? Fingerprint: {fingerprint}. Identities: {identities}. The address comes from the key itself, so continue only if you verified this key belongs to this contact.'**
+  String emailContactsImportKeyringConfirmBody(
+    Object address,
+    Object fingerprint,
+    Object identities,
+  );
+
   /// No description provided for @emailContactsImportNoValidContacts.
   ///
   /// In en, this message translates to:
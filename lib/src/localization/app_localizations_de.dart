@@ -5036,6 +5036,18 @@ class AppLocalizationsDe extends AppLocalizations {
   @override
   String get emailContactsImportFormatVcard => 'vCard (VCF)';
 
+  @override
+  String get emailContactsImportFormatOpenPgpKeyring => 'OpenPGP-Schlüsselbund';
+
+  @override
+  String emailContactsImportKeyringConfirmBody(
+    Object address,
+    Object fingerprint,
+    Object identities,
+  ) {
+    return 'Diesem Schlüssel für $address vertrauen? Fingerabdruck: $fingerprint. Identitäten: $identities. Die Adresse stammt aus dem Schlüssel selbst, fahre also nur fort, wenn du überprüft hast, dass dieser Schlüssel zu diesem Kontakt gehört.';
+  }
+
   @override
   String get emailContactsImportNoValidContacts =>
       'Keine gültigen Kontakte gefunden.';
@@ -4940,6 +4940,18 @@ class AppLocalizationsEn extends AppLocalizations {
   @override
   String get emailContactsImportFormatVcard => 'vCard (VCF)';
 
+  @override
+  String get emailContactsImportFormatOpenPgpKeyring => 'OpenPGP keyring';
+
+  @override
+  String emailContactsImportKeyringConfirmBody(
+    Object address,
+    Object fingerprint,
+    Object identities,
+  ) {
+    return 'Trust this key for $address? Fingerprint: $fingerprint. Identities: $identities. The address comes from the key itself, so continue only if you verified this key belongs to this contact.';
+  }
+
   @override
   String get emailContactsImportNoValidContacts => 'No valid contacts found.';
 
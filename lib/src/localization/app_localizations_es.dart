@@ -5026,6 +5026,18 @@ class AppLocalizationsEs extends AppLocalizations {
   @override
   String get emailContactsImportFormatVcard => 'vCard (VCF)';
 
+  @override
+  String get emailContactsImportFormatOpenPgpKeyring => 'Llavero OpenPGP';
+
+  @override
+  String emailContactsImportKeyringConfirmBody(
+    Object address,
+    Object fingerprint,
+    Object identities,
+  ) {
+    return '¿Confiar en esta clave para $address? Huella: $fingerprint. Identidades: $identities. La dirección proviene de la propia clave, así que continúa solo si verificaste que esta clave pertenece a este contacto.';
+  }
+
   @override
   String get emailContactsImportNoValidContacts =>
       'No se encontraron contactos válidos.';
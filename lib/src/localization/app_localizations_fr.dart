@@ -5049,6 +5049,18 @@ class AppLocalizationsFr extends AppLocalizations {
   @override
   String get emailContactsImportFormatVcard => 'vCard (VCF)';
 
+  @override
+  String get emailContactsImportFormatOpenPgpKeyring => 'Trousseau OpenPGP';
+
+  @override
+  String emailContactsImportKeyringConfirmBody(
+    Object address,
+    Object fingerprint,
+    Object identities,
+  ) {
+    return 'Faire confiance à cette clé pour $address ? Empreinte : $fingerprint. Identités : $identities. L’adresse provient de la clé elle-même : continuez uniquement si vous avez vérifié que cette clé appartient à ce contact.';
+  }
+
   @override
   String get emailContactsImportNoValidContacts =>
       'Aucun contact valide trouvé.';
@@ -4748,6 +4748,18 @@ class AppLocalizationsZh extends AppLocalizations {
   @override
   String get emailContactsImportFormatVcard => 'vCard (VCF)';
 
+  @override
+  String get emailContactsImportFormatOpenPgpKeyring => 'OpenPGP 密钥环';
+
+  @override
+  String emailContactsImportKeyringConfirmBody(
+    Object address,
+    Object fingerprint,
+    Object identities,
+  ) {
+    return '信任 $address 的此密钥？指纹：$fingerprint。身份：$identities。该地址来自密钥本身，只有在你确认此密钥属于该联系人后才继续。';
+  }
+
   @override
   String get emailContactsImportNoValidContacts => '未找到有效联系人。';
 
@@ -12228,6 +12240,18 @@ class AppLocalizationsZhHk extends AppLocalizationsZh {
   @override
   String get emailContactsImportFormatVcard => 'vCard (VCF)';
 
+  @override
+  String get emailContactsImportFormatOpenPgpKeyring => 'OpenPGP 密鑰環';
+
+  @override
+  String emailContactsImportKeyringConfirmBody(
+    Object address,
+    Object fingerprint,
+    Object identities,
+  ) {
+    return '信任 $address 的此金鑰？指紋：$fingerprint。身份：$identities。該地址來自金鑰本身，只有在你確認此金鑰屬於該聯絡人後才繼續。';
+  }
+
   @override
   String get emailContactsImportNoValidContacts => '找不到有效聯絡人。';
 
@@ -22,6 +22,9 @@ class RosterCubit extends Cubit<RosterState> with BlocCache<RosterState> {
   RosterCubit({required RosterService rosterService})
     : _rosterService = rosterService,
       super(const RosterState()) {
+    if (_rosterService.cachedRoster case final cached?) {
+      _handleRoster(cached);
+    }
     _rosterSubscription = _rosterService.rosterStream().listen(_handleRoster);
     _invitesSubscription = _rosterService.invitesStream().listen(
       _handleInvites,
@@ -0,0 +1,123 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+// Copyright (C) 2025-present Eliot Lew, Axichat Developers
+
+import 'package:axichat/src/common/memory_budget.dart';
+import 'package:axichat/src/common/ui/ui.dart';
+import 'package:flutter/foundation.dart';
+import 'package:flutter/material.dart';
+
+const String _memoryPanelTitle = 'Memory';
+const String _memoryPanelCachesLabel = 'Caches';
+const String _memoryPanelRssLabel = 'Resident';
+const String _memoryPanelTrimsLabel = 'Trims';
+const String _memoryPanelRssTrimsLabel = 'Resident trims';
+const String _memoryPanelSampleLabel = 'Sample';
+const String _memoryPanelTrimLabel = 'Trim';
+const String _memoryPanelUnavailable = 'n/a';
+const String _memoryPanelSeparator = ' / ';
+
+/// Diagnostics for [MemoryBudget]: per-cache usage against the cache budget
+/// and the process resident set against its soft limit. Not localized; only
+/// shown in debug and profile builds.
+class MemoryBudgetPanel extends StatelessWidget {
+  MemoryBudgetPanel({super.key, MemoryBudget? budget})
+    : assert(!kReleaseMode),
+      budget = budget ?? MemoryBudget.instance;
+
+  final MemoryBudget budget;
+
+  @override
+  Widget build(BuildContext context) {
+    final spacing = context.spacing;
+    return ListItemPadding(
+      child: ValueListenableBuilder<MemoryBudgetSnapshot>(
+        valueListenable: budget.usage,
+        builder: (context, snapshot, _) {
+          final int? rss = snapshot.rssBytes;
+          return Column(
+            crossAxisAlignment: CrossAxisAlignment.start,
+            children: [
+              Text(_memoryPanelTitle, style: context.textTheme.small.strong),
+              SizedBox(height: spacing.s),
+              for (final cache in snapshot.caches)
+                _MemoryBudgetRow(
+                  label: cache.name,
+                  value: _formatMebibytes(cache.bytes),
+                ),
+              _MemoryBudgetRow(
+                label: _memoryPanelCachesLabel,
+                value:
+                    '${_formatMebibytes(snapshot.cacheBytes)}'
+                    '$_memoryPanelSeparator'
+                    '${_formatMebibytes(snapshot.budgetBytes)}',
+                strong: true,
+              ),
+              _MemoryBudgetRow(
+                label: _memoryPanelRssLabel,
+                value: rss == null
+                    ? _memoryPanelUnavailable
+                    : '${_formatMebibytes(rss)}'
+                          '$_memoryPanelSeparator'
+                          '${_formatMebibytes(snapshot.rssSoftLimitBytes)}',
+              ),
+              _MemoryBudgetRow(
+                label: _memoryPanelTrimsLabel,
+                value: '${snapshot.trimCount} (${snapshot.lastPressure.name})',
+              ),
+              if (snapshot.rssTrimStreak > 0)
+                _MemoryBudgetRow(
+                  label: _memoryPanelRssTrimsLabel,
+                  value: '${snapshot.rssTrimStreak}',
+                ),
+              SizedBox(height: spacing.s),
+              Wrap(
+                spacing: spacing.s,
+                children: [
+                  AxiButton.outline(
+                    onPressed: budget.sample,
+                    child: const Text(_memoryPanelSampleLabel),
+                  ),
+                  AxiButton.outline(
+                    onPressed: () => budget.relieve(
+                      MemoryPressure.moderate,
+                      reason: 'manual',
+                    ),
+                    child: const Text(_memoryPanelTrimLabel),
+                  ),
+                ],
+              ),
+            ],
+          );
+        },
+      ),
+    );
+  }
+}
+
+class _MemoryBudgetRow extends StatelessWidget {
+  const _MemoryBudgetRow({
+    required this.label,
+    required this.value,
+    this.strong = false,
+  });
+
+  final String label;
+  final String value;
+  final bool strong;
+
+  @override
+  Widget build(BuildContext context) {
+    final style = strong
+        ? context.textTheme.small.strong
+        : context.textTheme.muted;
+    return Row(
+      children: [
+        Expanded(child: Text(label, style: style)),
+        Text(value, style: style),
+      ],
+    );
+  }
+}
+
+String _formatMebibytes(int bytes) =>
+    '${(bytes / (1 << 20)).toStringAsFixed(1)} MiB';
@@ -26,6 +26,7 @@ import 'package:axichat/src/profile/utils/contact_exporter.dart';
 import 'package:axichat/src/profile/view/contact_export_sheet.dart';
 import 'package:axichat/src/routes.dart';
 import 'package:axichat/src/settings/bloc/settings_cubit.dart';
+import 'package:axichat/src/settings/view/memory_budget_panel.dart';
 import 'package:axichat/src/storage/models.dart';
 import 'package:file_picker/file_picker.dart';
 import 'package:flutter/foundation.dart';
@@ -874,6 +875,7 @@ class SettingsControls extends StatelessWidget {
               link: donateUrl,
               faIconData: FontAwesomeIcons.heart,
             ),
+            if (!kReleaseMode) MemoryBudgetPanel(),
             SizedBox(height: spacing.xxl),
           ],
         );
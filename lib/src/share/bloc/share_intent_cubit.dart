@@ -3,9 +3,11 @@
 
 import 'dart:async';
 
+import 'package:axichat/src/share/desktop_launch_channel.dart';
 import 'package:bloc/bloc.dart';
 import 'package:flutter/foundation.dart';
 import 'package:flutter/services.dart';
+import 'package:mime/mime.dart';
 import 'package:share_handler/share_handler.dart';
 
 class ShareAttachmentPayload {
@@ -65,14 +67,23 @@ class ShareIntentCubit extends Cubit<ShareIntentState> {
   static const int _maxSharedAttachmentCount = 32;
   static const int _maxSharedAttachmentPathLength = 4096;
 
-  ShareIntentCubit({ShareHandlerPlatform? handler})
-    : _handler = handler ?? ShareHandlerPlatform.instance,
-      super(const ShareIntentState.idle());
+  ShareIntentCubit({
+    ShareHandlerPlatform? handler,
+    DesktopLaunchChannel? desktopLaunch,
+  }) : _handler = handler ?? ShareHandlerPlatform.instance,
+       _desktopLaunch = desktopLaunch ?? desktopLaunchChannel,
+       super(const ShareIntentState.idle());
 
   final ShareHandlerPlatform _handler;
+  final DesktopLaunchChannel _desktopLaunch;
   StreamSubscription<SharedMedia>? _subscription;
+  StreamSubscription<List<Uri>>? _desktopLaunchSubscription;
 
   Future<void> initialize() async {
+    if (DesktopLaunchChannel.isSupportedPlatform) {
+      await _initializeDesktopLaunch();
+      return;
+    }
     if (!_isSupportedPlatform) {
       return;
     }
@@ -129,6 +140,24 @@ class ShareIntentCubit extends Cubit<ShareIntentState> {
     }
   }
 
+  Future<void> _initializeDesktopLaunch() async {
+    if (_desktopLaunchSubscription != null) {
+      return;
+    }
+    _desktopLaunchSubscription = _desktopLaunch.launches.listen(
+      _handleDesktopLaunch,
+    );
+    await _desktopLaunch.start();
+  }
+
+  void _handleDesktopLaunch(List<Uri> uris) {
+    final SharePayload? payload = _sanitizeDesktopLaunch(uris);
+    if (payload == null) {
+      return;
+    }
+    emit(ShareIntentState.ready(payload));
+  }
+
   void _handleMedia(SharedMedia media) {
     final SharePayload? payload = _sanitizePayload(media);
     if (payload == null) {
@@ -162,6 +191,37 @@ class ShareIntentCubit extends Cubit<ShareIntentState> {
     );
   }
 
+  SharePayload? _sanitizeDesktopLaunch(List<Uri> uris) {
+    final List<ShareAttachmentPayload> files = <ShareAttachmentPayload>[];
+    final List<String> links = <String>[];
+    for (final uri in uris) {
+      if (uri.isScheme('file')) {
+        final String path = uri.toFilePath();
+        files.add(
+          ShareAttachmentPayload(path: path, type: _attachmentTypeFor(path)),
+        );
+        continue;
+      }
+      links.add(uri.toString());
+    }
+    final String? sanitizedText = _sanitizeSharedText(links.join('\n'));
+    final List<ShareAttachmentPayload> attachments =
+        _sanitizeAttachmentPayloads(files);
+    if (sanitizedText == null && attachments.isEmpty) {
+      return null;
+    }
+    return SharePayload(text: sanitizedText, attachments: attachments);
+  }
+
+  SharedAttachmentType _attachmentTypeFor(String path) {
+    final String? mimeType = lookupMimeType(path);
+    if (mimeType == null) return SharedAttachmentType.file;
+    if (mimeType.startsWith('image/')) return SharedAttachmentType.image;
+    if (mimeType.startsWith('video/')) return SharedAttachmentType.video;
+    if (mimeType.startsWith('audio/')) return SharedAttachmentType.audio;
+    return SharedAttachmentType.file;
+  }
+
   String? _sanitizeSharedText(String text) {
     final String normalized = text.replaceAll('\u0000', '').trim();
     if (normalized.isEmpty) {
@@ -190,10 +250,22 @@ class ShareIntentCubit extends Cubit<ShareIntentState> {
     if (attachments == null || attachments.isEmpty) {
       return const <ShareAttachmentPayload>[];
     }
+    return _sanitizeAttachmentPayloads(
+      attachments.nonNulls.map(
+        (attachment) => ShareAttachmentPayload(
+          path: attachment.path,
+          type: attachment.type,
+        ),
+      ),
+    );
+  }
+
+  List<ShareAttachmentPayload> _sanitizeAttachmentPayloads(
+    Iterable<ShareAttachmentPayload> attachments,
+  ) {
     final Set<String> seenPaths = <String>{};
     final List<ShareAttachmentPayload> sanitized = <ShareAttachmentPayload>[];
     for (final attachment in attachments) {
-      if (attachment == null) continue;
       final String path = attachment.path.trim();
       if (path.isEmpty) continue;
       if (path.length > _maxSharedAttachmentPathLength) continue;
@@ -211,6 +283,8 @@ class ShareIntentCubit extends Cubit<ShareIntentState> {
   Future<void> close() async {
     await _subscription?.cancel();
     _subscription = null;
+    await _desktopLaunchSubscription?.cancel();
+    _desktopLaunchSubscription = null;
     return super.close();
   }
 }
@@ -0,0 +1,116 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+// Copyright (C) 2025-present Eliot Lew, Axichat Developers
+
+import 'dart:async';
+
+import 'package:flutter/foundation.dart';
+import 'package:flutter/services.dart';
+import 'package:logging/logging.dart';
+
+/// Talks to the Linux runner about how the app was launched: files and URIs
+/// opened in this instance (including the payload a second launch forwards
+/// over D-Bus), whether the Flutter view is currently attached to a window
+/// or running headless in background mode, and low-memory warnings from the
+/// desktop session.
+class DesktopLaunchChannel {
+  DesktopLaunchChannel({MethodChannel? channel})
+    : _channel = channel ?? const MethodChannel(_channelName);
+
+  static const String _channelName = 'im.axi.axichat/instance';
+  static const String _takePendingUrisMethod = 'takePendingUris';
+  static const String _launchPendingMethod = 'launchPending';
+  static const String _getWindowAttachedMethod = 'getWindowAttached';
+  static const String _windowAttachedMethod = 'windowAttached';
+  static const String _lowMemoryWarningMethod = 'lowMemoryWarning';
+  static final Logger _log = Logger('DesktopLaunchChannel');
+
+  final MethodChannel _channel;
+  late final StreamController<List<Uri>> _controller =
+      StreamController<List<Uri>>.broadcast(
+        onListen: () => unawaited(_drainPendingUris()),
+      );
+  final ValueNotifier<bool> _windowAttached = ValueNotifier<bool>(true);
+  final StreamController<int> _lowMemoryWarnings =
+      StreamController<int>.broadcast();
+  bool _started = false;
+
+  /// Launch payloads. URIs stay queued in the runner until someone listens,
+  /// so a payload delivered before the UI subscribes is not lost.
+  Stream<List<Uri>> get launches => _controller.stream;
+
+  ValueListenable<bool> get windowAttached => _windowAttached;
+
+  /// `GMemoryMonitorWarningLevel` values: 50 (low), 100 (medium) and 255
+  /// (critical, the process is about to be killed).
+  Stream<int> get lowMemoryWarnings => _lowMemoryWarnings.stream;
+
+  static const int criticalMemoryWarningLevel = 255;
+
+  static bool get isSupportedPlatform =>
+      !kIsWeb && defaultTargetPlatform == TargetPlatform.linux;
+
+  Future<void> start() async {
+    if (!isSupportedPlatform || _started) return;
+    _started = true;
+    _channel.setMethodCallHandler(_handleMethodCall);
+    try {
+      final attached = await _channel.invokeMethod<bool>(
+        _getWindowAttachedMethod,
+      );
+      if (attached != null) {
+        _windowAttached.value = attached;
+      }
+    } on MissingPluginException {
+      return;
+    } on PlatformException catch (error, stackTrace) {
+      _log.fine('Failed to read window attachment state.', error, stackTrace);
+    }
+    if (_controller.hasListener) {
+      await _drainPendingUris();
+    }
+  }
+
+  Future<Object?> _handleMethodCall(MethodCall call) async {
+    switch (call.method) {
+      case _launchPendingMethod:
+        if (_controller.hasListener) {
+          await _drainPendingUris();
+        }
+        return null;
+      case _windowAttachedMethod:
+        _windowAttached.value = call.arguments == true;
+        return null;
+      case _lowMemoryWarningMethod:
+        final level = call.arguments;
+        if (level is int) {
+          _lowMemoryWarnings.add(level);
+        }
+        return null;
+    }
+    throw MissingPluginException('Unknown method ${call.method}');
+  }
+
+  Future<void> _drainPendingUris() async {
+    if (!_started) return;
+    final List<String>? raw;
+    try {
+      raw = await _channel.invokeListMethod<String>(_takePendingUrisMethod);
+    } on MissingPluginException {
+      return;
+    } on PlatformException catch (error, stackTrace) {
+      _log.fine('Failed to read pending launch URIs.', error, stackTrace);
+      return;
+    }
+    if (raw == null || raw.isEmpty) return;
+    final uris = <Uri>[];
+    for (final value in raw) {
+      final uri = Uri.tryParse(value);
+      if (uri == null || !uri.hasScheme) continue;
+      uris.add(uri);
+    }
+    if (uris.isEmpty) return;
+    _controller.add(List<Uri>.unmodifiable(uris));
+  }
+}
+
+final desktopLaunchChannel = DesktopLaunchChannel();
@@ -14,6 +14,7 @@ import 'package:axichat/src/common/address_tools.dart';
 import 'package:axichat/src/common/anti_abuse_sync.dart';
 import 'package:axichat/src/common/app_owned_storage.dart';
 import 'package:axichat/src/common/safe_logging.dart';
+import 'package:axichat/src/common/startup/startup_trace.dart';
 import 'package:axichat/src/common/transport.dart';
 import 'package:axichat/src/email/util/delta_message_ids.dart';
 import 'package:axichat/src/email/util/email_message_ids.dart';
@@ -919,6 +920,10 @@ abstract interface class XmppDatabase implements Database {
 
   Future<void> upsertEmailTrustedContactKey(EmailTrustedContactKeyData key);
 
+  Future<void> upsertEmailTrustedContactKeys(
+    List<EmailTrustedContactKeyData> keys,
+  );
+
   Future<void> deleteEmailTrustedContactKey({
     required int deltaAccountId,
     required String address,
@@ -2882,6 +2887,7 @@ WHERE transport IS NULL
         }
       },
       beforeOpen: (_) async {
+        startupTrace.end(StartupPhase.sqlcipherOpen);
         await customStatement('PRAGMA foreign_keys = ON');
         await _repairRestoredArchiveJids();
         await repairMixedChatTransports();
@@ -9429,6 +9435,16 @@ ORDER BY pinned_at DESC, message_reference_id DESC
     await into(emailTrustedContactKeys).insertOnConflictUpdate(key);
   }
 
+  @override
+  Future<void> upsertEmailTrustedContactKeys(
+    List<EmailTrustedContactKeyData> keys,
+  ) async {
+    if (keys.isEmpty) return;
+    await batch((batch) {
+      batch.insertAllOnConflictUpdate(emailTrustedContactKeys, keys);
+    });
+  }
+
   @override
   Future<void> deleteEmailTrustedContactKey({
     required int deltaAccountId,
@@ -14201,6 +14217,7 @@ String? _trimmedReferenceValue(String? value) {
 
 QueryExecutor _openDatabase(File file, String passphrase) {
   return LazyDatabase(() async {
+    startupTrace.begin(StartupPhase.sqlcipherOpen);
     final token = RootIsolateToken.instance!;
     if (kDebugMode) {
       // await file.delete();
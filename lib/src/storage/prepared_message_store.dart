@@ -0,0 +1,240 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+// Copyright (C) 2025-present Eliot Lew, Axichat Developers
+
+import 'dart:async';
+import 'dart:collection';
+import 'dart:convert';
+import 'dart:io';
+import 'dart:isolate';
+import 'dart:typed_data';
+
+import 'package:axichat/src/common/html_content.dart';
+import 'package:axichat/src/storage/app_storage.dart';
+import 'package:axichat/src/storage/sealed_file.dart';
+import 'package:logging/logging.dart';
+import 'package:path/path.dart' as p;
+
+const String _preparedMessagesFileName = '.axichat.prepared_messages';
+const List<int> _preparedMessagesMagic = <int>[0x41, 0x58, 0x50, 0x4d]; // AXPM
+const int _preparedMessagesMaxFileBytes = 8 << 20;
+const String _preparedMessagesKeyInfo = 'axichat-prepared-messages-v1';
+const int _preparedMessagesMaxEntries = 512;
+// Encoded size the store holds in memory. JSON escaping adds to it on
+// write, so it stays under the file cap; the writer enforces the cap itself.
+const int _preparedMessagesMaxBytes = 6 << 20;
+const Duration _preparedMessagesFlushDelay = Duration(seconds: 5);
+
+const int _flagPlainTextHtml = 1 << 0;
+const int _flagRemoteImages = 1 << 1;
+const int _flagBlockedWebViewContent = 1 << 2;
+const int _flagCidImages = 1 << 3;
+
+/// Render data derived from one message. [revision] is the content key of
+/// the HTML it was derived from, so an edited or re-downloaded body misses.
+class PreparedMessage {
+  PreparedMessage({required this.revision, required this.emailHtml});
+
+  final String revision;
+  final EmailHtmlDerivation emailHtml;
+
+  late final int _bytes =
+      utf8.encode(revision).length +
+      utf8.encode(emailHtml.preparedFlutterHtml).length +
+      utf8.encode(emailHtml.visibleBodyText).length;
+}
+
+/// Prepared messages for one account, keyed by stanza ID and kept in a
+/// [SealedFile] so reopening a chat skips the HTML preparation its messages
+/// already went through.
+///
+/// Entries are held most recently used last and bounded by count and size.
+/// Reads and writes of the file run on a worker isolate.
+class PreparedMessageStore {
+  PreparedMessageStore({required File file, required String passphrase})
+    : _file = SealedFile(
+        file: file,
+        passphrase: passphrase,
+        magic: _preparedMessagesMagic,
+        keyInfo: _preparedMessagesKeyInfo,
+        maxBytes: _preparedMessagesMaxFileBytes,
+      );
+
+  static final Logger _log = Logger('PreparedMessageStore');
+
+  final SealedFile _file;
+  final LinkedHashMap<String, PreparedMessage> _entries =
+      LinkedHashMap<String, PreparedMessage>();
+  int _bytes = 0;
+  Future<void>? _loading;
+  Timer? _flushTimer;
+  bool _dirty = false;
+
+  static Future<PreparedMessageStore> forPrefix({
+    required String prefix,
+    required String passphrase,
+  }) async {
+    final directory = await prepareAppStorageSubdirectory(prefix);
+    return PreparedMessageStore(
+      file: File(p.join(directory.path, _preparedMessagesFileName)),
+      passphrase: passphrase,
+    );
+  }
+
+  int get length => _entries.length;
+
+  Future<void> load() => _loading ??= _load();
+
+  Future<void> _load() async {
+    final file = _file;
+    final Map<String, PreparedMessage>? stored;
+    try {
+      stored = await Isolate.run(() => _readEntries(file));
+    } on Exception catch (error, stackTrace) {
+      _log.fine('Failed to load prepared messages.', error, stackTrace);
+      return;
+    }
+    if (stored == null) return;
+    // Entries prepared while the file was loading are newer; keep them last.
+    final fresh = Map<String, PreparedMessage>.of(_entries);
+    _entries.clear();
+    _bytes = 0;
+    for (final entry in stored.entries) {
+      _insert(entry.key, entry.value);
+    }
+    for (final entry in fresh.entries) {
+      _insert(entry.key, entry.value);
+    }
+  }
+
+  PreparedMessage? lookup(String stanzaId, String revision) {
+    final entry = _entries.remove(stanzaId);
+    if (entry == null) return null;
+    if (entry.revision != revision) {
+      _bytes -= entry._bytes;
+      _dirty = true;
+      return null;
+    }
+    _entries[stanzaId] = entry;
+    return entry;
+  }
+
+  void put(String stanzaId, PreparedMessage message) {
+    final existing = _entries[stanzaId];
+    if (existing != null && existing.revision == message.revision) return;
+    _insert(stanzaId, message);
+    _dirty = true;
+    _flushTimer ??= Timer(_preparedMessagesFlushDelay, () {
+      _flushTimer = null;
+      unawaited(flush());
+    });
+  }
+
+  void _insert(String stanzaId, PreparedMessage message) {
+    final replaced = _entries.remove(stanzaId);
+    if (replaced != null) {
+      _bytes -= replaced._bytes;
+    }
+    _entries[stanzaId] = message;
+    _bytes += message._bytes;
+    while (_entries.length > _preparedMessagesMaxEntries ||
+        _bytes > _preparedMessagesMaxBytes) {
+      final oldest = _entries.keys.first;
+      _bytes -= _entries.remove(oldest)!._bytes;
+    }
+  }
+
+  /// Writes pending entries now. Called on a timer after [put], when the app
+  /// goes to the background and before the account's storage closes.
+  Future<void> flush() async {
+    _flushTimer?.cancel();
+    _flushTimer = null;
+    if (!_dirty) return;
+    _dirty = false;
+    final file = _file;
+    final entries = Map<String, PreparedMessage>.of(_entries);
+    try {
+      await Isolate.run(() => _writeEntries(file, entries));
+    } on Exception catch (error, stackTrace) {
+      _dirty = true;
+      _log.fine('Failed to save prepared messages.', error, stackTrace);
+    }
+  }
+
+  void dispose() {
+    _flushTimer?.cancel();
+    _flushTimer = null;
+  }
+}
+
+Future<Map<String, PreparedMessage>?> _readEntries(SealedFile file) async {
+  final plain = await file.read();
+  if (plain == null) return null;
+  try {
+    final json = jsonDecode(utf8.decode(plain));
+    if (json is! Map<String, Object?>) return null;
+    final entries = <String, PreparedMessage>{};
+    for (final entry in json.entries) {
+      final row = entry.value;
+      if (row is! List<Object?> || row.length != 4) continue;
+      final [revision, preparedFlutterHtml, visibleBodyText, flags] = row;
+      if (revision is! String ||
+          preparedFlutterHtml is! String ||
+          visibleBodyText is! String ||
+          flags is! int) {
+        continue;
+      }
+      entries[entry.key] = PreparedMessage(
+        revision: revision,
+        emailHtml: (
+          preparedFlutterHtml: preparedFlutterHtml,
+          visibleBodyText: visibleBodyText,
+          isPlainTextHtml: flags & _flagPlainTextHtml != 0,
+          containsRemoteImages: flags & _flagRemoteImages != 0,
+          containsBlockedWebViewContent:
+              flags & _flagBlockedWebViewContent != 0,
+          containsCidImages: flags & _flagCidImages != 0,
+        ),
+      );
+    }
+    return entries;
+  } on FormatException {
+    return null;
+  }
+}
+
+/// Encodes [entries] as one JSON object, keeping the most recently used
+/// entries that fit in [SealedFile.maxPlainBytes] so the file stays readable.
+Future<void> _writeEntries(
+  SealedFile file,
+  Map<String, PreparedMessage> entries,
+) {
+  final rows = <List<int>>[];
+  // Braces around the object.
+  var size = 2;
+  for (final MapEntry(key: stanzaId, value: message)
+      in entries.entries.toList().reversed) {
+    final value = <Object?>[
+      message.revision,
+      message.emailHtml.preparedFlutterHtml,
+      message.emailHtml.visibleBodyText,
+      (message.emailHtml.isPlainTextHtml ? _flagPlainTextHtml : 0) |
+          (message.emailHtml.containsRemoteImages ? _flagRemoteImages : 0) |
+          (message.emailHtml.containsBlockedWebViewContent
+              ? _flagBlockedWebViewContent
+              : 0) |
+          (message.emailHtml.containsCidImages ? _flagCidImages : 0),
+    ];
+    final row = utf8.encode('${jsonEncode(stanzaId)}:${jsonEncode(value)}');
+    final separator = rows.isEmpty ? 0 : 1;
+    if (size + separator + row.length > file.maxPlainBytes) break;
+    rows.add(row);
+    size += separator + row.length;
+  }
+  final plain = BytesBuilder(copy: false)..addByte(0x7b); // {
+  for (var index = rows.length - 1; index >= 0; index -= 1) {
+    plain.add(rows[index]);
+    if (index > 0) plain.addByte(0x2c); // ,
+  }
+  plain.addByte(0x7d); // }
+  return file.write(plain.takeBytes());
+}
@@ -0,0 +1,138 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+// Copyright (C) 2025-present Eliot Lew, Axichat Developers
+
+import 'dart:convert';
+import 'dart:io';
+import 'dart:math' as math;
+import 'dart:typed_data';
+
+import 'package:cryptography/cryptography.dart';
+import 'package:logging/logging.dart';
+
+const int _sealedFileVersion = 1;
+const int _sealedFileSaltLength = 16;
+const int _sealedFileNonceLength = 12;
+const int _sealedFileMacLength = 16;
+const int _sealedFileMagicLength = 4;
+const int _sealedFileSaltStart = _sealedFileMagicLength + 1;
+const int _sealedFileNonceStart = _sealedFileSaltStart + _sealedFileSaltLength;
+const int _sealedFileHeaderLength =
+    _sealedFileNonceStart + _sealedFileNonceLength;
+
+/// A small file sealed with AES-GCM under a key derived from the database
+/// passphrase, for account data kept outside the encrypted database.
+///
+/// Layout: four byte [magic], version byte, salt, nonce, ciphertext, MAC.
+/// The header is authenticated; any mismatch, including an older version,
+/// reads as no file.
+class SealedFile {
+  SealedFile({
+    required File file,
+    required String passphrase,
+    required List<int> magic,
+    required String keyInfo,
+    required int maxBytes,
+  }) : assert(magic.length == _sealedFileMagicLength),
+       _file = file,
+       _passphrase = passphrase,
+       _magic = magic,
+       _keyInfo = keyInfo,
+       _maxBytes = maxBytes;
+
+  static final Logger _log = Logger('SealedFile');
+
+  final File _file;
+  final String _passphrase;
+  final List<int> _magic;
+  final String _keyInfo;
+  final int _maxBytes;
+
+  /// The largest plaintext [write] can take and [read] still accept.
+  int get maxPlainBytes =>
+      _maxBytes - _sealedFileHeaderLength - _sealedFileMacLength;
+
+  Future<List<int>?> read() async {
+    final Uint8List bytes;
+    try {
+      if (!await _file.exists()) return null;
+      if (await _file.length() > _maxBytes) return null;
+      bytes = await _file.readAsBytes();
+    } on FileSystemException catch (error, stackTrace) {
+      _log.fine('Failed to read ${_file.path}.', error, stackTrace);
+      return null;
+    }
+    if (bytes.length <= _sealedFileHeaderLength + _sealedFileMacLength) {
+      return null;
+    }
+    for (var index = 0; index < _magic.length; index += 1) {
+      if (bytes[index] != _magic[index]) return null;
+    }
+    if (bytes[_sealedFileMagicLength] != _sealedFileVersion) return null;
+    final box = SecretBox(
+      Uint8List.sublistView(
+        bytes,
+        _sealedFileHeaderLength,
+        bytes.length - _sealedFileMacLength,
+      ),
+      nonce: Uint8List.sublistView(
+        bytes,
+        _sealedFileNonceStart,
+        _sealedFileHeaderLength,
+      ),
+      mac: Mac(
+        Uint8List.sublistView(bytes, bytes.length - _sealedFileMacLength),
+      ),
+    );
+    try {
+      return await AesGcm.with256bits().decrypt(
+        box,
+        secretKey: await _deriveKey(
+          Uint8List.sublistView(
+            bytes,
+            _sealedFileSaltStart,
+            _sealedFileNonceStart,
+          ),
+        ),
+        aad: Uint8List.sublistView(bytes, 0, _sealedFileHeaderLength),
+      );
+    } on SecretBoxAuthenticationError {
+      return null;
+    }
+  }
+
+  /// Replaces the file with [plain] sealed under a fresh salt and nonce.
+  /// Writes to a sibling and renames, so readers see the old or new file.
+  Future<void> write(List<int> plain) async {
+    final random = math.Random.secure();
+    List<int> randomBytes(int length) =>
+        List<int>.generate(length, (_) => random.nextInt(256));
+    final salt = randomBytes(_sealedFileSaltLength);
+    final nonce = randomBytes(_sealedFileNonceLength);
+    final header = Uint8List(_sealedFileHeaderLength)
+      ..setAll(0, _magic)
+      ..[_sealedFileMagicLength] = _sealedFileVersion
+      ..setAll(_sealedFileSaltStart, salt)
+      ..setAll(_sealedFileNonceStart, nonce);
+    final box = await AesGcm.with256bits().encrypt(
+      plain,
+      secretKey: await _deriveKey(salt),
+      nonce: nonce,
+      aad: header,
+    );
+    final output = BytesBuilder(copy: false)
+      ..add(header)
+      ..add(box.cipherText)
+      ..add(box.mac.bytes);
+    final staging = File('${_file.path}.tmp');
+    await staging.writeAsBytes(output.takeBytes(), flush: true);
+    await staging.rename(_file.path);
+  }
+
+  Future<SecretKey> _deriveKey(List<int> salt) {
+    return Hkdf(hmac: Hmac.sha256(), outputLength: 32).deriveKey(
+      secretKey: SecretKey(utf8.encode(_passphrase)),
+      nonce: salt,
+      info: utf8.encode(_keyInfo),
+    );
+  }
+}
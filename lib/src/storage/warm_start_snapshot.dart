@@ -0,0 +1,221 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+// Copyright (C) 2025-present Eliot Lew, Axichat Developers
+
+import 'dart:convert';
+import 'dart:io';
+
+import 'package:axichat/src/common/transport.dart';
+import 'package:axichat/src/storage/app_storage.dart';
+import 'package:axichat/src/storage/models.dart';
+import 'package:axichat/src/storage/sealed_file.dart';
+import 'package:logging/logging.dart';
+import 'package:path/path.dart' as p;
+
+const String _warmStartFileName = '.axichat.warm_start';
+const List<int> _warmStartMagic = <int>[0x41, 0x58, 0x57, 0x53]; // AXWS
+const int _warmStartMaxFileBytes = 2 << 20;
+const String _warmStartKeyInfo = 'axichat-warm-start-v1';
+
+/// What the home screen needs for its first frame: the first page of chats
+/// (with unread counts) and the roster with presence. Rows carry only the
+/// fields the list tiles render; live database streams replace them.
+class WarmStartSnapshot {
+  const WarmStartSnapshot({
+    required this.chats,
+    required this.roster,
+    required this.savedAt,
+  });
+
+  final List<Chat> chats;
+  final List<RosterItem> roster;
+  final DateTime savedAt;
+
+  int get unreadCount =>
+      chats.fold<int>(0, (total, chat) => total + chat.unreadCount);
+}
+
+/// Reads and writes [WarmStartSnapshot] as a [SealedFile] in the account's
+/// storage directory, keyed from the database passphrase.
+class WarmStartSnapshotStore {
+  WarmStartSnapshotStore({required File file, required String passphrase})
+    : _file = SealedFile(
+        file: file,
+        passphrase: passphrase,
+        magic: _warmStartMagic,
+        keyInfo: _warmStartKeyInfo,
+        maxBytes: _warmStartMaxFileBytes,
+      );
+
+  static final Logger _log = Logger('WarmStartSnapshotStore');
+
+  final SealedFile _file;
+
+  static Future<WarmStartSnapshotStore> forPrefix({
+    required String prefix,
+    required String passphrase,
+  }) async {
+    final directory = await prepareAppStorageSubdirectory(prefix);
+    return WarmStartSnapshotStore(
+      file: File(p.join(directory.path, _warmStartFileName)),
+      passphrase: passphrase,
+    );
+  }
+
+  Future<WarmStartSnapshot?> read() async {
+    final plain = await _file.read();
+    if (plain == null) return null;
+    try {
+      return _decodeSnapshot(jsonDecode(utf8.decode(plain)));
+    } on FormatException catch (error, stackTrace) {
+      _log.fine('Discarding malformed warm start snapshot.', error, stackTrace);
+      return null;
+    }
+  }
+
+  Future<void> write(WarmStartSnapshot snapshot) =>
+      _file.write(utf8.encode(jsonEncode(_encodeSnapshot(snapshot))));
+}
+
+Map<String, Object?> _encodeSnapshot(WarmStartSnapshot snapshot) => {
+  'savedAt': snapshot.savedAt.toUtc().microsecondsSinceEpoch,
+  'chats': [for (final chat in snapshot.chats) _encodeChat(chat)],
+  'roster': [for (final item in snapshot.roster) _encodeRosterItem(item)],
+};
+
+WarmStartSnapshot _decodeSnapshot(Object? json) {
+  if (json is! Map<String, Object?>) {
+    throw const FormatException('Warm start snapshot is not an object');
+  }
+  return WarmStartSnapshot(
+    savedAt: _decodeTimestamp(json['savedAt']),
+    chats: List<Chat>.unmodifiable([
+      for (final row in _list(json['chats'])) _decodeChat(_map(row)),
+    ]),
+    roster: List<RosterItem>.unmodifiable([
+      for (final row in _list(json['roster'])) _decodeRosterItem(_map(row)),
+    ]),
+  );
+}
+
+Map<String, Object?> _encodeChat(Chat chat) => {
+  'jid': chat.jid,
+  'title': chat.title,
+  'type': chat.type.name,
+  'primaryView': chat.primaryView.name,
+  'lastChange': chat.lastChangeTimestamp.toUtc().microsecondsSinceEpoch,
+  'transport': chat.transport.name,
+  'avatarPath': chat.avatarPath,
+  'avatarHash': chat.avatarHash,
+  'lastMessage': chat.lastMessage,
+  'alert': chat.alert,
+  'unread': chat.unreadCount,
+  'open': chat.open,
+  'muted': chat.muted,
+  'favorited': chat.favorited,
+  'archived': chat.archived,
+  'hidden': chat.hidden,
+  'spam': chat.spam,
+  'encryption': chat.encryptionProtocol.name,
+  'contactID': chat.contactID,
+  'contactDisplayName': chat.contactDisplayName,
+  'contactAvatarPath': chat.contactAvatarPath,
+  'contactAvatarHash': chat.contactAvatarHash,
+  'contactJid': chat.contactJid,
+  'deltaChatId': chat.deltaChatId,
+  'emailAddress': chat.emailAddress,
+  'emailFromAddress': chat.emailFromAddress,
+};
+
+Chat _decodeChat(Map<String, Object?> row) => Chat(
+  jid: _string(row['jid']),
+  title: _string(row['title']),
+  type: ChatType.values.asNameMap()[row['type']] ?? ChatType.chat,
+  primaryView:
+      ChatPrimaryView.values.asNameMap()[row['primaryView']] ??
+      ChatPrimaryView.chat,
+  lastChangeTimestamp: _decodeTimestamp(row['lastChange']),
+  transport:
+      MessageTransport.values.asNameMap()[row['transport']] ??
+      MessageTransport.xmpp,
+  avatarPath: row['avatarPath'] as String?,
+  avatarHash: row['avatarHash'] as String?,
+  lastMessage: row['lastMessage'] as String?,
+  alert: row['alert'] as String?,
+  unreadCount: row['unread'] as int? ?? 0,
+  open: row['open'] == true,
+  muted: row['muted'] == true,
+  favorited: row['favorited'] == true,
+  archived: row['archived'] == true,
+  hidden: row['hidden'] == true,
+  spam: row['spam'] == true,
+  encryptionProtocol:
+      EncryptionProtocol.values.asNameMap()[row['encryption']] ??
+      EncryptionProtocol.none,
+  contactID: row['contactID'] as String?,
+  contactDisplayName: row['contactDisplayName'] as String?,
+  contactAvatarPath: row['contactAvatarPath'] as String?,
+  contactAvatarHash: row['contactAvatarHash'] as String?,
+  contactJid: row['contactJid'] as String?,
+  deltaChatId: row['deltaChatId'] as int?,
+  emailAddress: row['emailAddress'] as String?,
+  emailFromAddress: row['emailFromAddress'] as String?,
+);
+
+Map<String, Object?> _encodeRosterItem(RosterItem item) => {
+  'jid': item.jid,
+  'title': item.title,
+  'presence': item.presence.name,
+  'subscription': item.subscription.name,
+  'status': item.status,
+  'ask': item.ask?.name,
+  'avatarPath': item.avatarPath,
+  'avatarHash': item.avatarHash,
+  'contactID': item.contactID,
+  'contactAvatarPath': item.contactAvatarPath,
+  'contactDisplayName': item.contactDisplayName,
+  'groups': item.groups,
+};
+
+RosterItem _decodeRosterItem(Map<String, Object?> row) => RosterItem(
+  jid: _string(row['jid']),
+  title: _string(row['title']),
+  presence: Presence.fromString(row['presence'] as String?),
+  subscription: Subscription.fromString(_string(row['subscription'])),
+  status: row['status'] as String?,
+  ask: Ask.fromString(row['ask'] as String?),
+  avatarPath: row['avatarPath'] as String?,
+  avatarHash: row['avatarHash'] as String?,
+  contactID: row['contactID'] as String?,
+  contactAvatarPath: row['contactAvatarPath'] as String?,
+  contactDisplayName: row['contactDisplayName'] as String?,
+  groups: [for (final group in _list(row['groups'])) _string(group)],
+);
+
+DateTime _decodeTimestamp(Object? value) {
+  if (value is! int) {
+    throw const FormatException('Warm start timestamp is not an integer');
+  }
+  return DateTime.fromMicrosecondsSinceEpoch(value, isUtc: true).toLocal();
+}
+
+String _string(Object? value) {
+  if (value is! String) {
+    throw const FormatException('Warm start field is not a string');
+  }
+  return value;
+}
+
+List<Object?> _list(Object? value) {
+  if (value == null) return const <Object?>[];
+  if (value is! List<Object?>) {
+    throw const FormatException('Warm start field is not a list');
+  }
+  return value;
+}
+
+Map<String, Object?> _map(Object? value) {
+  if (value is! Map<String, Object?>) {
+    throw const FormatException('Warm start row is not an object');
+  }
+  return value;
+}
@@ -0,0 +1,261 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+// Copyright (C) 2025-present Eliot Lew, Axichat Developers
+
+import 'dart:async';
+import 'dart:collection';
+import 'dart:math' as math;
+
+import 'package:logging/logging.dart';
+
+const int _mamCatchUpDefaultMinPageSize = 25;
+const int _mamCatchUpDefaultMaxPageSize = 250;
+const int _mamCatchUpDefaultMaxConcurrentScopes = 3;
+const Duration _mamCatchUpDefaultTargetIngest = Duration(milliseconds: 750);
+const double _mamCatchUpSmoothing = 0.3;
+const int _mamCatchUpGrowthFactor = 2;
+
+final class MamCatchUpTuning {
+  const MamCatchUpTuning({
+    this.minPageSize = _mamCatchUpDefaultMinPageSize,
+    this.maxPageSize = _mamCatchUpDefaultMaxPageSize,
+    this.maxConcurrentScopes = _mamCatchUpDefaultMaxConcurrentScopes,
+    this.targetIngest = _mamCatchUpDefaultTargetIngest,
+  }) : assert(minPageSize > 0),
+       assert(maxPageSize >= minPageSize),
+       assert(maxConcurrentScopes > 0);
+
+  final int minPageSize;
+  final int maxPageSize;
+
+  /// Upper bound on archives (MUCs, chats) queried at the same time.
+  final int maxConcurrentScopes;
+
+  /// Ingest time per page the sizer aims for. Longer pages hold the database
+  /// and calendar processors for too long; much shorter ones waste round
+  /// trips.
+  final Duration targetIngest;
+}
+
+/// One archive page whose RSM result is known. [ingested] completes once every
+/// message of the page has been processed locally.
+final class MamCatchUpPage {
+  const MamCatchUpPage({
+    required this.complete,
+    required this.ingested,
+    this.firstId,
+    this.lastId,
+    this.count,
+  });
+
+  final bool complete;
+  final String? firstId;
+  final String? lastId;
+  final int? count;
+  final Future<void> ingested;
+}
+
+typedef MamCatchUpFetch =
+    Future<MamCatchUpPage> Function({
+      required String? after,
+      required bool initial,
+      required int pageSize,
+    });
+
+typedef MamCatchUpCheckpoint = Future<void> Function(String lastId);
+
+typedef _TimedPage = Future<(MamCatchUpPage, Duration)>;
+
+final class MamCatchUpRun {
+  const MamCatchUpRun({
+    required this.pages,
+    required this.stalled,
+    required this.lastId,
+  });
+
+  final List<MamCatchUpPage> pages;
+
+  /// The server returned a page that did not advance the cursor.
+  final bool stalled;
+  final String? lastId;
+}
+
+/// Picks the next RSM page size from the measured query round trip and the
+/// local ingest cost of previous pages.
+///
+/// While the round trip dominates, pipelining cannot hide it and larger pages
+/// mean fewer trips. Once ingesting a page exceeds the target the page shrinks
+/// so a single page never monopolises the database.
+final class MamCatchUpPageSizer {
+  MamCatchUpPageSizer({
+    required int initialPageSize,
+    this.tuning = const MamCatchUpTuning(),
+  }) : _pageSize = initialPageSize.clamp(
+         tuning.minPageSize,
+         tuning.maxPageSize,
+       );
+
+  final MamCatchUpTuning tuning;
+  int _pageSize;
+  double? _roundTripMicros;
+  double? _ingestMicros;
+
+  int get pageSize => _pageSize;
+
+  void record({
+    required Duration roundTrip,
+    required Duration ingest,
+    required int pageSize,
+  }) {
+    _roundTripMicros = _smooth(_roundTripMicros, roundTrip.inMicroseconds);
+    _ingestMicros = _smooth(_ingestMicros, ingest.inMicroseconds);
+    final roundTripMicros = _roundTripMicros!;
+    final ingestMicros = _ingestMicros!;
+    final targetMicros = tuning.targetIngest.inMicroseconds;
+    var next = pageSize;
+    if (ingestMicros > targetMicros && ingestMicros > 0) {
+      next = (pageSize * targetMicros / ingestMicros).floor();
+    } else if (roundTripMicros > ingestMicros) {
+      next = pageSize * _mamCatchUpGrowthFactor;
+    }
+    _pageSize = next.clamp(tuning.minPageSize, tuning.maxPageSize);
+  }
+
+  double _smooth(double? current, int sample) => current == null
+      ? sample.toDouble()
+      : current + (sample - current) * _mamCatchUpSmoothing;
+}
+
+/// Walks one archive scope page by page, requesting the next RSM page as soon
+/// as the current page's `<fin/>` arrives instead of after its messages are
+/// ingested. A page's checkpoint is only reported once it is fully ingested,
+/// so an interrupted run resumes without gaps.
+final class MamCatchUpEngine {
+  MamCatchUpEngine({required this.sizer, Logger? log})
+    : _log = log ?? Logger('MamCatchUpEngine');
+
+  final MamCatchUpPageSizer sizer;
+  final Logger _log;
+
+  Future<MamCatchUpRun> run({
+    required MamCatchUpFetch fetch,
+    String? after,
+    MamCatchUpCheckpoint? onCheckpoint,
+  }) async {
+    final pages = <MamCatchUpPage>[];
+    var cursor = after;
+    var pageSize = sizer.pageSize;
+    _TimedPage? pending = _timed(
+      fetch(after: cursor, initial: true, pageSize: pageSize),
+    );
+    while (pending != null) {
+      final (page, roundTrip) = await pending;
+      pending = null;
+      pages.add(page);
+      final lastId = page.lastId;
+      final hasProgress = lastId != null && lastId != cursor;
+      final done = page.complete || lastId == null;
+      final nextPageSize = sizer.pageSize;
+      if (!done && hasProgress) {
+        pending = _timed(
+          fetch(after: lastId, initial: false, pageSize: nextPageSize),
+        );
+      }
+      final ingestWatch = Stopwatch()..start();
+      try {
+        await page.ingested;
+        if (hasProgress) {
+          await onCheckpoint?.call(lastId);
+        }
+      } on Object {
+        _discard(pending);
+        rethrow;
+      }
+      sizer.record(
+        roundTrip: roundTrip,
+        ingest: ingestWatch.elapsed,
+        pageSize: pageSize,
+      );
+      _log.finer(
+        'MAM catch-up page: '
+        'pageSize=$pageSize '
+        'roundTripMs=${roundTrip.inMilliseconds} '
+        'ingestMs=${ingestWatch.elapsedMilliseconds} '
+        'nextPageSize=${sizer.pageSize}.',
+      );
+      if (done) {
+        return MamCatchUpRun(
+          pages: List.unmodifiable(pages),
+          stalled: false,
+          lastId: lastId ?? cursor,
+        );
+      }
+      if (!hasProgress) {
+        return MamCatchUpRun(
+          pages: List.unmodifiable(pages),
+          stalled: true,
+          lastId: cursor,
+        );
+      }
+      cursor = lastId;
+      pageSize = nextPageSize;
+    }
+    throw StateError('MAM catch-up ended without a page');
+  }
+
+  /// Measures the round trip when [fetch] itself completes. The run awaits
+  /// a prefetched page only after the previous page is ingested, so timing
+  /// at that await would count ingest time as network time.
+  _TimedPage _timed(Future<MamCatchUpPage> fetch) {
+    final requestedAt = Stopwatch()..start();
+    return fetch.then((page) => (page, requestedAt.elapsed));
+  }
+
+  /// Drops a prefetched page after the run failed, including a later failure
+  /// of its ingestion, which nobody awaits anymore.
+  void _discard(_TimedPage? pending) {
+    pending?.then(
+      (timed) => timed.$1.ingested.ignore(),
+      onError: (Object _) {},
+    );
+  }
+}
+
+/// Bounds how many archive scopes are caught up concurrently.
+final class MamCatchUpLimiter {
+  MamCatchUpLimiter({int maxConcurrent = _mamCatchUpDefaultMaxConcurrentScopes})
+    : _maxConcurrent = math.max(1, maxConcurrent);
+
+  int _maxConcurrent;
+  int _active = 0;
+  final Queue<Completer<void>> _waiters = Queue<Completer<void>>();
+
+  int get maxConcurrent => _maxConcurrent;
+
+  set maxConcurrent(int value) {
+    _maxConcurrent = math.max(1, value);
+    _releaseWaiters();
+  }
+
+  Future<T> run<T>(Future<T> Function() operation) async {
+    if (_active >= _maxConcurrent) {
+      final waiter = Completer<void>();
+      _waiters.addLast(waiter);
+      await waiter.future;
+    } else {
+      _active += 1;
+    }
+    try {
+      return await operation();
+    } finally {
+      _active -= 1;
+      _releaseWaiters();
+    }
+  }
+
+  void _releaseWaiters() {
+    while (_waiters.isNotEmpty && _active < _maxConcurrent) {
+      _active += 1;
+      _waiters.removeFirst().complete();
+    }
+  }
+}
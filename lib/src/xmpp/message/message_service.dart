@@ -905,6 +905,13 @@ class MamPageResult {
     this.count,
   });
 
+  factory MamPageResult.fromCatchUpPage(MamCatchUpPage page) => MamPageResult(
+    complete: page.complete,
+    firstId: page.firstId,
+    lastId: page.lastId,
+    count: page.count,
+  );
+
   final bool complete;
   final String? firstId;
   final String? lastId;
@@ -1087,6 +1094,9 @@ final _capabilityCacheKey = XmppStateStore.registerKey(
 const String _mamGlobalLastIdKeyName = 'mam_global_last_id';
 const String _mamGlobalLastSyncKeyName = 'mam_global_last_sync';
 const String _mamGlobalDeniedUntilKeyName = 'mam_global_denied_until';
+const String _mamCatchUpCheckpointKeyName = 'mam_catch_up_checkpoint';
+const String _mamCatchUpCheckpointSinceField = 'since';
+const String _mamCatchUpCheckpointAfterField = 'after';
 const String _calendarReadOnlyTaskOwnersKeyName =
     'calendar_read_only_task_owners_v1';
 final _mamGlobalLastIdKey = XmppStateStore.registerKey(_mamGlobalLastIdKeyName);
@@ -1328,6 +1338,13 @@ enum _DraftSyncDecision { applyRemote, publishLocal, skip }
 enum _CalendarSyncAuthorizationResult { allowed, rejected, unresolved }
 
 mixin MessageService on XmppBase, BaseStreamService, BlockingService {
+  Future<PreparedMessageStore>? _preparedMessageStore;
+
+  /// Prepared timeline render data for the signed-in account; null while
+  /// signed out.
+  Future<PreparedMessageStore>? get preparedMessageStore =>
+      _preparedMessageStore;
+
   bool _draftSnapshotInFlight = false;
   String? _draftSourceId;
   bool _pendingDraftSyncLoaded = false;
@@ -5030,6 +5047,11 @@ mixin MessageService on XmppBase, BaseStreamService, BlockingService {
   final Queue<({String mamId, String queryId})>
   _calendarSyncMamWorkOutcomeOrder = Queue<({String mamId, String queryId})>();
   final Set<String> _mucJoinMamSyncRooms = {};
+  MamCatchUpTuning _mamCatchUpTuning = const MamCatchUpTuning();
+  late final MamCatchUpLimiter _mamCatchUpLimiter = MamCatchUpLimiter(
+    maxConcurrent: _mamCatchUpTuning.maxConcurrentScopes,
+  );
+  MamCatchUpPageSizer? _mamGlobalPageSizer;
   DateTime? _mamGlobalDeniedUntil;
   String? _mamGlobalDeniedUntilScope;
   bool _mamGlobalDeniedUntilLoaded = false;
@@ -6104,23 +6126,131 @@ mixin MessageService on XmppBase, BaseStreamService, BlockingService {
     required bool isMuc,
   }) async {
     if (since == null) return;
-    String? afterId;
-    while (true) {
-      final result = await fetchSinceFromArchive(
-        jid: jid,
-        since: since,
-        pageSize: mamLoginBackfillMessageLimit,
-        isMuc: isMuc,
-        after: afterId,
+    await _catchUpArchiveScope(
+      jid: jid,
+      since: since,
+      isMuc: isMuc,
+      pageSize: mamLoginBackfillMessageLimit,
+    );
+  }
+
+  /// Pipelined catch-up of one archive from [since]. Progress is checkpointed
+  /// per scope after every ingested page, and an interrupted run resumes from
+  /// the checkpoint with the filter it was started with.
+  Future<List<MamPageResult>> _catchUpArchiveScope({
+    required String jid,
+    required DateTime since,
+    required bool isMuc,
+    required int pageSize,
+  }) async {
+    if (!await _canFetchArchiveForChat(
+      chatJid: jid,
+      chatType: isMuc ? ChatType.groupChat : ChatType.chat,
+    )) {
+      return const <MamPageResult>[MamPageResult(complete: true)];
+    }
+    final checkpoint = await _loadMamCatchUpCheckpoint(jid);
+    final scopeSince = checkpoint?.since ?? since;
+    if (checkpoint != null) {
+      _log.fine('Resuming MAM catch-up from checkpoint.');
+    }
+    final MamCatchUpRun run;
+    try {
+      run = await MamCatchUpEngine(
+        sizer: MamCatchUpPageSizer(
+          initialPageSize: pageSize,
+          tuning: _mamCatchUpTuning,
+        ),
+        log: _log,
+      ).run(
+        after: checkpoint?.after,
+        fetch: ({required after, required initial, required pageSize}) =>
+            _startMamArchivePage(
+              jid: jid,
+              start: scopeSince,
+              after: after,
+              pageSize: pageSize,
+              isMuc: isMuc,
+            ),
+        onCheckpoint: (lastId) =>
+            _storeMamCatchUpCheckpoint(jid, since: scopeSince, after: lastId),
       );
-      final nextAfterId = result.lastId ?? afterId;
-      if (result.complete || nextAfterId == null || nextAfterId == afterId) {
-        break;
+    } on XmppAbortedException {
+      rethrow;
+    } on Exception {
+      // A stale cursor would fail every resume; start the scope over instead.
+      if (checkpoint != null) {
+        await _clearMamCatchUpCheckpoint(jid);
       }
-      afterId = nextAfterId;
+      rethrow;
+    }
+    await _clearMamCatchUpCheckpoint(jid);
+    return List<MamPageResult>.unmodifiable(
+      run.pages.map(MamPageResult.fromCatchUpPage),
+    );
+  }
+
+  RegisteredStateKey _mamCatchUpCheckpointKey(String jid) => _mamScopedKey(
+    '$_mamCatchUpCheckpointKeyName$_mamGlobalScopeSeparator$jid',
+  );
+
+  Future<({DateTime since, String after})?> _loadMamCatchUpCheckpoint(
+    String jid,
+  ) async {
+    final key = _mamCatchUpCheckpointKey(jid);
+    final raw = await _dbOpReturning<XmppStateStore, String?>(
+      (ss) => ss.read(key: key) as String?,
+    );
+    if (raw == null || raw.isEmpty) {
+      return null;
+    }
+    try {
+      final decoded = jsonDecode(raw);
+      if (decoded is! Map) return null;
+      final since = DateTime.tryParse(
+        decoded[_mamCatchUpCheckpointSinceField]?.toString() ?? '',
+      );
+      final after = decoded[_mamCatchUpCheckpointAfterField]?.toString();
+      if (since == null || after == null || after.isEmpty) {
+        return null;
+      }
+      return (since: since.toUtc(), after: after);
+    } on FormatException {
+      return null;
     }
   }
 
+  Future<void> _storeMamCatchUpCheckpoint(
+    String jid, {
+    required DateTime since,
+    required String after,
+  }) async {
+    final key = _mamCatchUpCheckpointKey(jid);
+    final value = jsonEncode(<String, String>{
+      _mamCatchUpCheckpointSinceField: since.toUtc().toIso8601String(),
+      _mamCatchUpCheckpointAfterField: after,
+    });
+    await _dbOp<XmppStateStore>(
+      (ss) async => ss.write(key: key, value: value),
+      awaitDatabase: true,
+    );
+  }
+
+  Future<void> _clearMamCatchUpCheckpoint(String jid) async {
+    final key = _mamCatchUpCheckpointKey(jid);
+    await _dbOp<XmppStateStore>(
+      (ss) async => ss.delete(key: key),
+      awaitDatabase: true,
+    );
+  }
+
+  /// Caps concurrent archive catch-ups and bounds adaptive page sizes.
+  void configureMamCatchUp(MamCatchUpTuning tuning) {
+    _mamCatchUpTuning = tuning;
+    _mamCatchUpLimiter.maxConcurrent = tuning.maxConcurrentScopes;
+    _mamGlobalPageSizer = null;
+  }
+
   void _trackMamGlobalAnchor(mox.MessageEvent event) {
     if (!_mamGlobalSyncInFlight) return;
     if (!event.isFromMAM) return;
@@ -6176,14 +6306,14 @@ mixin MessageService on XmppBase, BaseStreamService, BlockingService {
       final privateCalendarHadCompleteCoverage =
           _readPersonalCalendarSyncState().hasCompleteCoverage;
       emitXmppOperation(_mamGlobalStartEvent);
-      String? after = await _loadMamGlobalLastId();
+      final after = await _loadMamGlobalLastId();
       final anchor = await _loadMamGlobalLastSync();
       _throwIfMamGlobalSyncOwnerChanged(
         operationEpoch: operationEpoch,
         syncOwner: syncOwner,
       );
-      DateTime? start = after == null ? anchor : null;
-      String? before = after == null && start == null
+      final start = after == null ? anchor : null;
+      final before = after == null && start == null
           ? ''
           : null; // Seed last page only on first-run.
       _log.info(
@@ -6194,27 +6324,26 @@ mixin MessageService on XmppBase, BaseStreamService, BlockingService {
         'before=$before.',
       );
 
-      while (true) {
-        final result = await _fetchGlobalMamPage(
-          after: after,
-          before: before,
-          start: start,
-          pageSize: pageSize,
-        );
-        _throwIfMamGlobalSyncOwnerChanged(
-          operationEpoch: operationEpoch,
-          syncOwner: syncOwner,
-        );
-        final lastId = result.lastId;
-        final hasProgress = lastId != null && lastId != after;
-        _log.fine(
-          'Global MAM page fetched: '
-          'lastId=$lastId '
-          'complete=${result.complete} '
-          'hasProgress=$hasProgress.',
-        );
-        if (hasProgress) {
-          after = lastId;
+      final sizer = _mamGlobalPageSizer ??= MamCatchUpPageSizer(
+        initialPageSize: pageSize,
+        tuning: _mamCatchUpTuning,
+      );
+      final run = await MamCatchUpEngine(sizer: sizer, log: _log).run(
+        after: after,
+        fetch: ({required after, required initial, required pageSize}) {
+          _throwIfMamGlobalSyncOwnerChanged(
+            operationEpoch: operationEpoch,
+            syncOwner: syncOwner,
+          );
+          return _fetchGlobalMamPage(
+            after: after,
+            before: initial ? before : null,
+            start: initial ? start : null,
+            pageSize: pageSize,
+          );
+        },
+        onCheckpoint: (lastId) async {
+          _log.fine('Global MAM page ingested: lastId=$lastId.');
           _throwIfMamGlobalSyncOwnerChanged(
             operationEpoch: operationEpoch,
             syncOwner: syncOwner,
@@ -6228,16 +6357,15 @@ mixin MessageService on XmppBase, BaseStreamService, BlockingService {
             operationEpoch: operationEpoch,
             syncOwner: syncOwner,
           );
-        }
-        if (result.complete || lastId == null) {
-          break;
-        }
-        if (!hasProgress) {
-          _log.fine(_mamGlobalNoProgressLog);
-          throw XmppMessageException();
-        }
-        before = null;
-        start = null;
+        },
+      );
+      _throwIfMamGlobalSyncOwnerChanged(
+        operationEpoch: operationEpoch,
+        syncOwner: syncOwner,
+      );
+      if (run.stalled) {
+        _log.fine(_mamGlobalNoProgressLog);
+        throw XmppMessageException();
       }
 
       final anchorTimestamp =
@@ -6363,13 +6491,37 @@ mixin MessageService on XmppBase, BaseStreamService, BlockingService {
         !_mamGlobalArchiveReplayInterrupted;
   }
 
-  Future<MamPageResult> _fetchGlobalMamPage({
+  Future<MamCatchUpPage> _fetchGlobalMamPage({
     String? before,
     String? after,
     DateTime? start,
     int pageSize = mamLoginBackfillMessageLimit,
+  }) {
+    final queryId = 'axi-mam-${uuid.v4()}';
+    return _startMamPage(
+      to: null,
+      queryId: queryId,
+      options: mox.MAMQueryOptions(
+        withJid: null,
+        start: start,
+        formType: mox.mamXmlns,
+        forceForm: true,
+        queryId: queryId,
+      ),
+      rsm: mox.ResultSetManagement(before: before, after: after, max: pageSize),
+    );
+  }
+
+  /// Sends one MAM query and returns as soon as its `<fin/>` arrives. The
+  /// page's [MamCatchUpPage.ingested] tracks the local processing of its
+  /// messages, so callers can request the next page while this one ingests.
+  Future<MamCatchUpPage> _startMamPage({
+    required mox.JID? to,
+    required String queryId,
+    required mox.MAMQueryOptions options,
+    required mox.ResultSetManagement rsm,
   }) async {
-    var success = false;
+    var queried = false;
     emitXmppOperation(_mamFetchStartEvent);
     try {
       final mamManager = _connection.getManager<mox.MAMManager>();
@@ -6377,41 +6529,45 @@ mixin MessageService on XmppBase, BaseStreamService, BlockingService {
         _log.warning('MAM manager unavailable; ensure it is registered.');
         throw XmppMessageException();
       }
-      final queryId = 'axi-mam-${uuid.v4()}';
-      final options = mox.MAMQueryOptions(
-        withJid: null,
-        start: start,
-        formType: mox.mamXmlns,
-        forceForm: true,
-        queryId: queryId,
-      );
+      _openArchivePage(queryId);
       final result = await _queryMamArchive(
         mamManager: mamManager,
-        to: null,
+        to: to,
         options: options,
-        rsm: mox.ResultSetManagement(
-          before: before,
-          after: after,
-          max: pageSize,
-        ),
+        rsm: rsm,
       );
       if (result == null) {
-        _log.warning('Global MAM query failed.');
+        _log.warning('MAM query failed.');
         throw XmppMessageException();
       }
-      await _waitForCalendarSyncMamResults(queryId: queryId, result: result);
-      final rsm = result.rsm;
-      success = true;
-      return MamPageResult(
+      queried = true;
+      final ingested = _drainArchivePage(queryId)
+          .then(
+            (_) => _waitForCalendarSyncMamResults(
+              queryId: queryId,
+              result: result,
+            ),
+          )
+          .then(
+            (_) => emitXmppOperation(_mamFetchSuccessEvent),
+            onError: (Object error, StackTrace stackTrace) {
+              emitXmppOperation(_mamFetchFailureEvent);
+              Error.throwWithStackTrace(error, stackTrace);
+            },
+          );
+      final resultRsm = result.rsm;
+      return MamCatchUpPage(
         complete: result.complete,
-        firstId: rsm?.first,
-        lastId: rsm?.last,
-        count: rsm?.count,
+        firstId: resultRsm?.first,
+        lastId: resultRsm?.last,
+        count: resultRsm?.count,
+        ingested: ingested,
       );
     } finally {
-      emitXmppOperation(
-        success ? _mamFetchSuccessEvent : _mamFetchFailureEvent,
-      );
+      if (!queried) {
+        _discardArchivePage(queryId);
+        emitXmppOperation(_mamFetchFailureEvent);
+      }
     }
   }
 
@@ -9454,23 +9610,16 @@ mixin MessageService on XmppBase, BaseStreamService, BlockingService {
     required DateTime since,
     int pageSize = 50,
   }) async {
-    final results = <MamPageResult>[];
-    String? afterId;
-    while (true) {
-      final result = await fetchSinceFromArchiveForChat(
-        chat: chat,
-        since: since,
-        pageSize: pageSize,
-        after: afterId,
-      );
-      results.add(result);
-      final nextAfter = result.lastId ?? afterId;
-      if (result.complete || nextAfter == afterId || nextAfter == null) {
-        break;
-      }
-      afterId = nextAfter;
+    final jid = _resolvedMamChatJid(chat);
+    if (jid == null || !await _canFetchMamForChat(chat)) {
+      return const <MamPageResult>[MamPageResult(complete: true)];
     }
-    return List<MamPageResult>.unmodifiable(results);
+    return _catchUpArchiveScope(
+      jid: jid,
+      since: since,
+      isMuc: chat.type == ChatType.groupChat,
+      pageSize: pageSize,
+    );
   }
 
   _ChatMamSession _chatMamSession(String sessionId, {Chat? chat}) {
@@ -9581,52 +9730,43 @@ mixin MessageService on XmppBase, BaseStreamService, BlockingService {
     )) {
       return const MamPageResult(complete: true);
     }
-    var success = false;
-    emitXmppOperation(_mamFetchStartEvent);
-    try {
-      final mamManager = _connection.getManager<mox.MAMManager>();
-      if (mamManager == null) {
-        _log.warning('MAM manager unavailable; ensure it is registered.');
-        throw XmppMessageException();
-      }
-      final peerJid = mox.JID.fromString(jid);
-      final queryId = 'axi-mam-${uuid.v4()}';
-      final options = mox.MAMQueryOptions(
+    final page = await _startMamArchivePage(
+      jid: jid,
+      before: before,
+      after: after,
+      start: start,
+      end: end,
+      pageSize: pageSize,
+      isMuc: isMuc,
+    );
+    await page.ingested;
+    return MamPageResult.fromCatchUpPage(page);
+  }
+
+  Future<MamCatchUpPage> _startMamArchivePage({
+    required String jid,
+    String? before,
+    String? after,
+    DateTime? start,
+    DateTime? end,
+    int pageSize = 50,
+    bool isMuc = false,
+  }) {
+    final peerJid = mox.JID.fromString(jid);
+    final queryId = 'axi-mam-${uuid.v4()}';
+    return _startMamPage(
+      to: isMuc ? peerJid : null,
+      queryId: queryId,
+      options: mox.MAMQueryOptions(
         withJid: isMuc ? null : peerJid,
         start: start,
         end: end,
         formType: mox.mamXmlns,
         forceForm: true,
         queryId: queryId,
-      );
-      final result = await _queryMamArchive(
-        mamManager: mamManager,
-        to: isMuc ? peerJid : null,
-        options: options,
-        rsm: mox.ResultSetManagement(
-          before: before,
-          after: after,
-          max: pageSize,
-        ),
-      );
-      if (result == null) {
-        _log.warning('MAM query failed.');
-        throw XmppMessageException();
-      }
-      await _waitForCalendarSyncMamResults(queryId: queryId, result: result);
-      final rsm = result.rsm;
-      success = true;
-      return MamPageResult(
-        complete: result.complete,
-        firstId: rsm?.first,
-        lastId: rsm?.last,
-        count: rsm?.count,
-      );
-    } finally {
-      emitXmppOperation(
-        success ? _mamFetchSuccessEvent : _mamFetchFailureEvent,
-      );
-    }
+      ),
+      rsm: mox.ResultSetManagement(before: before, after: after, max: pageSize),
+    );
   }
 
   Future<mox.MAMQueryResult?> _queryMamArchive({
@@ -12584,6 +12724,7 @@ mixin MessageService on XmppBase, BaseStreamService, BlockingService {
         return acl.write;
       case CalendarSyncType.full:
       case CalendarSyncType.snapshot:
+      case CalendarSyncType.delta:
         return acl.write;
     }
     return acl.write;
@@ -12629,10 +12770,13 @@ mixin MessageService on XmppBase, BaseStreamService, BlockingService {
     required String chatJid,
   }) async {
     if (syncMessage.type != CalendarSyncType.full &&
-        syncMessage.type != CalendarSyncType.snapshot) {
+        syncMessage.type != CalendarSyncType.snapshot &&
+        syncMessage.type != CalendarSyncType.delta) {
       return syncMessage;
     }
-    final data = syncMessage.data;
+    final data = syncMessage.type == CalendarSyncType.delta
+        ? syncMessage.deltaModel
+        : syncMessage.data;
     if (data == null) {
       return syncMessage;
     }
@@ -12689,6 +12833,12 @@ mixin MessageService on XmppBase, BaseStreamService, BlockingService {
       _log.warning(
         'Removed unauthorized read-only task changes from calendar ${syncMessage.type}.',
       );
+      if (syncMessage.type == CalendarSyncType.delta) {
+        return syncMessage.withDeltaModel(
+          checkedModel.toJson(),
+          checksum: checksum,
+        );
+      }
       return syncMessage.copyWith(
         data: checkedModel.toJson(),
         checksum: checksum,
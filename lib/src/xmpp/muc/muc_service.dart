@@ -403,11 +403,15 @@ mixin MucService on XmppBase, BaseStreamService, AvatarService, MessageService {
   static const Duration _mucIdleLeaveDelay = Duration(minutes: 5);
   static const int _defaultMucJoinHistoryStanzas = 50;
   static const int _roomMemberSnapshotLimit = 256;
+  static const Duration _roomStateCoalesceWindow = Duration(milliseconds: 150);
   static const int _mucSnapshotStart = 0;
   static const int _mucSnapshotEnd = 0;
   static const List<MucBookmark> _emptyMucSnapshot = <MucBookmark>[];
   final _roomStates = <String, RoomState>{};
   final _roomStreams = <String, StreamController<RoomState>>{};
+  final _roomStateCoalesceTimers = <String, Timer>{};
+  final _coalescedRoomStates = <String>{};
+  final _pendingRoomSnapshotReplaces = <String, bool>{};
   final _roomSubjects = <String, String?>{};
   final _roomSubjectStreams = <String, StreamController<String?>>{};
   final _roomSessions = <String, _MucRoomSession>{};
@@ -835,6 +839,12 @@ mixin MucService on XmppBase, BaseStreamService, AvatarService, MessageService {
       session.presenceRetainCount = 0;
       session.clearSelfPresenceReadiness();
     }
+    for (final timer in _roomStateCoalesceTimers.values) {
+      timer.cancel();
+    }
+    _roomStateCoalesceTimers.clear();
+    _coalescedRoomStates.clear();
+    _pendingRoomSnapshotReplaces.clear();
     for (final controller in _roomStreams.values.toList(growable: false)) {
       await controller.close();
     }
@@ -1070,19 +1080,23 @@ mixin MucService on XmppBase, BaseStreamService, AvatarService, MessageService {
       final archiveCursor = await loadArchiveCursorTimestamp(normalizedRoom);
       final shouldBackfillLatest = localCount == 0 || archiveCursor == null;
 
-      if (!shouldBackfillLatest) {
-        await _catchUpChatFromArchive(
+      // Rejoining many rooms after a reconnect would otherwise start one
+      // archive walk per room at once.
+      await _mamCatchUpLimiter.run(() async {
+        if (!shouldBackfillLatest) {
+          await _catchUpChatFromArchive(
+            jid: normalizedRoom,
+            since: archiveCursor,
+            isMuc: true,
+          );
+        }
+
+        await fetchLatestFromArchive(
           jid: normalizedRoom,
-          since: archiveCursor,
+          pageSize: mamLoginBackfillMessageLimit,
           isMuc: true,
         );
-      }
-
-      await fetchLatestFromArchive(
-        jid: normalizedRoom,
-        pageSize: mamLoginBackfillMessageLimit,
-        isMuc: true,
-      );
+      });
       success = true;
     } on XmppAbortedException {
       return;
@@ -2495,17 +2509,45 @@ mixin MucService on XmppBase, BaseStreamService, AvatarService, MessageService {
     }
   }
 
+  /// Stores [room] as the current state and emits it. With [coalesce], the
+  /// first update emits at once and opens a [_roomStateCoalesceWindow];
+  /// further coalesced updates inside it only replace the stored state, which
+  /// is emitted when the window closes. A join flood of thousands of
+  /// presences thus reaches listeners and the member snapshot a few times
+  /// per second instead of once per presence.
   void _publishRoomState({
     required String roomKey,
     required RoomState room,
     bool persistSnapshot = true,
     bool replaceSnapshot = false,
+    bool coalesce = false,
   }) {
     _roomStates[roomKey] = room;
-    _roomStreams[roomKey]?.add(room);
     final suppressSnapshot =
         _roomSessionForKey(roomKey)?.suppressSnapshotPersistence == true;
-    if (!persistSnapshot || suppressSnapshot) {
+    if (persistSnapshot && !suppressSnapshot) {
+      _pendingRoomSnapshotReplaces[roomKey] =
+          replaceSnapshot || _pendingRoomSnapshotReplaces[roomKey] == true;
+    }
+    if (coalesce && _roomStateCoalesceTimers.containsKey(roomKey)) {
+      _coalescedRoomStates.add(roomKey);
+      return;
+    }
+    _emitRoomState(roomKey);
+    if (coalesce) {
+      _openRoomStateCoalesceWindow(roomKey);
+    }
+  }
+
+  void _emitRoomState(String roomKey) {
+    _coalescedRoomStates.remove(roomKey);
+    final replaceSnapshot = _pendingRoomSnapshotReplaces.remove(roomKey);
+    final room = _roomStates[roomKey];
+    if (room == null) {
+      return;
+    }
+    _roomStreams[roomKey]?.add(room);
+    if (replaceSnapshot == null) {
       return;
     }
     fireAndForget(
@@ -2516,6 +2558,17 @@ mixin MucService on XmppBase, BaseStreamService, AvatarService, MessageService {
     );
   }
 
+  void _openRoomStateCoalesceWindow(String roomKey) {
+    _roomStateCoalesceTimers[roomKey] = Timer(_roomStateCoalesceWindow, () {
+      _roomStateCoalesceTimers.remove(roomKey);
+      if (!_coalescedRoomStates.contains(roomKey)) {
+        return;
+      }
+      _emitRoomState(roomKey);
+      _openRoomStateCoalesceWindow(roomKey);
+    });
+  }
+
   Future<String> _resolveMucPrejoinNickname(MucBookmark bookmark) async {
     final trimmedBookmarkNick = bookmark.nick?.trim();
     if (trimmedBookmarkNick?.isNotEmpty == true) {
@@ -6324,25 +6377,24 @@ mixin MucService on XmppBase, BaseStreamService, AvatarService, MessageService {
     final key = _roomKey(roomJid);
     final existing =
         _roomStates[key] ?? RoomState(roomJid: key, occupants: const {});
-    final updated = Map<String, Occupant>.of(existing.occupants);
     var resolvedOccupantId = occupantId;
-    var current = updated[resolvedOccupantId];
+    var current = existing.occupants[resolvedOccupantId];
     final normalizedRealJid = _normalizeBareJid(realJid);
-    final workingRoom = existing.copyWith(occupants: updated);
-    final matchedOccupant = workingRoom.matchingOccupant(
+    final matchedOccupant = existing.matchingOccupant(
       occupantId,
       realJid: normalizedRealJid,
     );
     final matchedOccupantId = matchedOccupant?.occupantId;
+    String? replacedOccupantId;
     if (matchedOccupantId != null && matchedOccupantId != resolvedOccupantId) {
       current ??= matchedOccupant;
-      if (workingRoom.shouldPreferMatchedOccupantId(
+      if (existing.shouldPreferMatchedOccupantId(
         resolvedOccupantId,
         matchedOccupantId,
       )) {
         resolvedOccupantId = matchedOccupantId;
       }
-      updated.remove(matchedOccupantId);
+      replacedOccupantId = matchedOccupantId;
     }
     final base =
         current ??
@@ -6377,8 +6429,7 @@ mixin MucService on XmppBase, BaseStreamService, AvatarService, MessageService {
     final isKnownSelf =
         _isSelfOccupant(next) || existing.myOccupantJid == resolvedOccupantId;
     final allowNickMatch = _mucJoinInFlight(key);
-    updated[resolvedOccupantId] = next;
-    var room = existing.copyWith(occupants: updated);
+    var room = existing.withOccupant(next, replacing: replacedOccupantId);
     final joinedInviteeJid = next.isPresent ? next.normalizedBareRealJid : null;
     if (joinedInviteeJid != null) {
       final withoutPendingInvitee = room.withoutPendingInvitee(
@@ -6399,6 +6450,7 @@ mixin MucService on XmppBase, BaseStreamService, AvatarService, MessageService {
       roomKey: key,
       room: room,
       persistSnapshot: persistSnapshot && shouldPersistSnapshot,
+      coalesce: true,
     );
     if (clearedPendingInvitee) {
       fireAndForget(
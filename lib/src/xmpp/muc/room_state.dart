@@ -1,7 +1,10 @@
 // SPDX-License-Identifier: AGPL-3.0-or-later
 // Copyright (C) 2025-present Eliot Lew, Axichat Developers
 
+import 'dart:collection';
+
 import 'package:axichat/src/common/address_tools.dart';
+import 'package:axichat/src/common/persistent_hash_map.dart';
 import 'package:axichat/src/xmpp/muc/muc_join_state.dart';
 import 'package:axichat/src/xmpp/muc/occupant.dart';
 
@@ -18,9 +21,7 @@ class RoomState {
     this.destroyedAlternateRoomJid,
     this.postJoinRefreshPending = false,
     Set<String>? pendingInviteeJids,
-  }) : occupants = Map.unmodifiable(
-         Map<String, Occupant>.of(occupants ?? <String, Occupant>{}),
-       ),
+  }) : _occupants = _RoomOccupantMap(_RoomOccupantIndex.of(occupants)),
        selfPresenceStatusCodes = Set.unmodifiable(
          Set<String>.of(selfPresenceStatusCodes ?? const <String>{}),
        ),
@@ -29,7 +30,7 @@ class RoomState {
        );
 
   final String roomJid;
-  final Map<String, Occupant> occupants;
+  final _RoomOccupantMap _occupants;
   final String? myOccupantJid;
   final Set<String> selfPresenceStatusCodes;
   final String? selfPresenceReason;
@@ -42,9 +43,13 @@ class RoomState {
   late final _RoomOccupantGroups _occupantGroups = _buildOccupantGroups();
   late final _RoomOccupantDirectory _occupantDirectory = _RoomOccupantDirectory(
     roomJid: roomJid,
-    occupants: occupants,
+    index: _occupants.index,
   );
 
+  /// Read-only; derive updated states through the `with*` methods, which
+  /// share structure with this state instead of copying every occupant.
+  Map<String, Occupant> get occupants => _occupants;
+
   OccupantAffiliation get myAffiliation =>
       occupants[myOccupantJid]?.affiliation ?? OccupantAffiliation.none;
 
@@ -527,29 +532,16 @@ class RoomState {
     String? selfRealJid,
     bool pruneMissing = true,
   }) {
-    final updated = Map<String, Occupant>.of(occupants);
+    var index = _occupants.index;
     var nextMyOccupantJid = myOccupantJid;
     final retainedOccupantIds = <String>{};
     for (final entry in entries) {
       final nick = entry.nick?.trim();
       final realJid = entry.jid;
-      final workingRoom = RoomState(
+      final occupantId = _RoomOccupantDirectory(
         roomJid: roomJid,
-        occupants: updated,
-        myOccupantJid: nextMyOccupantJid,
-        selfPresenceStatusCodes: selfPresenceStatusCodes,
-        selfPresenceReason: selfPresenceReason,
-        joinErrorCondition: joinErrorCondition,
-        joinErrorText: joinErrorText,
-        isDestroyed: isDestroyed,
-        destroyedAlternateRoomJid: destroyedAlternateRoomJid,
-        postJoinRefreshPending: postJoinRefreshPending,
-        pendingInviteeJids: pendingInviteeJids,
-      );
-      final occupantId = workingRoom.occupantIdForAffiliation(
-        realJid: realJid,
-        nick: nick,
-      );
+        index: index,
+      ).occupantIdForAffiliation(realJid: realJid, nick: nick);
       if (occupantId == null) {
         if ((nick == null || nick.isEmpty) &&
             (realJid == null || realJid.isEmpty)) {
@@ -557,9 +549,9 @@ class RoomState {
         }
         final resolvedOccupantId = realJid == null || realJid.isEmpty
             ? '$roomJid/$nick'
-            : workingRoom.syntheticOccupantIdForAffiliationJid(realJid);
+            : syntheticOccupantIdForAffiliationJid(realJid);
         final resolvedNick = (nick == null || nick.isEmpty)
-            ? workingRoom.fallbackNickForAffiliationJid(realJid!)
+            ? fallbackNickForAffiliationJid(realJid!)
             : nick;
         final isSelf =
             selfRealJid != null &&
@@ -569,15 +561,18 @@ class RoomState {
         if (isSelf &&
             nextMyOccupantJid != null &&
             nextMyOccupantJid != resolvedOccupantId) {
-          updated.remove(nextMyOccupantJid);
+          index = index.remove(nextMyOccupantJid);
         }
-        updated[resolvedOccupantId] = Occupant(
-          occupantId: resolvedOccupantId,
-          nick: resolvedNick,
-          realJid: realJid,
-          affiliation: entry.affiliation,
-          role: entry.role ?? OccupantRole.none,
-          isPresent: false,
+        index = index.put(
+          resolvedOccupantId,
+          Occupant(
+            occupantId: resolvedOccupantId,
+            nick: resolvedNick,
+            realJid: realJid,
+            affiliation: entry.affiliation,
+            role: entry.role ?? OccupantRole.none,
+            isPresent: false,
+          ),
         );
         if (isSelf) {
           nextMyOccupantJid = resolvedOccupantId;
@@ -585,47 +580,38 @@ class RoomState {
         retainedOccupantIds.add(resolvedOccupantId);
         continue;
       }
-      final occupant = updated[occupantId];
+      final occupant = index.byId[occupantId];
       if (occupant == null) continue;
-      updated[occupantId] = occupant.copyWith(
-        nick: nick ?? occupant.nick,
-        affiliation: entry.affiliation,
-        role: entry.role ?? occupant.role,
-        realJid: occupant.realJid ?? realJid,
+      index = index.put(
+        occupantId,
+        occupant.copyWith(
+          nick: nick ?? occupant.nick,
+          affiliation: entry.affiliation,
+          role: entry.role ?? occupant.role,
+          realJid: occupant.realJid ?? realJid,
+        ),
       );
       retainedOccupantIds.add(occupantId);
     }
     if (pruneMissing) {
-      updated.removeWhere((occupantId, occupant) {
-        if (occupant.affiliation != queriedAffiliation) {
-          return false;
-        }
-        if (occupant.isPresent) {
-          return false;
-        }
-        final realJid = occupant.realJid;
-        if (realJid == null || realJid.isEmpty) {
-          return false;
-        }
-        return !retainedOccupantIds.contains(occupantId);
-      });
+      final pruned = <String>[
+        for (final MapEntry(key: occupantId, value: occupant)
+            in index.byId.entries)
+          if (occupant.affiliation == queriedAffiliation &&
+              !occupant.isPresent &&
+              occupant.realJid?.isNotEmpty == true &&
+              !retainedOccupantIds.contains(occupantId))
+            occupantId,
+      ];
+      for (final occupantId in pruned) {
+        index = index.remove(occupantId);
+      }
     }
-    if (nextMyOccupantJid != null && !updated.containsKey(nextMyOccupantJid)) {
+    if (nextMyOccupantJid != null &&
+        !index.byId.containsKey(nextMyOccupantJid)) {
       nextMyOccupantJid = null;
     }
-    return RoomState(
-      roomJid: roomJid,
-      occupants: updated,
-      myOccupantJid: nextMyOccupantJid,
-      selfPresenceStatusCodes: selfPresenceStatusCodes,
-      selfPresenceReason: selfPresenceReason,
-      joinErrorCondition: joinErrorCondition,
-      joinErrorText: joinErrorText,
-      isDestroyed: isDestroyed,
-      destroyedAlternateRoomJid: destroyedAlternateRoomJid,
-      postJoinRefreshPending: postJoinRefreshPending,
-      pendingInviteeJids: pendingInviteeJids,
-    );
+    return _withOccupantIndex(index, myOccupantJid: nextMyOccupantJid);
   }
 
   RoomState withSelfOccupantUnavailable() {
@@ -641,9 +627,10 @@ class RoomState {
     if (identical(updatedOccupant, occupant)) {
       return this;
     }
-    final updated = Map<String, Occupant>.of(occupants)
-      ..[occupantJid] = updatedOccupant;
-    return copyWith(occupants: updated);
+    return _withOccupantIndex(
+      _occupants.index.put(occupantJid, updatedOccupant),
+      myOccupantJid: myOccupantJid,
+    );
   }
 
   RoomState withOccupantUnavailable(String occupantId) {
@@ -659,9 +646,26 @@ class RoomState {
     if (identical(updatedOccupant, occupant)) {
       return this;
     }
-    final updated = Map<String, Occupant>.of(occupants)
-      ..[resolvedOccupantId] = updatedOccupant;
-    return copyWith(occupants: updated);
+    return _withOccupantIndex(
+      _occupants.index.put(resolvedOccupantId, updatedOccupant),
+      myOccupantJid: myOccupantJid,
+    );
+  }
+
+  /// Inserts or replaces [occupant] under its occupant id. When [replacing]
+  /// names a different entry, that entry is dropped in the same step, as when
+  /// a placeholder resolves to the occupant's real id. The self occupant id
+  /// is left alone either way.
+  RoomState withOccupant(Occupant occupant, {String? replacing}) {
+    var index = _occupants.index;
+    if (replacing != null && replacing != occupant.occupantId) {
+      index = index.remove(replacing);
+    }
+    index = index.put(occupant.occupantId, occupant);
+    if (identical(index, _occupants.index)) {
+      return this;
+    }
+    return _withOccupantIndex(index, myOccupantJid: myOccupantJid);
   }
 
   RoomState withoutOccupants() {
@@ -686,38 +690,21 @@ class RoomState {
     required String keepOccupantId,
     required String realJid,
   }) {
-    var changed = false;
     var nextMyOccupantJid = myOccupantJid;
-    final updated = Map<String, Occupant>.of(occupants);
-    updated.removeWhere((occupantId, occupant) {
-      final occupantRealJid = occupant.realJid;
-      if (occupantId == keepOccupantId ||
-          occupantRealJid == null ||
-          !sameBareAddress(occupantRealJid, realJid)) {
-        return false;
+    var index = _occupants.index;
+    for (final occupantId in index.idsForRealJid(realJid)) {
+      if (occupantId == keepOccupantId) {
+        continue;
       }
       if (occupantId == nextMyOccupantJid) {
         nextMyOccupantJid = null;
       }
-      changed = true;
-      return true;
-    });
-    if (!changed) {
+      index = index.remove(occupantId);
+    }
+    if (identical(index, _occupants.index)) {
       return this;
     }
-    return RoomState(
-      roomJid: roomJid,
-      occupants: updated,
-      myOccupantJid: nextMyOccupantJid,
-      selfPresenceStatusCodes: selfPresenceStatusCodes,
-      selfPresenceReason: selfPresenceReason,
-      joinErrorCondition: joinErrorCondition,
-      joinErrorText: joinErrorText,
-      isDestroyed: isDestroyed,
-      destroyedAlternateRoomJid: destroyedAlternateRoomJid,
-      postJoinRefreshPending: postJoinRefreshPending,
-      pendingInviteeJids: pendingInviteeJids,
-    );
+    return _withOccupantIndex(index, myOccupantJid: nextMyOccupantJid);
   }
 
   RoomState withoutPresenceAndJoinState() {
@@ -748,20 +735,9 @@ class RoomState {
     if (resolvedOccupantId == null) {
       return this;
     }
-    final updated = Map<String, Occupant>.of(occupants)
-      ..remove(resolvedOccupantId);
-    return RoomState(
-      roomJid: roomJid,
-      occupants: updated,
+    return _withOccupantIndex(
+      _occupants.index.remove(resolvedOccupantId),
       myOccupantJid: myOccupantJid == resolvedOccupantId ? null : myOccupantJid,
-      selfPresenceStatusCodes: selfPresenceStatusCodes,
-      selfPresenceReason: selfPresenceReason,
-      joinErrorCondition: joinErrorCondition,
-      joinErrorText: joinErrorText,
-      isDestroyed: isDestroyed,
-      destroyedAlternateRoomJid: destroyedAlternateRoomJid,
-      postJoinRefreshPending: postJoinRefreshPending,
-      pendingInviteeJids: pendingInviteeJids,
     );
   }
 
@@ -771,72 +747,52 @@ class RoomState {
         !occupants.containsKey(trimmedOccupantId)) {
       return this;
     }
-    final updated = Map<String, Occupant>.of(occupants)
-      ..remove(trimmedOccupantId);
-    return RoomState(
-      roomJid: roomJid,
-      occupants: updated,
+    return _withOccupantIndex(
+      _occupants.index.remove(trimmedOccupantId),
       myOccupantJid: myOccupantJid == trimmedOccupantId ? null : myOccupantJid,
-      selfPresenceStatusCodes: selfPresenceStatusCodes,
-      selfPresenceReason: selfPresenceReason,
-      joinErrorCondition: joinErrorCondition,
-      joinErrorText: joinErrorText,
-      isDestroyed: isDestroyed,
-      destroyedAlternateRoomJid: destroyedAlternateRoomJid,
-      postJoinRefreshPending: postJoinRefreshPending,
-      pendingInviteeJids: pendingInviteeJids,
     );
   }
 
+  RoomState _withOccupantIndex(
+    _RoomOccupantIndex index, {
+    required String? myOccupantJid,
+  }) => RoomState(
+    roomJid: roomJid,
+    occupants: _RoomOccupantMap(index),
+    myOccupantJid: myOccupantJid,
+    selfPresenceStatusCodes: selfPresenceStatusCodes,
+    selfPresenceReason: selfPresenceReason,
+    joinErrorCondition: joinErrorCondition,
+    joinErrorText: joinErrorText,
+    isDestroyed: isDestroyed,
+    destroyedAlternateRoomJid: destroyedAlternateRoomJid,
+    postJoinRefreshPending: postJoinRefreshPending,
+    pendingInviteeJids: pendingInviteeJids,
+  );
+
   _RoomOccupantGroups _buildOccupantGroups() {
-    final owners = <Occupant>[];
-    final admins = <Occupant>[];
-    final moderators = <Occupant>[];
-    final members = <Occupant>[];
-    final participants = <Occupant>[];
-    final visitors = <Occupant>[];
-
-    for (final occupant in occupants.values) {
-      if (occupant.affiliation.isOutcast) continue;
-      if (!occupant.hasResolvedMembershipState) continue;
-      if (!occupant.isPresent && isPendingInvitee(occupant)) continue;
-      switch (occupant.memberSectionKind) {
-        case RoomMemberSectionKind.owners:
-          owners.add(occupant);
-        case RoomMemberSectionKind.admins:
-          admins.add(occupant);
-        case RoomMemberSectionKind.moderators:
-          moderators.add(occupant);
-        case RoomMemberSectionKind.members:
-          members.add(occupant);
-        case RoomMemberSectionKind.participants:
-          participants.add(occupant);
-        case RoomMemberSectionKind.visitors:
-          visitors.add(occupant);
+    List<Occupant> section(RoomMemberSectionKind kind) {
+      final sorted = _occupants.index.sortedSection(kind);
+      if (pendingInviteeJids.isEmpty) {
+        return sorted;
       }
+      return List<Occupant>.unmodifiable(
+        sorted.where(
+          (occupant) => occupant.isPresent || !isPendingInvitee(occupant),
+        ),
+      );
     }
 
-    _sortByNick(owners);
-    _sortByNick(admins);
-    _sortByNick(moderators);
-    _sortByNick(members);
-    _sortByNick(participants);
-    _sortByNick(visitors);
-
     return _RoomOccupantGroups(
-      owners: owners,
-      admins: admins,
-      moderators: moderators,
-      members: members,
-      participants: participants,
-      visitors: visitors,
+      owners: section(RoomMemberSectionKind.owners),
+      admins: section(RoomMemberSectionKind.admins),
+      moderators: section(RoomMemberSectionKind.moderators),
+      members: section(RoomMemberSectionKind.members),
+      participants: section(RoomMemberSectionKind.participants),
+      visitors: section(RoomMemberSectionKind.visitors),
     );
   }
 
-  void _sortByNick(List<Occupant> items) {
-    items.sort((a, b) => a.nick.toLowerCase().compareTo(b.nick.toLowerCase()));
-  }
-
   RoomState copyWith({
     Map<String, Occupant>? occupants,
     String? myOccupantJid,
@@ -960,14 +916,223 @@ class _RoomOccupantGroups {
   final List<Occupant> visitors;
 }
 
+/// The occupant map backing a [RoomState]. Passing it back into a
+/// [RoomState] constructor reuses its indexes instead of rebuilding them.
+final class _RoomOccupantMap extends UnmodifiableMapBase<String, Occupant> {
+  _RoomOccupantMap(this.index);
+
+  final _RoomOccupantIndex index;
+
+  @override
+  Occupant? operator [](Object? key) => index.byId[key];
+
+  @override
+  bool containsKey(Object? key) => index.byId.containsKey(key);
+
+  @override
+  int get length => index.byId.length;
+
+  @override
+  bool get isEmpty => index.byId.isEmpty;
+
+  @override
+  bool get isNotEmpty => index.byId.isNotEmpty;
+
+  @override
+  Iterable<String> get keys => index.byId.keys;
+
+  @override
+  Iterable<Occupant> get values => index.byId.values;
+
+  @override
+  Iterable<MapEntry<String, Occupant>> get entries => index.byId.entries;
+}
+
+/// Occupants keyed by id, plus the secondary lookups presence handling and
+/// the member list need: real JID, nick, full address, and member section.
+/// Every index is persistent, so an update touches O(log n) nodes and
+/// leaves earlier room states intact.
+final class _RoomOccupantIndex {
+  _RoomOccupantIndex._({
+    required this.byId,
+    required PersistentHashMap<String, List<String>> idsByRealJid,
+    required PersistentHashMap<String, List<String>> idsByNick,
+    required PersistentHashMap<String, List<String>> idsByFullAddress,
+    required List<PersistentHashMap<String, Occupant>> sections,
+    required List<List<Occupant>?> sortedSections,
+  }) : _idsByRealJid = idsByRealJid,
+       _idsByNick = idsByNick,
+       _idsByFullAddress = idsByFullAddress,
+       _sections = sections,
+       _sortedSections = sortedSections;
+
+  factory _RoomOccupantIndex.of(Map<String, Occupant>? occupants) {
+    if (occupants is _RoomOccupantMap) {
+      return occupants.index;
+    }
+    var index = _RoomOccupantIndex._empty();
+    for (final MapEntry(key: occupantId, value: occupant)
+        in occupants?.entries ?? const <MapEntry<String, Occupant>>[]) {
+      index = index.put(occupantId, occupant);
+    }
+    return index;
+  }
+
+  factory _RoomOccupantIndex._empty() => _RoomOccupantIndex._(
+    byId: const PersistentHashMap<String, Occupant>.empty(),
+    idsByRealJid: const PersistentHashMap<String, List<String>>.empty(),
+    idsByNick: const PersistentHashMap<String, List<String>>.empty(),
+    idsByFullAddress: const PersistentHashMap<String, List<String>>.empty(),
+    sections: List<PersistentHashMap<String, Occupant>>.filled(
+      RoomMemberSectionKind.values.length,
+      const PersistentHashMap<String, Occupant>.empty(),
+    ),
+    sortedSections: List<List<Occupant>?>.filled(
+      RoomMemberSectionKind.values.length,
+      const <Occupant>[],
+    ),
+  );
+
+  final PersistentHashMap<String, Occupant> byId;
+  final PersistentHashMap<String, List<String>> _idsByRealJid;
+  final PersistentHashMap<String, List<String>> _idsByNick;
+  final PersistentHashMap<String, List<String>> _idsByFullAddress;
+  final List<PersistentHashMap<String, Occupant>> _sections;
+
+  /// Sorted section lists, built on first read. Sections an update does not
+  /// touch carry their sorted list over to the next index.
+  final List<List<Occupant>?> _sortedSections;
+
+  List<String> idsForRealJid(String realJid) =>
+      _idsByRealJid[normalizedAddressKey(realJid)] ?? const <String>[];
+
+  List<String> idsForNick(String nick) =>
+      _idsByNick[nick.trim().toLowerCase()] ?? const <String>[];
+
+  List<String> idsForFullAddress(String address) =>
+      _idsByFullAddress[fullAddressLower(address)] ?? const <String>[];
+
+  List<Occupant> sortedSection(RoomMemberSectionKind kind) =>
+      _sortedSections[kind.index] ??= List<Occupant>.unmodifiable(
+        _sections[kind.index].values.toList()..sort(
+          (a, b) => a.nick.toLowerCase().compareTo(b.nick.toLowerCase()),
+        ),
+      );
+
+  _RoomOccupantIndex put(String occupantId, Occupant occupant) {
+    final previous = byId[occupantId];
+    if (identical(previous, occupant)) {
+      return this;
+    }
+    return _update(occupantId, previous: previous, next: occupant);
+  }
+
+  _RoomOccupantIndex remove(String occupantId) {
+    final previous = byId[occupantId];
+    if (previous == null) {
+      return this;
+    }
+    return _update(occupantId, previous: previous, next: null);
+  }
+
+  _RoomOccupantIndex _update(
+    String occupantId, {
+    required Occupant? previous,
+    required Occupant? next,
+  }) {
+    final sections = List<PersistentHashMap<String, Occupant>>.of(_sections);
+    final sortedSections = List<List<Occupant>?>.of(_sortedSections);
+    final previousSection = previous == null ? null : _sectionOf(previous);
+    final nextSection = next == null ? null : _sectionOf(next);
+    if (previousSection != null && previousSection != nextSection) {
+      sections[previousSection] = sections[previousSection].remove(occupantId);
+      sortedSections[previousSection] = null;
+    }
+    if (nextSection != null) {
+      sections[nextSection] = sections[nextSection].put(occupantId, next!);
+      sortedSections[nextSection] = null;
+    }
+    return _RoomOccupantIndex._(
+      byId: next == null
+          ? byId.remove(occupantId)
+          : byId.put(occupantId, next),
+      idsByRealJid: _reindex(
+        _idsByRealJid,
+        occupantId,
+        previous?.normalizedBareRealJid,
+        next?.normalizedBareRealJid,
+      ),
+      idsByNick: _reindex(
+        _idsByNick,
+        occupantId,
+        previous?.normalizedNick,
+        next?.normalizedNick,
+      ),
+      idsByFullAddress: _reindex(
+        _idsByFullAddress,
+        occupantId,
+        previous == null ? null : fullAddressLower(occupantId),
+        next == null ? null : fullAddressLower(occupantId),
+      ),
+      sections: sections,
+      sortedSections: sortedSections,
+    );
+  }
+
+  /// Mirrors the filters of the member list; pending invitees are filtered
+  /// when the list is read since they belong to the room, not the occupant.
+  static int? _sectionOf(Occupant occupant) {
+    if (occupant.affiliation.isOutcast) return null;
+    if (!occupant.hasResolvedMembershipState) return null;
+    return occupant.memberSectionKind.index;
+  }
+
+  static PersistentHashMap<String, List<String>> _reindex(
+    PersistentHashMap<String, List<String>> buckets,
+    String occupantId,
+    String? previousKey,
+    String? nextKey,
+  ) {
+    if (previousKey == nextKey) {
+      return buckets;
+    }
+    var updated = buckets;
+    if (previousKey != null && previousKey.isNotEmpty) {
+      final ids = updated[previousKey];
+      if (ids != null) {
+        final remaining = ids.where((id) => id != occupantId).toList();
+        updated = remaining.isEmpty
+            ? updated.remove(previousKey)
+            : updated.put(previousKey, List<String>.unmodifiable(remaining));
+      }
+    }
+    if (nextKey != null && nextKey.isNotEmpty) {
+      final ids = updated[nextKey] ?? const <String>[];
+      if (!ids.contains(occupantId)) {
+        updated = updated.put(
+          nextKey,
+          List<String>.unmodifiable(<String>[...ids, occupantId]),
+        );
+      }
+    }
+    return updated;
+  }
+}
+
 class _RoomOccupantDirectory {
-  const _RoomOccupantDirectory({
-    required this.roomJid,
-    required this.occupants,
-  });
+  const _RoomOccupantDirectory({required this.roomJid, required this.index});
 
   final String roomJid;
-  final Map<String, Occupant> occupants;
+  final _RoomOccupantIndex index;
+
+  Iterable<Occupant> _occupantsFor(List<String> occupantIds) sync* {
+    for (final occupantId in occupantIds) {
+      final occupant = index.byId[occupantId];
+      if (occupant != null) {
+        yield occupant;
+      }
+    }
+  }
 
   bool isRoomNickOccupantId(String occupantId) {
     final parsed = parseJid(occupantId);
@@ -993,14 +1158,13 @@ class _RoomOccupantDirectory {
       return null;
     }
     Occupant? fallback;
-    for (final occupant in occupants.values) {
+    for (final occupant in _occupantsFor(
+      index.idsForRealJid(trimmedRealJid),
+    )) {
       if (excludeRoomNickOccupantIds &&
           isRoomNickOccupantId(occupant.occupantId)) {
         continue;
       }
-      if (!occupant.matchesRealJid(trimmedRealJid)) {
-        continue;
-      }
       if (occupant.isPresent) {
         return occupant;
       }
@@ -1020,13 +1184,10 @@ class _RoomOccupantDirectory {
       return null;
     }
     Occupant? fallback;
-    for (final occupant in occupants.values) {
+    for (final occupant in _occupantsFor(index.idsForNick(trimmedNick))) {
       if (roomNickOccupantOnly && !isRoomNickOccupantId(occupant.occupantId)) {
         continue;
       }
-      if (!occupant.matchesNick(trimmedNick)) {
-        continue;
-      }
       if (preferPresent && occupant.isPresent) {
         if (!preferRealJid || occupant.hasRealJid) {
           return occupant;
@@ -1047,7 +1208,7 @@ class _RoomOccupantDirectory {
     bool preferRealJid = false,
   }) {
     final occupantId = canonicalOccupantId(senderJid);
-    final direct = occupantId == null ? null : occupants[occupantId];
+    final direct = occupantId == null ? null : index.byId[occupantId];
     if (direct != null && (!preferRealJid || direct.hasRealJid)) {
       return direct;
     }
@@ -1056,10 +1217,7 @@ class _RoomOccupantDirectory {
       return direct;
     }
     Occupant? fallback = direct;
-    for (final occupant in occupants.values) {
-      if (!occupant.matchesNick(nick)) {
-        continue;
-      }
+    for (final occupant in _occupantsFor(index.idsForNick(nick))) {
       if (preferRealJid && occupant.hasRealJid) {
         return occupant;
       }
@@ -1073,15 +1231,11 @@ class _RoomOccupantDirectory {
     if (trimmedOccupantId.isEmpty) {
       return null;
     }
-    if (occupants.containsKey(trimmedOccupantId)) {
+    if (index.byId.containsKey(trimmedOccupantId)) {
       return trimmedOccupantId;
     }
-    for (final key in occupants.keys) {
-      if (sameFullAddress(key, trimmedOccupantId)) {
-        return key;
-      }
-    }
-    return null;
+    final matches = index.idsForFullAddress(trimmedOccupantId);
+    return matches.isEmpty ? null : matches.first;
   }
 
   String? occupantIdForAffiliation({String? realJid, String? nick}) {
@@ -1119,8 +1273,8 @@ class _RoomOccupantDirectory {
       return null;
     }
     Occupant? fallback;
-    for (final occupant in occupants.values) {
-      if (!occupant.matchesNick(trimmedNick) || occupant.hasRealJid) {
+    for (final occupant in _occupantsFor(index.idsForNick(trimmedNick))) {
+      if (occupant.hasRealJid) {
         continue;
       }
       if (occupant.isPresent) {
@@ -0,0 +1,162 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+// Copyright (C) 2025-present Eliot Lew, Axichat Developers
+
+import 'dart:async';
+import 'dart:math' as math;
+
+import 'package:axichat/src/xmpp/omemo/omemo_cryptography.dart';
+import 'package:logging/logging.dart';
+import 'package:moxxmpp/moxxmpp.dart' as mox;
+
+const String omemoArchiveDecryptManagerId = 'axi.omemo.archive_decrypt';
+const String _encryptedTag = 'encrypted';
+const String _headerTag = 'header';
+const String _senderDeviceAttr = 'sid';
+
+typedef _HeldStanza = ({mox.Stanza stanza, mox.StanzaHandlerData state});
+
+/// Decrypts the OMEMO messages of an archive page as one batch.
+///
+/// While a page is [open], encrypted messages replayed for its query are
+/// taken out of the stanza pipeline just before the OMEMO manager would
+/// decrypt them one at a time. [drain] then decrypts every sending session
+/// in archive order inside [runInOmemoSession], with sessions running
+/// concurrently, and passes each message on to the remaining handlers in the
+/// order the archive returned them. Live messages are left alone.
+final class OmemoArchiveDecryptManager extends mox.XmppManagerBase {
+  OmemoArchiveDecryptManager(this._omemo, this._pipeline)
+    : super(omemoArchiveDecryptManagerId);
+
+  static final Logger _log = Logger('OmemoArchiveDecryptManager');
+
+  final mox.XmppManagerBase _omemo;
+
+  /// Managers registered on the connection, in registration order.
+  final List<mox.XmppManagerBase> Function() _pipeline;
+
+  final Map<String, List<_HeldStanza>> _pages = <String, List<_HeldStanza>>{};
+
+  late final List<int> _decryptPriorities = <int>[
+    for (final handler in _omemo.getIncomingStanzaHandlers())
+      if (handler.tagName == _encryptedTag) handler.priority,
+  ];
+
+  /// Runs right above the OMEMO manager's decryption handler.
+  int? get _holdPriority => _decryptPriorities.isEmpty
+      ? null
+      : _decryptPriorities.reduce(math.max) + 1;
+
+  @override
+  List<mox.StanzaHandler> getIncomingStanzaHandlers() {
+    final priority = _holdPriority;
+    if (priority == null) return const <mox.StanzaHandler>[];
+    return [
+      mox.StanzaHandler(
+        stanzaTag: 'message',
+        tagXmlns: mox.omemoXmlns,
+        tagName: _encryptedTag,
+        callback: _onEncryptedMessage,
+        priority: priority,
+      ),
+    ];
+  }
+
+  @override
+  Future<bool> isSupported() async => true;
+
+  /// Starts holding back encrypted messages replayed for [queryId].
+  void open(String queryId) =>
+      _pages.putIfAbsent(queryId, () => <_HeldStanza>[]);
+
+  /// Drops a page whose query failed; it is fetched again on retry.
+  void discard(String queryId) => _pages.remove(queryId);
+
+  Future<mox.StanzaHandlerData> _onEncryptedMessage(
+    mox.Stanza stanza,
+    mox.StanzaHandlerData state,
+  ) async {
+    final mamContext = state.extensions.get<mox.MAMContextData>();
+    if (!(mamContext?.isFromMAM ?? false)) return state;
+    final page = _pages[mamContext?.queryId?.trim()];
+    if (page == null) return state;
+    page.add((stanza: stanza, state: state));
+    return state..done = true;
+  }
+
+  /// Decrypts and delivers the messages held back for [queryId].
+  Future<void> drain(String queryId) async {
+    final page = _pages.remove(queryId);
+    final holdPriority = _holdPriority;
+    if (page == null || page.isEmpty || holdPriority == null) return;
+    final decryptFloor = _decryptPriorities.reduce(math.min);
+    final handlers = <mox.StanzaHandler>[
+      for (final manager in _pipeline())
+        if (!identical(manager, this))
+          for (final handler in manager.getIncomingStanzaHandlers())
+            if (handler.priority < holdPriority) handler,
+    ]..sort((a, b) => b.priority.compareTo(a.priority));
+    final decrypt = [
+      for (final handler in handlers)
+        if (handler.priority >= decryptFloor) handler,
+    ];
+    final deliver = [
+      for (final handler in handlers)
+        if (handler.priority < decryptFloor) handler,
+    ];
+
+    final sessionTails = <String, Future<void>>{};
+    final decrypted = <Future<mox.StanzaHandlerData>>[];
+    for (final held in page) {
+      held.state.done = false;
+      final session = _sessionOf(held.stanza);
+      final previous = sessionTails[session] ?? Future<void>.value();
+      final result = previous.then(
+        (_) => runInOmemoSession(
+          session,
+          () => _runHandlers(decrypt, held.state),
+        ),
+      );
+      sessionTails[session] = result.then<void>((_) {}, onError: (_) {});
+      decrypted.add(result);
+    }
+
+    for (final result in decrypted) {
+      try {
+        final state = await result;
+        if (state.done || state.cancel) continue;
+        await _runHandlers(deliver, state);
+      } catch (error, stackTrace) {
+        _log.warning(
+          'Failed to process an archived OMEMO message.',
+          error,
+          stackTrace,
+        );
+      }
+    }
+  }
+
+  /// Mirrors the connection's handler loop for one stanza.
+  Future<mox.StanzaHandlerData> _runHandlers(
+    List<mox.StanzaHandler> handlers,
+    mox.StanzaHandlerData state,
+  ) async {
+    var current = state;
+    for (final handler in handlers) {
+      if (!handler.matches(current.stanza)) continue;
+      current = await handler.callback(current.stanza, current);
+      if (current.done || current.cancel) break;
+    }
+    return current;
+  }
+
+  String _sessionOf(mox.Stanza stanza) {
+    final header = stanza
+        .firstTag(_encryptedTag, xmlns: mox.omemoXmlns)
+        ?.firstTag(_headerTag);
+    final device = int.tryParse(
+      header?.attributes[_senderDeviceAttr] as String? ?? '',
+    );
+    final sender = stanza.from?.split('/').first ?? '';
+    return omemoSessionKey(sender, device ?? 0);
+  }
+}
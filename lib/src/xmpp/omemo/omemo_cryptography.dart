@@ -0,0 +1,121 @@
+// SPDX-License-Identifier: AGPL-3.0-or-later
+// Copyright (C) 2025-present Eliot Lew, Axichat Developers
+
+import 'dart:async';
+import 'dart:math' as math;
+
+import 'package:axichat/src/common/keyed_isolate_pool.dart';
+import 'package:cryptography/cryptography.dart';
+import 'package:cryptography/dart.dart';
+
+const int _x25519SeedLength = 32;
+
+final Object _omemoSessionZoneKey = Object();
+
+/// Partition key for work done outside [runInOmemoSession].
+const String _omemoUnscopedTaskKey = 'omemo';
+
+/// Pool partition key of the session with [device] of [jid].
+String omemoSessionKey(String jid, int device) => '$jid:$device';
+
+/// Runs [body] with the X25519 work of [OmemoCryptography] keyed on
+/// [session], so one session's key agreements run in order on a single worker
+/// while other sessions spread across the pool.
+Future<T> runInOmemoSession<T>(Object session, Future<T> Function() body) =>
+    runZoned(body, zoneValues: {_omemoSessionZoneKey: session});
+
+/// [DartCryptography] with X25519 moved onto a [KeyedIsolatePool].
+///
+/// Handed to the OMEMO manager, which runs omemo_dart against it, so the
+/// scalar multiplications of every ratchet step and key exchange leave the
+/// calling isolate without replacing [Cryptography.instance] for the rest of
+/// the app. Hashing and AES over a message body stay inline; they cost less
+/// than the hop to a worker.
+final class OmemoCryptography extends DartCryptography {
+  OmemoCryptography(this._pool);
+
+  /// Looked up per call so a pool closed on reset is replaced transparently.
+  final KeyedIsolatePool Function() _pool;
+
+  @override
+  X25519 x25519() => _PooledX25519(_pool);
+}
+
+final class _PooledX25519 extends X25519 {
+  _PooledX25519(this._pool) : super.constructor();
+
+  final KeyedIsolatePool Function() _pool;
+
+  Object get _taskKey =>
+      Zone.current[_omemoSessionZoneKey] ?? _omemoUnscopedTaskKey;
+
+  @override
+  Future<SimpleKeyPair> newKeyPair() {
+    final random = math.Random.secure();
+    return newKeyPairFromSeed(
+      List<int>.generate(_x25519SeedLength, (_) => random.nextInt(256)),
+    );
+  }
+
+  @override
+  Future<SimpleKeyPair> newKeyPairFromSeed(List<int> seed) async {
+    final (privateKey, publicKey) = await _pool().run(
+      _taskKey,
+      _keyPairTask(List<int>.of(seed)),
+    );
+    return SimpleKeyPairData(
+      privateKey,
+      publicKey: SimplePublicKey(publicKey, type: KeyPairType.x25519),
+      type: KeyPairType.x25519,
+    );
+  }
+
+  @override
+  Future<SecretKey> sharedSecretKey({
+    required KeyPair keyPair,
+    required PublicKey remotePublicKey,
+  }) async {
+    final keyPairData = await keyPair.extract();
+    if (keyPairData is! SimpleKeyPairData ||
+        remotePublicKey is! SimplePublicKey) {
+      return DartX25519().sharedSecretKey(
+        keyPair: keyPair,
+        remotePublicKey: remotePublicKey,
+      );
+    }
+    final secret = await _pool().run(
+      _taskKey,
+      _sharedSecretTask(
+        privateKey: await keyPairData.extractPrivateKeyBytes(),
+        publicKey: (await keyPairData.extractPublicKey()).bytes,
+        remotePublicKey: remotePublicKey.bytes,
+      ),
+    );
+    return SecretKey(secret);
+  }
+}
+
+// Tasks are built in top-level functions so their closures capture only the
+// key bytes they are sent to the worker with.
+KeyedIsolateTask<(List<int>, List<int>)> _keyPairTask(List<int> seed) =>
+    () async {
+      final keyPair = await DartX25519().newKeyPairFromSeed(seed);
+      final publicKey = await keyPair.extractPublicKey();
+      return (await keyPair.extractPrivateKeyBytes(), publicKey.bytes);
+    };
+
+KeyedIsolateTask<List<int>> _sharedSecretTask({
+  required List<int> privateKey,
+  required List<int> publicKey,
+  required List<int> remotePublicKey,
+}) => () async {
+  final secret = await DartX25519().sharedSecretKey(
+    keyPair: SimpleKeyPairData(
+      privateKey,
+      publicKey: SimplePublicKey(publicKey, type: KeyPairType.x25519),
+      type: KeyPairType.x25519,
+    ),
+    remotePublicKey: SimplePublicKey(remotePublicKey, type: KeyPairType.x25519),
+  );
+  return secret.extractBytes();
+};
@@ -6,11 +6,19 @@ part of 'package:axichat/src/xmpp/xmpp_service.dart';
 final _omemoLogger = Logger('OmemoService');
 const String _omemoPublishBootstrapOperationName =
     'OmemoService.ensureDevicePublishedOnNegotiations';
+const String _omemoRatchetFlushOperationName =
+    'OmemoService.flushRatchetsOnTimer';
+const Duration _omemoRatchetFlushInterval = Duration(seconds: 2);
+const int _omemoRatchetFlushBatchSize = 64;
+const int _omemoRatchetCacheMaxJids = 256;
+const int _omemoRatchetDisposeFlushAttempts = 3;
+const Duration _omemoRatchetDisposeRetryDelay = Duration(milliseconds: 200);
 
 mixin OmemoService on XmppBase {
   var _omemoManager = ImpatientCompleter(Completer<mox.OmemoManager>());
   mox.OmemoPersistence? _omemoPersistence;
   Future<void>? _pendingOmemoInitialization;
+  OmemoArchiveDecryptManager? _omemoArchiveDecrypt;
 
   @override
   bool get needsReset => super.needsReset || _omemoManager.isCompleted;
@@ -101,7 +109,12 @@ mixin OmemoService on XmppBase {
       try {
         final manager = _omemoManager.value;
         if (manager != null) {
-          managers.add(manager);
+          final archiveDecrypt = OmemoArchiveDecryptManager(
+            manager,
+            () => _registeredFeatureManagers,
+          );
+          _omemoArchiveDecrypt = archiveDecrypt;
+          managers.addAll([manager, archiveDecrypt]);
           _omemoLogger.info('OMEMO manager added to featureManagers');
         }
       } catch (e) {
@@ -243,6 +256,29 @@ mixin OmemoService on XmppBase {
     return _OmemoPersistenceImpl(this);
   }
 
+  /// Writes back ratchets that are only held in memory so far. Called when
+  /// the app is paused or asked to exit, where the process may be killed
+  /// before the next timed flush.
+  Future<void> flushOmemoRatchets() async {
+    final persistence = _omemoPersistence;
+    if (persistence is! _OmemoPersistenceImpl) return;
+    try {
+      await persistence.flushRatchets();
+    } on XmppAbortedException {
+      return;
+    } catch (error, stackTrace) {
+      _omemoLogger.severe('Failed to flush OMEMO ratchets.', error, stackTrace);
+    }
+  }
+
+  Future<void> _discardOmemoPersistence() async {
+    final persistence = _omemoPersistence;
+    _omemoPersistence = null;
+    if (persistence is _OmemoPersistenceImpl) {
+      await persistence.dispose();
+    }
+  }
+
   Future<void> _completeOmemoManager() async {
     if (_omemoManager.isCompleted) return;
 
@@ -253,13 +289,13 @@ mixin OmemoService on XmppBase {
 
     try {
       _omemoLogger.info('Creating OMEMO manager (manual initialization)...');
-
       final manager = mox.OmemoManager(
         _shouldEncryptStanza,
         _getDeviceCallback,
         const mox.TrustManagerConfig.btbv(),
         enableMessageQueueing: true,
         initializeManually: true,
+        cryptography: kIsWeb ? null : OmemoCryptography(_omemoWorkerPool),
       );
 
       _omemoManager.complete(manager);
@@ -536,8 +572,9 @@ mixin OmemoService on XmppBase {
     await _connection.getManager<mox.OmemoManager>()?.deleteDevice(old.id);
 
     // Reinitialize the manager with the new device
+    await flushOmemoRatchets();
     _omemoManager = ImpatientCompleter(Completer<mox.OmemoManager>());
-    _omemoPersistence = null;
+    await _discardOmemoPersistence();
     await _completeOmemoManager();
     await _initializeOmemoManagerIfNeeded();
   }
@@ -565,15 +602,209 @@ mixin OmemoService on XmppBase {
     await manager.resetAllSessions(mox.JID.fromString(jid));
   }
 
+  @override
+  Future<void> _flushBeforeReset() async {
+    await super._flushBeforeReset();
+    await flushOmemoRatchets();
+  }
+
+  @override
+  void _openArchivePage(String queryId) {
+    super._openArchivePage(queryId);
+    _omemoArchiveDecrypt?.open(queryId);
+  }
+
+  @override
+  Future<void> _drainArchivePage(String queryId) async {
+    await super._drainArchivePage(queryId);
+    await _omemoArchiveDecrypt?.drain(queryId);
+  }
+
+  @override
+  void _discardArchivePage(String queryId) {
+    super._discardArchivePage(queryId);
+    _omemoArchiveDecrypt?.discard(queryId);
+  }
+
   @override
   Future<void> _reset() async {
     await super._reset();
     _omemoManager = ImpatientCompleter(Completer<mox.OmemoManager>());
-    _omemoPersistence = null;
+    _omemoArchiveDecrypt = null;
+    await _discardOmemoPersistence();
+    await _closeOmemoWorkerPool();
     _pendingOmemoInitialization = null;
   }
 }
 
+KeyedIsolatePool? _omemoWorkerPoolInstance;
+
+/// Runs ratchet (de)serialization and, through [OmemoCryptography], the
+/// X25519 work of decryption. Closed on reset and recreated on first use.
+KeyedIsolatePool _omemoWorkerPool() =>
+    _omemoWorkerPoolInstance ??= KeyedIsolatePool(debugName: 'omemo-worker');
+
+Future<void> _closeOmemoWorkerPool() async {
+  final pool = _omemoWorkerPoolInstance;
+  _omemoWorkerPoolInstance = null;
+  await pool?.close();
+}
+
+/// Serializes a ratchet on the worker pool. The closure only captures the
+/// ratchet, which is copied to the worker as a snapshot.
+Future<OmemoRatchet> _encodeOmemoRatchet({
+  required String jid,
+  required int device,
+  required omemo.OmemoDoubleRatchet ratchet,
+}) => _omemoWorkerPool().run(
+  omemoSessionKey(jid, device),
+  () => OmemoRatchet.fromDoubleRatchet(
+    jid: jid,
+    device: device,
+    ratchet: ratchet,
+  ),
+);
+
+Future<omemo.OmemoDoubleRatchet?> _decodeOmemoRatchet(OmemoRatchet row) =>
+    _omemoWorkerPool()
+        .run(omemoSessionKey(row.jid, row.device), row.toDoubleRatchet)
+        .catchError((Object error, StackTrace stackTrace) {
+          _omemoLogger.warning(
+            'Failed to restore ratchet for ${row.jid}:${row.device}',
+            error,
+            stackTrace,
+          );
+          return null;
+        });
+
+/// Ratchets keyed by (jid, device) plus the serialized rows that still need
+/// to be written back.
+///
+/// A jid is only served from memory once all of its ratchets were loaded, and
+/// rows are serialized when stored so a later write never observes a ratchet
+/// that omemo_dart is in the middle of advancing.
+final class _OmemoRatchetCache {
+  final LinkedHashMap<String, Map<int, omemo.OmemoDoubleRatchet>> _byJid =
+      LinkedHashMap<String, Map<int, omemo.OmemoDoubleRatchet>>();
+  final Map<RatchetMapKey, OmemoRatchet> _dirty =
+      <RatchetMapKey, OmemoRatchet>{};
+
+  /// Sessions that have a row on disk.
+  final Set<RatchetMapKey> _persisted = <RatchetMapKey>{};
+
+  /// Sending chain position (`ns`) of each session as last stored or loaded.
+  final Map<RatchetMapKey, int> _sendingPositions = <RatchetMapKey, int>{};
+
+  /// Sessions removed since the last [takeDirty]; a failed write must not
+  /// bring their rows back.
+  final Set<RatchetMapKey> _removedSinceTake = <RatchetMapKey>{};
+  final Map<String, int> _generations = <String, int>{};
+
+  int get dirtyCount => _dirty.length;
+
+  bool hasDirtyFor(String jid) => _dirty.keys.any((key) => key.jid == jid);
+
+  Map<RatchetMapKey, omemo.OmemoDoubleRatchet>? lookup(String jid) {
+    final ratchets = _byJid.remove(jid);
+    if (ratchets == null) return null;
+    _byJid[jid] = ratchets;
+    return <RatchetMapKey, omemo.OmemoDoubleRatchet>{
+      for (final entry in ratchets.entries)
+        RatchetMapKey(jid, entry.key): entry.value,
+    };
+  }
+
+  /// Bumped on every store or removal for [jid], so a load can tell whether
+  /// it raced one.
+  int generationOf(String jid) => _generations[jid] ?? 0;
+
+  void fill(
+    String jid,
+    Map<RatchetMapKey, omemo.OmemoDoubleRatchet> loaded, {
+    required int generation,
+  }) {
+    // A ratchet stored or removed while the load was in flight makes what
+    // was read stale; keep serving the jid from disk until the next load.
+    if (generationOf(jid) != generation) return;
+    _persisted.addAll(loaded.keys);
+    for (final entry in loaded.entries) {
+      _sendingPositions[entry.key] = entry.value.ns;
+    }
+    _byJid.remove(jid);
+    _byJid[jid] = <int, omemo.OmemoDoubleRatchet>{
+      for (final entry in loaded.entries) entry.key.deviceId: entry.value,
+    };
+    _evict();
+  }
+
+  /// Records a stored ratchet taken at sending position [sendingPosition].
+  /// Returns whether its write may wait for the next flush: only when the
+  /// session already has a row on disk and its sending chain did not move,
+  /// so all that a crash can lose is receive-side state the peer's messages
+  /// derive again. Anything else is written through by callers.
+  bool put(
+    omemo.OmemoDoubleRatchet ratchet,
+    OmemoRatchet row, {
+    required int sendingPosition,
+  }) {
+    final key = RatchetMapKey(row.jid, row.device);
+    _generations[row.jid] = generationOf(row.jid) + 1;
+    _dirty[key] = row;
+    final ratchets = _byJid.remove(row.jid);
+    if (ratchets != null) {
+      ratchets[row.device] = ratchet;
+      _byJid[row.jid] = ratchets;
+    }
+    final previousPosition = _sendingPositions[key];
+    _sendingPositions[key] = sendingPosition;
+    return _persisted.contains(key) && previousPosition == sendingPosition;
+  }
+
+  void markPersisted(Iterable<RatchetMapKey> keys) => _persisted.addAll(keys);
+
+  void remove(Iterable<RatchetMapKey> keys) {
+    for (final key in keys) {
+      _generations[key.jid] = generationOf(key.jid) + 1;
+      _dirty.remove(key);
+      _persisted.remove(key);
+      _sendingPositions.remove(key);
+      _removedSinceTake.add(key);
+      _byJid[key.jid]?.remove(key.deviceId);
+    }
+  }
+
+  Map<RatchetMapKey, OmemoRatchet> takeDirty() {
+    final dirty = Map<RatchetMapKey, OmemoRatchet>.of(_dirty);
+    _dirty.clear();
+    _removedSinceTake.clear();
+    return dirty;
+  }
+
+  /// Puts back rows whose write failed unless a newer row replaced them or
+  /// the session was removed in the meantime.
+  void restoreDirty(Map<RatchetMapKey, OmemoRatchet> rows) {
+    for (final entry in rows.entries) {
+      if (_removedSinceTake.contains(entry.key)) continue;
+      _dirty.putIfAbsent(entry.key, () => entry.value);
+    }
+  }
+
+  void clear() {
+    _byJid.clear();
+    _dirty.clear();
+    _persisted.clear();
+    _sendingPositions.clear();
+    _removedSinceTake.clear();
+    _generations.clear();
+  }
+
+  void _evict() {
+    while (_byJid.length > _omemoRatchetCacheMaxJids) {
+      _byJid.remove(_byJid.keys.first);
+    }
+  }
+}
+
 String _hexEncode(List<int> bytes) {
   final buffer = StringBuffer();
   for (final byte in bytes) {
@@ -650,6 +881,12 @@ class _OmemoPersistenceImpl implements mox.OmemoPersistence {
 
   static const _bundleCacheTtl = Duration(minutes: 30);
 
+  final _OmemoRatchetCache _ratchets = _OmemoRatchetCache();
+  Timer? _ratchetFlushTimer;
+  Future<void> _ratchetWriteTail = Future<void>.value();
+  int _pendingRatchetWrites = 0;
+  bool _disposed = false;
+
   bool get _hasDatabase => _service.isDatabaseReady;
 
   bool get _hasStateStore => _service.isStateStoreReady;
@@ -695,96 +932,225 @@ class _OmemoPersistenceImpl implements mox.OmemoPersistence {
       return;
     }
 
-    _omemoLogger.info('Storing ${ratchets.length} ratchets');
+    _omemoLogger.fine('Storing ${ratchets.length} ratchets');
+
+    // Sessions serialize in parallel on the worker pool; rows are applied in
+    // the order omemo_dart stored them. Sending positions are read now,
+    // before omemo_dart advances the ratchets any further.
+    final rows = <Future<OmemoRatchet>>[];
+    final sendingPositions = <int>[
+      for (final ratchetData in ratchets) ratchetData.ratchet.ns,
+    ];
+    for (final ratchetData in ratchets) {
+      _emitPersistRatchet(ratchetData, mox.OmemoActivityStage.start);
+      rows.add(
+        _encodeOmemoRatchet(
+          jid: ratchetData.jid,
+          device: ratchetData.id,
+          ratchet: ratchetData.ratchet,
+        ),
+      );
+    }
 
-    await _service._dbOp<XmppDatabase>((db) async {
-      for (final ratchetData in ratchets) {
-        _service.emitOmemoActivity(
-          mox.OmemoActivityEvent(
-            operation: mox.OmemoActivityOperation.persistRatchets,
-            stage: mox.OmemoActivityStage.start,
-            jid: ratchetData.jid,
-            deviceId: ratchetData.id,
-          ),
+    var writeThrough = false;
+    for (var index = 0; index < ratchets.length; index += 1) {
+      final ratchetData = ratchets[index];
+      try {
+        final row = await rows[index];
+        if (!_ratchets.put(
+          ratchetData.ratchet,
+          row,
+          sendingPosition: sendingPositions[index],
+        )) {
+          // A new session consumed one of our prekeys, or the sending chain
+          // advanced for a stanza about to go out. Losing either would reuse
+          // message keys or break the session, so, as before batching, the
+          // row is on disk before omemo_dart hands the stanza back.
+          writeThrough = true;
+        }
+      } catch (error, stackTrace) {
+        _omemoLogger.severe(
+          'Failed to persist ratchet for ${ratchetData.jid}:${ratchetData.id}.',
+          error,
+          stackTrace,
         );
-        try {
-          final ratchet = await OmemoRatchet.fromDoubleRatchet(
-            jid: ratchetData.jid,
-            device: ratchetData.id,
-            ratchet: ratchetData.ratchet,
-          );
-          await db.saveOmemoRatchet(ratchet);
-          _service.emitOmemoActivity(
-            mox.OmemoActivityEvent(
-              operation: mox.OmemoActivityOperation.persistRatchets,
-              stage: mox.OmemoActivityStage.end,
-              jid: ratchetData.jid,
-              deviceId: ratchetData.id,
-            ),
+        for (final pending in rows.skip(index + 1)) {
+          pending.ignore();
+        }
+        _emitPersistRatchet(
+          ratchetData,
+          mox.OmemoActivityStage.end,
+          error: error,
+        );
+        rethrow;
+      }
+    }
+
+    if (writeThrough || _ratchets.dirtyCount >= _omemoRatchetFlushBatchSize) {
+      try {
+        await flushRatchets();
+      } catch (error) {
+        for (final ratchetData in ratchets) {
+          _emitPersistRatchet(
+            ratchetData,
+            mox.OmemoActivityStage.end,
+            error: error,
           );
-        } catch (error, stackTrace) {
+        }
+        rethrow;
+      }
+    } else {
+      _scheduleRatchetFlush();
+    }
+    for (final ratchetData in ratchets) {
+      _emitPersistRatchet(ratchetData, mox.OmemoActivityStage.end);
+    }
+  }
+
+  void _emitPersistRatchet(
+    omemo.OmemoRatchetData ratchetData,
+    mox.OmemoActivityStage stage, {
+    Object? error,
+  }) {
+    _service.emitOmemoActivity(
+      mox.OmemoActivityEvent(
+        operation: mox.OmemoActivityOperation.persistRatchets,
+        stage: stage,
+        jid: ratchetData.jid,
+        deviceId: ratchetData.id,
+        error: error,
+      ),
+    );
+  }
+
+  void _scheduleRatchetFlush() {
+    if (_disposed) return;
+    _ratchetFlushTimer ??= Timer(_omemoRatchetFlushInterval, () {
+      _ratchetFlushTimer = null;
+      fireAndForget(
+        flushRatchets,
+        operationName: _omemoRatchetFlushOperationName,
+      );
+    });
+  }
+
+  /// Writes every dirty ratchet in one transaction. Writes are serialized, so
+  /// once this completes all ratchets stored before the call are on disk.
+  Future<void> flushRatchets() {
+    _ratchetFlushTimer?.cancel();
+    _ratchetFlushTimer = null;
+    if (_disposed ||
+        (_ratchets.dirtyCount == 0 && _pendingRatchetWrites == 0)) {
+      return Future<void>.value();
+    }
+    return _enqueueRatchetWrite(() async {
+      final rows = _ratchets.takeDirty();
+      if (rows.isEmpty) return;
+      try {
+        await _service._dbOp<XmppDatabase>(
+          (db) => db.saveOmemoRatchets(rows.values.toList(growable: false)),
+          awaitDatabase: true,
+        );
+      } catch (error) {
+        _ratchets.restoreDirty(rows);
+        _scheduleRatchetFlush();
+        rethrow;
+      }
+      _ratchets.markPersisted(rows.keys);
+      _omemoLogger.fine('Flushed ${rows.length} OMEMO ratchets.');
+    });
+  }
+
+  Future<void> _enqueueRatchetWrite(Future<void> Function() write) {
+    _pendingRatchetWrites += 1;
+    final next = _ratchetWriteTail.then((_) => write()).whenComplete(() {
+      _pendingRatchetWrites -= 1;
+    });
+    _ratchetWriteTail = next.then<void>((_) {}, onError: (Object _) {});
+    return next;
+  }
+
+  /// Writes back what is still dirty, retrying a failed write a few times
+  /// before the rows are given up.
+  Future<void> dispose() async {
+    for (var attempt = 1; !_disposed; attempt += 1) {
+      try {
+        await flushRatchets();
+        break;
+      } catch (error, stackTrace) {
+        if (attempt >= _omemoRatchetDisposeFlushAttempts) {
           _omemoLogger.severe(
-            'Failed to persist ratchet for ${ratchetData.jid}:${ratchetData.id}.',
+            'Dropping ${_ratchets.dirtyCount} unsaved OMEMO ratchets.',
             error,
             stackTrace,
           );
-          _service.emitOmemoActivity(
-            mox.OmemoActivityEvent(
-              operation: mox.OmemoActivityOperation.persistRatchets,
-              stage: mox.OmemoActivityStage.end,
-              jid: ratchetData.jid,
-              deviceId: ratchetData.id,
-              error: error,
-            ),
-          );
-          rethrow;
+          break;
         }
+        await Future<void>.delayed(_omemoRatchetDisposeRetryDelay * attempt);
       }
-    });
+    }
+    _disposed = true;
+    _ratchetFlushTimer?.cancel();
+    _ratchetFlushTimer = null;
+    _ratchets.clear();
   }
 
   @override
   Future<void> removeRatchets(List<RatchetMapKey> keys) async {
     if (!_hasDatabase) return;
+    _ratchets.remove(keys);
     final keyPairs = keys.map((key) => (key.jid, key.deviceId)).toList();
-    await _service._dbOp<XmppDatabase>(
-      (db) => db.removeOmemoRatchets(keyPairs),
+    // Queued behind in-flight flushes so an older row cannot reappear.
+    await _enqueueRatchetWrite(
+      () => _service._dbOp<XmppDatabase>(
+        (db) => db.removeOmemoRatchets(keyPairs),
+      ),
     );
   }
 
   @override
   Future<OmemoDataPackage?> loadRatchets(String jid) async {
     if (!_hasDatabase) return null;
-    return await _service._dbOpReturning<XmppDatabase, OmemoDataPackage?>((
-      db,
-    ) async {
-      // Load device list
-      final deviceListData = await db.getOmemoDeviceList(jid);
-      final deviceList = deviceListData?.devices ?? <int>[];
-
-      // Load ratchets for this JID
-      final ratchetList = await db.getOmemoRatchets(jid);
-      final ratchets = <RatchetMapKey, omemo.OmemoDoubleRatchet>{};
-
-      for (final entry in ratchetList) {
-        try {
-          final ratchet = await entry.toDoubleRatchet();
-          if (ratchet != null) {
-            ratchets[RatchetMapKey(entry.jid, entry.device)] = ratchet;
-          }
-        } catch (error, stackTrace) {
-          _omemoLogger.warning(
-            'Failed to restore ratchet for ${entry.jid}:${entry.device}',
-            error,
-            stackTrace,
+    final cached = _ratchets.lookup(jid);
+    if (cached != null) {
+      final deviceList = await _service
+          ._dbOpReturning<XmppDatabase, OmemoDeviceList?>(
+            (db) => db.getOmemoDeviceList(jid),
           );
-        }
+      final devices = deviceList?.devices ?? <int>[];
+      if (devices.isEmpty && cached.isEmpty) return null;
+      return OmemoDataPackage(devices, cached);
+    }
+    if (_ratchets.hasDirtyFor(jid)) {
+      await flushRatchets();
+    }
+    final generation = _ratchets.generationOf(jid);
+    final (deviceList, rows) = await _service
+        ._dbOpReturning<XmppDatabase, (List<int>, List<OmemoRatchet>)>((
+          db,
+        ) async {
+          final deviceListData = await db.getOmemoDeviceList(jid);
+          return (
+            deviceListData?.devices ?? <int>[],
+            await db.getOmemoRatchets(jid),
+          );
+        });
+
+    // Restoring a ratchet imports its keys; a 50-device group does that on
+    // the worker pool instead of between UI frames.
+    final restored = await Future.wait(rows.map(_decodeOmemoRatchet));
+    final ratchets = <RatchetMapKey, omemo.OmemoDoubleRatchet>{};
+    for (var index = 0; index < rows.length; index += 1) {
+      final ratchet = restored[index];
+      if (ratchet != null) {
+        ratchets[RatchetMapKey(rows[index].jid, rows[index].device)] = ratchet;
       }
+    }
+    _ratchets.fill(jid, ratchets, generation: generation);
 
-      if (deviceList.isEmpty && ratchets.isEmpty) return null;
+    if (deviceList.isEmpty && ratchets.isEmpty) return null;
 
-      return OmemoDataPackage(deviceList, ratchets);
-    });
+    return OmemoDataPackage(deviceList, ratchets);
   }
 
   @override
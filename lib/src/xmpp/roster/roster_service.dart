@@ -16,13 +16,22 @@ mixin RosterService
     );
   }
 
+  List<RosterItem>? _cachedRoster;
+
+  List<RosterItem>? get cachedRoster => _cachedRoster;
+
   Stream<List<RosterItem>> rosterStream({
     int start = 0,
     int end = basePageItemLimit,
   }) => createPaginatedStream<RosterItem, XmppDatabase>(
     watchFunction: (db) async => db.watchRoster(start: start, end: end),
     getFunction: (db) => db.getRoster(),
-  );
+  ).map((items) {
+    if (start == 0) {
+      _cachedRoster = List<RosterItem>.unmodifiable(items);
+    }
+    return items;
+  });
 
   Stream<List<Invite>> invitesStream({
     int start = 0,
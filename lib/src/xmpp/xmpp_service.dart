@@ -45,8 +45,10 @@ import 'package:axichat/src/common/foreground_notification_snapshot.dart';
 import 'package:axichat/src/common/foreground_task_messages.dart';
 import 'package:axichat/src/common/generate_random.dart';
 import 'package:axichat/src/common/html_content.dart';
+import 'package:axichat/src/common/keyed_isolate_pool.dart';
 import 'package:axichat/src/common/anti_abuse_sync.dart' as anti_abuse;
 import 'package:axichat/src/common/network_availability.dart';
+import 'package:axichat/src/common/startup/startup_trace.dart';
 import 'package:axichat/src/common/network_safety.dart';
 import 'package:axichat/src/common/safe_logging.dart';
 import 'package:axichat/src/common/security_flags.dart';
@@ -64,13 +66,18 @@ import 'package:axichat/src/localization/app_localizations.dart';
 import 'package:axichat/src/notifications/notification_service.dart';
 import 'package:axichat/src/notifications/notification_payload.dart';
 import 'package:axichat/src/storage/app_storage.dart';
+import 'package:axichat/src/xmpp/message/mam_catch_up.dart';
 import 'package:axichat/src/xmpp/muc/muc_join_state.dart';
 import 'package:axichat/src/xmpp/muc/occupant.dart';
 import 'package:axichat/src/xmpp/muc/room_state.dart';
+import 'package:axichat/src/xmpp/omemo/omemo_archive_decrypt.dart';
+import 'package:axichat/src/xmpp/omemo/omemo_cryptography.dart';
 import 'package:axichat/src/storage/database.dart' hide DraftAttachmentRef;
 import 'package:axichat/src/storage/impatient_completer.dart';
 import 'package:axichat/src/storage/models.dart';
+import 'package:axichat/src/storage/prepared_message_store.dart';
 import 'package:axichat/src/storage/state_store.dart';
+import 'package:axichat/src/storage/warm_start_snapshot.dart';
 import 'package:axichat/src/xmpp/pubsub/bookmarks_manager.dart';
 import 'package:axichat/src/xmpp/pubsub/calendar_snapshot_pubsub_manager.dart';
 import 'package:axichat/src/xmpp/pubsub/chat_settings_pubsub_manager.dart';
@@ -627,6 +634,10 @@ abstract interface class XmppBase {
 
   List<mox.XmppManagerBase> get featureManagers => [];
 
+  /// The [featureManagers] registered on the current connection.
+  List<mox.XmppManagerBase> _registeredFeatureManagers =
+      const <mox.XmppManagerBase>[];
+
   List<mox.XmppManagerBase> get pubSubFeatureManagers =>
       const <mox.XmppManagerBase>[];
 
@@ -669,8 +680,19 @@ abstract interface class XmppBase {
     bool awaitDatabase = false,
   });
 
+  /// Runs before a reset tears down the databases, while writes still land.
+  Future<void> _flushBeforeReset() async {}
+
   Future<void> _reset() async {}
 
+  /// Lets mixins hold back stanzas replayed for an archive query until
+  /// [_drainArchivePage] processes the page as a whole.
+  void _openArchivePage(String queryId) {}
+
+  Future<void> _drainArchivePage(String queryId) async {}
+
+  void _discardArchivePage(String queryId) {}
+
   bool get isDatabaseReady;
 
   bool get isStateStoreReady;
@@ -839,6 +861,7 @@ class XmppService extends XmppBase
   Completer<void>? _dbOperationsDrained;
   @override
   String? _databasePrefix;
+  Future<WarmStartSnapshotStore>? _warmStartStore;
 
   @override
   String? get activeDatabasePrefix {
@@ -2248,6 +2271,8 @@ class XmppService extends XmppBase
     _setConnection(await _connectionFactory());
     _configureSocketCallbacks();
     _myJid = targetJid;
+    _loadWarmStartSnapshot(databasePrefix, databasePassphrase);
+    _openPreparedMessageStore(databasePrefix, databasePassphrase);
     if (!_stateStore.isCompleted) {
       _stateStore.complete(
         await _stateStoreFactory(databasePrefix, databasePassphrase),
@@ -2288,6 +2313,8 @@ class XmppService extends XmppBase
     required bool preHashed,
   }) async {
     _connectionPasswordPreHashed = preHashed;
+    _loadWarmStartSnapshot(databasePrefix, databasePassphrase);
+    _openPreparedMessageStore(databasePrefix, databasePassphrase);
     _setConnection(connectionOverride ?? await _connectionFactory());
     _configureSocketCallbacks();
     _xmppLogger.info(
@@ -2619,7 +2646,9 @@ class XmppService extends XmppBase
     ];
     await _connection.registerFeatureNegotiators(featureNegotiators);
 
-    await _connection.registerManagers(featureManagers);
+    final managers = featureManagers;
+    _registeredFeatureManagers = managers;
+    await _connection.registerManagers(managers);
     _connection
         .getManager<mox.MessageManager>()
         ?.registerMessageSendingCallback(
@@ -2698,6 +2727,78 @@ class XmppService extends XmppBase
     // }
   }
 
+  /// Starts reading the warm start snapshot alongside the database open and
+  /// seeds the chat list and roster caches the home screen cubits start from,
+  /// unless live rows got there first.
+  void _loadWarmStartSnapshot(String prefix, String passphrase) {
+    if (_warmStartStore != null) return;
+    final pending = WarmStartSnapshotStore.forPrefix(
+      prefix: prefix,
+      passphrase: passphrase,
+    );
+    _warmStartStore = pending;
+    fireAndForget(() async {
+      final snapshot = await (await pending).read();
+      if (snapshot == null || !identical(_warmStartStore, pending)) return;
+      startupTrace.mark(StartupPhase.warmStartLoaded);
+      _cachedChatList ??= snapshot.chats;
+      _cachedRoster ??= snapshot.roster;
+      _xmppLogger.info(
+        'Warm start snapshot: ${snapshot.chats.length} chats, '
+        '${snapshot.roster.length} contacts, '
+        '${snapshot.unreadCount} unread.',
+      );
+    }, operationName: 'XmppService.loadWarmStartSnapshot');
+  }
+
+  void _openPreparedMessageStore(String prefix, String passphrase) {
+    _preparedMessageStore ??= PreparedMessageStore.forPrefix(
+      prefix: prefix,
+      passphrase: passphrase,
+    );
+  }
+
+  Future<void> _flushPreparedMessageStore() async {
+    final pending = _preparedMessageStore;
+    if (pending == null) return;
+    try {
+      await (await pending).flush();
+    } on Exception catch (error, stackTrace) {
+      _xmppLogger.fine('Failed to flush prepared messages.', error, stackTrace);
+    }
+  }
+
+  Future<void> _closePreparedMessageStore() async {
+    final pending = _preparedMessageStore;
+    if (pending == null) return;
+    await _flushPreparedMessageStore();
+    _preparedMessageStore = null;
+    try {
+      (await pending).dispose();
+    } on Exception catch (error, stackTrace) {
+      _xmppLogger.fine('Failed to close prepared messages.', error, stackTrace);
+    }
+  }
+
+  /// Persists the live first page of chats and the roster. Called when the
+  /// app goes to the background and before the databases close.
+  Future<void> _saveWarmStartSnapshot() async {
+    final pending = _warmStartStore;
+    final chats = _cachedChatList;
+    if (pending == null || chats == null || !_database.isCompleted) return;
+    try {
+      await (await pending).write(
+        WarmStartSnapshot(
+          chats: chats,
+          roster: _cachedRoster ?? const <RosterItem>[],
+          savedAt: DateTime.now(),
+        ),
+      );
+    } on Exception catch (error, stackTrace) {
+      _xmppLogger.fine('Failed to save warm start snapshot.', error, stackTrace);
+    }
+  }
+
   Future<void> _seedDemoChatsIfNeeded() async {
     if (_demoSeedAttempted || !kEnableDemoChats) return;
     _demoSeedAttempted = true;
@@ -3528,6 +3629,10 @@ class XmppService extends XmppBase
   }
 
   Future<void> setClientState([bool active = true]) async {
+    if (!active) {
+      await _saveWarmStartSnapshot();
+      await _flushPreparedMessageStore();
+    }
     if (!connected) return;
 
     if (_connection.getManager<mox.CSIManager>() case final csi?) {
@@ -4318,6 +4423,8 @@ class XmppService extends XmppBase
   Future<void> _reset([Exception? e]) async {
     if (!needsReset) return;
 
+    await _flushBeforeReset();
+
     final wasConnected = connected;
     final shouldDisconnectMox =
         wasConnected || await _moxConnectionStateIsConnectedForReset();
@@ -4400,6 +4507,10 @@ class XmppService extends XmppBase
       await _dbOperationsDrained?.future;
     }
 
+    await _saveWarmStartSnapshot();
+    _warmStartStore = null;
+    await _closePreparedMessageStore();
+
     final previousStateStore = _stateStore;
     final previousDatabase = _database;
     _stateStore = ImpatientCompleter(Completer<XmppStateStore>());
@@ -4423,6 +4534,7 @@ class XmppService extends XmppBase
     }
     _databasePrefix = null;
     _cachedChatList = null;
+    _cachedRoster = null;
 
     await super._reset();
     await _resetStreamControllers();
@@ -0,0 +1,121 @@
+#include "instance_channel.h"
+
+#include <cstring>
+
+namespace {
+
+constexpr char kChannelName[] = "im.axi.axichat/instance";
+constexpr char kTakePendingUrisMethod[] = "takePendingUris";
+constexpr char kLaunchPendingMethod[] = "launchPending";
+constexpr char kGetWindowAttachedMethod[] = "getWindowAttached";
+constexpr char kWindowAttachedMethod[] = "windowAttached";
+constexpr char kLowMemoryWarningMethod[] = "lowMemoryWarning";
+// Bounds the queue if Dart never drains it, e.g. a wedged engine.
+constexpr guint kMaxPendingUris = 64;
+
+GPtrArray* pending_uris = nullptr;
+gboolean window_attached = FALSE;
+
+FlValue* take_pending_uris_value() {
+  FlValue* result = fl_value_new_list();
+  if (pending_uris == nullptr) {
+    return result;
+  }
+  for (guint i = 0; i < pending_uris->len; ++i) {
+    fl_value_append_take(
+        result, fl_value_new_string(static_cast<const gchar*>(
+                    g_ptr_array_index(pending_uris, i))));
+  }
+  g_ptr_array_set_size(pending_uris, 0);
+  return result;
+}
+
+void method_call_cb(FlMethodChannel* channel, FlMethodCall* method_call,
+                    gpointer user_data) {
+  g_autoptr(FlMethodResponse) response = nullptr;
+  const gchar* method = fl_method_call_get_name(method_call);
+  if (strcmp(method, kTakePendingUrisMethod) == 0) {
+    g_autoptr(FlValue) result = take_pending_uris_value();
+    response = FL_METHOD_RESPONSE(fl_method_success_response_new(result));
+  } else if (strcmp(method, kGetWindowAttachedMethod) == 0) {
+    g_autoptr(FlValue) result = fl_value_new_bool(window_attached);
+    response = FL_METHOD_RESPONSE(fl_method_success_response_new(result));
+  } else {
+    response = FL_METHOD_RESPONSE(fl_method_not_implemented_response_new());
+  }
+
+  g_autoptr(GError) error = nullptr;
+  if (!fl_method_call_respond(method_call, response, &error)) {
+    g_warning("Failed to send instance channel response: %s", error->message);
+  }
+}
+
+#if GLIB_CHECK_VERSION(2, 64, 0)
+void low_memory_warning_cb(GMemoryMonitor* monitor,
+                           GMemoryMonitorWarningLevel level,
+                           gpointer user_data) {
+  g_autoptr(FlValue) args = fl_value_new_int(level);
+  fl_method_channel_invoke_method(FL_METHOD_CHANNEL(user_data),
+                                  kLowMemoryWarningMethod, args, nullptr,
+                                  nullptr, nullptr);
+}
+
+// Held for the life of the process; the signal connection is dropped with
+// the channel it targets.
+GMemoryMonitor* memory_monitor = nullptr;
+
+void watch_low_memory(FlMethodChannel* channel) {
+  if (memory_monitor == nullptr) {
+    memory_monitor = g_memory_monitor_dup_default();
+  }
+  if (memory_monitor == nullptr) {
+    return;
+  }
+  g_signal_connect_object(memory_monitor, "low-memory-warning",
+                          G_CALLBACK(low_memory_warning_cb), channel,
+                          static_cast<GConnectFlags>(0));
+}
+#else
+void watch_low_memory(FlMethodChannel* channel) {}
+#endif
+
+}  // namespace
+
+void instance_channel_queue_uris(FlMethodChannel* channel,
+                                 const gchar* const* uris) {
+  if (pending_uris == nullptr) {
+    pending_uris = g_ptr_array_new_with_free_func(g_free);
+  }
+  for (guint i = 0; uris[i] != nullptr; ++i) {
+    if (pending_uris->len >= kMaxPendingUris) {
+      g_warning("Dropping launch URI; %u already pending.", kMaxPendingUris);
+      break;
+    }
+    g_ptr_array_add(pending_uris, g_strdup(uris[i]));
+  }
+
+  if (channel != nullptr) {
+    fl_method_channel_invoke_method(channel, kLaunchPendingMethod, nullptr,
+                                    nullptr, nullptr, nullptr);
+  }
+}
+
+void instance_channel_set_window_attached(FlMethodChannel* channel,
+                                          gboolean attached) {
+  window_attached = attached;
+  if (channel != nullptr) {
+    g_autoptr(FlValue) args = fl_value_new_bool(attached);
+    fl_method_channel_invoke_method(channel, kWindowAttachedMethod, args,
+                                    nullptr, nullptr, nullptr);
+  }
+}
+
+FlMethodChannel* instance_channel_new(FlBinaryMessenger* messenger) {
+  g_autoptr(FlStandardMethodCodec) codec = fl_standard_method_codec_new();
+  FlMethodChannel* channel =
+      fl_method_channel_new(messenger, kChannelName, FL_METHOD_CODEC(codec));
+  fl_method_channel_set_method_call_handler(channel, method_call_cb, nullptr,
+                                            nullptr);
+  watch_low_memory(channel);
+  return channel;
+}
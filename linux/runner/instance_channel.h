@@ -0,0 +1,22 @@
+#ifndef RUNNER_INSTANCE_CHANNEL_H_
+#define RUNNER_INSTANCE_CHANNEL_H_
+
+#include <flutter_linux/flutter_linux.h>
+
+// Queues URIs opened in the primary instance, including those forwarded over
+// D-Bus from a second launch, until Dart drains them. When |channel| is
+// non-null Dart is notified that a launch payload is pending.
+void instance_channel_queue_uris(FlMethodChannel* channel,
+                                 const gchar* const* uris);
+
+// Records whether the Flutter view is attached to a window and, when |channel|
+// is non-null, tells Dart so it can trim UI memory while detached.
+void instance_channel_set_window_attached(FlMethodChannel* channel,
+                                          gboolean attached);
+
+// Creates the "im.axi.axichat/instance" channel Dart uses to take queued
+// launch URIs and the window attachment state. The channel also forwards
+// GMemoryMonitor low-memory warnings so Dart can trim its caches.
+FlMethodChannel* instance_channel_new(FlBinaryMessenger* messenger);
+
+#endif  // RUNNER_INSTANCE_CHANNEL_H_
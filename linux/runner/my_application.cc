@@ -8,17 +8,31 @@
 #include <glib/gstdio.h>
 
 #include "flutter/generated_plugin_registrant.h"
+#include "instance_channel.h"
+#include "startup_trace.h"
 
 struct _MyApplication {
   GtkApplication parent_instance;
   char** dart_entrypoint_arguments;
+  gboolean background;
+  GtkWindow* window;
+  FlEngine* engine;
+  FlMethodChannel* startup_trace_channel;
+  FlMethodChannel* instance_channel;
 };
 
 G_DEFINE_TYPE(MyApplication, my_application, GTK_TYPE_APPLICATION)
 
+// Runs the engine and sync without a window until the app is activated.
+constexpr char kBackgroundArgument[] = "--background";
+constexpr char kQuitArgument[] = "--quit";
+
 // Called when first Flutter frame received.
 static void first_frame_cb(MyApplication* self, FlView* view) {
-  gtk_widget_show(gtk_widget_get_toplevel(GTK_WIDGET(view)));
+  startup_trace_mark("native_first_frame");
+  if (self->window != nullptr) {
+    gtk_widget_show(GTK_WIDGET(self->window));
+  }
 }
 
 static gchar* build_executable_dir() {
@@ -132,11 +146,101 @@ static gchar* build_icon_path() {
                                    G_FILE_TEST_IS_REGULAR);
 }
 
+static FlDartProject* create_dart_project(MyApplication* self) {
+  configure_wpe_environment();
+  startup_trace_mark("native_wpe_environment_configured");
+
+  FlDartProject* project = fl_dart_project_new();
+  fl_dart_project_set_dart_entrypoint_arguments(project, self->dart_entrypoint_arguments);
+  return project;
+}
+
+static void create_channels(MyApplication* self, FlBinaryMessenger* messenger) {
+  self->startup_trace_channel = startup_trace_channel_new(messenger);
+  self->instance_channel = instance_channel_new(messenger);
+}
+
+// Starts a headless engine for background mode. It runs Dart without a
+// renderer: no GL context, surfaces or raster caches exist until a window
+// adds a view to it. Plugins are registered on the engine, so plugins that
+// need the view (desktop_drop) are inactive in this mode.
+static gboolean start_background_engine(MyApplication* self) {
+  g_autoptr(FlDartProject) project = create_dart_project(self);
+  self->engine = fl_engine_new_headless(project);
+
+  fl_register_plugins(FL_PLUGIN_REGISTRY(self->engine));
+  startup_trace_mark("native_plugins_registered");
+
+  create_channels(self, fl_engine_get_binary_messenger(self->engine));
+
+  g_autoptr(GError) error = nullptr;
+  if (!fl_engine_start(self->engine, &error)) {
+    g_warning("Failed to start headless engine: %s", error->message);
+    g_clear_object(&self->engine);
+    return FALSE;
+  }
+  startup_trace_mark("native_engine_started");
+  return TRUE;
+}
+
+// Creates the view for a new window. A background engine gets one view per
+// window; otherwise the view owns its engine, which starts on realize.
+static FlView* create_flutter_view(MyApplication* self) {
+  FlView* view = nullptr;
+  if (self->engine != nullptr) {
+    view = fl_view_new_for_engine(self->engine);
+    startup_trace_mark("native_view_created");
+  } else {
+    g_autoptr(FlDartProject) project = create_dart_project(self);
+    view = fl_view_new(project);
+    startup_trace_mark("native_view_created");
+
+    fl_register_plugins(FL_PLUGIN_REGISTRY(view));
+    startup_trace_mark("native_plugins_registered");
+
+    create_channels(self,
+                    fl_engine_get_binary_messenger(fl_view_get_engine(view)));
+  }
+
+  GdkRGBA background_color;
+  // Background defaults to black, override it here if necessary, e.g. #00000000
+  // for transparent.
+  gdk_rgba_parse(&background_color, "#000000");
+  fl_view_set_background_color(view, &background_color);
+  gtk_widget_show(GTK_WIDGET(view));
+
+  // Show the window when Flutter renders.
+  g_signal_connect_swapped(view, "first-frame", G_CALLBACK(first_frame_cb),
+                           self);
+  return view;
+}
+
+// In background mode closing the window destroys it together with its view,
+// which removes the view from the engine and releases its surfaces. The
+// engine, sync and notifications keep running; the next activation adds a
+// fresh view.
+static gboolean window_delete_cb(GtkWidget* window, GdkEvent* event,
+                                 MyApplication* self) {
+  instance_channel_set_window_attached(self->instance_channel, FALSE);
+  return FALSE;
+}
+
 // Implements GApplication::activate.
 static void my_application_activate(GApplication* application) {
   MyApplication* self = MY_APPLICATION(application);
+  // A unique instance is activated again by every forwarded launch; raise the
+  // existing window instead of booting a second engine.
+  if (self->window != nullptr) {
+    gtk_window_present(self->window);
+    return;
+  }
+
+  startup_trace_mark("native_activate");
   GtkWindow* window =
       GTK_WINDOW(gtk_application_window_new(GTK_APPLICATION(application)));
+  self->window = window;
+  g_object_add_weak_pointer(G_OBJECT(window),
+                            reinterpret_cast<gpointer*>(&self->window));
   gtk_window_set_icon_name(window, APPLICATION_ID);
 
   // Use a header bar when running in GNOME as this is the common style used
@@ -178,31 +282,56 @@ static void my_application_activate(GApplication* application) {
   }
 
   gtk_window_set_default_size(window, 1360, 760);
-  configure_wpe_environment();
 
-  g_autoptr(FlDartProject) project = fl_dart_project_new();
-  fl_dart_project_set_dart_entrypoint_arguments(project, self->dart_entrypoint_arguments);
-
-  FlView* view = fl_view_new(project);
-  GdkRGBA background_color;
-  // Background defaults to black, override it here if necessary, e.g. #00000000
-  // for transparent.
-  gdk_rgba_parse(&background_color, "#000000");
-  fl_view_set_background_color(view, &background_color);
-  gtk_widget_show(GTK_WIDGET(view));
+  FlView* view = create_flutter_view(self);
   gtk_container_add(GTK_CONTAINER(window), GTK_WIDGET(view));
+  if (self->background) {
+    g_signal_connect(window, "delete-event", G_CALLBACK(window_delete_cb),
+                     self);
+  }
 
-  // Show the window when Flutter renders.
   // Requires the view to be realized so we can start rendering.
-  g_signal_connect_swapped(view, "first-frame", G_CALLBACK(first_frame_cb),
-                           self);
   gtk_widget_realize(GTK_WIDGET(view));
-
-  fl_register_plugins(FL_PLUGIN_REGISTRY(view));
+  instance_channel_set_window_attached(self->instance_channel, TRUE);
 
   gtk_widget_grab_focus(GTK_WIDGET(view));
 }
 
+// Implements GApplication::open.
+static void my_application_open(GApplication* application, GFile** files,
+                                gint n_files, const gchar* hint) {
+  MyApplication* self = MY_APPLICATION(application);
+  g_autoptr(GPtrArray) uris = g_ptr_array_new_with_free_func(g_free);
+  for (gint i = 0; i < n_files; ++i) {
+    g_ptr_array_add(uris, g_file_get_uri(files[i]));
+  }
+  g_ptr_array_add(uris, nullptr);
+  instance_channel_queue_uris(self->instance_channel,
+                              reinterpret_cast<const gchar* const*>(uris->pdata));
+
+  g_application_activate(application);
+}
+
+// Opens the positional |arguments| as files/URIs, or activates when there are
+// none. On a remote instance GApplication forwards both over D-Bus to the
+// primary instance.
+static void open_or_activate(GApplication* application, gchar** arguments) {
+  g_autoptr(GPtrArray) files = g_ptr_array_new_with_free_func(g_object_unref);
+  for (gchar** argument = arguments; *argument != nullptr; ++argument) {
+    if (g_str_has_prefix(*argument, "-")) {
+      continue;
+    }
+    g_ptr_array_add(files, g_file_new_for_commandline_arg(*argument));
+  }
+
+  if (files->len == 0) {
+    g_application_activate(application);
+    return;
+  }
+  g_application_open(application, reinterpret_cast<GFile**>(files->pdata),
+                     files->len, "");
+}
+
 // Implements GApplication::local_command_line.
 static gboolean my_application_local_command_line(GApplication* application, gchar*** arguments, int* exit_status) {
   MyApplication* self = MY_APPLICATION(application);
@@ -221,12 +350,39 @@ static gboolean my_application_local_command_line(GApplication* application, gch
      return TRUE;
   }
 
-  g_application_activate(application);
   *exit_status = 0;
+  const gchar* const* options = *arguments + 1;
+  if (g_strv_contains(options, kQuitArgument)) {
+    g_action_group_activate_action(G_ACTION_GROUP(application), "quit",
+                                   nullptr);
+    return TRUE;
+  }
+
+  if (g_strv_contains(options, kBackgroundArgument)) {
+    // A running instance is already syncing; there is nothing to forward.
+    if (!g_application_get_is_remote(application)) {
+      if (!start_background_engine(self)) {
+        *exit_status = 1;
+        return TRUE;
+      }
+      self->background = TRUE;
+      g_application_hold(application);
+    }
+    return TRUE;
+  }
+
+  // A second launch hands its payload to the primary instance and exits
+  // before any engine, database or Delta accounts directory is touched.
+  open_or_activate(application, *arguments + 1);
 
   return TRUE;
 }
 
+static void quit_activated(GSimpleAction* action, GVariant* parameter,
+                           gpointer user_data) {
+  g_application_quit(G_APPLICATION(user_data));
+}
+
 // Implements GApplication::startup.
 static void my_application_startup(GApplication* application) {
   //MyApplication* self = MY_APPLICATION(object);
@@ -234,6 +390,14 @@ static void my_application_startup(GApplication* application) {
   // Perform any actions required at application startup.
 
   G_APPLICATION_CLASS(my_application_parent_class)->startup(application);
+
+  // "quit" is exported over D-Bus, so `--quit` from a second launch stops a
+  // primary instance that runs in background mode without a window.
+  static const GActionEntry app_actions[] = {
+      {"quit", quit_activated, nullptr, nullptr, nullptr, {0, 0, 0}},
+  };
+  g_action_map_add_action_entries(G_ACTION_MAP(application), app_actions,
+                                  G_N_ELEMENTS(app_actions), application);
 }
 
 // Implements GApplication::shutdown.
@@ -249,11 +413,15 @@ static void my_application_shutdown(GApplication* application) {
 static void my_application_dispose(GObject* object) {
   MyApplication* self = MY_APPLICATION(object);
   g_clear_pointer(&self->dart_entrypoint_arguments, g_strfreev);
+  g_clear_object(&self->startup_trace_channel);
+  g_clear_object(&self->instance_channel);
+  g_clear_object(&self->engine);
   G_OBJECT_CLASS(my_application_parent_class)->dispose(object);
 }
 
 static void my_application_class_init(MyApplicationClass* klass) {
   G_APPLICATION_CLASS(klass)->activate = my_application_activate;
+  G_APPLICATION_CLASS(klass)->open = my_application_open;
   G_APPLICATION_CLASS(klass)->local_command_line = my_application_local_command_line;
   G_APPLICATION_CLASS(klass)->startup = my_application_startup;
   G_APPLICATION_CLASS(klass)->shutdown = my_application_shutdown;
@@ -271,6 +439,6 @@ MyApplication* my_application_new() {
 
   return MY_APPLICATION(g_object_new(my_application_get_type(),
                                      "application-id", APPLICATION_ID,
-                                     "flags", G_APPLICATION_NON_UNIQUE,
+                                     "flags", G_APPLICATION_HANDLES_OPEN,
                                      nullptr));
 }
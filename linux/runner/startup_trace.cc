@@ -0,0 +1,67 @@
+#include "startup_trace.h"
+
+#include <cstring>
+
+namespace {
+
+constexpr char kChannelName[] = "im.axi.axichat/startup_trace";
+constexpr char kGetNativeMarksMethod[] = "getNativeMarks";
+constexpr guint kMaxMarks = 32;
+
+struct StartupMark {
+  const gchar* phase;
+  gint64 timestamp_micros;
+};
+
+StartupMark marks[kMaxMarks];
+guint mark_count = 0;
+
+FlValue* build_marks_value() {
+  FlValue* result = fl_value_new_list();
+  for (guint i = 0; i < mark_count; ++i) {
+    FlValue* entry = fl_value_new_map();
+    fl_value_set_string_take(entry, "name",
+                             fl_value_new_string(marks[i].phase));
+    fl_value_set_string_take(entry, "timestampMicros",
+                             fl_value_new_int(marks[i].timestamp_micros));
+    fl_value_append_take(result, entry);
+  }
+  return result;
+}
+
+void method_call_cb(FlMethodChannel* channel, FlMethodCall* method_call,
+                    gpointer user_data) {
+  g_autoptr(FlMethodResponse) response = nullptr;
+  if (strcmp(fl_method_call_get_name(method_call), kGetNativeMarksMethod) ==
+      0) {
+    g_autoptr(FlValue) result = build_marks_value();
+    response = FL_METHOD_RESPONSE(fl_method_success_response_new(result));
+  } else {
+    response = FL_METHOD_RESPONSE(fl_method_not_implemented_response_new());
+  }
+
+  g_autoptr(GError) error = nullptr;
+  if (!fl_method_call_respond(method_call, response, &error)) {
+    g_warning("Failed to send startup trace response: %s", error->message);
+  }
+}
+
+}  // namespace
+
+void startup_trace_mark(const gchar* phase) {
+  if (mark_count >= kMaxMarks) {
+    return;
+  }
+  marks[mark_count].phase = phase;
+  marks[mark_count].timestamp_micros = g_get_monotonic_time();
+  ++mark_count;
+}
+
+FlMethodChannel* startup_trace_channel_new(FlBinaryMessenger* messenger) {
+  g_autoptr(FlStandardMethodCodec) codec = fl_standard_method_codec_new();
+  FlMethodChannel* channel =
+      fl_method_channel_new(messenger, kChannelName, FL_METHOD_CODEC(codec));
+  fl_method_channel_set_method_call_handler(channel, method_call_cb, nullptr,
+                                            nullptr);
+  return channel;
+}
@@ -0,0 +1,14 @@
+#ifndef RUNNER_STARTUP_TRACE_H_
+#define RUNNER_STARTUP_TRACE_H_
+
+#include <flutter_linux/flutter_linux.h>
+
+// Records a named startup phase at the current g_get_monotonic_time().
+// |phase| must be a string literal; only the pointer is stored.
+void startup_trace_mark(const gchar* phase);
+
+// Creates the "im.axi.axichat/startup_trace" channel that hands the recorded
+// native phases to Dart, where they merge with the Dart-side marks.
+FlMethodChannel* startup_trace_channel_new(FlBinaryMessenger* messenger);
+
+#endif  // RUNNER_STARTUP_TRACE_H_
@@ -27,20 +27,30 @@ typedef DeltaContextBackgroundFetchRunner = Future<bool> Function({
   required int timeoutSeconds,
 });
 
+typedef DeltaBackgroundFetchReportRunner = Future<String?> Function({
+  required int accountsAddress,
+  required int timeoutSeconds,
+  required int accountTimeoutSeconds,
+});
+
 class DeltaSafe {
   DeltaSafe({
     DeltaChatBindings? bindings,
     DeltaBackgroundFetchRunner? backgroundFetchRunner,
     DeltaContextBackgroundFetchRunner? contextBackgroundFetchRunner,
+    DeltaBackgroundFetchReportRunner? backgroundFetchReportRunner,
   })  : _bindings = bindings ?? deltaBindings,
         _backgroundFetchRunner =
             backgroundFetchRunner ?? _runNativeAccountsBackgroundFetch,
         _contextBackgroundFetchRunner =
-            contextBackgroundFetchRunner ?? _runNativeContextBackgroundFetch;
+            contextBackgroundFetchRunner ?? _runNativeContextBackgroundFetch,
+        _backgroundFetchReportRunner = backgroundFetchReportRunner ??
+            _runNativeAccountsBackgroundFetchReport;
 
   final DeltaChatBindings _bindings;
   final DeltaBackgroundFetchRunner _backgroundFetchRunner;
   final DeltaContextBackgroundFetchRunner _contextBackgroundFetchRunner;
+  final DeltaBackgroundFetchReportRunner _backgroundFetchReportRunner;
 
   Future<DeltaContextHandle> createContext({
     required String databasePath,
@@ -79,6 +89,25 @@ class DeltaSafe {
     );
   }
 
+  bool get supportsIncrementalBackup =>
+      _deltaOptionalIncrementalBackup.isAvailable;
+
+  /// Rebuilds an account database and blob directory from an incremental
+  /// backup manifest, off this isolate. The account must be closed; existing
+  /// targets are never overwritten, and a failed restore leaves the blob
+  /// directory as it found it.
+  Future<DeltaIncrementalBackupRestore> restoreIncrementalBackup({
+    required String manifestPath,
+    required String databasePath,
+    required String blobDirectoryPath,
+  }) async {
+    return _deltaOptionalIncrementalBackup.restore(
+      manifestPath: manifestPath,
+      databasePath: databasePath,
+      blobDirectoryPath: blobDirectoryPath,
+    );
+  }
+
   Future<DeltaAccountsHandle> createAccounts({
     required String directory,
     bool writable = true,
@@ -93,6 +122,7 @@ class DeltaSafe {
       _bindings,
       accounts,
       backgroundFetchRunner: _backgroundFetchRunner,
+      backgroundFetchReportRunner: _backgroundFetchReportRunner,
     );
   }
 }
@@ -127,6 +157,49 @@ Future<bool> _runNativeContextBackgroundFetch({
   });
 }
 
+Future<String?> _runNativeAccountsBackgroundFetchReport({
+  required int accountsAddress,
+  required int timeoutSeconds,
+  required int accountTimeoutSeconds,
+}) {
+  return Isolate.run(() {
+    final _AxichatDcAccountsBackgroundFetchReportDart fetch;
+    try {
+      fetch = loadDeltaLibrary()
+          .lookup<
+              ffi.NativeFunction<
+                  _AxichatDcAccountsBackgroundFetchReportNative>>(
+            'axichat_dc_accounts_background_fetch_report',
+          )
+          .asFunction<_AxichatDcAccountsBackgroundFetchReportDart>();
+    } on Object catch (error) {
+      if (error is! ArgumentError && error is! UnsupportedError) {
+        rethrow;
+      }
+      return null;
+    }
+    final accounts = ffi.Pointer<dc_accounts_t>.fromAddress(accountsAddress);
+    return _takeString(
+      fetch(accounts, timeoutSeconds, accountTimeoutSeconds),
+      bindings: DeltaChatBindings(loadDeltaLibrary()),
+    );
+  });
+}
+
+typedef _AxichatDcAccountsBackgroundFetchReportNative = ffi.Pointer<ffi.Char>
+    Function(
+  ffi.Pointer<dc_accounts_t>,
+  ffi.Uint64,
+  ffi.Uint64,
+);
+
+typedef _AxichatDcAccountsBackgroundFetchReportDart = ffi.Pointer<ffi.Char>
+    Function(
+  ffi.Pointer<dc_accounts_t>,
+  int,
+  int,
+);
+
 typedef _DcGetConfigNative = ffi.Pointer<ffi.Char> Function(
   ffi.Pointer<dc_context_t>,
   ffi.Pointer<ffi.Char>,
@@ -191,6 +264,85 @@ typedef _AxichatDcGetMsgDebugInfoDart = ffi.Pointer<ffi.Char> Function(
   int,
 );
 
+typedef _AxichatDcImportBlobNative = ffi.Pointer<ffi.Char> Function(
+  ffi.Pointer<dc_context_t>,
+  ffi.Pointer<ffi.Char>,
+  ffi.Pointer<ffi.Char>,
+);
+
+typedef _AxichatDcImportBlobDart = ffi.Pointer<ffi.Char> Function(
+  ffi.Pointer<dc_context_t>,
+  ffi.Pointer<ffi.Char>,
+  ffi.Pointer<ffi.Char>,
+);
+
+typedef _AxichatDcFanOutSendNative = ffi.Pointer<ffi.Char> Function(
+  ffi.Pointer<dc_context_t>,
+  ffi.Pointer<ffi.Uint32>,
+  ffi.Int32,
+  ffi.Pointer<ffi.Char>,
+);
+
+typedef _AxichatDcFanOutSendDart = ffi.Pointer<ffi.Char> Function(
+  ffi.Pointer<dc_context_t>,
+  ffi.Pointer<ffi.Uint32>,
+  int,
+  ffi.Pointer<ffi.Char>,
+);
+
+typedef _AxichatDcInspectOpenPgpKeyringNative = ffi.Pointer<ffi.Char> Function(
+  ffi.Pointer<ffi.Char>,
+);
+
+typedef _AxichatDcInspectOpenPgpKeyringDart = ffi.Pointer<ffi.Char> Function(
+  ffi.Pointer<ffi.Char>,
+);
+
+typedef _AxichatDcImportContactPublicKeysNative = ffi.Pointer<ffi.Char>
+    Function(
+  ffi.Pointer<dc_context_t>,
+  ffi.Pointer<ffi.Char>,
+  ffi.Pointer<ffi.Char>,
+);
+
+typedef _AxichatDcImportContactPublicKeysDart = ffi.Pointer<ffi.Char> Function(
+  ffi.Pointer<dc_context_t>,
+  ffi.Pointer<ffi.Char>,
+  ffi.Pointer<ffi.Char>,
+);
+
+typedef _AxichatDcStartIncrementalBackupNative = ffi.Int32 Function(
+  ffi.Pointer<dc_context_t>,
+  ffi.Pointer<ffi.Char>,
+);
+
+typedef _AxichatDcStartIncrementalBackupDart = int Function(
+  ffi.Pointer<dc_context_t>,
+  ffi.Pointer<ffi.Char>,
+);
+
+typedef _AxichatDcStopIncrementalBackupNative = ffi.Int32 Function(
+  ffi.Pointer<dc_context_t>,
+);
+
+typedef _AxichatDcStopIncrementalBackupDart = int Function(
+  ffi.Pointer<dc_context_t>,
+);
+
+typedef _AxichatDcRestoreIncrementalBackupNative = ffi.Pointer<ffi.Char>
+    Function(
+  ffi.Pointer<ffi.Char>,
+  ffi.Pointer<ffi.Char>,
+  ffi.Pointer<ffi.Char>,
+);
+
+typedef _AxichatDcRestoreIncrementalBackupDart = ffi.Pointer<ffi.Char>
+    Function(
+  ffi.Pointer<ffi.Char>,
+  ffi.Pointer<ffi.Char>,
+  ffi.Pointer<ffi.Char>,
+);
+
 typedef _AxichatDcGetMsgRfc822BodyNative = ffi.Pointer<ffi.Char> Function(
   ffi.Pointer<dc_context_t>,
   ffi.Uint32,
@@ -542,6 +694,329 @@ final class _DeltaOptionalMsgRfc822Body {
 final _DeltaOptionalMsgRfc822Body _deltaOptionalMsgRfc822Body =
     _DeltaOptionalMsgRfc822Body();
 
+/// Runs the blob import on a short-lived isolate: a streamed copy of a large
+/// attachment would otherwise block the caller's event loop. Returns null
+/// when the native library predates the import export.
+Future<({String? json})?> _runNativeImportBlob({
+  required int contextAddress,
+  required String filePath,
+  required String? fileName,
+}) {
+  return Isolate.run(() {
+    final _AxichatDcImportBlobDart importBlob;
+    try {
+      importBlob = loadDeltaLibrary()
+          .lookup<ffi.NativeFunction<_AxichatDcImportBlobNative>>(
+            'axichat_dc_import_blob',
+          )
+          .asFunction<_AxichatDcImportBlobDart>();
+    } on Object catch (error) {
+      if (error is! ArgumentError && error is! UnsupportedError) {
+        rethrow;
+      }
+      return null;
+    }
+    final context = ffi.Pointer<dc_context_t>.fromAddress(contextAddress);
+    return _withCString(filePath, (pathPtr) {
+      final namePtr = fileName == null || fileName.isEmpty
+          ? ffi.nullptr
+          : _toCString(fileName);
+      try {
+        return (
+          json: _cleanString(
+            _takeString(
+              importBlob(context, pathPtr, namePtr),
+              bindings: DeltaChatBindings(loadDeltaLibrary()),
+            ),
+          ),
+        );
+      } finally {
+        if (namePtr != ffi.nullptr) {
+          malloc.free(namePtr);
+        }
+      }
+    });
+  });
+}
+
+/// Runs the fan-out send on a short-lived isolate: core renders and queues
+/// one message per chat, which would otherwise block the caller's event loop
+/// for the whole batch. Returns null when the native library predates the
+/// fan-out export.
+Future<String?> _runNativeFanOutSend({
+  required int contextAddress,
+  required List<int> chatIds,
+  required String messageJson,
+}) {
+  return Isolate.run(() {
+    final _AxichatDcFanOutSendDart fanOutSend;
+    try {
+      fanOutSend = loadDeltaLibrary()
+          .lookup<ffi.NativeFunction<_AxichatDcFanOutSendNative>>(
+            'axichat_dc_fan_out_send',
+          )
+          .asFunction<_AxichatDcFanOutSendDart>();
+    } on Object catch (error) {
+      if (error is! ArgumentError && error is! UnsupportedError) {
+        rethrow;
+      }
+      return null;
+    }
+    final context = ffi.Pointer<dc_context_t>.fromAddress(contextAddress);
+    final idsPointer = malloc<ffi.Uint32>(chatIds.length);
+    try {
+      for (var i = 0; i < chatIds.length; i++) {
+        idsPointer[i] = chatIds[i];
+      }
+      return _withCString(messageJson, (messagePtr) {
+        return _cleanString(
+          _takeString(
+            fanOutSend(context, idsPointer, chatIds.length, messagePtr),
+            bindings: DeltaChatBindings(loadDeltaLibrary()),
+          ),
+        );
+      });
+    } finally {
+      malloc.free(idsPointer);
+    }
+  });
+}
+
+final class _DeltaOptionalOpenPgpKeyring {
+  _DeltaOptionalOpenPgpKeyring()
+      : _inspect = _loadInspect(),
+        _import = _loadImport();
+
+  final _AxichatDcInspectOpenPgpKeyringDart? _inspect;
+  final _AxichatDcImportContactPublicKeysDart? _import;
+
+  static _AxichatDcInspectOpenPgpKeyringDart? _loadInspect() {
+    try {
+      final library = loadDeltaLibrary();
+      final symbol = library
+          .lookup<ffi.NativeFunction<_AxichatDcInspectOpenPgpKeyringNative>>(
+        'axichat_dc_inspect_openpgp_keyring',
+      );
+      return symbol.asFunction<_AxichatDcInspectOpenPgpKeyringDart>();
+    } on Object catch (error) {
+      if (error is! ArgumentError && error is! UnsupportedError) {
+        rethrow;
+      }
+      return null;
+    }
+  }
+
+  static _AxichatDcImportContactPublicKeysDart? _loadImport() {
+    try {
+      final library = loadDeltaLibrary();
+      final symbol = library.lookup<
+          ffi.NativeFunction<_AxichatDcImportContactPublicKeysNative>>(
+        'axichat_dc_import_contact_public_keys',
+      );
+      return symbol.asFunction<_AxichatDcImportContactPublicKeysDart>();
+    } on Object catch (error) {
+      if (error is! ArgumentError && error is! UnsupportedError) {
+        rethrow;
+      }
+      return null;
+    }
+  }
+
+  List<DeltaOpenPgpKeyringEntry>? inspect(
+    String armoredKeyring, {
+    required DeltaChatBindings bindings,
+  }) {
+    final fn = _inspect;
+    if (fn == null) {
+      return null;
+    }
+    final raw = _withCString(armoredKeyring, (keyringPtr) {
+      return _takeString(fn(keyringPtr), bindings: bindings);
+    });
+    return _entries(raw, operation: 'inspect OpenPGP keyring');
+  }
+
+  List<DeltaOpenPgpKeyringEntry>? import(
+    ffi.Pointer<dc_context_t> context,
+    String armoredKeyring, {
+    required Set<String> confirmedFingerprints,
+    required DeltaChatBindings bindings,
+  }) {
+    final fn = _import;
+    if (fn == null) {
+      return null;
+    }
+    final confirmed = jsonEncode(confirmedFingerprints.toList());
+    final raw = _withCString(armoredKeyring, (keyringPtr) {
+      return _withCString(confirmed, (confirmedPtr) {
+        return _takeString(
+          fn(context, keyringPtr, confirmedPtr),
+          bindings: bindings,
+        );
+      });
+    });
+    return _entries(raw, operation: 'import contact OpenPGP keyring');
+  }
+
+  static List<DeltaOpenPgpKeyringEntry> _entries(
+    String? raw, {
+    required String operation,
+  }) {
+    final parsed = _parseAxichatJsonResult(raw, operation: operation);
+    final keys = parsed['keys'];
+    if (keys is! List<Object?>) {
+      throw DeltaOperationException(
+        'Failed to $operation: invalid native response',
+      );
+    }
+    return [
+      for (final key in keys)
+        if (key is Map<String, Object?>) DeltaOpenPgpKeyringEntry.fromJson(key),
+    ];
+  }
+}
+
+final _DeltaOptionalOpenPgpKeyring _deltaOptionalOpenPgpKeyring =
+    _DeltaOptionalOpenPgpKeyring();
+
+final class _DeltaOptionalIncrementalBackup {
+  _DeltaOptionalIncrementalBackup()
+      : _start = _loadStart(),
+        _stop = _loadStop(),
+        _restore = _loadRestore();
+
+  final _AxichatDcStartIncrementalBackupDart? _start;
+  final _AxichatDcStopIncrementalBackupDart? _stop;
+  final _AxichatDcRestoreIncrementalBackupDart? _restore;
+
+  static _AxichatDcStartIncrementalBackupDart? _loadStart() {
+    try {
+      final library = loadDeltaLibrary();
+      final symbol = library.lookup<
+          ffi.NativeFunction<_AxichatDcStartIncrementalBackupNative>>(
+        'axichat_dc_start_incremental_backup',
+      );
+      return symbol.asFunction<_AxichatDcStartIncrementalBackupDart>();
+    } on Object catch (error) {
+      if (error is! ArgumentError && error is! UnsupportedError) {
+        rethrow;
+      }
+      return null;
+    }
+  }
+
+  static _AxichatDcStopIncrementalBackupDart? _loadStop() {
+    try {
+      final library = loadDeltaLibrary();
+      final symbol = library.lookup<
+          ffi.NativeFunction<_AxichatDcStopIncrementalBackupNative>>(
+        'axichat_dc_stop_incremental_backup',
+      );
+      return symbol.asFunction<_AxichatDcStopIncrementalBackupDart>();
+    } on Object catch (error) {
+      if (error is! ArgumentError && error is! UnsupportedError) {
+        rethrow;
+      }
+      return null;
+    }
+  }
+
+  static _AxichatDcRestoreIncrementalBackupDart? _loadRestore() {
+    try {
+      final library = loadDeltaLibrary();
+      final symbol = library.lookup<
+          ffi.NativeFunction<_AxichatDcRestoreIncrementalBackupNative>>(
+        'axichat_dc_restore_incremental_backup',
+      );
+      return symbol.asFunction<_AxichatDcRestoreIncrementalBackupDart>();
+    } on Object catch (error) {
+      if (error is! ArgumentError && error is! UnsupportedError) {
+        rethrow;
+      }
+      return null;
+    }
+  }
+
+  bool get isAvailable => _start != null && _restore != null;
+
+  bool start(ffi.Pointer<dc_context_t> context, String storeDirectory) {
+    final fn = _start;
+    if (fn == null) {
+      throw const DeltaOperationException(
+        'Delta FFI missing required symbol '
+        'axichat_dc_start_incremental_backup',
+      );
+    }
+    return _withCString(storeDirectory, (storePtr) {
+      return fn(context, storePtr) != _zeroValue;
+    });
+  }
+
+  bool stop(ffi.Pointer<dc_context_t> context) {
+    final fn = _stop;
+    if (fn == null) {
+      return false;
+    }
+    return fn(context) != _zeroValue;
+  }
+
+  Future<DeltaIncrementalBackupRestore> restore({
+    required String manifestPath,
+    required String databasePath,
+    required String blobDirectoryPath,
+  }) async {
+    if (_restore == null) {
+      throw const DeltaOperationException(
+        'Delta FFI missing required symbol '
+        'axichat_dc_restore_incremental_backup',
+      );
+    }
+    final raw = await _runNativeRestoreIncrementalBackup(
+      manifestPath: manifestPath,
+      databasePath: databasePath,
+      blobDirectoryPath: blobDirectoryPath,
+    );
+    final parsed = _parseAxichatJsonResult(
+      raw,
+      operation: 'restore incremental backup',
+    );
+    return DeltaIncrementalBackupRestore.fromJson(parsed);
+  }
+}
+
+/// Runs the restore on a short-lived isolate: it verifies and writes every
+/// chunk and the database snapshot, which would otherwise block the
+/// caller's event loop for the whole restore.
+Future<String?> _runNativeRestoreIncrementalBackup({
+  required String manifestPath,
+  required String databasePath,
+  required String blobDirectoryPath,
+}) {
+  return Isolate.run(() {
+    final library = loadDeltaLibrary();
+    final restore = library
+        .lookup<ffi.NativeFunction<_AxichatDcRestoreIncrementalBackupNative>>(
+          'axichat_dc_restore_incremental_backup',
+        )
+        .asFunction<_AxichatDcRestoreIncrementalBackupDart>();
+    return _withCString(manifestPath, (manifestPtr) {
+      return _withCString(databasePath, (databasePtr) {
+        return _withCString(blobDirectoryPath, (blobDirPtr) {
+          return _cleanString(
+            _takeString(
+              restore(manifestPtr, databasePtr, blobDirPtr),
+              bindings: DeltaChatBindings(library),
+            ),
+          );
+        });
+      });
+    });
+  });
+}
+
+final _DeltaOptionalIncrementalBackup _deltaOptionalIncrementalBackup =
+    _DeltaOptionalIncrementalBackup();
+
 final class _DeltaOptionalChatContactId {
   _DeltaOptionalChatContactId() : _getContactId = _loadGetContactId();
 
@@ -789,6 +1264,53 @@ final class DeltaContactPublicKeyImport {
   final int chatId;
 }
 
+/// One key of a keyring in a batch inspect or import. [reason] is set when
+/// the key was skipped or failed to import; ids are set once imported.
+final class DeltaOpenPgpKeyringEntry {
+  const DeltaOpenPgpKeyringEntry({
+    required this.index,
+    this.fingerprint,
+    this.address,
+    this.displayName,
+    this.userIds = const <String>[],
+    this.contactId,
+    this.chatId,
+    this.reason,
+  });
+
+  factory DeltaOpenPgpKeyringEntry.fromJson(Map<String, Object?> json) {
+    final contactId = json['contactId'];
+    final chatId = json['chatId'];
+    return DeltaOpenPgpKeyringEntry(
+      index: _jsonInt(json['index']),
+      fingerprint: _cleanString(json['fingerprint']?.toString()),
+      address: _cleanString(json['address']?.toString()),
+      displayName: _cleanString(json['name']?.toString()),
+      userIds: switch (json['userIds']) {
+        final List<Object?> values => values
+            .map((value) => value?.toString() ?? '')
+            .where((value) => value.trim().isNotEmpty)
+            .toList(growable: false),
+        _ => const <String>[],
+      },
+      contactId: contactId == null ? null : _jsonInt(contactId),
+      chatId: chatId == null ? null : _jsonInt(chatId),
+      reason: _cleanString(json['reason']?.toString()),
+    );
+  }
+
+  final int index;
+  final String? fingerprint;
+  final String? address;
+  final String? displayName;
+  final List<String> userIds;
+  final int? contactId;
+  final int? chatId;
+  final String? reason;
+
+  bool get isImported => reason == null && contactId != null && chatId != null;
+}
+
 final class DeltaContactPublicKeyRemoval {
   const DeltaContactPublicKeyRemoval({
     required this.contactId,
@@ -812,6 +1334,165 @@ final class DeltaContactPublicKeyRemoval {
   final String fingerprint;
 }
 
+enum DeltaBlobImportStrategy {
+  blobdir,
+  reflink,
+  copy;
+
+  static DeltaBlobImportStrategy? fromName(Object? name) {
+    for (final value in values) {
+      if (value.name == name) return value;
+    }
+    return null;
+  }
+}
+
+/// Result of placing an outgoing file into the account blob directory.
+final class DeltaBlobImport {
+  const DeltaBlobImport({
+    required this.path,
+    required this.strategy,
+    required this.bytes,
+    required this.deduplicated,
+    this.hash,
+  });
+
+  factory DeltaBlobImport.fromJson(Map<String, Object?> json) {
+    final path = json['path']?.toString() ?? '';
+    final strategy = DeltaBlobImportStrategy.fromName(json['strategy']);
+    if (path.isEmpty || strategy == null) {
+      throw const DeltaOperationException(
+        'Failed to import blob: invalid native response',
+      );
+    }
+    return DeltaBlobImport(
+      path: path,
+      strategy: strategy,
+      bytes: _jsonInt(json['bytes']),
+      deduplicated: json['deduplicated'] == true,
+      hash: json['hash']?.toString(),
+    );
+  }
+
+  final String path;
+  final DeltaBlobImportStrategy strategy;
+  final int bytes;
+  final bool deduplicated;
+  final String? hash;
+}
+
+/// Outcome of one chat in a fan-out send: the new message id, or the core
+/// error that kept this chat's copy from being queued.
+final class DeltaFanOutSendResult {
+  const DeltaFanOutSendResult({
+    required this.chatId,
+    this.msgId,
+    this.error,
+  });
+
+  factory DeltaFanOutSendResult.fromJson(Map<String, Object?> json) {
+    final msgId = json['msgId'];
+    return DeltaFanOutSendResult(
+      chatId: _jsonInt(json['chatId']),
+      msgId: msgId == null ? null : _jsonInt(msgId),
+      error: json['error']?.toString(),
+    );
+  }
+
+  final int chatId;
+  final int? msgId;
+  final String? error;
+
+  bool get isSent => msgId != null && msgId! > 0;
+}
+
+enum DeltaAccountFetchStatus {
+  done,
+  error,
+  timeout,
+  cancelled;
+
+  static DeltaAccountFetchStatus fromJson(Object? value) =>
+      DeltaAccountFetchStatus.values.firstWhere(
+        (status) => status.name == value,
+        orElse: () => DeltaAccountFetchStatus.error,
+      );
+}
+
+/// One account's share of a concurrent background fetch.
+final class DeltaAccountFetchReport {
+  const DeltaAccountFetchReport({
+    required this.accountId,
+    required this.status,
+    required this.fetched,
+    required this.duration,
+    this.error,
+  });
+
+  factory DeltaAccountFetchReport.fromJson(Map<String, Object?> json) {
+    return DeltaAccountFetchReport(
+      accountId: _jsonInt(json['accountId']),
+      status: DeltaAccountFetchStatus.fromJson(json['status']),
+      fetched: _jsonInt(json['fetched']),
+      duration: Duration(milliseconds: _jsonInt(json['durationMs'])),
+      error: json['error']?.toString(),
+    );
+  }
+
+  final int accountId;
+  final DeltaAccountFetchStatus status;
+  final int fetched;
+  final Duration duration;
+  final String? error;
+}
+
+final class DeltaBackgroundFetchReport {
+  const DeltaBackgroundFetchReport({
+    required this.cancelled,
+    required this.duration,
+    required this.accounts,
+  });
+
+  factory DeltaBackgroundFetchReport.fromJson(Map<String, Object?> json) {
+    final accounts = json['accounts'];
+    return DeltaBackgroundFetchReport(
+      cancelled: json['cancelled'] == true,
+      duration: Duration(milliseconds: _jsonInt(json['durationMs'])),
+      accounts: [
+        if (accounts is List<Object?>)
+          for (final account in accounts)
+            if (account is Map<String, Object?>)
+              DeltaAccountFetchReport.fromJson(account),
+      ],
+    );
+  }
+
+  final bool cancelled;
+  final Duration duration;
+  final List<DeltaAccountFetchReport> accounts;
+
+  int get fetched =>
+      accounts.fold<int>(0, (total, account) => total + account.fetched);
+}
+
+/// What an incremental backup restore wrote into the account directory.
+final class DeltaIncrementalBackupRestore {
+  const DeltaIncrementalBackupRestore({
+    required this.blobs,
+    required this.bytes,
+  });
+
+  factory DeltaIncrementalBackupRestore.fromJson(Map<String, Object?> json) {
+    return DeltaIncrementalBackupRestore(
+      blobs: _jsonInt(json['blobs']),
+      bytes: _jsonInt(json['bytes']),
+    );
+  }
+
+  final int blobs;
+  final int bytes;
+}
+
 class DeltaVideoChatType {
   static const int unknown = DC_VIDEOCHATTYPE_UNKNOWN;
   static const int basicWebrtc = DC_VIDEOCHATTYPE_BASICWEBRTC;
@@ -1302,6 +1983,36 @@ class DeltaContextHandle {
     return DeltaContactPublicKeyImport.fromJson(parsed);
   }
 
+  /// Parses every public key block in [armoredKeyring] on native worker
+  /// threads. Returns null when the native library predates the keyring
+  /// exports.
+  Future<List<DeltaOpenPgpKeyringEntry>?> inspectOpenPgpKeyring(
+    String armoredKeyring,
+  ) async {
+    _ensureState(_opened, 'inspect OpenPGP keyring');
+    return _deltaOptionalOpenPgpKeyring.inspect(
+      armoredKeyring,
+      bindings: _bindings,
+    );
+  }
+
+  /// Imports the usable keys of [armoredKeyring] whose fingerprints are in
+  /// [confirmedFingerprints] as key contacts with their chats in one native
+  /// call; other keys come back with the reason `unconfirmed`. Returns null
+  /// when the native library predates the keyring exports.
+  Future<List<DeltaOpenPgpKeyringEntry>?> importContactPublicKeys(
+    String armoredKeyring, {
+    required Set<String> confirmedFingerprints,
+  }) async {
+    _ensureState(_opened, 'import contact OpenPGP keyring');
+    return _deltaOptionalOpenPgpKeyring.import(
+      _context,
+      armoredKeyring,
+      confirmedFingerprints: confirmedFingerprints,
+      bindings: _bindings,
+    );
+  }
+
   Future<DeltaContactPublicKeyRemoval> removeContactPublicKey({
     required String address,
     required String fingerprint,
@@ -1330,6 +2041,79 @@ class DeltaContextHandle {
     return DeltaContactPublicKeyRemoval.fromJson(parsed);
   }
 
+  /// Copies [filePath] into the blob directory by reflink or streamed copy,
+  /// naming it by content hash. Returns null when the native library
+  /// predates the import export.
+  Future<DeltaBlobImport?> importBlob({
+    required String filePath,
+    String? fileName,
+  }) async {
+    _ensureState(_opened, 'import blob');
+    final result = await _runNativeImportBlob(
+      contextAddress: _context.address,
+      filePath: filePath,
+      fileName: fileName,
+    );
+    if (result == null) {
+      return null;
+    }
+    final parsed = _parseAxichatJsonResult(
+      result.json,
+      operation: 'import blob',
+    );
+    return DeltaBlobImport.fromJson(parsed);
+  }
+
+  /// Sends the same file message to every chat in [chatIds] in one native
+  /// call, off this isolate, that attaches the file once and queues a copy
+  /// per chat. Returns null when the native library predates the fan-out
+  /// export.
+  Future<List<DeltaFanOutSendResult>?> fanOutFileMessage({
+    required List<int> chatIds,
+    required int viewType,
+    required String filePath,
+    String? fileName,
+    String? mimeType,
+    String? text,
+    String? subject,
+    String? html,
+    bool forcePlaintext = false,
+  }) async {
+    _ensureState(_opened, _deltaSendFileOperation);
+    if (chatIds.isEmpty) {
+      return const <DeltaFanOutSendResult>[];
+    }
+    final raw = await _runNativeFanOutSend(
+      contextAddress: _context.address,
+      chatIds: chatIds,
+      messageJson: jsonEncode({
+        'viewType': viewType,
+        'file': filePath,
+        'fileName': fileName,
+        'mime': mimeType,
+        'text': text,
+        'subject': subject?.trim(),
+        'html': html?.trim(),
+        'forcePlaintext': forcePlaintext,
+      }),
+    );
+    if (raw == null) {
+      return null;
+    }
+    final parsed = _parseAxichatJsonResult(raw, operation: 'fan out send');
+    final results = parsed['results'];
+    if (results is! List<Object?>) {
+      throw const DeltaOperationException(
+        'Failed to fan out send: invalid native response',
+      );
+    }
+    return [
+      for (final result in results)
+        if (result is Map<String, Object?>)
+          DeltaFanOutSendResult.fromJson(result),
+    ];
+  }
+
   Future<int?> lookupContactIdByAddress(String address) async {
     _ensureState(_opened, 'lookup contact');
     final contactId = _withCString(address, (addrPtr) {
@@ -2552,8 +3336,28 @@ class DeltaContextHandle {
     }
   }
 
+  /// Starts the wrapper's chunked backup export into [storeDirectory]. Like
+  /// [startImex] it returns at once and reports through ImexProgress, with
+  /// the new manifest path in ImexFileWritten; [stopOngoingProcess] cancels
+  /// it.
+  Future<void> startIncrementalBackup({required String storeDirectory}) async {
+    _ensureState(_opened, 'start incremental backup');
+    final trimmedPath = storeDirectory.trim();
+    if (trimmedPath.isEmpty) {
+      throw const DeltaOperationException(
+        'Failed to start incremental backup: empty path',
+      );
+    }
+    if (!_deltaOptionalIncrementalBackup.start(_context, trimmedPath)) {
+      throw const DeltaOperationException(
+        'Failed to start incremental backup',
+      );
+    }
+  }
+
   Future<void> stopOngoingProcess() async {
     _ensureState(_opened, 'stop ongoing process');
+    _deltaOptionalIncrementalBackup.stop(_context);
     try {
       _bindings.dc_stop_ongoing_process(_context);
     } on Object catch (error) {
@@ -2647,11 +3451,14 @@ class DeltaAccountsHandle {
     this._bindings,
     this._accounts, {
     required DeltaBackgroundFetchRunner backgroundFetchRunner,
-  }) : _backgroundFetchRunner = backgroundFetchRunner;
+    required DeltaBackgroundFetchReportRunner backgroundFetchReportRunner,
+  })  : _backgroundFetchRunner = backgroundFetchRunner,
+        _backgroundFetchReportRunner = backgroundFetchReportRunner;
 
   final DeltaChatBindings _bindings;
   final ffi.Pointer<dc_accounts_t> _accounts;
   final DeltaBackgroundFetchRunner _backgroundFetchRunner;
+  final DeltaBackgroundFetchReportRunner _backgroundFetchReportRunner;
 
   _DeltaEventLoop? _eventLoop;
   Future<void>? _idleEventLoopDisposal;
@@ -2800,6 +3607,56 @@ class DeltaAccountsHandle {
     }
   }
 
+  /// Fetches every account concurrently, each within [accountTimeout]
+  /// (capped by [timeout]), and reports per-account outcomes. Returns null
+  /// when the native library predates the report export; callers fall back
+  /// to [backgroundFetch]. [stopIo] and [dispose] cancel it like a plain
+  /// background fetch.
+  Future<DeltaBackgroundFetchReport?> backgroundFetchReport(
+    Duration timeout, {
+    Duration? accountTimeout,
+  }) async {
+    if (_disposed) return null;
+    final timeoutSeconds = timeout.inSeconds;
+    if (timeoutSeconds <= 2) {
+      return null;
+    }
+    final active = _activeBackgroundFetch;
+    if (active != null) {
+      final completed = await active;
+      return DeltaBackgroundFetchReport(
+        cancelled: !completed,
+        duration: Duration.zero,
+        accounts: const <DeltaAccountFetchReport>[],
+      );
+    }
+    final report = Future<String?>.sync(
+      () => _backgroundFetchReportRunner(
+        accountsAddress: _accounts.address,
+        timeoutSeconds: timeoutSeconds,
+        accountTimeoutSeconds: accountTimeout?.inSeconds ?? timeoutSeconds,
+      ),
+    );
+    final task = report.then(
+      (raw) => raw != null,
+      onError: (Object _) => false,
+    );
+    _activeBackgroundFetch = task;
+    try {
+      final raw = await report;
+      if (raw == null) {
+        return null;
+      }
+      return DeltaBackgroundFetchReport.fromJson(
+        _parseAxichatJsonResult(raw, operation: 'background fetch'),
+      );
+    } finally {
+      if (identical(_activeBackgroundFetch, task)) {
+        _activeBackgroundFetch = null;
+      }
+    }
+  }
+
   Future<void> setPushDeviceToken(String token) async {
     final trimmed = token.trim();
     if (trimmed.isEmpty) return;
@@ -0,0 +1,141 @@
+// ignore_for_file: avoid_print
+
+import 'dart:io';
+import 'dart:math' as math;
+
+import 'package:axichat/src/common/address_autocomplete.dart';
+
+const List<String> _names = <String>[
+  'alex',
+  'jordan',
+  'sam',
+  'taylor',
+  'priya',
+  'chen',
+  'maria',
+  'omar',
+  'lena',
+  'kai',
+];
+
+const List<String> _domains = <String>[
+  'gmail.com',
+  'outlook.com',
+  'yahoo.com',
+  'proton.me',
+  'fastmail.com',
+  'example.org',
+  'university.edu',
+  'company.io',
+];
+
+const List<String> _typed = <String>[
+  'alex.morgan@gm',
+  'j',
+  'jo',
+  'jor',
+  'jordan',
+  'jordan.',
+  'jordan.k@',
+  'sam@out',
+  'zz',
+  'taylor',
+];
+
+/// Times [addressAutocompleteSuggestions] against a synthetic recipient
+/// address table: the initial index build, each keystroke of a few typed
+/// addresses, and the incremental sync after one address is bumped to the
+/// front as a new message would.
+///
+/// Usage: `dart run tool/address_autocomplete_bench.dart
+///   [--addresses=100000] [--rounds=5]`
+void main(List<String> args) {
+  final options = _Options.parse(args);
+  if (options == null) {
+    stderr.writeln(
+      'Usage: dart run tool/address_autocomplete_bench.dart '
+      '[--addresses=N] [--rounds=N]',
+    );
+    exit(1);
+  }
+  final random = math.Random(11);
+  final addresses = List<String>.generate(options.addresses, (index) {
+    final name = _names[random.nextInt(_names.length)];
+    final domain = _domains[random.nextInt(_domains.length)];
+    return '$name.${index.toRadixString(36)}@$domain';
+  });
+
+  final watch = Stopwatch()..start();
+  final index = AddressAutocompleteIndex()..sync(addresses);
+  final build = watch.elapsedMicroseconds;
+
+  final keystrokes = <int>[];
+  final syncs = <int>[];
+  var current = addresses;
+  for (var round = 0; round < options.rounds; round += 1) {
+    for (final phrase in _typed) {
+      for (var end = 1; end <= phrase.length; end += 1) {
+        watch
+          ..reset()
+          ..start();
+        addressAutocompleteSuggestions(
+          input: phrase.substring(0, end),
+          knownDomains: _domains,
+          addressIndex: index,
+        );
+        keystrokes.add(watch.elapsedMicroseconds);
+      }
+    }
+    final bumped = current[random.nextInt(current.length)];
+    current = <String>[
+      bumped,
+      for (final address in current)
+        if (address != bumped) address,
+    ];
+    watch
+      ..reset()
+      ..start();
+    index.sync(current);
+    syncs.add(watch.elapsedMicroseconds);
+  }
+
+  print('addresses=${index.length} rounds=${options.rounds}');
+  print('build: ${build}us');
+  _report('keystroke', keystrokes);
+  _report('sync', syncs);
+}
+
+void _report(String label, List<int> samples) {
+  samples.sort();
+  final total = samples.fold<int>(0, (sum, value) => sum + value);
+  int percentile(double p) =>
+      samples[math.min(samples.length - 1, (samples.length * p).floor())];
+  print(
+    '$label: n=${samples.length} '
+    'mean=${total ~/ math.max(1, samples.length)}us '
+    'p50=${percentile(0.5)}us p95=${percentile(0.95)}us '
+    'max=${samples.last}us',
+  );
+}
+
+final class _Options {
+  const _Options({required this.addresses, required this.rounds});
+
+  static _Options? parse(List<String> args) {
+    final values = <String, int>{'addresses': 100000, 'rounds': 5};
+    for (final arg in args) {
+      final match = RegExp(r'^--([a-z]+)=(\d+)$').firstMatch(arg);
+      if (match == null || !values.containsKey(match.group(1))) {
+        return null;
+      }
+      values[match.group(1)!] = int.parse(match.group(2)!);
+    }
+    return _Options(
+      addresses: math.max(1, values['addresses']!),
+      rounds: math.max(1, values['rounds']!),
+    );
+  }
+
+  final int addresses;
+  final int rounds;
+}
@@ -0,0 +1,195 @@
+// ignore_for_file: avoid_print
+
+import 'dart:io';
+import 'dart:math' as math;
+
+import 'package:axichat/src/calendar/storage/calendar_item_store.dart';
+import 'package:hive_ce/hive.dart';
+
+/// Measures how many bytes a single task toggle appends to the calendar Hive
+/// box, comparing the old whole-state record with [CalendarItemStore].
+///
+/// The state is synthetic but shaped like a hydrated calendar state: a few
+/// thousand tasks and day events plus tombstones. Auto-compaction is off so
+/// the box file grows by exactly what each write appends.
+///
+/// Usage: `dart run tool/calendar_storage_write_amplification.dart
+///   [--items=5000] [--toggles=50]`
+Future<void> main(List<String> args) async {
+  final options = _Options.parse(args);
+  if (options == null) {
+    stderr.writeln(
+      'Usage: dart run tool/calendar_storage_write_amplification.dart '
+      '[--items=N] [--toggles=N]',
+    );
+    exit(1);
+  }
+  final directory = await Directory.systemTemp.createTemp('calendar-wa-');
+  Hive.init(directory.path);
+  try {
+    final legacy = await _measure(
+      directory: directory,
+      name: 'legacy',
+      options: options,
+      write: (box, key, state) => box.put(key, state),
+    );
+    final items = await _measure(
+      directory: directory,
+      name: 'items',
+      options: options,
+      write: (box, key, state) =>
+          CalendarItemStore.forBox(box).write(key, state),
+    );
+    print('items=${options.items} toggles=${options.toggles}');
+    _report('whole-state', legacy);
+    _report('per-item', items);
+    final ratio = legacy.bytesPerToggle / math.max(1, items.bytesPerToggle);
+    print('write amplification reduced ${ratio.toStringAsFixed(0)}x');
+  } finally {
+    await Hive.close();
+    await directory.delete(recursive: true);
+  }
+}
+
+typedef _Write =
+    Future<void> Function(
+      Box<dynamic> box,
+      String key,
+      Map<String, dynamic> state,
+    );
+
+Future<_Measurement> _measure({
+  required Directory directory,
+  required String name,
+  required _Options options,
+  required _Write write,
+}) async {
+  const key = 'calendar_auth_calendar_auth';
+  final box = await Hive.openBox<dynamic>(
+    name,
+    compactionStrategy: (entries, deletedEntries) => false,
+  );
+  final file = File('${directory.path}/$name.hive');
+  final state = _syntheticState(options.items);
+  await write(box, key, state);
+  final initialBytes = await file.length();
+  final random = math.Random(7);
+  final tasks =
+      (state['model'] as Map<String, dynamic>)['tasks']
+          as Map<String, dynamic>;
+  final watch = Stopwatch()..start();
+  for (var toggle = 0; toggle < options.toggles; toggle += 1) {
+    final id = 'task-${random.nextInt(options.items)}';
+    final task = Map<String, dynamic>.of(tasks[id] as Map<String, dynamic>);
+    task['isCompleted'] = !(task['isCompleted'] as bool);
+    task['modifiedAt'] = DateTime.utc(2026, 1, 1, 0, 0, toggle).toString();
+    tasks[id] = task;
+    await write(box, key, state);
+  }
+  final elapsed = watch.elapsed;
+  final toggledBytes = await file.length() - initialBytes;
+  await box.close();
+  return _Measurement(
+    initialBytes: initialBytes,
+    bytesPerToggle: toggledBytes ~/ math.max(1, options.toggles),
+    writeTime: elapsed ~/ math.max(1, options.toggles),
+  );
+}
+
+void _report(String label, _Measurement measurement) {
+  print(
+    '$label: initial=${measurement.initialBytes}B '
+    'perToggle=${measurement.bytesPerToggle}B '
+    'perToggleTime=${measurement.writeTime.inMicroseconds}us',
+  );
+}
+
+Map<String, dynamic> _syntheticState(int items) {
+  final start = DateTime.utc(2026, 1, 1);
+  final tasks = <String, dynamic>{};
+  final dayEvents = <String, dynamic>{};
+  final deletedTaskIds = <String, dynamic>{};
+  final taskCount = items * 4 ~/ 5;
+  for (var index = 0; index < taskCount; index += 1) {
+    final scheduled = start.add(Duration(hours: index * 5));
+    tasks['task-$index'] = <String, dynamic>{
+      'id': 'task-$index',
+      'title': 'Task $index: follow up on the quarterly planning notes',
+      'description':
+          'Synthetic description for task $index with enough text to '
+          'resemble a real note attached to a calendar item.',
+      'scheduledTime': scheduled.toIso8601String(),
+      'duration': 3600000000,
+      'isCompleted': index.isEven,
+      'createdAt': start.toIso8601String(),
+      'modifiedAt': start.toIso8601String(),
+      'location': index % 3 == 0 ? 'Room ${index % 40}' : null,
+      'priority': 'none',
+      'checklist': <Object?>[
+        <String, dynamic>{
+          'id': 'check-$index-0',
+          'label': 'First step',
+          'isCompleted': false,
+        },
+      ],
+    };
+  }
+  for (var index = taskCount; index < items; index += 1) {
+    dayEvents['event-$index'] = <String, dynamic>{
+      'id': 'event-$index',
+      'title': 'Event $index',
+      'startDate': start.add(Duration(days: index % 365)).toIso8601String(),
+      'endDate': start.add(Duration(days: index % 365)).toIso8601String(),
+      'createdAt': start.toIso8601String(),
+      'modifiedAt': start.toIso8601String(),
+    };
+  }
+  for (var index = 0; index < items ~/ 10; index += 1) {
+    deletedTaskIds['deleted-$index'] = start.toIso8601String();
+  }
+  return <String, dynamic>{
+    'model': <String, dynamic>{
+      'tasks': tasks,
+      'day_events': dayEvents,
+      'deleted_task_ids': deletedTaskIds,
+      'last_modified': start.toIso8601String(),
+      'checksum': 'synthetic',
+    },
+    'selectedDate': start.toIso8601String(),
+    'viewMode': 'week',
+  };
+}
+
+final class _Measurement {
+  const _Measurement({
+    required this.initialBytes,
+    required this.bytesPerToggle,
+    required this.writeTime,
+  });
+
+  final int initialBytes;
+  final int bytesPerToggle;
+  final Duration writeTime;
+}
+
+final class _Options {
+  const _Options({required this.items, required this.toggles});
+
+  static _Options? parse(List<String> args) {
+    final values = <String, int>{'items': 5000, 'toggles': 50};
+    for (final arg in args) {
+      final match = RegExp(r'^--([a-z]+)=(\d+)$').firstMatch(arg);
+      if (match == null || !values.containsKey(match.group(1))) {
+        return null;
+      }
+      values[match.group(1)!] = int.parse(match.group(2)!);
+    }
+    return _Options(
+      items: math.max(1, values['items']!),
+      toggles: math.max(1, values['toggles']!),
+    );
+  }
+
+  final int items;
+  final int toggles;
+}
@@ -0,0 +1,736 @@
+// ignore_for_file: avoid_print
+
+import 'dart:async';
+import 'dart:convert';
+import 'dart:io';
+import 'dart:math' as math;
+
+import 'package:axichat/src/email/sync/delta_event_consumer.dart';
+import 'package:axichat/src/email/sync/delta_event_replay.dart';
+import 'package:axichat/src/storage/database.dart';
+import 'package:delta_ffi/delta_safe.dart';
+import 'package:drift/drift.dart';
+import 'package:drift/native.dart';
+import 'package:flutter/widgets.dart' show WidgetsFlutterBinding;
+
+const String _selfAddress = 'self@example.com';
+
+const List<String> _words = <String>[
+  'invoice',
+  'meeting',
+  'tomorrow',
+  'attached',
+  'please',
+  'review',
+  'thanks',
+  'schedule',
+  'quarter',
+  'draft',
+  'the',
+  'and',
+];
+
+/// Replays a Delta core session into [DeltaEventConsumer] against an
+/// in-memory database and reports ingest throughput, per-event handling
+/// latency and the statements written.
+///
+/// The session is a recording made with `--dart-define=
+/// AXI_DELTA_EVENT_RECORDING_DIR=<dir>`, or a synthetic one generated from
+/// `--seed` when no recording is given. Replays are deterministic; compare
+/// runs on different commits only when the printed session digest matches.
+///
+/// The consumer needs the Flutter engine, so this runs as an app target:
+/// Usage: `flutter run -d linux -t tool/delta_event_replay_bench.dart
+///   --dart-entrypoint-args=[--recording=<path>],[--seed=7],[--chats=40],
+///   [--messages=25],[--events=2000],[--latency-us=0],[--burst=50],
+///   [--rounds=3],[--refreshes=20]`
+Future<void> main(List<String> args) async {
+  WidgetsFlutterBinding.ensureInitialized();
+  final options = _Options.parse(args);
+  if (options == null) {
+    stderr.writeln(
+      'Usage: flutter run -t tool/delta_event_replay_bench.dart '
+      '--dart-entrypoint-args=[--recording=PATH],[--seed=N],[--chats=N],'
+      '[--messages=N],[--events=N],[--latency-us=N],[--burst=N],'
+      '[--rounds=N],[--refreshes=N]',
+    );
+    exit(1);
+  }
+  final recordingPath = options.recording;
+  final recording = recordingPath == null
+      ? await _syntheticRecording(options)
+      : DeltaEventRecording.decode(await File(recordingPath).readAsBytes());
+  final source =
+      recordingPath ??
+      'synthetic seed=${options.seed} chats=${options.chats} '
+          'messages=${options.messages}';
+  print(
+    'session=${recording.digest} source=$source '
+    'events=${recording.events.length} '
+    'responses=${recording.responseCount} '
+    'latency=${options.latency.inMicroseconds}us '
+    'commit=${await _commit()}',
+  );
+
+  await _runBootstrap(recording, options);
+  await _runSequential(recording, options);
+  await _runBurstsAndRefresh(recording, options);
+  exit(0);
+}
+
+Future<void> _runBootstrap(
+  DeltaEventRecording recording,
+  _Options options,
+) async {
+  final samples = <int>[];
+  late _Harness last;
+  for (var round = 0; round < options.rounds; round += 1) {
+    final harness = await _Harness.open(recording, options.latency);
+    final watch = Stopwatch()..start();
+    await harness.consumer.bootstrapFromCore(includeMessages: true);
+    samples.add(watch.elapsedMicroseconds);
+    last = harness;
+    await harness.close();
+  }
+  _report('bootstrap', samples);
+  print('  ${last.describe()}');
+}
+
+/// Events handed over one at a time, each awaited: handling cost alone.
+Future<void> _runSequential(
+  DeltaEventRecording recording,
+  _Options options,
+) async {
+  final harness = await _Harness.open(recording, options.latency);
+  await harness.prime();
+  final samples = <int>[];
+  final total = Stopwatch()..start();
+  final watch = Stopwatch();
+  for (var index = 0; index < recording.events.length; index += 1) {
+    harness.core.epoch = index + 1;
+    watch
+      ..reset()
+      ..start();
+    await harness.consumer.handle(recording.events[index]);
+    samples.add(watch.elapsedMicroseconds);
+  }
+  _report('events', samples, elapsed: total.elapsed);
+  print('  ${harness.describe()}');
+  await harness.close();
+}
+
+/// Events delivered [_Options.burst] at a time, as the core does after a
+/// fetch; latency includes time spent queued behind the burst. The chatlist
+/// refreshes then run against the resulting state.
+Future<void> _runBurstsAndRefresh(
+  DeltaEventRecording recording,
+  _Options options,
+) async {
+  final harness = await _Harness.open(recording, options.latency);
+  await harness.prime();
+  final events = recording.events;
+  final samples = <int>[];
+  final total = Stopwatch()..start();
+  for (var start = 0; start < events.length; start += options.burst) {
+    final end = math.min(events.length, start + options.burst);
+    harness.core.epoch = end;
+    final pending = <Future<void>>[];
+    for (var index = start; index < end; index += 1) {
+      final watch = Stopwatch()..start();
+      pending.add(
+        harness.consumer
+            .handle(events[index])
+            .then((_) => samples.add(watch.elapsedMicroseconds)),
+      );
+    }
+    await Future.wait(pending);
+  }
+  _report('bursts', samples, elapsed: total.elapsed);
+  print('  ${harness.describe()}');
+
+  harness.reset();
+  final refreshSamples = <int>[];
+  final watch = Stopwatch();
+  for (var round = 0; round < options.refreshes; round += 1) {
+    watch
+      ..reset()
+      ..start();
+    await harness.consumer.refreshChatlistSnapshot();
+    refreshSamples.add(watch.elapsedMicroseconds);
+  }
+  _report('chatlist refresh', refreshSamples);
+  print('  ${harness.describe()}');
+  await harness.close();
+}
+
+final class _Harness {
+  _Harness._({
+    required this.database,
+    required this.writes,
+    required this.core,
+    required this.consumer,
+  });
+
+  static Future<_Harness> open(
+    DeltaEventRecording recording,
+    Duration latency,
+  ) async {
+    final writes = _WriteCounter();
+    final database = XmppDrift.inMemory(
+      executor: NativeDatabase.memory().interceptWith(writes),
+    );
+    // Open the database and create the schema before anything is counted.
+    await database.customSelect('SELECT 1').get();
+    final core = ReplayDeltaEventCore(recording, latency: latency);
+    final harness = _Harness._(
+      database: database,
+      writes: writes,
+      core: core,
+      consumer: DeltaEventConsumer(
+        databaseBuilder: () async => database,
+        core: core,
+        selfJidProvider: () => _selfAddress,
+      ),
+    );
+    harness.reset();
+    return harness;
+  }
+
+  final XmppDrift database;
+  final _WriteCounter writes;
+  final ReplayDeltaEventCore core;
+  final DeltaEventConsumer consumer;
+
+  /// Projects the chat list as it was before the first event, as an account
+  /// that was already open would have it.
+  Future<void> prime() async {
+    core.epoch = 0;
+    await consumer.bootstrapFromCore();
+    reset();
+  }
+
+  void reset() {
+    writes.reset();
+    core.callCount = 0;
+  }
+
+  String describe() => '${writes.describe()} core calls=${core.callCount}';
+
+  Future<void> close() => database.close();
+}
+
+/// Counts statements that change the database, by kind.
+final class _WriteCounter extends QueryInterceptor {
+  int inserts = 0;
+  int updates = 0;
+  int deletes = 0;
+  int batched = 0;
+  int custom = 0;
+  int transactions = 0;
+
+  void reset() {
+    inserts = 0;
+    updates = 0;
+    deletes = 0;
+    batched = 0;
+    custom = 0;
+    transactions = 0;
+  }
+
+  String describe() =>
+      'writes=${inserts + updates + deletes + batched + custom} '
+      '(insert=$inserts update=$updates delete=$deletes '
+      'batched=$batched custom=$custom) transactions=$transactions';
+
+  @override
+  TransactionExecutor beginTransaction(QueryExecutor parent) {
+    transactions += 1;
+    return super.beginTransaction(parent);
+  }
+
+  @override
+  Future<int> runInsert(
+    QueryExecutor executor,
+    String statement,
+    List<Object?> args,
+  ) {
+    inserts += 1;
+    return super.runInsert(executor, statement, args);
+  }
+
+  @override
+  Future<int> runUpdate(
+    QueryExecutor executor,
+    String statement,
+    List<Object?> args,
+  ) {
+    updates += 1;
+    return super.runUpdate(executor, statement, args);
+  }
+
+  @override
+  Future<int> runDelete(
+    QueryExecutor executor,
+    String statement,
+    List<Object?> args,
+  ) {
+    deletes += 1;
+    return super.runDelete(executor, statement, args);
+  }
+
+  @override
+  Future<void> runBatched(
+    QueryExecutor executor,
+    BatchedStatements statements,
+  ) {
+    batched += statements.arguments.length;
+    return super.runBatched(executor, statements);
+  }
+
+  @override
+  Future<void> runCustom(
+    QueryExecutor executor,
+    String statement,
+    List<Object?> args,
+  ) {
+    custom += 1;
+    return super.runCustom(executor, statement, args);
+  }
+}
+
+/// Generates a session by driving [_SyntheticCore] through the recorder,
+/// asking after everything each event touched as a real consumer would.
+/// The result depends only on the options, not on the consumer under test.
+Future<DeltaEventRecording> _syntheticRecording(_Options options) async {
+  final core = _SyntheticCore(
+    random: math.Random(options.seed),
+    chats: options.chats,
+    messagesPerChat: options.messages,
+  );
+  final buffer = StringBuffer();
+  final recorder = RecordingDeltaEventCore(core, sink: buffer);
+  await _probe(
+    recorder,
+    chatIds: core.chatIds,
+    messageIds: core.messageIds,
+  );
+  for (var index = 0; index < options.events; index += 1) {
+    final step = core.step();
+    recorder.recordEvent(step.event);
+    await _probe(
+      recorder,
+      chatIds: <int>[step.event.data1],
+      messageIds: step.messageIds,
+    );
+  }
+  return DeltaEventRecording.decode(utf8.encode(buffer.toString()));
+}
+
+Future<void> _probe(
+  DeltaEventCore core, {
+  required Iterable<int> chatIds,
+  required Iterable<int> messageIds,
+}) async {
+  await core.getChatlist();
+  await core.getChatlist(flags: DeltaChatlistFlags.archivedOnly);
+  await core.getFreshMessageIds();
+  for (final chatId in chatIds) {
+    await core.getChat(chatId);
+    await core.getChatMessageIds(chatId: chatId);
+    await core.getFreshMessageCountSafe(chatId);
+    await core.chatSendCapabilities(chatId);
+  }
+  final ids = messageIds.toList(growable: false);
+  await core.getMessages(ids);
+  await core.getMessageStatuses(ids);
+}
+
+/// A one-to-one mail account whose contacts write, get replies, read them
+/// and get renamed, driven by [random].
+final class _SyntheticCore implements DeltaEventCore {
+  _SyntheticCore({
+    required math.Random random,
+    required int chats,
+    required int messagesPerChat,
+  }) : _random = random {
+    for (var index = 0; index < chats; index += 1) {
+      final chatId = DeltaChatId.lastSpecial + 1 + index;
+      _chats[chatId] = DeltaChat(
+        id: chatId,
+        name: 'Contact $index',
+        contactAddress: 'contact$index@example.com',
+        contactId: DeltaContactId.lastSpecial + 1 + index,
+        contactName: 'Contact $index',
+        type: DeltaChatType.single,
+      );
+      _messagesByChat[chatId] = <int>[];
+      if (index % 10 == 9) {
+        _archived.add(chatId);
+      }
+      for (var count = 0; count < messagesPerChat; count += 1) {
+        final outgoing = _random.nextInt(3) == 0;
+        _add(
+          chatId: chatId,
+          outgoing: outgoing,
+          state: outgoing
+              ? DeltaMessageState.outMdnRcvd
+              : DeltaMessageState.inSeen,
+        );
+      }
+    }
+  }
+
+  final math.Random _random;
+  final Map<int, DeltaChat> _chats = <int, DeltaChat>{};
+  final Map<int, List<int>> _messagesByChat = <int, List<int>>{};
+  final Map<int, DeltaMessage> _messages = <int, DeltaMessage>{};
+  final Set<int> _archived = <int>{};
+  final List<int> _pending = <int>[];
+  final List<int> _delivered = <int>[];
+  int _nextMessageId = 100;
+  DateTime _clock = DateTime.utc(2025, 1, 1);
+
+  Iterable<int> get chatIds => _chats.keys;
+
+  Iterable<int> get messageIds => _messages.keys;
+
+  ({DeltaCoreEvent event, List<int> messageIds}) step() {
+    final chatIds = _chats.keys.toList(growable: false);
+    final chatId = chatIds[_random.nextInt(chatIds.length)];
+    final roll = _random.nextInt(100);
+    if (roll < 15) {
+      final id = _add(
+        chatId: chatId,
+        outgoing: true,
+        state: DeltaMessageState.outPending,
+      );
+      _pending.add(id);
+      return _event(DeltaEventCode.msgsChanged, chatId, id);
+    }
+    if (roll < 25 && _pending.isNotEmpty) {
+      final id = _pending.removeAt(0);
+      _setState(id, DeltaMessageState.outDelivered);
+      _delivered.add(id);
+      return _event(DeltaEventCode.msgDelivered, _messages[id]!.chatId, id);
+    }
+    if (roll < 35 && _delivered.isNotEmpty) {
+      final id = _delivered.removeAt(_random.nextInt(_delivered.length));
+      _setState(id, DeltaMessageState.outMdnRcvd);
+      return _event(DeltaEventCode.msgRead, _messages[id]!.chatId, id);
+    }
+    if (roll < 45) {
+      final noticed = <int>[
+        for (final id in _messagesByChat[chatId]!)
+          if (_messages[id]!.state == DeltaMessageState.inFresh) id,
+      ];
+      for (final id in noticed) {
+        _setState(id, DeltaMessageState.inSeen);
+      }
+      return (
+        event: DeltaCoreEvent(
+          type: DeltaEventCode.msgsNoticed,
+          data1: chatId,
+          data2: 0,
+        ),
+        messageIds: noticed,
+      );
+    }
+    if (roll < 48) {
+      final chat = _chats[chatId]!;
+      _chats[chatId] = DeltaChat(
+        id: chatId,
+        name: '${chat.contactName} (${_random.nextInt(1000)})',
+        contactAddress: chat.contactAddress,
+        contactId: chat.contactId,
+        contactName: chat.contactName,
+        type: chat.type,
+      );
+      return (
+        event: DeltaCoreEvent(
+          type: DeltaEventCode.chatModified,
+          data1: chatId,
+          data2: 0,
+        ),
+        messageIds: const <int>[],
+      );
+    }
+    final id = _add(
+      chatId: chatId,
+      outgoing: false,
+      state: DeltaMessageState.inFresh,
+    );
+    return _event(DeltaEventCode.incomingMsg, chatId, id);
+  }
+
+  ({DeltaCoreEvent event, List<int> messageIds}) _event(
+    int type,
+    int chatId,
+    int messageId,
+  ) => (
+    event: DeltaCoreEvent(type: type, data1: chatId, data2: messageId),
+    messageIds: <int>[messageId],
+  );
+
+  int _add({required int chatId, required bool outgoing, required int state}) {
+    final id = _nextMessageId++;
+    _clock = _clock.add(Duration(minutes: 1 + _random.nextInt(90)));
+    final words = <String>[
+      for (var count = 0; count < 6 + _random.nextInt(80); count += 1)
+        _words[_random.nextInt(_words.length)],
+    ];
+    final text = words.join(' ');
+    final html = _random.nextInt(3) == 0
+        ? '<html><body><p>$text</p><blockquote><p>'
+              '${words.reversed.join(' ')}</p></blockquote></body></html>'
+        : null;
+    _messages[id] = DeltaMessage(
+      id: id,
+      chatId: chatId,
+      text: text,
+      html: html,
+      subject: 'Re: ${words.first} ${words.last}',
+      viewType: DeltaMessageType.text,
+      state: state,
+      timestamp: _clock,
+      isOutgoing: outgoing,
+      downloadState: DeltaDownloadState.done,
+    );
+    _messagesByChat[chatId]!.add(id);
+    return id;
+  }
+
+  void _setState(int id, int state) {
+    final message = _messages[id]!;
+    _messages[id] = DeltaMessage(
+      id: message.id,
+      chatId: message.chatId,
+      text: message.text,
+      html: message.html,
+      subject: message.subject,
+      viewType: message.viewType,
+      state: state,
+      timestamp: message.timestamp,
+      isOutgoing: message.isOutgoing,
+      downloadState: message.downloadState,
+    );
+  }
+
+  @override
+  int get accountId => 1;
+
+  @override
+  bool get supportsMessageRfc724Mid => false;
+
+  @override
+  bool get supportsMessageInfo => false;
+
+  @override
+  bool get supportsMessageDebugInfo => false;
+
+  @override
+  Future<List<DeltaChatlistEntry>> getChatlist({int flags = 0}) async {
+    final archivedOnly = flags & DeltaChatlistFlags.archivedOnly != 0;
+    final entries = <DeltaChatlistEntry>[
+      for (final MapEntry(key: chatId, value: ids) in _messagesByChat.entries)
+        if (_archived.contains(chatId) == archivedOnly)
+          DeltaChatlistEntry(
+            chatId: chatId,
+            msgId: ids.isEmpty ? DeltaMessageId.none : ids.last,
+          ),
+    ];
+    entries.sort((a, b) => b.msgId.compareTo(a.msgId));
+    return entries;
+  }
+
+  @override
+  Future<List<int>> getChatMessageIds({
+    required int chatId,
+    int? beforeMessageId,
+  }) async => <int>[
+    for (final id in _messagesByChat[chatId] ?? const <int>[])
+      if (beforeMessageId == null || id < beforeMessageId) id,
+  ];
+
+  @override
+  Future<DeltaMessage?> getMessage(int messageId) async =>
+      _messages[messageId];
+
+  @override
+  Future<DeltaMessageStatus?> getMessageStatus(int messageId) async {
+    final message = _messages[messageId];
+    if (message == null) {
+      return null;
+    }
+    return DeltaMessageStatus(
+      id: message.id,
+      chatId: message.chatId,
+      state: message.state,
+      timestamp: message.timestamp,
+      isOutgoing: message.isOutgoing,
+    );
+  }
+
+  @override
+  Future<List<DeltaMessage>> getMessages(List<int> messageIds) async =>
+      <DeltaMessage>[
+        for (final id in messageIds)
+          if (_messages[id] case final message?) message,
+      ];
+
+  @override
+  Future<List<DeltaMessageStatus>> getMessageStatuses(
+    List<int> messageIds,
+  ) async => <DeltaMessageStatus>[
+    for (final id in messageIds)
+      if (await getMessageStatus(id) case final status?) status,
+  ];
+
+  @override
+  Future<List<int>> getFreshMessageIds() async => <int>[
+    for (final message in _messages.values)
+      if (message.state == DeltaMessageState.inFresh) message.id,
+  ];
+
+  @override
+  Future<DeltaFreshMessageCount> getFreshMessageCountSafe(int chatId) async =>
+      DeltaFreshMessageCount(
+        count: (_messagesByChat[chatId] ?? const <int>[])
+            .where((id) => _messages[id]!.state == DeltaMessageState.inFresh)
+            .length,
+        supported: true,
+      );
+
+  @override
+  Future<bool> downloadFullMessage(int messageId) async => false;
+
+  @override
+  Future<String?> getMessageRfc724Mid(int messageId) async => null;
+
+  @override
+  Future<String?> getMessageInfo(int messageId) async => null;
+
+  @override
+  Future<String?> getMessageMimeHeaders(int messageId) async => null;
+
+  @override
+  Future<String?> getMessageDebugInfo(int messageId) async => null;
+
+  @override
+  Future<DeltaMessageRfc822Body?> getMessageRfc822Body(int messageId) async =>
+      null;
+
+  @override
+  Future<DeltaQuotedMessage?> getQuotedMessage(int messageId) async => null;
+
+  @override
+  Future<DeltaContactPublicKeyImport> importContactPublicKey({
+    required String address,
+    required String displayName,
+    required String armoredPublicKey,
+  }) async =>
+      throw const DeltaOperationException('Synthetic core has no keys.');
+
+  @override
+  Future<DeltaChatSendCapabilities> chatSendCapabilities(int chatId) async =>
+      DeltaChatSendCapabilities(
+        exists: _chats.containsKey(chatId),
+        canSend: true,
+        isEncrypted: false,
+      );
+
+  @override
+  Future<DeltaChat?> getChat(int chatId) async => _chats[chatId];
+}
+
+Future<String> _commit() async {
+  try {
+    final result = await Process.run('git', <String>[
+      'rev-parse',
+      '--short',
+      'HEAD',
+    ]);
+    final commit = (result.stdout as String).trim();
+    return result.exitCode == 0 && commit.isNotEmpty ? commit : 'unknown';
+  } on ProcessException {
+    return 'unknown';
+  }
+}
+
+void _report(String label, List<int> samples, {Duration? elapsed}) {
+  if (samples.isEmpty) {
+    print('$label: n=0');
+    return;
+  }
+  samples.sort();
+  int percentile(double p) =>
+      samples[math.min(samples.length - 1, (samples.length * p).floor())];
+  final rate = elapsed == null || elapsed == Duration.zero
+      ? ''
+      : 'rate=${(samples.length * 1e6 / elapsed.inMicroseconds).round()}/s ';
+  print(
+    '$label: n=${samples.length} $rate'
+    'p50=${percentile(0.5)}us p99=${percentile(0.99)}us '
+    'max=${samples.last}us',
+  );
+}
+
+final class _Options {
+  const _Options({
+    required this.recording,
+    required this.seed,
+    required this.chats,
+    required this.messages,
+    required this.events,
+    required this.latency,
+    required this.burst,
+    required this.rounds,
+    required this.refreshes,
+  });
+
+  static _Options? parse(List<String> args) {
+    final values = <String, int>{
+      'seed': 7,
+      'chats': 40,
+      'messages': 25,
+      'events': 2000,
+      'latency-us': 0,
+      'burst': 50,
+      'rounds': 3,
+      'refreshes': 20,
+    };
+    String? recording;
+    for (final arg in args) {
+      final path = RegExp(r'^--recording=(.+)$').firstMatch(arg);
+      if (path != null) {
+        recording = path.group(1);
+        continue;
+      }
+      final match = RegExp(r'^--([a-z-]+)=(\d+)$').firstMatch(arg);
+      if (match == null || !values.containsKey(match.group(1))) {
+        return null;
+      }
+      values[match.group(1)!] = int.parse(match.group(2)!);
+    }
+    return _Options(
+      recording: recording,
+      seed: values['seed']!,
+      chats: math.max(1, values['chats']!),
+      messages: values['messages']!,
+      events: values['events']!,
+      latency: Duration(microseconds: values['latency-us']!),
+      burst: math.max(1, values['burst']!),
+      rounds: math.max(1, values['rounds']!),
+      refreshes: values['refreshes']!,
+    );
+  }
+
+  final String? recording;
+  final int seed;
+  final int chats;
+  final int messages;
+  final int events;
+  final Duration latency;
+  final int burst;
+  final int rounds;
+  final int refreshes;
+}
@@ -0,0 +1,214 @@
+// ignore_for_file: avoid_print
+
+import 'dart:async';
+import 'dart:io';
+import 'dart:isolate';
+import 'dart:math' as math;
+
+import 'package:axichat/src/email/transport/email_delta_rpc_lane.dart';
+import 'package:delta_ffi/delta_safe.dart';
+import 'package:json_rpc_2/json_rpc_2.dart' as json_rpc;
+import 'package:stream_channel/isolate_channel.dart';
+
+final DeltaMessage _message = DeltaMessage(
+  id: 4242,
+  chatId: 12,
+  text: 'Quarterly planning notes are attached. ' * 8,
+  subject: 'Re: Quarterly planning',
+  viewType: 10,
+  state: 26,
+  fileName: 'notes.pdf',
+  fileMime: 'application/pdf',
+  fileSize: 182044,
+  timestamp: DateTime.utc(2026, 3, 2, 17),
+  isOutgoing: true,
+  showPadlock: true,
+);
+
+/// Measures round trips per second between two isolates for the Delta
+/// worker's `getMessage` and `getMessages` calls, comparing the JSON-RPC
+/// envelope with map payloads against [EmailDeltaRpcLaneClient].
+///
+/// The worker side answers from a canned message, so the numbers are the
+/// cost of the transport alone. `sequential` awaits each call before the
+/// next; `pipelined` keeps `--inflight` calls outstanding.
+///
+/// Usage: `dart run tool/email_delta_rpc_bench.dart
+///   [--calls=20000] [--inflight=32] [--batch=50]`
+Future<void> main(List<String> args) async {
+  final options = _Options.parse(args);
+  if (options == null) {
+    stderr.writeln(
+      'Usage: dart run tool/email_delta_rpc_bench.dart '
+      '[--calls=N] [--inflight=N] [--batch=N]',
+    );
+    exit(1);
+  }
+  final setup = ReceivePort();
+  final isolate = await Isolate.spawn(_workerMain, setup.sendPort);
+  final ports = await setup.first as List<Object?>;
+  final jsonPort = ports[0] as SendPort;
+  final laneOpenPort = ports[1] as SendPort;
+
+  final peer = json_rpc.Peer.withoutJson(
+    IsolateChannel<Object?>.connectSend(jsonPort),
+  );
+  unawaited(peer.listen());
+  final lane = await EmailDeltaRpcLaneClient.connect((replyPort) async {
+    final reply = ReceivePort();
+    laneOpenPort.send(<Object?>[replyPort, reply.sendPort]);
+    final requests = await reply.first as SendPort;
+    reply.close();
+    return requests;
+  }, decodeError: (error) => StateError('$error'));
+
+  final batchIds = List<int>.generate(options.batch, (index) => index + 1);
+  final cases = <String, Future<Object?> Function()>{
+    'json getMessage': () => peer.sendRequest('axichat.email.getMessage', {
+      'messageId': 4242,
+      'accountId': null,
+    }),
+    'lane getMessage': () =>
+        lane.call(EmailDeltaRpcOp.getMessage, <Object?>[4242, null]),
+    'json getMessages': () => peer.sendRequest('axichat.email.getMessages', {
+      'messageIds': batchIds,
+      'accountId': null,
+    }),
+    'lane getMessages': () => lane.call(EmailDeltaRpcOp.getMessages, <Object?>[
+      emailDeltaRpcIds(batchIds),
+      null,
+    ]),
+  };
+
+  print(
+    'calls=${options.calls} inflight=${options.inflight} '
+    'batch=${options.batch}',
+  );
+  for (final MapEntry(key: label, value: call) in cases.entries) {
+    await _run(call, math.min(options.calls, 500), 1);
+    final sequential = await _run(call, options.calls, 1);
+    final pipelined = await _run(call, options.calls, options.inflight);
+    print(
+      '$label: sequential=${sequential.toStringAsFixed(0)}/s '
+      'pipelined=${pipelined.toStringAsFixed(0)}/s',
+    );
+  }
+
+  lane.close();
+  await peer.close();
+  setup.close();
+  isolate.kill();
+}
+
+Future<double> _run(
+  Future<Object?> Function() call,
+  int calls,
+  int inflight,
+) async {
+  final watch = Stopwatch()..start();
+  var issued = 0;
+  Future<void> worker() async {
+    while (issued < calls) {
+      issued += 1;
+      await call();
+    }
+  }
+
+  await Future.wait(<Future<void>>[
+    for (var slot = 0; slot < inflight; slot += 1) worker(),
+  ]);
+  return calls / (watch.elapsedMicroseconds / Duration.microsecondsPerSecond);
+}
+
+void _workerMain(SendPort setup) {
+  final jsonReceive = ReceivePort();
+  final laneOpen = ReceivePort();
+  setup.send(<Object?>[jsonReceive.sendPort, laneOpen.sendPort]);
+
+  // The JSON side mirrors the worker's old envelope: typed maps with a
+  // `$type` tag for every message.
+  final messageMap = _messageMap(_message);
+  final server = json_rpc.Peer.withoutJson(
+    IsolateChannel<Object?>.connectReceive(jsonReceive),
+  );
+  server.registerMethod('axichat.email.getMessage', (_) => messageMap);
+  server.registerMethod(
+    'axichat.email.getMessages',
+    (json_rpc.Parameters params) => <Object?>[
+      for (final _ in params['messageIds'].asList) _messageMap(_message),
+    ],
+  );
+  unawaited(server.listen());
+
+  laneOpen.listen((message) {
+    final [replyPort as SendPort, openReply as SendPort] =
+        message as List<Object?>;
+    final lane = EmailDeltaRpcLaneServer(
+      replyPort: replyPort,
+      handler: (op, args) async => switch (op) {
+        EmailDeltaRpcOp.getMessage => _message,
+        EmailDeltaRpcOp.getMessages => <DeltaMessage>[
+          for (final _ in emailDeltaRpcIdsArgument(args[0])) _message,
+        ],
+        _ => null,
+      },
+      encodeError: (error) => error.toString(),
+    );
+    openReply.send(lane.sendPort);
+  });
+}
+
+Map<String, Object?> _messageMap(DeltaMessage message) => {
+  r'$type': 'DeltaMessage',
+  'id': message.id,
+  'chatId': message.chatId,
+  'text': message.text,
+  'html': message.html,
+  'subject': message.subject,
+  'viewType': message.viewType,
+  'infoType': message.infoType,
+  'state': message.state,
+  'filePath': message.filePath,
+  'fileName': message.fileName,
+  'fileMime': message.fileMime,
+  'fileSize': message.fileSize,
+  'width': message.width,
+  'height': message.height,
+  'timestamp': {
+    r'$type': 'DateTime',
+    'microsecondsSinceEpoch': message.timestamp?.microsecondsSinceEpoch,
+    'isUtc': message.timestamp?.isUtc,
+  },
+  'isOutgoing': message.isOutgoing,
+  'downloadState': message.downloadState,
+  'error': message.error,
+  'showPadlock': message.showPadlock,
+};
+
+final class _Options {
+  const _Options({
+    required this.calls,
+    required this.inflight,
+    required this.batch,
+  });
+
+  static _Options? parse(List<String> args) {
+    final values = <String, int>{'calls': 20000, 'inflight': 32, 'batch': 50};
+    for (final arg in args) {
+      final match = RegExp(r'^--([a-z]+)=(\d+)$').firstMatch(arg);
+      if (match == null || !values.containsKey(match.group(1))) {
+        return null;
+      }
+      values[match.group(1)!] = int.parse(match.group(2)!);
+    }
+    return _Options(
+      calls: math.max(1, values['calls']!),
+      inflight: math.max(1, values['inflight']!),
+      batch: math.max(1, values['batch']!),
+    );
+  }
+
+  final int calls;
+  final int inflight;
+  final int batch;
+}
@@ -0,0 +1,263 @@
+// ignore_for_file: avoid_print
+
+import 'dart:async';
+import 'dart:io';
+import 'dart:math' as math;
+
+import 'package:axichat/src/xmpp/message/mam_catch_up.dart';
+
+/// Replays a MAM catch-up against an in-memory archive server that injects
+/// round-trip latency and per-message ingest cost, then compares the old
+/// page-at-a-time walk with the pipelined, concurrent engine.
+///
+/// Usage: `dart run tool/mam_catch_up_latency_stub.dart
+///   [--rtt-ms=300] [--ingest-us=2000] [--messages=5000] [--rooms=8]
+///   [--concurrency=3] [--interrupt-after=3]`
+Future<void> main(List<String> args) async {
+  final options = _StubOptions.parse(args);
+  if (options == null) {
+    stderr.writeln(
+      'Usage: dart run tool/mam_catch_up_latency_stub.dart '
+      '[--rtt-ms=N] [--ingest-us=N] [--messages=N] [--rooms=N] '
+      '[--concurrency=N] [--interrupt-after=N]',
+    );
+    exit(1);
+  }
+  print(
+    'Stub: rtt=${options.roundTrip.inMilliseconds}ms '
+    'ingest=${options.ingestPerMessage.inMicroseconds}us/message '
+    'messages=${options.messages} rooms=${options.rooms}',
+  );
+
+  final sequential = await _timed(() async {
+    for (final server in options.servers()) {
+      await _sequentialWalk(server, pageSize: options.initialPageSize);
+    }
+  });
+  print('sequential: ${sequential.inMilliseconds}ms');
+
+  final limiter = MamCatchUpLimiter(maxConcurrent: options.concurrency);
+  final pipelined = await _timed(() async {
+    await Future.wait(<Future<void>>[
+      for (final server in options.servers())
+        limiter.run(() async {
+          final run = await _engineFor(options).run(fetch: server.fetch);
+          server.expectDrained(run);
+        }),
+    ]);
+  });
+  print(
+    'pipelined: ${pipelined.inMilliseconds}ms '
+    '(concurrency=${options.concurrency})',
+  );
+
+  final resumed = await _interruptAndResume(options);
+  print('resume: $resumed');
+}
+
+Future<Duration> _timed(Future<void> Function() body) async {
+  final watch = Stopwatch()..start();
+  await body();
+  return watch.elapsed;
+}
+
+MamCatchUpEngine _engineFor(_StubOptions options) => MamCatchUpEngine(
+  sizer: MamCatchUpPageSizer(initialPageSize: options.initialPageSize),
+);
+
+/// The previous behaviour: query, wait for ingest, then query again.
+Future<void> _sequentialWalk(
+  _LatencyArchiveServer server, {
+  required int pageSize,
+}) async {
+  String? after;
+  var initial = true;
+  while (true) {
+    final page = await server.fetch(
+      after: after,
+      initial: initial,
+      pageSize: pageSize,
+    );
+    await page.ingested;
+    initial = false;
+    if (page.complete || page.lastId == null || page.lastId == after) {
+      return;
+    }
+    after = page.lastId;
+  }
+}
+
+/// Aborts a catch-up after a few ingested pages, then resumes from the last
+/// stored checkpoint and verifies no message was skipped.
+Future<String> _interruptAndResume(_StubOptions options) async {
+  final server = _LatencyArchiveServer(
+    name: 'resume',
+    messages: options.messages,
+    roundTrip: options.roundTrip,
+    ingestPerMessage: options.ingestPerMessage,
+  );
+  String? checkpoint;
+  var checkpoints = 0;
+  try {
+    await _engineFor(options).run(
+      fetch: server.fetch,
+      onCheckpoint: (lastId) async {
+        checkpoint = lastId;
+        checkpoints += 1;
+        if (checkpoints >= options.interruptAfter) {
+          throw const _Interrupted();
+        }
+      },
+    );
+  } on _Interrupted {
+    // Simulated disconnect.
+  }
+  final resumedFrom = checkpoint;
+  final run = await _engineFor(
+    options,
+  ).run(fetch: server.fetch, after: resumedFrom);
+  server.expectDrained(run);
+  return 'interrupted after $checkpoints pages at $resumedFrom, '
+      'resumed to ${run.lastId}, ingested ${server.ingestedCount} '
+      'of ${options.messages} messages '
+      '(${server.duplicateCount} redelivered)';
+}
+
+final class _Interrupted implements Exception {
+  const _Interrupted();
+}
+
+final class _StubOptions {
+  const _StubOptions({
+    required this.roundTrip,
+    required this.ingestPerMessage,
+    required this.messages,
+    required this.rooms,
+    required this.concurrency,
+    required this.interruptAfter,
+  });
+
+  static _StubOptions? parse(List<String> args) {
+    final values = <String, int>{
+      'rtt-ms': 300,
+      'ingest-us': 2000,
+      'messages': 5000,
+      'rooms': 8,
+      'concurrency': 3,
+      'interrupt-after': 3,
+    };
+    for (final arg in args) {
+      final match = RegExp(r'^--([a-z-]+)=(\d+)$').firstMatch(arg);
+      if (match == null || !values.containsKey(match.group(1))) {
+        return null;
+      }
+      values[match.group(1)!] = int.parse(match.group(2)!);
+    }
+    return _StubOptions(
+      roundTrip: Duration(milliseconds: values['rtt-ms']!),
+      ingestPerMessage: Duration(microseconds: values['ingest-us']!),
+      messages: values['messages']!,
+      rooms: math.max(0, values['rooms']!),
+      concurrency: math.max(1, values['concurrency']!),
+      interruptAfter: math.max(1, values['interrupt-after']!),
+    );
+  }
+
+  final Duration roundTrip;
+  final Duration ingestPerMessage;
+  final int messages;
+  final int rooms;
+  final int concurrency;
+  final int interruptAfter;
+
+  int get initialPageSize => 50;
+
+  /// One global archive plus one archive per room, each a fraction of the
+  /// global message count.
+  List<_LatencyArchiveServer> servers() => <_LatencyArchiveServer>[
+    _LatencyArchiveServer(
+      name: 'global',
+      messages: messages,
+      roundTrip: roundTrip,
+      ingestPerMessage: ingestPerMessage,
+    ),
+    for (var room = 0; room < rooms; room += 1)
+      _LatencyArchiveServer(
+        name: 'room$room',
+        messages: messages ~/ math.max(1, rooms),
+        roundTrip: roundTrip,
+        ingestPerMessage: ingestPerMessage,
+      ),
+  ];
+}
+
+/// An RSM archive whose ids are `<name>-<index>`. Queries complete after the
+/// configured round trip; ingesting a page costs [ingestPerMessage] per
+/// message and is serialised like the real stanza pipeline. As with a real
+/// server, a page's messages are delivered whether or not the client waits
+/// for them.
+final class _LatencyArchiveServer {
+  _LatencyArchiveServer({
+    required this.name,
+    required this.messages,
+    required this.roundTrip,
+    required this.ingestPerMessage,
+  });
+
+  final String name;
+  final int messages;
+  final Duration roundTrip;
+  final Duration ingestPerMessage;
+  final Set<int> _ingested = <int>{};
+  Future<void> _ingestTail = Future<void>.value();
+
+  /// Messages delivered again after a resume; the app dedupes these by
+  /// stanza id, so they cost bandwidth but not correctness.
+  int duplicateCount = 0;
+
+  int get ingestedCount => _ingested.length;
+
+  Future<MamCatchUpPage> fetch({
+    required String? after,
+    required bool initial,
+    required int pageSize,
+  }) async {
+    await Future<void>.delayed(roundTrip);
+    final start = after == null ? 0 : _indexOf(after) + 1;
+    final end = math.min(messages, start + pageSize);
+    final ingested = _ingest(start, end);
+    return MamCatchUpPage(
+      complete: end >= messages,
+      firstId: start < end ? '$name-$start' : null,
+      lastId: start < end ? '$name-${end - 1}' : null,
+      count: messages,
+      ingested: ingested,
+    );
+  }
+
+  Future<void> _ingest(int start, int end) {
+    final previous = _ingestTail;
+    final next = () async {
+      await previous;
+      await Future<void>.delayed(ingestPerMessage * (end - start));
+      for (var index = start; index < end; index += 1) {
+        if (!_ingested.add(index)) {
+          duplicateCount += 1;
+        }
+      }
+    }();
+    _ingestTail = next;
+    return next;
+  }
+
+  int _indexOf(String id) => int.parse(id.substring(name.length + 1));
+
+  void expectDrained(MamCatchUpRun run) {
+    if (run.stalled || _ingested.length != messages) {
+      throw StateError(
+        '$name drained ${_ingested.length}/$messages '
+        '(stalled=${run.stalled})',
+      );
+    }
+  }
+}
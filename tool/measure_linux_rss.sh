@@ -0,0 +1,63 @@
+#!/usr/bin/env bash
+
+set -euo pipefail
+
+repo_root="$(cd "$(dirname "${BASH_SOURCE[0]}")/.." && pwd)"
+bundle_dir="${1:-${repo_root}/build/linux/x64/release/bundle}"
+settle_seconds="${AXICHAT_RSS_SETTLE_SECONDS:-30}"
+binary="${bundle_dir}/axichat"
+
+usage() {
+  cat <<'EOF'
+Usage: ./tool/measure_linux_rss.sh [bundle-dir]
+
+Report the resident memory of the Linux bundle in background mode
+(--background, no window) and after a second launch attaches a window to the
+same instance. The app is stopped with --quit afterwards.
+
+Runs inside dbus-run-session when no session bus is available, and under
+xvfb-run when no display is available.
+
+Environment overrides:
+  AXICHAT_RSS_SETTLE_SECONDS
+                            Seconds to let each mode settle before sampling.
+                            Default: 30.
+EOF
+}
+
+if [[ "${1:-}" == "-h" || "${1:-}" == "--help" ]]; then
+  usage
+  exit 0
+fi
+
+if [[ ! -x "${binary}" ]]; then
+  echo "Linux bundle binary not found: ${binary}" >&2
+  exit 1
+fi
+
+if [[ -z "${DBUS_SESSION_BUS_ADDRESS:-}" ]]; then
+  exec dbus-run-session -- "$0" "$@"
+fi
+
+if [[ -z "${DISPLAY:-}" && -z "${WAYLAND_DISPLAY:-}" ]]; then
+  exec xvfb-run --auto-servernum --server-args="-screen 0 1360x760x24" \
+    "$0" "$@"
+fi
+
+rss_kib() {
+  awk '/^VmRSS:/ { print $2 }' "/proc/$1/status"
+}
+
+"${binary}" --background &
+app_pid=$!
+trap '"${binary}" --quit >/dev/null 2>&1 || kill "${app_pid}" 2>/dev/null || true' EXIT
+
+sleep "${settle_seconds}"
+background_rss="$(rss_kib "${app_pid}")"
+
+"${binary}"
+sleep "${settle_seconds}"
+windowed_rss="$(rss_kib "${app_pid}")"
+
+printf 'background_rss_mib=%s\n' "$((background_rss / 1024))"
+printf 'windowed_rss_mib=%s\n' "$((windowed_rss / 1024))"
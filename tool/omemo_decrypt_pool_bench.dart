@@ -0,0 +1,549 @@
+// ignore_for_file: avoid_print
+
+import 'dart:async';
+import 'dart:convert';
+import 'dart:io';
+import 'dart:math' as math;
+import 'dart:typed_data';
+
+import 'package:axichat/src/common/keyed_isolate_pool.dart';
+import 'package:axichat/src/xmpp/omemo/omemo_archive_decrypt.dart';
+import 'package:axichat/src/xmpp/omemo/omemo_cryptography.dart';
+import 'package:cryptography/cryptography.dart';
+import 'package:cryptography/dart.dart';
+import 'package:moxxmpp/moxxmpp.dart' as mox;
+
+/// Replays an encrypted archive page through [OmemoArchiveDecryptManager],
+/// the manager OmemoService registers next to the OMEMO manager and drains
+/// once a MAM query finishes, and compares it with running the same stanzas
+/// through the handler pipeline one at a time, as live traffic is. Reports
+/// wall time plus the longest event-loop stall seen by a 4 ms ticker (a
+/// stand-in for dropped UI frames).
+///
+/// The OMEMO manager needs a connection and published bundles, so a stand-in
+/// manager takes its slot in the pipeline: it keeps one receiving chain per
+/// (jid, device) and runs an OMEMO 0.3 message step against the
+/// [Cryptography] it is handed, with an X25519 ratchet step every
+/// `--dh-every` messages. Chains only decrypt in order, so the run fails if
+/// a session is reordered, and delivered bodies are checked against archive
+/// order.
+///
+/// Usage: `dart run tool/omemo_decrypt_pool_bench.dart
+///   [--stanzas=5000] [--sessions=50] [--workers=N] [--dh-every=10]`
+Future<void> main(List<String> args) async {
+  final options = _BenchOptions.parse(args);
+  if (options == null) {
+    stderr.writeln(
+      'Usage: dart run tool/omemo_decrypt_pool_bench.dart '
+      '[--stanzas=N] [--sessions=N] [--workers=N] [--dh-every=N]',
+    );
+    exit(1);
+  }
+  print(
+    'Building archive: stanzas=${options.stanzas} '
+    'sessions=${options.sessions} dhEvery=${options.dhEvery}',
+  );
+  final archive = await _SyntheticArchive.build(options);
+
+  final inline = await _measure(
+    'pipeline, inline X25519',
+    () => _replayLive(archive, DartCryptography()),
+  );
+  archive.verify(inline.plaintexts);
+
+  final pool = KeyedIsolatePool(
+    size: options.workers,
+    debugName: 'omemo-bench',
+  );
+  try {
+    final cryptography = OmemoCryptography(() => pool);
+    final live = await _measure(
+      'pipeline, OmemoCryptography(${pool.size})',
+      () => _replayLive(archive, cryptography),
+    );
+    archive.verify(live.plaintexts);
+    final batch = await _measure(
+      'archive batch, OmemoCryptography(${pool.size})',
+      () => _replayBatch(archive, cryptography),
+    );
+    archive.verify(batch.plaintexts);
+    final speedup =
+        inline.elapsed.inMicroseconds / batch.elapsed.inMicroseconds;
+    print(
+      'speedup: ${speedup.toStringAsFixed(2)}x, '
+      'max stall ${inline.maxStall.inMilliseconds}ms -> '
+      '${batch.maxStall.inMilliseconds}ms',
+    );
+  } finally {
+    await pool.close();
+  }
+}
+
+const String _queryId = 'omemo-bench';
+const int _decryptPriority = 100;
+const int _deliverPriority = -100;
+
+/// Every stanza runs through the whole pipeline before the next one starts.
+Future<List<String>> _replayLive(
+  _SyntheticArchive archive,
+  Cryptography cryptography,
+) async {
+  final delivery = _DeliveryManager();
+  final handlers = _handlersOf([
+    _StandInOmemoManager(archive, cryptography),
+    delivery,
+  ]);
+  for (final stanza in archive.stanzas) {
+    await _dispatch(handlers, stanza);
+  }
+  return delivery.bodies;
+}
+
+/// Stanzas are held back as the MAM page arrives and decrypted on drain.
+Future<List<String>> _replayBatch(
+  _SyntheticArchive archive,
+  Cryptography cryptography,
+) async {
+  final delivery = _DeliveryManager();
+  final omemo = _StandInOmemoManager(archive, cryptography);
+  final managers = <mox.XmppManagerBase>[];
+  final batch = OmemoArchiveDecryptManager(omemo, () => managers);
+  managers.addAll([omemo, batch, delivery]);
+  final handlers = _handlersOf(managers);
+  batch.open(_queryId);
+  for (final stanza in archive.stanzas) {
+    await _dispatch(handlers, stanza);
+  }
+  await batch.drain(_queryId);
+  return delivery.bodies;
+}
+
+List<mox.StanzaHandler> _handlersOf(List<mox.XmppManagerBase> managers) => [
+  for (final manager in managers) ...manager.getIncomingStanzaHandlers(),
+]..sort((a, b) => b.priority.compareTo(a.priority));
+
+/// Stands in for the connection's handler loop on a MAM-replayed message.
+Future<void> _dispatch(
+  List<mox.StanzaHandler> handlers,
+  mox.Stanza stanza,
+) async {
+  var state = mox.StanzaHandlerData(
+    false,
+    false,
+    stanza,
+    mox.TypedMap<mox.StanzaHandlerExtension>()
+      ..set(mox.MAMContextData(isFromMAM: true, queryId: _queryId)),
+  );
+  for (final handler in handlers) {
+    if (!handler.matches(state.stanza)) continue;
+    state = await handler.callback(state.stanza, state);
+    if (state.done || state.cancel) break;
+  }
+}
+
+final class _StandInOmemoManager extends mox.XmppManagerBase {
+  _StandInOmemoManager(this._archive, this._cryptography)
+    : super('bench.omemo');
+
+  final _SyntheticArchive _archive;
+  final Cryptography _cryptography;
+  final Map<String, _ChainState> _chains = <String, _ChainState>{};
+
+  @override
+  List<mox.StanzaHandler> getIncomingStanzaHandlers() => [
+    mox.StanzaHandler(
+      stanzaTag: 'message',
+      tagXmlns: mox.omemoXmlns,
+      tagName: 'encrypted',
+      callback: _onEncrypted,
+      priority: _decryptPriority,
+    ),
+  ];
+
+  @override
+  Future<bool> isSupported() async => true;
+
+  Future<mox.StanzaHandlerData> _onEncrypted(
+    mox.Stanza stanza,
+    mox.StanzaHandlerData state,
+  ) async {
+    final encrypted = stanza.firstTag('encrypted', xmlns: mox.omemoXmlns)!;
+    final header = encrypted.firstTag('header')!;
+    final payload = encrypted.firstTag('payload')!;
+    final ratchetKey = header.firstTag('ratchet')?.innerText();
+    final seed = _archive.seeds[omemoSessionKey(
+      stanza.from!.split('/').first,
+      int.parse(header.attributes['sid']! as String),
+    )]!;
+    final body = await _decrypt(
+      seed,
+      index: int.parse(payload.attributes['n']! as String),
+      ciphertext: base64Decode(payload.innerText()),
+      mac: base64Decode(payload.attributes['mac']! as String),
+      ratchetKey: ratchetKey == null ? null : base64Decode(ratchetKey),
+    );
+    return state
+      ..stanza = mox.Stanza.message(
+        from: stanza.from,
+        children: [mox.XMLNode(tag: 'body', text: body)],
+      );
+  }
+
+  Future<String> _decrypt(
+    _SessionSeed seed, {
+    required int index,
+    required Uint8List ciphertext,
+    required Uint8List mac,
+    Uint8List? ratchetKey,
+  }) async {
+    final state = _chains.putIfAbsent(
+      seed.key,
+      () => _ChainState(seed.rootKey, Uint8List(32)),
+    );
+    if (ratchetKey != null) {
+      final x25519 = _cryptography.x25519();
+      final receiver = await x25519.newKeyPairFromSeed(seed.receiverSeed);
+      final shared = await x25519.sharedSecretKey(
+        keyPair: receiver,
+        remotePublicKey: SimplePublicKey(ratchetKey, type: KeyPairType.x25519),
+      );
+      final (root, chain) = await _rootStep(
+        state.rootKey,
+        await shared.extractBytes(),
+      );
+      state
+        ..rootKey = root
+        ..chainKey = chain;
+    }
+    if (index != state.nextIndex) {
+      throw StateError(
+        '${seed.key}: expected message ${state.nextIndex}, got $index',
+      );
+    }
+    final (messageKey, nextChainKey) = await _chainStep(state.chainKey);
+    state
+      ..chainKey = nextChainKey
+      ..nextIndex += 1;
+    final keys = await _messageKeys(messageKey);
+    final expectedMac = await _hmacBytes(keys.authKey, ciphertext);
+    for (var i = 0; i < _macLength; i += 1) {
+      if (expectedMac[i] != mac[i]) {
+        throw StateError('${seed.key}: bad MAC on message $index');
+      }
+    }
+    final plaintext = await _aes.decrypt(
+      SecretBox(ciphertext, nonce: keys.iv, mac: Mac.empty),
+      secretKey: SecretKey(keys.encKey),
+    );
+    return utf8.decode(plaintext);
+  }
+}
+
+/// Stands in for the message manager turning a stanza into an event.
+final class _DeliveryManager extends mox.XmppManagerBase {
+  _DeliveryManager() : super('bench.delivery');
+
+  final List<String> bodies = <String>[];
+
+  @override
+  List<mox.StanzaHandler> getIncomingStanzaHandlers() => [
+    mox.StanzaHandler(
+      stanzaTag: 'message',
+      tagName: 'body',
+      callback: _onBody,
+      priority: _deliverPriority,
+    ),
+  ];
+
+  @override
+  Future<bool> isSupported() async => true;
+
+  Future<mox.StanzaHandlerData> _onBody(
+    mox.Stanza stanza,
+    mox.StanzaHandlerData state,
+  ) async {
+    bodies.add(stanza.firstTag('body')!.innerText());
+    return state..done = true;
+  }
+}
+
+final class _Measurement {
+  const _Measurement(this.elapsed, this.maxStall, this.plaintexts);
+
+  final Duration elapsed;
+  final Duration maxStall;
+  final List<String> plaintexts;
+}
+
+Future<_Measurement> _measure(
+  String label,
+  Future<List<String>> Function() body,
+) async {
+  const tick = Duration(milliseconds: 4);
+  var maxStall = Duration.zero;
+  final tickWatch = Stopwatch()..start();
+  final ticker = Timer.periodic(tick, (_) {
+    final lateness = tickWatch.elapsed - tick;
+    if (lateness > maxStall) maxStall = lateness;
+    tickWatch.reset();
+  });
+  final watch = Stopwatch()..start();
+  final plaintexts = await body();
+  watch.stop();
+  ticker.cancel();
+  final perSecond =
+      plaintexts.length * 1000 / math.max(1, watch.elapsedMilliseconds);
+  print(
+    '$label: ${watch.elapsedMilliseconds}ms '
+    '(${perSecond.toStringAsFixed(0)} stanzas/s), '
+    'max stall ${maxStall.inMilliseconds}ms',
+  );
+  return _Measurement(watch.elapsed, maxStall, plaintexts);
+}
+
+final class _BenchOptions {
+  const _BenchOptions({
+    required this.stanzas,
+    required this.sessions,
+    required this.workers,
+    required this.dhEvery,
+  });
+
+  static _BenchOptions? parse(List<String> args) {
+    final values = <String, int>{
+      'stanzas': 5000,
+      'sessions': 50,
+      'workers': KeyedIsolatePool.defaultSize,
+      'dh-every': 10,
+    };
+    for (final arg in args) {
+      final match = RegExp(r'^--([a-z-]+)=(\d+)$').firstMatch(arg);
+      if (match == null || !values.containsKey(match.group(1))) {
+        return null;
+      }
+      values[match.group(1)!] = int.parse(match.group(2)!);
+    }
+    return _BenchOptions(
+      stanzas: math.max(1, values['stanzas']!),
+      sessions: math.max(1, values['sessions']!),
+      workers: math.max(1, values['workers']!),
+      dhEvery: math.max(1, values['dh-every']!),
+    );
+  }
+
+  final int stanzas;
+  final int sessions;
+  final int workers;
+  final int dhEvery;
+}
+
+/// Initial receiving state of one (jid, device) session.
+final class _SessionSeed {
+  const _SessionSeed({
+    required this.jid,
+    required this.device,
+    required this.rootKey,
+    required this.receiverSeed,
+  });
+
+  final String jid;
+  final int device;
+  final Uint8List rootKey;
+  final Uint8List receiverSeed;
+
+  String get key => omemoSessionKey(jid, device);
+}
+
+final Hmac _hmac = Hmac.sha256();
+final AesCbc _aes = AesCbc.with256bits(macAlgorithm: MacAlgorithm.empty);
+final List<int> _rootInfo = utf8.encode('OMEMO Root Chain');
+final List<int> _messageInfo = utf8.encode('OMEMO Message Key Material');
+const int _macLength = 16;
+
+final class _ChainState {
+  _ChainState(this.rootKey, this.chainKey);
+
+  Uint8List rootKey;
+  Uint8List chainKey;
+  int nextIndex = 0;
+}
+
+Future<Uint8List> _hmacBytes(List<int> key, List<int> data) async {
+  final mac = await _hmac.calculateMac(data, secretKey: SecretKey(key));
+  return Uint8List.fromList(mac.bytes);
+}
+
+Future<Uint8List> _hkdf(
+  List<int> ikm, {
+  required List<int> salt,
+  required List<int> info,
+  required int length,
+}) async {
+  final key = await Hkdf(hmac: _hmac, outputLength: length).deriveKey(
+    secretKey: SecretKey(ikm),
+    nonce: salt,
+    info: info,
+  );
+  return Uint8List.fromList(await key.extractBytes());
+}
+
+/// Advances the root chain with a DH output; returns (root, chain).
+Future<(Uint8List, Uint8List)> _rootStep(
+  Uint8List rootKey,
+  List<int> sharedSecret,
+) async {
+  final output = await _hkdf(
+    sharedSecret,
+    salt: rootKey,
+    info: _rootInfo,
+    length: 64,
+  );
+  return (
+    Uint8List.sublistView(output, 0, 32),
+    Uint8List.sublistView(output, 32),
+  );
+}
+
+/// Advances a symmetric chain; returns (message key, next chain key).
+Future<(Uint8List, Uint8List)> _chainStep(Uint8List chainKey) async => (
+  await _hmacBytes(chainKey, const <int>[1]),
+  await _hmacBytes(chainKey, const <int>[2]),
+);
+
+Future<({Uint8List encKey, Uint8List authKey, Uint8List iv})> _messageKeys(
+  Uint8List messageKey,
+) async {
+  final material = await _hkdf(
+    messageKey,
+    salt: Uint8List(32),
+    info: _messageInfo,
+    length: 80,
+  );
+  return (
+    encKey: Uint8List.sublistView(material, 0, 32),
+    authKey: Uint8List.sublistView(material, 32, 64),
+    iv: Uint8List.sublistView(material, 64),
+  );
+}
+
+final class _SyntheticArchive {
+  _SyntheticArchive(this.seeds, this.stanzas, this.expected);
+
+  /// Keyed by [omemoSessionKey].
+  final Map<String, _SessionSeed> seeds;
+  final List<mox.Stanza> stanzas;
+  final List<String> expected;
+
+  static Future<_SyntheticArchive> build(_BenchOptions options) async {
+    final random = math.Random(0x0e0e);
+    Uint8List randomBytes(int length) => Uint8List.fromList(
+      List<int>.generate(length, (_) => random.nextInt(256)),
+    );
+
+    final x25519 = DartX25519();
+    final seeds = <_SessionSeed>[];
+    final senders = <_ChainState>[];
+    final receiverKeys = <SimplePublicKey>[];
+    for (var session = 0; session < options.sessions; session += 1) {
+      final seed = _SessionSeed(
+        jid: 'member$session@example.org',
+        device: 1000 + session,
+        rootKey: randomBytes(32),
+        receiverSeed: randomBytes(32),
+      );
+      seeds.add(seed);
+      senders.add(_ChainState(seed.rootKey, Uint8List(32)));
+      final receiver = await x25519.newKeyPairFromSeed(seed.receiverSeed);
+      receiverKeys.add(await receiver.extractPublicKey());
+    }
+
+    final stanzas = <mox.Stanza>[];
+    final expected = <String>[];
+    final sent = List<int>.filled(options.sessions, 0);
+    for (var n = 0; n < options.stanzas; n += 1) {
+      final session = random.nextInt(options.sessions);
+      final seed = seeds[session];
+      final sender = senders[session];
+      Uint8List? ratchetKey;
+      if (sent[session] % options.dhEvery == 0) {
+        final ephemeral = await x25519.newKeyPairFromSeed(randomBytes(32));
+        final shared = await x25519.sharedSecretKey(
+          keyPair: ephemeral,
+          remotePublicKey: receiverKeys[session],
+        );
+        final (root, chain) = await _rootStep(
+          sender.rootKey,
+          await shared.extractBytes(),
+        );
+        sender
+          ..rootKey = root
+          ..chainKey = chain;
+        ratchetKey = Uint8List.fromList(
+          (await ephemeral.extractPublicKey()).bytes,
+        );
+      }
+      final (messageKey, nextChainKey) = await _chainStep(sender.chainKey);
+      sender.chainKey = nextChainKey;
+      final keys = await _messageKeys(messageKey);
+      final plaintext = 'archived message $n from ${seed.key}';
+      final box = await _aes.encrypt(
+        utf8.encode(plaintext),
+        secretKey: SecretKey(keys.encKey),
+        nonce: keys.iv,
+      );
+      final mac = await _hmacBytes(keys.authKey, box.cipherText);
+      stanzas.add(
+        mox.Stanza.message(
+          from: '${seed.jid}/phone',
+          children: [
+            mox.XMLNode.xmlns(
+              tag: 'encrypted',
+              xmlns: mox.omemoXmlns,
+              children: [
+                mox.XMLNode(
+                  tag: 'header',
+                  attributes: {'sid': '${seed.device}'},
+                  children: [
+                    if (ratchetKey != null)
+                      mox.XMLNode(
+                        tag: 'ratchet',
+                        text: base64Encode(ratchetKey),
+                      ),
+                  ],
+                ),
+                mox.XMLNode(
+                  tag: 'payload',
+                  attributes: {
+                    'n': '${sent[session]}',
+                    'mac': base64Encode(mac.sublist(0, _macLength)),
+                  },
+                  text: base64Encode(box.cipherText),
+                ),
+              ],
+            ),
+          ],
+        ),
+      );
+      expected.add(plaintext);
+      sent[session] += 1;
+    }
+    return _SyntheticArchive(
+      {for (final seed in seeds) seed.key: seed},
+      stanzas,
+      expected,
+    );
+  }
+
+  void verify(List<String> plaintexts) {
+    if (plaintexts.length != expected.length) {
+      throw StateError(
+        'Delivered ${plaintexts.length} of ${expected.length} stanzas',
+      );
+    }
+    for (var i = 0; i < expected.length; i += 1) {
+      if (plaintexts[i] != expected[i]) {
+        throw StateError('Stanza $i was delivered out of archive order');
+      }
+    }
+  }
+}
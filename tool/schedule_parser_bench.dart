@@ -0,0 +1,112 @@
+// ignore_for_file: avoid_print
+
+import 'dart:io';
+import 'dart:math' as math;
+
+import 'package:axichat/src/calendar/task/schedule_parser.dart';
+import 'package:timezone/data/latest.dart' as tzdata;
+import 'package:timezone/timezone.dart' as tz;
+
+const List<String> _corpus = <String>[
+  'Call mom tomorrow at 6pm',
+  'Dentist next tuesday 9:30am at Smile Dental',
+  'Standup every weekday at 9:15 for 15 minutes',
+  'Team sync every other monday 10-11am with Alex and Priya',
+  'Pay rent on the 1st of every month',
+  'Submit report by friday EOD urgent',
+  'Lunch with Sam at noon in the cafeteria',
+  'Gym mwf 7am',
+  'Quarterly review the last friday of each month at 3pm',
+  'Flight to Berlin on March 14 at 08:45',
+  'Book club 2nd thursday of every month 7pm until end of year',
+  'Water plants every 3 days',
+  'Pick up groceries after work',
+  'Renew passport before June 30, important',
+  'Meeting from 2pm to 3:30pm at 123 Main St, Springfield',
+  'Yoga this weekend morning',
+  'Follow up in 2 hours',
+  'Write blog post sometime next week, no rush',
+  'Coffee w/ Jordan around 4ish',
+  'Weekly planning every sunday evening for 30 mins',
+];
+
+/// Times [ScheduleParser] the way quick-add drives it: every prefix of each
+/// phrase is parsed as if typed one character at a time, followed by a
+/// parse of each complete phrase.
+///
+/// The corpus mixes plain titles with dates, times, ranges, durations,
+/// recurrence, deadlines, locations, participants, and priority words.
+///
+/// Usage: `dart run tool/schedule_parser_bench.dart [--rounds=5]`
+void main(List<String> args) {
+  final rounds = _parseRounds(args);
+  if (rounds == null) {
+    stderr.writeln(
+      'Usage: dart run tool/schedule_parser_bench.dart [--rounds=N]',
+    );
+    exit(1);
+  }
+  tzdata.initializeTimeZones();
+  final location = tz.getLocation('America/Los_Angeles');
+  final parser = ScheduleParser(
+    ScheduleParseOptions(
+      tzLocation: location,
+      tzName: location.name,
+      reference: DateTime.utc(2026, 3, 2, 17),
+      policy: const FuzzyPolicy(),
+    ),
+  );
+
+  for (final phrase in _corpus) {
+    parser.parse(phrase);
+  }
+
+  final keystrokes = <int>[];
+  final phrases = <int>[];
+  final watch = Stopwatch();
+  for (var round = 0; round < rounds; round += 1) {
+    for (final phrase in _corpus) {
+      for (var end = 1; end <= phrase.length; end += 1) {
+        final prefix = phrase.substring(0, end);
+        if (prefix.trim().isEmpty) continue;
+        watch
+          ..reset()
+          ..start();
+        parser.parse(prefix);
+        keystrokes.add(watch.elapsedMicroseconds);
+      }
+      watch
+        ..reset()
+        ..start();
+      parser.parse(phrase);
+      phrases.add(watch.elapsedMicroseconds);
+    }
+  }
+
+  print('phrases=${_corpus.length} rounds=$rounds');
+  _report('keystroke', keystrokes);
+  _report('phrase', phrases);
+}
+
+void _report(String label, List<int> samples) {
+  samples.sort();
+  final total = samples.fold<int>(0, (sum, value) => sum + value);
+  int percentile(double p) =>
+      samples[math.min(samples.length - 1, (samples.length * p).floor())];
+  print(
+    '$label: n=${samples.length} '
+    'mean=${total ~/ math.max(1, samples.length)}us '
+    'p50=${percentile(0.5)}us p95=${percentile(0.95)}us '
+    'max=${samples.last}us',
+  );
+}
+
+int? _parseRounds(List<String> args) {
+  var rounds = 5;
+  for (final arg in args) {
+    final match = RegExp(r'^--rounds=(\d+)$').firstMatch(arg);
+    if (match == null) return null;
+    rounds = math.max(1, int.parse(match.group(1)!));
+  }
+  return rounds;
+}
@@ -0,0 +1,53 @@
+#!/usr/bin/env bash
+
+set -euo pipefail
+
+repo_root="$(cd "$(dirname "${BASH_SOURCE[0]}")/.." && pwd)"
+bundle_dir="${1:-${repo_root}/build/linux/x64/profile/bundle}"
+trace_file="${2:-${repo_root}/build/startup_trace.json}"
+timeout_seconds="${AXICHAT_STARTUP_TRACE_TIMEOUT:-60}"
+binary="${bundle_dir}/axichat"
+
+usage() {
+  cat <<'EOF'
+Usage: ./tool/startup_trace_linux.sh [bundle-dir] [trace-file]
+
+Launch the Linux bundle headlessly, record one cold start and write a
+Chrome-trace/Perfetto JSON with native runner and Dart startup phases.
+Prints time_to_first_frame_ms and time_to_chat_list_ms, and exits non-zero
+when the chat list was not reached before the timeout.
+
+The bundle should belong to a profile with stored credentials so that the
+chat list is reachable; without them only time-to-first-frame is reported.
+
+Environment overrides:
+  AXICHAT_STARTUP_TRACE_TIMEOUT
+                            Seconds to wait for the chat list. Default: 60.
+EOF
+}
+
+if [[ "${1:-}" == "-h" || "${1:-}" == "--help" ]]; then
+  usage
+  exit 0
+fi
+
+if [[ ! -x "${binary}" ]]; then
+  echo "Linux bundle binary not found: ${binary}" >&2
+  exit 1
+fi
+
+launcher=()
+if [[ -z "${DISPLAY:-}" && -z "${WAYLAND_DISPLAY:-}" ]]; then
+  if ! command -v xvfb-run >/dev/null 2>&1; then
+    echo "No display available and xvfb-run is not installed." >&2
+    exit 1
+  fi
+  launcher=(xvfb-run --auto-servernum --server-args="-screen 0 1360x760x24")
+fi
+
+mkdir -p "$(dirname "${trace_file}")"
+
+AXICHAT_STARTUP_TRACE="${trace_file}" \
+AXICHAT_STARTUP_TRACE_EXIT=1 \
+AXICHAT_STARTUP_TRACE_TIMEOUT="${timeout_seconds}" \
+  timeout "$((timeout_seconds + 30))" ${launcher[@]+"${launcher[@]}"} "${binary}"
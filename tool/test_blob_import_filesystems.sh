@@ -0,0 +1,93 @@
+#!/usr/bin/env bash
+
+set -euo pipefail
+
+repo_root="$(cd "$(dirname "${BASH_SOURCE[0]}")/.." && pwd)"
+manifest="${repo_root}/packages/delta_ffi/rust/Cargo.toml"
+image_size="${AXICHAT_BLOB_IMPORT_IMAGE_SIZE:-512M}"
+
+usage() {
+  cat <<'EOF'
+Usage: sudo ./tool/test_blob_import_filesystems.sh [filesystem...]
+
+Run the delta_ffi blob import tests on scratch filesystems and check which
+import strategy each one takes:
+
+  tmpfs   no reflink support; expects a streamed copy
+  btrfs   loopback image; expects a reflink
+  xfs     loopback image created with reflink=1; expects a reflink
+
+All three are tested when no filesystem is named. Needs root for mount and
+mkfs.btrfs / mkfs.xfs for the loopback images.
+
+Environment overrides:
+  AXICHAT_BLOB_IMPORT_IMAGE_SIZE
+                            Size of each loopback image. Default: 512M.
+EOF
+}
+
+if [[ "${1:-}" == "-h" || "${1:-}" == "--help" ]]; then
+  usage
+  exit 0
+fi
+
+if [[ "$(id -u)" -ne 0 ]]; then
+  echo "Mounting scratch filesystems requires root." >&2
+  exit 1
+fi
+
+filesystems=("$@")
+if [[ ${#filesystems[@]} -eq 0 ]]; then
+  filesystems=(tmpfs btrfs xfs)
+fi
+
+work_dir="$(mktemp -d)"
+mounts=()
+cleanup() {
+  for mount_point in "${mounts[@]+"${mounts[@]}"}"; do
+    umount "${mount_point}" 2>/dev/null || true
+  done
+  rm -rf "${work_dir}"
+}
+trap cleanup EXIT
+
+run_tests() {
+  local filesystem="$1"
+  local mount_point="$2"
+  local expected="$3"
+  chmod 1777 "${mount_point}"
+  echo "== ${filesystem}: expecting ${expected}"
+  AXICHAT_BLOB_IMPORT_TEST_DIR="${mount_point}" \
+    AXICHAT_BLOB_IMPORT_EXPECT="${expected}" \
+    cargo test --manifest-path "${manifest}" blob_import
+}
+
+for filesystem in "${filesystems[@]}"; do
+  mount_point="${work_dir}/${filesystem}"
+  mkdir -p "${mount_point}"
+  case "${filesystem}" in
+    tmpfs)
+      mount -t tmpfs -o size="${image_size}" tmpfs "${mount_point}"
+      mounts+=("${mount_point}")
+      run_tests tmpfs "${mount_point}" copy
+      ;;
+    btrfs)
+      truncate -s "${image_size}" "${work_dir}/btrfs.img"
+      mkfs.btrfs -q "${work_dir}/btrfs.img"
+      mount -o loop "${work_dir}/btrfs.img" "${mount_point}"
+      mounts+=("${mount_point}")
+      run_tests btrfs "${mount_point}" reflink
+      ;;
+    xfs)
+      truncate -s "${image_size}" "${work_dir}/xfs.img"
+      mkfs.xfs -q -m reflink=1 "${work_dir}/xfs.img"
+      mount -o loop "${work_dir}/xfs.img" "${mount_point}"
+      mounts+=("${mount_point}")
+      run_tests xfs "${mount_point}" reflink
+      ;;
+    *)
+      echo "Unknown filesystem: ${filesystem}" >&2
+      exit 1
+      ;;
+  esac
+done
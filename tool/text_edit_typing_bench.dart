@@ -0,0 +1,221 @@
+// ignore_for_file: avoid_print
+
+import 'dart:io';
+import 'dart:math' as math;
+
+import 'package:axichat/src/common/text_edit.dart';
+
+const List<String> _words = <String>[
+  'message',
+  'tomorrow',
+  'recieve',
+  'meeting',
+  'definately',
+  'thanks',
+  'attached',
+  'seperate',
+  'calendar',
+  'the',
+];
+
+const Set<String> _misspelled = <String>{'recieve', 'definately', 'seperate'};
+
+/// Simulates typing into a large composer document and times the per
+/// keystroke work the editor does outside layout: recording undo history
+/// and carrying spell check spans over to the new text.
+///
+/// Undo is compared as whole-value snapshots (one per burst of typing, like
+/// the framework's throttled history) against [TextEditHistory]. Spans are
+/// compared as a per-span word search, as the framework does, against a
+/// single [TextEdit] shift. `tool/text_field_frame_bench.dart` measures the
+/// same keystrokes through the editor widget, including layout and paint.
+///
+/// Usage: `dart run tool/text_edit_typing_bench.dart
+///   [--kilobytes=200] [--keystrokes=2000] [--burst=20]`
+void main(List<String> args) {
+  final options = _Options.parse(args);
+  if (options == null) {
+    stderr.writeln(
+      'Usage: dart run tool/text_edit_typing_bench.dart '
+      '[--kilobytes=N] [--keystrokes=N] [--burst=N]',
+    );
+    exit(1);
+  }
+  final random = math.Random(17);
+  final document = StringBuffer();
+  while (document.length < options.kilobytes * 1024) {
+    document
+      ..write(_words[random.nextInt(_words.length)])
+      ..write(random.nextInt(12) == 0 ? '\n' : ' ');
+  }
+  var text = document.toString();
+  final resultsText = text;
+  final spans = _findMisspellings(text);
+  var caret = text.length ~/ 2;
+
+  final snapshots = <String>[text];
+  final history = TextEditHistory<int>(maxEntries: 1 << 20);
+  final snapshotSamples = <int>[];
+  final editSamples = <int>[];
+  final searchSamples = <int>[];
+  final shiftSamples = <int>[];
+  final watch = Stopwatch();
+
+  for (var keystroke = 0; keystroke < options.keystrokes; keystroke += 1) {
+    final before = text;
+    final bool backspace = random.nextInt(8) == 0 && caret > 0;
+    if (backspace) {
+      text = text.replaceRange(caret - 1, caret, '');
+      caret -= 1;
+    } else {
+      final typed = String.fromCharCode(0x61 + random.nextInt(26));
+      text = text.replaceRange(caret, caret, typed);
+      caret += 1;
+    }
+    final bool burstEnd = (keystroke + 1) % options.burst == 0;
+
+    watch
+      ..reset()
+      ..start();
+    if (burstEnd) {
+      snapshots.add(text);
+    }
+    snapshotSamples.add(watch.elapsedMicroseconds);
+
+    watch
+      ..reset()
+      ..start();
+    final edit = TextEdit.between(before, text);
+    if (edit != null) {
+      history.record(edit, before: caret, after: caret);
+    }
+    if (burstEnd) {
+      history.seal();
+    }
+    editSamples.add(watch.elapsedMicroseconds);
+
+    if (keystroke % 10 == 0) {
+      watch
+        ..reset()
+        ..start();
+      _searchSpans(text, resultsText, spans);
+      searchSamples.add(watch.elapsedMicroseconds);
+
+      watch
+        ..reset()
+        ..start();
+      _shiftSpans(text, resultsText, spans);
+      shiftSamples.add(watch.elapsedMicroseconds);
+    }
+  }
+
+  final snapshotRetained = snapshots.fold<int>(
+    0,
+    (total, snapshot) => total + snapshot.length,
+  );
+  print(
+    'document=${resultsText.length} code units '
+    'spans=${spans.length} keystrokes=${options.keystrokes} '
+    'burst=${options.burst}',
+  );
+  _report('undo snapshot', snapshotSamples);
+  _report('undo text edit', editSamples);
+  _report('spans search', searchSamples);
+  _report('spans shift', shiftSamples);
+  print(
+    'undo retained: snapshot=${snapshotRetained * 2 ~/ 1024}KiB '
+    '(${snapshots.length} steps) '
+    'text edit=${history.retainedCodeUnits * 2 ~/ 1024}KiB',
+  );
+}
+
+List<(int, int)> _findMisspellings(String text) {
+  final spans = <(int, int)>[];
+  for (final match in RegExp(r'[a-z]+').allMatches(text)) {
+    if (_misspelled.contains(match.group(0))) {
+      spans.add((match.start, match.end));
+    }
+  }
+  return spans;
+}
+
+/// The framework's approach: look every span's word up again in the new
+/// text, resuming after the previous hit.
+List<(int, int)> _searchSpans(
+  String text,
+  String resultsText,
+  List<(int, int)> spans,
+) {
+  final corrected = <(int, int)>[];
+  var searchStart = 0;
+  for (final (start, end) in spans) {
+    final word = RegExp.escape(resultsText.substring(start, end));
+    final found = text.substring(searchStart).indexOf(RegExp('\\b$word\\b'));
+    if (found < 0) continue;
+    final adjusted = searchStart + found;
+    corrected.add((adjusted, adjusted + end - start));
+    searchStart = math.min(adjusted + end - start + 1, text.length);
+  }
+  return corrected;
+}
+
+List<(int, int)> _shiftSpans(
+  String text,
+  String resultsText,
+  List<(int, int)> spans,
+) {
+  final edit = TextEdit.between(resultsText, text);
+  if (edit == null) return spans;
+  return <(int, int)>[
+    for (final (start, end) in spans)
+      if (end <= edit.start)
+        (start, end)
+      else if (start > edit.removedEnd)
+        (start + edit.lengthDelta, end + edit.lengthDelta),
+  ];
+}
+
+void _report(String label, List<int> samples) {
+  samples.sort();
+  final total = samples.fold<int>(0, (sum, value) => sum + value);
+  int percentile(double p) =>
+      samples[math.min(samples.length - 1, (samples.length * p).floor())];
+  print(
+    '$label: n=${samples.length} '
+    'mean=${total ~/ math.max(1, samples.length)}us '
+    'p50=${percentile(0.5)}us p99=${percentile(0.99)}us '
+    'max=${samples.last}us',
+  );
+}
+
+final class _Options {
+  const _Options({
+    required this.kilobytes,
+    required this.keystrokes,
+    required this.burst,
+  });
+
+  static _Options? parse(List<String> args) {
+    final values = <String, int>{
+      'kilobytes': 200,
+      'keystrokes': 2000,
+      'burst': 20,
+    };
+    for (final arg in args) {
+      final match = RegExp(r'^--([a-z]+)=(\d+)$').firstMatch(arg);
+      if (match == null || !values.containsKey(match.group(1))) {
+        return null;
+      }
+      values[match.group(1)!] = int.parse(match.group(2)!);
+    }
+    return _Options(
+      kilobytes: math.max(1, values['kilobytes']!),
+      keystrokes: math.max(1, values['keystrokes']!),
+      burst: math.max(1, values['burst']!),
+    );
+  }
+
+  final int kilobytes;
+  final int keystrokes;
+  final int burst;
+}
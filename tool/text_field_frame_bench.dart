@@ -0,0 +1,248 @@
+// ignore_for_file: avoid_print
+
+import 'dart:async';
+import 'dart:io';
+import 'dart:math' as math;
+import 'dart:ui' show FrameTiming;
+
+import 'package:axichat/src/common/ui/axi_editable_text.dart' as axi;
+import 'package:axichat/src/common/ui/axi_spell_check.dart' as axi;
+import 'package:flutter/scheduler.dart';
+import 'package:flutter/services.dart';
+import 'package:flutter/widgets.dart';
+
+const List<String> _words = <String>[
+  'message',
+  'tomorrow',
+  'recieve',
+  'meeting',
+  'definately',
+  'thanks',
+  'attached',
+  'seperate',
+  'calendar',
+  'the',
+];
+
+const Set<String> _misspelled = <String>{'recieve', 'definately', 'seperate'};
+
+/// Types into a multiline editor holding a large document and reports what
+/// each keystroke costs end to end: the synchronous edit handling (input
+/// formatting, undo recording, spell check span carry-over) and the build
+/// and raster time of the frame it produces.
+///
+/// Keystrokes go through [axi.EditableTextState.userUpdateTextEditingValue],
+/// one per frame. The spell check service answers the first request only and
+/// reports later ones as still in flight, so every frame carries the initial
+/// spans across the edit, as between real spell check passes. Pass
+/// `--spellcheck=0` to compare against an editor without spans.
+///
+/// `tool/text_edit_typing_bench.dart` isolates the undo and span work; this
+/// one measures it in context with layout and paint.
+///
+/// Run in profile mode so frame timings are representative:
+/// Usage: `flutter run -d linux --profile -t tool/text_field_frame_bench.dart
+///   --dart-entrypoint-args=[--kilobytes=200],[--keystrokes=500],
+///   [--spellcheck=1]`
+Future<void> main(List<String> args) async {
+  WidgetsFlutterBinding.ensureInitialized();
+  final options = _Options.parse(args);
+  if (options == null) {
+    stderr.writeln(
+      'Usage: flutter run --profile -t tool/text_field_frame_bench.dart '
+      '--dart-entrypoint-args=[--kilobytes=N],[--keystrokes=N],'
+      '[--spellcheck=0|1]',
+    );
+    exit(1);
+  }
+  final random = math.Random(17);
+  final document = StringBuffer();
+  while (document.length < options.kilobytes * 1024) {
+    document
+      ..write(_words[random.nextInt(_words.length)])
+      ..write(random.nextInt(12) == 0 ? '\n' : ' ');
+  }
+  final text = document.toString();
+  final controller = TextEditingController.fromValue(
+    TextEditingValue(
+      text: text,
+      selection: TextSelection.collapsed(offset: text.length ~/ 2),
+    ),
+  );
+  final focusNode = FocusNode();
+  final editorKey = GlobalKey<axi.EditableTextState>();
+  final spellCheckService = _FirstPassSpellCheckService();
+
+  final frameTimings = <FrameTiming>[];
+  var recording = false;
+  void collect(List<FrameTiming> timings) {
+    if (recording) frameTimings.addAll(timings);
+  }
+
+  runApp(
+    Directionality(
+      textDirection: TextDirection.ltr,
+      child: ColoredBox(
+        color: const Color(0xFFFFFFFF),
+        child: axi.EditableText(
+          key: editorKey,
+          controller: controller,
+          focusNode: focusNode,
+          autofocus: true,
+          expands: true,
+          maxLines: null,
+          locale: const Locale('en'),
+          typingAnimationDuration: Duration.zero,
+          style: const TextStyle(fontSize: 14, color: Color(0xFF000000)),
+          cursorColor: const Color(0xFF000000),
+          backgroundCursorColor: const Color(0xFF808080),
+          spellCheckConfiguration: options.spellCheck
+              ? axi.SpellCheckConfiguration(
+                  spellCheckService: spellCheckService,
+                  misspelledTextStyle: const TextStyle(
+                    decoration: TextDecoration.underline,
+                    decorationColor: Color(0xFFFF0000),
+                    decorationStyle: TextDecorationStyle.wavy,
+                  ),
+                )
+              : const axi.SpellCheckConfiguration.disabled(),
+        ),
+      ),
+    ),
+  );
+  await WidgetsBinding.instance.endOfFrame;
+  final editor = editorKey.currentState!;
+
+  // Let the initial spell check pass land before timing anything.
+  _type(editor, random);
+  await spellCheckService.firstPass;
+  await WidgetsBinding.instance.endOfFrame;
+
+  SchedulerBinding.instance.addTimingsCallback(collect);
+  recording = true;
+  final editSamples = <int>[];
+  final watch = Stopwatch();
+  for (var keystroke = 0; keystroke < options.keystrokes; keystroke += 1) {
+    watch
+      ..reset()
+      ..start();
+    _type(editor, random);
+    editSamples.add(watch.elapsedMicroseconds);
+    await WidgetsBinding.instance.endOfFrame;
+  }
+  // The engine reports timings in batches; give the last batch time to
+  // arrive.
+  await Future<void>.delayed(const Duration(seconds: 2));
+  recording = false;
+  SchedulerBinding.instance.removeTimingsCallback(collect);
+
+  print(
+    'document=${text.length} code units '
+    'spans=${spellCheckService.spanCount} '
+    'keystrokes=${options.keystrokes} spellcheck=${options.spellCheck}',
+  );
+  _report('edit', editSamples);
+  _report(
+    'frame build',
+    [for (final timing in frameTimings) timing.buildDuration.inMicroseconds],
+  );
+  _report(
+    'frame raster',
+    [for (final timing in frameTimings) timing.rasterDuration.inMicroseconds],
+  );
+  exit(0);
+}
+
+void _type(axi.EditableTextState editor, math.Random random) {
+  final value = editor.textEditingValue;
+  final caret = value.selection.baseOffset;
+  final TextEditingValue next;
+  if (random.nextInt(8) == 0 && caret > 0) {
+    next = TextEditingValue(
+      text: value.text.replaceRange(caret - 1, caret, ''),
+      selection: TextSelection.collapsed(offset: caret - 1),
+    );
+  } else {
+    final typed = String.fromCharCode(0x61 + random.nextInt(26));
+    next = TextEditingValue(
+      text: value.text.replaceRange(caret, caret, typed),
+      selection: TextSelection.collapsed(offset: caret + 1),
+    );
+  }
+  editor.userUpdateTextEditingValue(next, SelectionChangedCause.keyboard);
+}
+
+final class _FirstPassSpellCheckService implements SpellCheckService {
+  final Completer<void> _firstPass = Completer<void>();
+  int spanCount = 0;
+
+  Future<void> get firstPass => _firstPass.future;
+
+  @override
+  Future<List<SuggestionSpan>?> fetchSpellCheckSuggestions(
+    Locale locale,
+    String text,
+  ) async {
+    if (_firstPass.isCompleted) return null;
+    final spans = <SuggestionSpan>[
+      for (final match in RegExp(r'[a-z]+').allMatches(text))
+        if (_misspelled.contains(match.group(0)))
+          SuggestionSpan(
+            TextRange(start: match.start, end: match.end),
+            const <String>['correction'],
+          ),
+    ];
+    spanCount = spans.length;
+    _firstPass.complete();
+    return spans;
+  }
+}
+
+void _report(String label, List<int> samples) {
+  if (samples.isEmpty) {
+    print('$label: n=0');
+    return;
+  }
+  samples.sort();
+  final total = samples.fold<int>(0, (sum, value) => sum + value);
+  int percentile(double p) =>
+      samples[math.min(samples.length - 1, (samples.length * p).floor())];
+  print(
+    '$label: n=${samples.length} '
+    'mean=${total ~/ samples.length}us '
+    'p50=${percentile(0.5)}us p99=${percentile(0.99)}us '
+    'max=${samples.last}us',
+  );
+}
+
+final class _Options {
+  const _Options({
+    required this.kilobytes,
+    required this.keystrokes,
+    required this.spellCheck,
+  });
+
+  static _Options? parse(List<String> args) {
+    final values = <String, int>{
+      'kilobytes': 200,
+      'keystrokes': 500,
+      'spellcheck': 1,
+    };
+    for (final arg in args) {
+      final match = RegExp(r'^--([a-z]+)=(\d+)$').firstMatch(arg);
+      if (match == null || !values.containsKey(match.group(1))) {
+        return null;
+      }
+      values[match.group(1)!] = int.parse(match.group(2)!);
+    }
+    return _Options(
+      kilobytes: math.max(1, values['kilobytes']!),
+      keystrokes: math.max(1, values['keystrokes']!),
+      spellCheck: values['spellcheck']! != 0,
+    );
+  }
+
+  final int kilobytes;
+  final int keystrokes;
+  final bool spellCheck;
+}